@@ -0,0 +1,197 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <nncase/kernels/kernel_context.h>
+#include <nncase/runtime/interpreter.h>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::bench;
+using namespace nncase::runtime;
+namespace chrono = std::chrono;
+
+namespace
+{
+double elapsed_ms(chrono::steady_clock::time_point start, chrono::steady_clock::time_point end) noexcept
+{
+    return chrono::duration_cast<chrono::nanoseconds>(end - start).count() / 1e6;
+}
+
+arena_sizes collect_arenas(interpreter &interp) noexcept
+{
+    arena_sizes arenas;
+    for (size_t i = 0; i < interp.modules_size(); i++)
+    {
+        auto mod = interp.find_module_by_id(i).unwrap();
+        for (size_t j = 0; j < mod->mempools_size(); j++)
+        {
+            auto &desc = mod->mempool(j);
+            switch (desc.location)
+            {
+            case mem_input:
+                arenas.input += desc.size;
+                break;
+            case mem_output:
+                arenas.output += desc.size;
+                break;
+            case mem_rdata:
+                arenas.rdata += desc.size;
+                break;
+            case mem_data:
+                arenas.data += desc.size;
+                break;
+            case mem_shared_data:
+                arenas.shared_data += desc.size;
+                break;
+            default:
+                arenas.private_data += desc.size;
+                break;
+            }
+        }
+    }
+
+    return arenas;
+}
+}
+
+double bench::percentile(const std::vector<double> &sorted, double p) noexcept
+{
+    if (sorted.empty())
+        return 0;
+
+    // Linear interpolation between the closest ranks
+    auto rank = p / 100.0 * (sorted.size() - 1);
+    auto lower = (size_t)std::floor(rank);
+    auto upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+void bench::reset_peak_rss() noexcept
+{
+#if defined(__linux__)
+    // Resets VmHWM (and the peak RSS reported by getrusage) of this process, needs Linux 4.0+
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs)
+        clear_refs << "5";
+#endif
+}
+
+size_t bench::peak_rss_kb() noexcept
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize / 1024;
+    return 0;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+    }
+    return 0;
+#elif defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0;
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+result<bench_result> bench::bench_model(const std::string &name, gsl::span<const gsl::byte> model, uint32_t threads, const bench_options &options)
+{
+    bench_result res {};
+    res.model = name;
+    res.model_size = model.size();
+
+    // Modules copy num_threads into their kernel context when they are loaded
+    auto &context = kernels::default_kernel_context();
+    auto old_threads = context.num_threads;
+    if (threads)
+        context.num_threads = threads;
+    res.threads = context.num_threads;
+
+    reset_peak_rss();
+    interpreter interp;
+    auto load_start = chrono::steady_clock::now();
+    auto load_r = interp.load_model(model);
+    res.load_ms = elapsed_ms(load_start, chrono::steady_clock::now());
+    context.num_threads = old_threads;
+    try_(load_r);
+    res.arenas = collect_arenas(interp);
+
+    // warm up
+    for (size_t i = 0; i < options.warm_up_count; i++)
+    {
+        try_(interp.run());
+    }
+
+    // run
+    std::vector<double> samples;
+    samples.reserve(options.loop_count ? options.loop_count : 1024);
+    auto bench_start = chrono::steady_clock::now();
+    while (true)
+    {
+        auto start_time = chrono::steady_clock::now();
+        try_(interp.run());
+        auto end_time = chrono::steady_clock::now();
+        samples.push_back(elapsed_ms(start_time, end_time));
+
+        if (options.loop_count && samples.size() >= options.loop_count)
+            break;
+        // The time budget caps the loop count, or replaces it when there is none
+        if (options.time_budget > 0 ? elapsed_ms(bench_start, end_time) >= options.time_budget * 1000 : !options.loop_count)
+            break;
+    }
+
+    double total_time = 0;
+    for (auto t : samples)
+        total_time += t;
+
+    res.iterations = samples.size();
+    res.avg_ms = total_time / samples.size();
+    double variance = 0;
+    for (auto t : samples)
+        variance += (t - res.avg_ms) * (t - res.avg_ms);
+    res.stddev_ms = std::sqrt(variance / samples.size());
+
+    std::sort(samples.begin(), samples.end());
+    res.min_ms = samples.front();
+    res.max_ms = samples.back();
+    res.p50_ms = percentile(samples, 50);
+    res.p90_ms = percentile(samples, 90);
+    res.p99_ms = percentile(samples, 99);
+    res.throughput = res.avg_ms > 0 ? 1000.0 / res.avg_ms : 0;
+    res.peak_rss_kb = peak_rss_kb();
+    return ok(res);
+}
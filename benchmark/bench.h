@@ -0,0 +1,87 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <gsl/gsl-lite.hpp>
+#include <iostream>
+#include <nncase/runtime/result.h>
+#include <string>
+#include <vector>
+
+namespace nncase
+{
+namespace bench
+{
+enum class report_format
+{
+    text,
+    json,
+    csv
+};
+
+struct bench_options
+{
+    size_t warm_up_count = 5;
+    // 0 means run until the time budget is exhausted
+    size_t loop_count = 10;
+    // seconds, 0 means no budget
+    double time_budget = 0;
+    // empty means keep the runtime default
+    std::vector<uint32_t> threads;
+    report_format format = report_format::text;
+    std::string output;
+    std::string tag;
+};
+
+// Sum of the mempools of all the modules, per memory location
+struct arena_sizes
+{
+    size_t input = 0;
+    size_t output = 0;
+    size_t rdata = 0;
+    size_t data = 0;
+    size_t shared_data = 0;
+    size_t private_data = 0;
+};
+
+struct bench_result
+{
+    std::string model;
+    uint32_t threads;
+    size_t model_size;
+    size_t iterations;
+    double load_ms;
+    double min_ms;
+    double max_ms;
+    double avg_ms;
+    double p50_ms;
+    double p90_ms;
+    double p99_ms;
+    double stddev_ms;
+    // inferences per second
+    double throughput;
+    // KiB, 0 if not supported on this platform
+    size_t peak_rss_kb;
+    arena_sizes arenas;
+};
+
+result<bench_result> bench_model(const std::string &name, gsl::span<const gsl::byte> model, uint32_t threads, const bench_options &options);
+
+double percentile(const std::vector<double> &sorted, double p) noexcept;
+void reset_peak_rss() noexcept;
+size_t peak_rss_kb() noexcept;
+
+void write_report(std::ostream &os, const std::vector<bench_result> &results, const bench_options &options);
+}
+}
@@ -12,77 +12,249 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "bench.h"
 #include "models/models.h"
-#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <limits>
-#include <nncase/runtime/interpreter.h>
+#include <iterator>
 #include <nncase/version.h>
+#include <sstream>
 
 using namespace nncase;
-using namespace nncase::runtime;
-namespace chrono = std::chrono;
-using namespace std::chrono_literals;
+using namespace nncase::bench;
 
-size_t warm_up_count = 5;
-size_t loop_count = 10;
-
-result<void> bench_model(const std::string &name)
+namespace
 {
-    interpreter interp;
+const char *embedded_models[] = {
+    "mnist",
+    "mobilenet_v2"
+};
 
-    auto model = get_model(name);
-    if (model.empty())
-        return err(std::errc::no_such_file_or_directory);
+void print_usage(std::ostream &os)
+{
+    os << "Usage: benchnncase [options] [model ...]" << std::endl
+       << std::endl
+       << "  model                  embedded model name (mnist, mobilenet_v2) or kmodel file, defaults to all the embedded models" << std::endl
+       << "  -w, --warmup <n>       warm up runs (default: 5)" << std::endl
+       << "  -n, --iterations <n>   measured runs, 0 runs until the time budget is exhausted (default: 10)" << std::endl
+       << "  -t, --time-budget <s>  stop measuring a model after <s> seconds" << std::endl
+       << "  -j, --threads <list>   comma separated kernel num_threads to sweep, e.g. 1,2,4 (default: runtime default)" << std::endl
+       << "  -f, --format <fmt>     text, json or csv (default: text)" << std::endl
+       << "  -o, --output <file>    write the results to <file> instead of stdout" << std::endl
+       << "      --tag <label>      label stored with the results, e.g. a commit id" << std::endl
+       << "  -h, --help             show this help" << std::endl;
+}
 
-    try_(interp.load_model(model));
+bool parse_size(const char *str, size_t &value)
+{
+    char *end;
+    auto v = std::strtoull(str, &end, 10);
+    if (!*str || *end || *str == '-')
+        return false;
+    value = (size_t)v;
+    return true;
+}
 
-    // warm up
-    for (size_t i = 0; i < warm_up_count; i++)
+bool parse_threads(const char *str, std::vector<uint32_t> &threads)
+{
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
     {
-        try_(interp.run());
+        size_t value;
+        if (!parse_size(item.c_str(), value) || !value)
+            return false;
+        threads.push_back((uint32_t)value);
     }
 
-    // run
-    double total_time = 0.0;
-    double min_time = std::numeric_limits<double>::max();
-    double max_time = std::numeric_limits<double>::lowest();
+    return !threads.empty();
+}
 
-    for (size_t i = 0; i < loop_count; i++)
+// Returns false with a message in error if the arguments are invalid
+bool parse_args(int argc, char *argv[], bench_options &options, std::vector<std::string> &models, bool &show_help, std::string &error)
+{
+    for (int i = 1; i < argc; i++)
     {
-        auto start_time = chrono::steady_clock::now();
-        try_(interp.run());
-        auto end_time = chrono::steady_clock::now();
-        auto duration_ns = chrono::duration_cast<chrono::nanoseconds>(end_time - start_time);
-        double duration_ms = duration_ns.count() / 1e6;
-
-        total_time += duration_ms;
-        min_time = std::min(min_time, duration_ms);
-        max_time = std::max(max_time, duration_ms);
+        std::string arg = argv[i];
+        auto next = [&]() -> const char * {
+            if (i + 1 >= argc)
+            {
+                error = "Missing value for " + arg;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        const char *value;
+        if (arg == "-h" || arg == "--help")
+        {
+            show_help = true;
+        }
+        else if (arg == "-w" || arg == "--warmup")
+        {
+            if (!(value = next()))
+                return false;
+            if (!parse_size(value, options.warm_up_count))
+                return error = "Invalid warm up count: " + std::string(value), false;
+        }
+        else if (arg == "-n" || arg == "--iterations")
+        {
+            if (!(value = next()))
+                return false;
+            if (!parse_size(value, options.loop_count))
+                return error = "Invalid iterations: " + std::string(value), false;
+        }
+        else if (arg == "-t" || arg == "--time-budget")
+        {
+            if (!(value = next()))
+                return false;
+            char *end;
+            options.time_budget = std::strtod(value, &end);
+            if (!*value || *end || options.time_budget <= 0)
+                return error = "Invalid time budget: " + std::string(value), false;
+        }
+        else if (arg == "-j" || arg == "--threads")
+        {
+            if (!(value = next()))
+                return false;
+            if (!parse_threads(value, options.threads))
+                return error = "Invalid threads: " + std::string(value), false;
+        }
+        else if (arg == "-f" || arg == "--format")
+        {
+            if (!(value = next()))
+                return false;
+            if (!strcmp(value, "text"))
+                options.format = report_format::text;
+            else if (!strcmp(value, "json"))
+                options.format = report_format::json;
+            else if (!strcmp(value, "csv"))
+                options.format = report_format::csv;
+            else
+                return error = "Invalid format: " + std::string(value), false;
+        }
+        else if (arg == "-o" || arg == "--output")
+        {
+            if (!(value = next()))
+                return false;
+            options.output = value;
+        }
+        else if (arg == "--tag")
+        {
+            if (!(value = next()))
+                return false;
+            options.tag = value;
+        }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            return error = "Unknown option: " + arg, false;
+        }
+        else
+        {
+            models.emplace_back(std::move(arg));
+        }
     }
 
-    printf("%20s  min = %7.2f  max = %7.2f  avg = %7.2f\n", name.c_str(), min_time, max_time, total_time / loop_count);
-    return ok();
+    if (!options.loop_count && options.time_budget <= 0)
+        return error = "--iterations 0 needs a --time-budget", false;
+    return true;
 }
 
-const char *models[] = {
-    "mnist",
-    "mobilenet_v2"
-};
+result<std::vector<gsl::byte>> read_file(const std::string &filename)
+{
+    std::ifstream infile(filename, std::ios::binary | std::ios::in);
+    if (!infile.good())
+        return err(std::errc::no_such_file_or_directory);
 
-int main()
+    infile.seekg(0, std::ios::end);
+    auto length = (size_t)infile.tellg();
+    infile.seekg(0, std::ios::beg);
+    std::vector<gsl::byte> data(length);
+    infile.read(reinterpret_cast<char *>(data.data()), length);
+    if (!infile.good())
+        return err(std::errc::io_error);
+    return ok(std::move(data));
+}
+}
+
+int main(int argc, char *argv[])
 {
-    std::cout << "nncase Benchmark Tools " NNCASE_VERSION NNCASE_VERSION_SUFFIX << std::endl
-              << "Copyright 2019-2021 Canaan Inc." << std::endl;
+    bench_options options;
+    std::vector<std::string> models;
+    bool show_help = false;
+    std::string error;
+    if (!parse_args(argc, argv, options, models, show_help, error))
+    {
+        std::cerr << error << std::endl;
+        print_usage(std::cerr);
+        return 1;
+    }
+
+    // Keep stdout clean for machine readable reports
+    auto &log = options.format == report_format::text && options.output.empty() ? std::cout : std::cerr;
+    log << "nncase Benchmark Tools " NNCASE_VERSION NNCASE_VERSION_SUFFIX << std::endl
+        << "Copyright 2019-2021 Canaan Inc." << std::endl;
 
-    for (size_t i = 0; i < sizeof(models) / sizeof(*models); i++)
+    if (show_help)
     {
-        auto r = bench_model(models[i]);
-        if (r.is_err())
+        print_usage(std::cout);
+        return 0;
+    }
+
+    if (models.empty())
+        models.assign(std::begin(embedded_models), std::end(embedded_models));
+    if (options.threads.empty())
+        options.threads.push_back(0);
+
+    std::ofstream outfile;
+    if (!options.output.empty())
+    {
+        outfile.open(options.output, std::ios::out | std::ios::trunc);
+        if (!outfile.good())
+        {
+            std::cerr << "Cannot open " << options.output << std::endl;
+            return 1;
+        }
+    }
+
+    auto &os = options.output.empty() ? std::cout : outfile;
+    std::vector<bench_result> results;
+    for (auto &name : models)
+    {
+        std::vector<gsl::byte> file_data;
+        auto model = get_model(name);
+        if (model.empty())
         {
-            fprintf(stderr, "Cannot run %s: %s, skipped\n", models[i], r.unwrap_err().message().c_str());
+            auto data_r = read_file(name);
+            if (data_r.is_err())
+            {
+                std::cerr << "Cannot read " << name << ": " << data_r.unwrap_err().message() << ", skipped" << std::endl;
+                continue;
+            }
+
+            file_data = std::move(data_r.unwrap());
+            model = file_data;
+        }
+
+        for (auto threads : options.threads)
+        {
+            auto r = bench_model(name, model, threads, options);
+            if (r.is_err())
+            {
+                std::cerr << "Cannot run " << name << ": " << r.unwrap_err().message() << ", skipped" << std::endl;
+                continue;
+            }
+
+            results.emplace_back(std::move(r.unwrap()));
+
+            // Text results are streamed as soon as they are available
+            if (options.format == report_format::text)
+                write_report(os, { results.back() }, options);
         }
     }
 
+    if (options.format != report_format::text)
+        write_report(os, results, options);
     return 0;
 }
@@ -0,0 +1,74 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "bench_util.h"
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/kernel_utils.h>
+
+using namespace nncase::kernels::cpu;
+
+namespace
+{
+struct conv2d_case
+{
+    runtime_shape_t in_shape;
+    size_t out_channels;
+    int32_t kernel;
+    int32_t stride;
+    int32_t groups;
+};
+
+const conv2d_case conv2d_cases[] = {
+    { { 1, 64, 56, 56 }, 64, 1, 1, 1 },
+    { { 1, 64, 56, 56 }, 64, 3, 1, 1 },
+    { { 1, 64, 56, 56 }, 128, 3, 2, 1 },
+    { { 1, 144, 56, 56 }, 144, 3, 1, 144 },
+    { { 1, 3, 224, 224 }, 32, 3, 2, 1 },
+};
+
+void bm_conv2d_args(benchmark::internal::Benchmark *b)
+{
+    case_thread_args(b, std::size(conv2d_cases));
+}
+
+template <impl Impl, class T>
+void bm_conv2d(benchmark::State &state)
+{
+    auto &c = conv2d_cases[state.range(0)];
+    const padding pad { c.kernel / 2, c.kernel / 2 };
+    auto out_h = kernels::detail::get_windowed_output_size(c.in_shape[2], c.kernel, c.stride, 1, pad);
+    auto out_w = kernels::detail::get_windowed_output_size(c.in_shape[3], c.kernel, c.stride, 1, pad);
+    const runtime_shape_t w_shape { c.out_channels, c.in_shape[1] / c.groups, (size_t)c.kernel, (size_t)c.kernel };
+    const runtime_shape_t out_shape { c.in_shape[0], c.out_channels, out_h, out_w };
+    auto in_strides = get_default_strides(c.in_shape), w_strides = get_default_strides(w_shape), out_strides = get_default_strides(out_shape);
+    const runtime_shape_t bias_strides { 1 };
+    auto input = random_tensor<T>(compute_size(c.in_shape));
+    auto weights = random_tensor<T>(compute_size(w_shape), -0.1, 0.1), bias = random_tensor<T>(c.out_channels);
+    std::vector<T> output(compute_size(out_shape));
+    auto act = value_range<float>::full();
+    auto context = make_context(state.range(1));
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::conv2d(input.data(), weights.data(), bias.data(), output.data(), c.in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides, pad, pad, c.groups, c.stride, c.stride, 1, 1, act, context))
+    else
+        BENCH_RUN(state, kernels::conv2d(input.data(), weights.data(), bias.data(), output.data(), c.in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides, pad, pad, c.groups, c.stride, c.stride, 1, 1, act, context))
+    state.SetLabel(shape_label(c.in_shape) + " w " + shape_label(w_shape) + " s" + std::to_string(c.stride) + (c.groups > 1 ? " dw" : ""));
+    set_counters(state, 2.0 * output.size() * w_shape[1] * w_shape[2] * w_shape[3],
+        (double)(input.size() + weights.size() + output.size()) * sizeof(T));
+}
+
+BENCH_IMPLS(bm_conv2d, float);
+}
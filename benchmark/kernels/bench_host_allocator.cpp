@@ -0,0 +1,78 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "bench_util.h"
+#include <nncase/runtime/host_runtime_tensor.h>
+
+namespace
+{
+// The input and output tensors a serving loop creates for every request, the last case is
+// beyond the largest buffer malloc keeps on its heap so each request maps and faults in fresh pages
+struct request_case
+{
+    runtime_shape_t in_shape;
+    runtime_shape_t out_shape;
+};
+
+const request_case request_cases[] = {
+    { { 1, 16 }, { 1, 4 } },
+    { { 1, 3, 224, 224 }, { 1, 1000 } },
+    { { 1, 3, 416, 416 }, { 1, 10647, 85 } },
+    { { 1, 3, 2160, 3840 }, { 1, 19, 540, 960 } },
+};
+
+constexpr size_t page_size = 4096;
+
+result<void> touch(runtime_tensor &tensor) noexcept
+{
+    try_var(map, hrt::map(tensor, hrt::map_write));
+    auto buffer = map.buffer();
+    for (size_t i = 0; i < buffer.size(); i += page_size)
+        buffer[i] = gsl::byte(1);
+    return ok();
+}
+
+result<void> request(const request_case &c, host_allocator &allocator) noexcept
+{
+    try_var(input, hrt::create(dt_float32, c.in_shape, allocator));
+    try_var(output, hrt::create(dt_float32, c.out_shape, allocator));
+    try_(touch(input));
+    return touch(output);
+}
+
+void bm_request_tensors_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(request_cases));
+}
+
+// Creates, writes every page of and releases the tensors of a request
+template <class Allocator>
+void bm_request_tensors(benchmark::State &state)
+{
+    auto &c = request_cases[state.range(0)];
+    Allocator allocator;
+    BENCH_RUN(state, request(c, allocator))
+    state.SetLabel(shape_label(c.in_shape) + " -> " + shape_label(c.out_shape));
+    if constexpr (std::is_same_v<Allocator, pooled_host_allocator>)
+    {
+        auto stats = allocator.stats();
+        state.counters["hits"] = (double)stats.hits;
+        state.counters["misses"] = (double)stats.misses;
+        state.counters["bytes_held"] = (double)stats.bytes_held;
+    }
+}
+}
+
+BENCHMARK_TEMPLATE(bm_request_tensors, heap_host_allocator)->Apply(bm_request_tensors_args);
+BENCHMARK_TEMPLATE(bm_request_tensors, pooled_host_allocator)->Apply(bm_request_tensors_args);
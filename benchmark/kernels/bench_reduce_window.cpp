@@ -0,0 +1,64 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "bench_util.h"
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/kernels/reduce_window.h>
+#include <limits>
+
+namespace
+{
+struct reduce_window2d_case
+{
+    reduce_op_t op;
+    runtime_shape_t in_shape;
+    int32_t filter;
+    int32_t stride;
+    padding pad;
+};
+
+const reduce_window2d_case reduce_window2d_cases[] = {
+    { reduce_max, { 1, 64, 112, 112 }, 3, 2, { 1, 1 } },
+    { reduce_mean, { 1, 64, 56, 56 }, 2, 2, padding::zero() },
+    { reduce_mean, { 1, 1280, 7, 7 }, 7, 1, padding::zero() },
+};
+
+void bm_reduce_window2d_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(reduce_window2d_cases));
+}
+
+template <class T>
+void bm_reduce_window2d(benchmark::State &state)
+{
+    auto &c = reduce_window2d_cases[state.range(0)];
+    auto out_h = kernels::detail::get_windowed_output_size(c.in_shape[2], c.filter, c.stride, 1, c.pad);
+    auto out_w = kernels::detail::get_windowed_output_size(c.in_shape[3], c.filter, c.stride, 1, c.pad);
+    const runtime_shape_t out_shape { c.in_shape[0], c.in_shape[1], out_h, out_w };
+    auto in_strides = get_default_strides(c.in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(c.in_shape));
+    std::vector<T> output(compute_size(out_shape));
+    T init_value = c.op == reduce_max ? std::numeric_limits<T>::lowest() : 0;
+    auto act = value_range<float>::full();
+    auto context = make_context(1);
+
+    BENCH_RUN(state, kernels::reduce_window2d(c.op, input.data(), init_value, output.data(), c.in_shape, in_strides, out_strides, c.pad, c.pad, c.filter, c.filter, c.stride, c.stride, 1, 1, act, context))
+    state.SetLabel(std::string(reduce_op_to_string(c.op)) + " " + shape_label(c.in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, (double)output.size() * c.filter * c.filter, (double)(input.size() + output.size()) * sizeof(T));
+}
+
+// The dispatch has no optimized path yet, so there is no reference variant to compare
+BENCHMARK_TEMPLATE(bm_reduce_window2d, float)->Apply(bm_reduce_window2d_args);
+}
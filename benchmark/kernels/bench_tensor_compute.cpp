@@ -0,0 +1,1056 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "bench_util.h"
+#include <algorithm>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/kernels/tensor_compute.h>
+
+using namespace nncase::kernels::cpu;
+
+namespace
+{
+const value_range<float> no_activation = value_range<float>::full();
+
+runtime_shape_t reduced_shape(const runtime_shape_t &in_shape, const runtime_shape_t &axis)
+{
+    auto out_shape = in_shape;
+    for (auto a : axis)
+        out_shape[a] = 1;
+    return out_shape;
+}
+
+// ---------------------------------------------------------------------------
+// Elementwise
+// ---------------------------------------------------------------------------
+
+struct binary_case
+{
+    runtime_shape_t a_shape;
+    runtime_shape_t b_shape;
+};
+
+const binary_case binary_cases[] = {
+    { { 1, 64, 56, 56 }, { 1, 64, 56, 56 } },
+    { { 1, 64, 56, 56 }, { 1, 64, 1, 1 } },
+    { { 1, 64, 56, 56 }, { 1 } },
+};
+
+void bm_binary_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(binary_cases));
+}
+
+template <impl Impl, class T>
+void bm_binary(benchmark::State &state)
+{
+    auto &c = binary_cases[state.range(0)];
+    auto out_shape = kernels::detail::get_binary_output_shape(c.a_shape, c.b_shape);
+    auto a = random_tensor<T>(compute_size(c.a_shape), 1, 8);
+    auto b = random_tensor<T>(compute_size(c.b_shape), 1, 8);
+    std::vector<T> out(compute_size(out_shape));
+    auto a_strides = get_default_strides(c.a_shape), b_strides = get_default_strides(c.b_shape), out_strides = get_default_strides(out_shape);
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::binary(binary_add, a.data(), b.data(), out.data(), c.a_shape, a_strides, c.b_shape, b_strides, out_shape, out_strides, no_activation, context))
+    else
+        BENCH_RUN(state, kernels::binary(binary_add, a.data(), b.data(), out.data(), c.a_shape, a_strides, c.b_shape, b_strides, out_shape, out_strides, no_activation, context))
+    state.SetLabel(shape_label(c.a_shape) + " + " + shape_label(c.b_shape));
+    set_counters(state, (double)out.size(), (double)(a.size() + b.size() + out.size()) * sizeof(T));
+}
+
+BENCH_IMPLS(bm_binary, float);
+BENCH_IMPLS(bm_binary, int32_t);
+BENCHMARK_TEMPLATE(bm_binary, impl::dispatch, int64_t)->Apply(bm_binary_args);
+
+const unary_op_t unary_cases[] = { unary_abs, unary_exp, unary_log, unary_rsqrt, unary_tanh, unary_erf };
+
+void bm_unary_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(unary_cases));
+}
+
+template <impl Impl>
+void bm_unary(benchmark::State &state)
+{
+    const runtime_shape_t shape { 1, 64, 112, 112 };
+    const auto strides = get_default_strides(shape);
+    auto op = unary_cases[state.range(0)];
+    auto input = random_tensor<float>(compute_size(shape), 0.1, 4);
+    std::vector<float> output(input.size());
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::unary(op, input.data(), output.data(), shape, strides, strides, context))
+    else
+        BENCH_RUN(state, kernels::unary(op, input.data(), output.data(), shape, strides, strides, context))
+    state.SetLabel(std::string(unary_op_to_string(op)) + " " + shape_label(shape));
+    set_counters(state, (double)input.size(), 2.0 * input.size() * sizeof(float));
+}
+
+BENCHMARK_TEMPLATE(bm_unary, impl::dispatch)->Apply(bm_unary_args);
+BENCHMARK_TEMPLATE(bm_unary, impl::ref)->Apply(bm_unary_args);
+
+template <class T>
+void bm_compare(benchmark::State &state)
+{
+    auto &c = binary_cases[state.range(0)];
+    auto out_shape = kernels::detail::get_binary_output_shape(c.a_shape, c.b_shape);
+    auto a = random_tensor<T>(compute_size(c.a_shape), 0, 8);
+    auto b = random_tensor<T>(compute_size(c.b_shape), 0, 8);
+    std::vector<uint8_t> out(compute_size(out_shape));
+    auto a_strides = get_default_strides(c.a_shape), b_strides = get_default_strides(c.b_shape), out_strides = get_default_strides(out_shape);
+
+    BENCH_RUN(state, kernels::compare(compare_less, a.data(), b.data(), reinterpret_cast<bool *>(out.data()), c.a_shape, a_strides, c.b_shape, b_strides, out_shape, out_strides))
+    state.SetLabel(shape_label(c.a_shape) + " < " + shape_label(c.b_shape));
+    set_counters(state, (double)out.size(), (double)(a.size() + b.size()) * sizeof(T) + out.size());
+}
+
+BENCHMARK_TEMPLATE(bm_compare, float)->Apply(bm_binary_args);
+BENCHMARK_TEMPLATE(bm_compare, int32_t)->Apply(bm_binary_args);
+BENCHMARK_TEMPLATE(bm_compare, uint8_t)->Apply(bm_binary_args);
+
+template <impl Impl>
+void bm_ternary(benchmark::State &state)
+{
+    const runtime_shape_t shape { 1, 64, 56, 56 };
+    const auto strides = get_default_strides(shape);
+    auto cond = random_tensor<float>(compute_size(shape), 0, 1);
+    for (auto &v : cond)
+        v = v > 0.5f ? 1.f : 0.f;
+    auto b = random_tensor<float>(cond.size());
+    auto c = random_tensor<float>(cond.size());
+    std::vector<float> out(cond.size());
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::ternary(cond.data(), b.data(), c.data(), out.data(), shape, strides, shape, strides, shape, strides, strides))
+    else
+        BENCH_RUN(state, kernels::ternary(cond.data(), b.data(), c.data(), out.data(), shape, strides, shape, strides, shape, strides, strides))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, 4.0 * out.size() * sizeof(float));
+}
+
+BENCHMARK_TEMPLATE(bm_ternary, impl::dispatch);
+BENCHMARK_TEMPLATE(bm_ternary, impl::ref);
+
+template <impl Impl>
+void bm_sigmoid(benchmark::State &state)
+{
+    const runtime_shape_t shape { 1, 64, 112, 112 };
+    const auto strides = get_default_strides(shape);
+    auto input = random_tensor<float>(compute_size(shape), -4, 4);
+    std::vector<float> output(input.size());
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::sigmoid(input.data(), output.data(), shape, strides, strides))
+    else
+        BENCH_RUN(state, kernels::sigmoid(input.data(), output.data(), shape, strides, strides))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 3.0 * input.size(), 2.0 * input.size() * sizeof(float));
+}
+
+BENCHMARK_TEMPLATE(bm_sigmoid, impl::dispatch);
+BENCHMARK_TEMPLATE(bm_sigmoid, impl::ref);
+
+void bm_lut1d(benchmark::State &state)
+{
+    const runtime_shape_t shape { 1, 64, 112, 112 };
+    const auto strides = get_default_strides(shape);
+    auto input = random_tensor<uint8_t>(compute_size(shape), 0, 255);
+    auto table = random_tensor<uint8_t>(256, 0, 255);
+    std::vector<uint8_t> output(input.size());
+
+    BENCH_RUN(state, kernels::lut1d(dt_uint8, bytes(input), bytes(table), bytes(output), shape, strides, strides, scalar((uint8_t)0), scalar((uint8_t)255)))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, 2.0 * input.size());
+}
+
+BENCHMARK(bm_lut1d);
+
+// ---------------------------------------------------------------------------
+// Quantization and type conversion
+// ---------------------------------------------------------------------------
+
+// network input, early and late feature maps, classifier output
+const runtime_shape_t quantize_cases[] = {
+    { 1, 3, 224, 224 },
+    { 1, 64, 112, 112 },
+    { 1, 256, 14, 14 },
+    { 1, 1000 },
+};
+
+void bm_quantize_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(quantize_cases));
+}
+
+void bm_dequantize_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(quantize_cases));
+}
+
+void bm_convert_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(quantize_cases));
+}
+
+template <impl Impl, class TQ>
+void bm_quantize(benchmark::State &state)
+{
+    auto &shape = quantize_cases[state.range(0)];
+    const auto strides = get_default_strides(shape);
+    auto input = random_tensor<float>(compute_size(shape), -4, 4);
+    std::vector<TQ> output(input.size());
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::quantize(dt_float32, to_datatype<TQ>(), bytes(input), bytes(output), shape, strides, strides, 0.03f, 128.f, context))
+    else
+        BENCH_RUN(state, kernels::quantize(dt_float32, to_datatype<TQ>(), bytes(input), bytes(output), shape, strides, strides, 0.03f, 128.f, context))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 2.0 * input.size(), (double)input.size() * (sizeof(float) + sizeof(TQ)));
+}
+
+template <impl Impl, class TQ>
+void bm_dequantize(benchmark::State &state)
+{
+    auto &shape = quantize_cases[state.range(0)];
+    const auto strides = get_default_strides(shape);
+    auto input = random_tensor<TQ>(compute_size(shape), 0, 127);
+    std::vector<float> output(input.size());
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::dequantize(to_datatype<TQ>(), dt_float32, bytes(input), bytes(output), shape, strides, strides, 0.03f, 128.f, context))
+    else
+        BENCH_RUN(state, kernels::dequantize(to_datatype<TQ>(), dt_float32, bytes(input), bytes(output), shape, strides, strides, 0.03f, 128.f, context))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 2.0 * input.size(), (double)input.size() * (sizeof(float) + sizeof(TQ)));
+}
+
+BENCH_IMPLS(bm_quantize, uint8_t);
+BENCH_IMPLS(bm_quantize, int8_t);
+BENCH_IMPLS(bm_dequantize, uint8_t);
+BENCH_IMPLS(bm_dequantize, int8_t);
+
+template <impl Impl, class TI, class TO>
+void bm_convert(benchmark::State &state)
+{
+    auto &shape = quantize_cases[state.range(0)];
+    const auto strides = get_default_strides(shape);
+    std::vector<TI> input(compute_size(shape));
+    auto values = random_tensor<float>(input.size(), -100, 100);
+    std::transform(values.begin(), values.end(), input.begin(), [](float v) { return static_cast<TI>(v); });
+    std::vector<TO> output(input.size());
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::convert(to_datatype<TI>(), to_datatype<TO>(), bytes(input), bytes(output), shape, strides, strides, context))
+    else
+        BENCH_RUN(state, kernels::convert(to_datatype<TI>(), to_datatype<TO>(), bytes(input), bytes(output), shape, strides, strides, context))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, (double)input.size() * (sizeof(TI) + sizeof(TO)));
+}
+
+BENCHMARK_TEMPLATE(bm_convert, impl::dispatch, float, int32_t)->Apply(bm_convert_args);
+BENCHMARK_TEMPLATE(bm_convert, impl::dispatch, uint8_t, float)->Apply(bm_convert_args);
+BENCH_IMPLS(bm_convert, float, half);
+BENCH_IMPLS(bm_convert, half, float);
+BENCH_IMPLS(bm_convert, float, bfloat16);
+BENCH_IMPLS(bm_convert, bfloat16, float);
+
+// ---------------------------------------------------------------------------
+// Linear algebra and normalization
+// ---------------------------------------------------------------------------
+
+// m, k, n
+const size_t matmul_cases[][3] = {
+    { 64, 64, 64 },
+    { 256, 256, 256 },
+    { 1, 1024, 1000 },
+    { 384, 768, 768 },
+};
+
+void bm_matmul_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(matmul_cases));
+}
+
+template <impl Impl, class T>
+void bm_matmul(benchmark::State &state)
+{
+    auto m = matmul_cases[state.range(0)][0], k = matmul_cases[state.range(0)][1], n = matmul_cases[state.range(0)][2];
+    const runtime_shape_t a_shape { m, k }, b_shape { k, n }, out_shape { m, n };
+    auto a = random_tensor<T>(m * k), b = random_tensor<T>(k * n), bias = random_tensor<T>(n);
+    std::vector<T> out(m * n);
+    auto a_strides = get_default_strides(a_shape), b_strides = get_default_strides(b_shape), out_strides = get_default_strides(out_shape);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::matmul(a.data(), b.data(), bias.data(), out.data(), a_shape, a_strides, b_shape, b_strides, out_shape, out_strides, no_activation))
+    else
+        BENCH_RUN(state, kernels::matmul(a.data(), b.data(), bias.data(), out.data(), a_shape, a_strides, b_shape, b_strides, out_shape, out_strides, no_activation))
+    state.SetLabel(shape_label(a_shape) + " * " + shape_label(b_shape));
+    set_counters(state, 2.0 * m * k * n, (double)(a.size() + b.size() + out.size()) * sizeof(T));
+}
+
+BENCH_IMPLS(bm_matmul, float);
+
+struct norm_case
+{
+    runtime_shape_t shape;
+    int32_t axis;
+};
+
+const norm_case softmax_cases[] = {
+    { { 1, 1000 }, 1 },
+    { { 8, 128, 128 }, 2 },
+    { { 1, 64, 56, 56 }, 1 },
+};
+
+void bm_softmax_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(softmax_cases));
+}
+
+template <impl Impl, class T>
+void bm_softmax(benchmark::State &state)
+{
+    auto &c = softmax_cases[state.range(0)];
+    const auto strides = get_default_strides(c.shape);
+    auto input = random_tensor<T>(compute_size(c.shape), -4, 4);
+    std::vector<T> output(input.size());
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::softmax(input.data(), output.data(), c.shape, strides, strides, c.axis, 1.f))
+    else
+        BENCH_RUN(state, kernels::softmax(input.data(), output.data(), c.shape, strides, strides, c.axis, 1.f))
+    state.SetLabel(shape_label(c.shape) + " axis " + std::to_string(c.axis));
+    set_counters(state, 4.0 * input.size(), 2.0 * input.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_softmax, float);
+
+const norm_case layernorm_cases[] = {
+    { { 1, 128, 768 }, 2 },
+    { { 1, 384, 1024 }, 2 },
+};
+
+void bm_layernorm_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(layernorm_cases));
+}
+
+template <impl Impl, class T>
+void bm_layernorm(benchmark::State &state)
+{
+    auto &c = layernorm_cases[state.range(0)];
+    size_t norm_size = 1;
+    for (size_t i = c.axis; i < c.shape.size(); i++)
+        norm_size *= c.shape[i];
+    auto input = random_tensor<T>(compute_size(c.shape));
+    auto scale = random_tensor<T>(norm_size), bias = random_tensor<T>(norm_size);
+    std::vector<T> output(input.size());
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::layernorm(input.data(), output.data(), scale.data(), bias.data(), c.shape, c.axis, 1e-5f))
+    else
+        BENCH_RUN(state, kernels::layernorm(input.data(), output.data(), scale.data(), bias.data(), c.shape, c.axis, 1e-5f))
+    state.SetLabel(shape_label(c.shape));
+    set_counters(state, 8.0 * input.size(), 2.0 * input.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_layernorm, float);
+
+void bm_hardmax(benchmark::State &state)
+{
+    const runtime_shape_t shape { 64, 1000 };
+    const auto strides = get_default_strides(shape);
+    auto input = random_tensor<float>(compute_size(shape));
+    std::vector<float> output(input.size());
+
+    BENCH_RUN(state, kernels::hardmax(input.data(), shape, strides, output.data(), 1))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, (double)input.size(), 2.0 * input.size() * sizeof(float));
+}
+
+BENCHMARK(bm_hardmax);
+
+// ---------------------------------------------------------------------------
+// Reductions
+// ---------------------------------------------------------------------------
+
+struct reduce_case
+{
+    runtime_shape_t shape;
+    runtime_shape_t axis;
+};
+
+const reduce_case reduce_cases[] = {
+    { { 1, 64, 56, 56 }, { 2, 3 } },
+    { { 1, 64, 56, 56 }, { 1 } },
+    { { 1, 64, 56, 56 }, { 3 } },
+    { { 1, 1000 }, { 1 } },
+};
+
+void bm_reduce_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(reduce_cases));
+}
+
+template <impl Impl, class T>
+void bm_reduce(benchmark::State &state)
+{
+    auto &c = reduce_cases[state.range(0)];
+    auto out_shape = reduced_shape(c.shape, c.axis);
+    auto in_strides = get_default_strides(c.shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(c.shape), 0, 8);
+    std::vector<T> output(compute_size(out_shape));
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::reduce(reduce_sum, (T)0, input.data(), output.data(), c.shape, c.axis, in_strides, out_strides, true, context))
+    else
+        BENCH_RUN(state, kernels::reduce(reduce_sum, (T)0, input.data(), output.data(), c.shape, c.axis, in_strides, out_strides, true, context))
+    state.SetLabel(shape_label(c.shape) + " -> " + shape_label(out_shape));
+    set_counters(state, (double)input.size(), (double)(input.size() + output.size()) * sizeof(T));
+}
+
+BENCH_IMPLS(bm_reduce, float);
+BENCH_IMPLS(bm_reduce, int32_t);
+
+template <class T>
+void bm_reduce_arg(benchmark::State &state)
+{
+    auto &c = reduce_cases[state.range(0)];
+    auto out_shape = reduced_shape(c.shape, c.axis);
+    auto in_strides = get_default_strides(c.shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<float>(compute_size(c.shape));
+    std::vector<T> output(compute_size(out_shape));
+
+    BENCH_RUN(state, kernels::reduce_arg(reduce_arg_max, input.data(), output.data(), c.shape, in_strides, out_strides, c.axis, true, false))
+    state.SetLabel(shape_label(c.shape) + " -> " + shape_label(out_shape));
+    set_counters(state, (double)input.size(), (double)input.size() * sizeof(float) + output.size() * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(bm_reduce_arg, int64_t)->Apply(bm_reduce_args);
+
+void bm_reduce_prod(benchmark::State &state)
+{
+    auto &c = reduce_cases[state.range(0)];
+    auto out_shape = reduced_shape(c.shape, c.axis);
+    auto in_strides = get_default_strides(c.shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<float>(compute_size(c.shape), 0.99, 1.01);
+    std::vector<float> output(compute_size(out_shape));
+
+    BENCH_RUN(state, kernels::reduce_prod(input.data(), output.data(), c.shape, in_strides, out_strides, c.axis, true))
+    state.SetLabel(shape_label(c.shape) + " -> " + shape_label(out_shape));
+    set_counters(state, (double)input.size(), (double)(input.size() + output.size()) * sizeof(float));
+}
+
+BENCHMARK(bm_reduce_prod)->Apply(bm_reduce_args);
+
+void bm_cumsum(benchmark::State &state)
+{
+    const runtime_shape_t shape { 64, 56, 56 };
+    auto input = random_tensor<float>(compute_size(shape));
+    std::vector<float> output(input.size());
+
+    BENCH_RUN(state, kernels::cumsum(input.data(), output.data(), shape, 2, false, false))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, (double)input.size(), 2.0 * input.size() * sizeof(float));
+}
+
+BENCHMARK(bm_cumsum);
+
+void bm_topk_args(benchmark::internal::Benchmark *b)
+{
+    b->Arg(5)->Arg(100)->ArgName("k");
+}
+
+template <impl Impl>
+void bm_topk(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 64, 1000 };
+    const int64_t k = state.range(0);
+    const runtime_shape_t out_shape { 64, (size_t)k };
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<float>(compute_size(in_shape));
+    std::vector<float> values(compute_size(out_shape));
+    std::vector<int64_t> indices(values.size());
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::topk(input.data(), values.data(), indices.data(), in_shape, in_strides, out_shape, out_strides, out_shape, out_strides, k, 1, true, true))
+    else
+        BENCH_RUN(state, kernels::topk(input.data(), values.data(), indices.data(), in_shape, in_strides, out_shape, out_strides, out_shape, out_strides, k, 1, true, true))
+    state.SetLabel(shape_label(in_shape) + " k " + std::to_string(k));
+    set_counters(state, 0, (double)input.size() * sizeof(float));
+}
+
+BENCHMARK_TEMPLATE(bm_topk, impl::dispatch)->Apply(bm_topk_args);
+BENCHMARK_TEMPLATE(bm_topk, impl::ref)->Apply(bm_topk_args);
+
+// ---------------------------------------------------------------------------
+// Data movement
+// ---------------------------------------------------------------------------
+
+// shape, source strides
+struct copy_case
+{
+    runtime_shape_t shape;
+    runtime_shape_t src_strides;
+};
+
+const copy_case copy_cases[] = {
+    { { 1, 64, 112, 112 }, { 64 * 112 * 112, 112 * 112, 112, 1 } },
+    { { 1, 64, 112, 112 }, { 64 * 112 * 128, 112 * 128, 128, 1 } },
+    { { 1, 64, 112, 112 }, { 64 * 112 * 112, 1, 112 * 64, 64 } },
+};
+
+void bm_copy_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(copy_cases));
+}
+
+template <impl Impl, class T>
+void bm_copy(benchmark::State &state)
+{
+    auto &c = copy_cases[state.range(0)];
+    auto dest_strides = get_default_strides(c.shape);
+    auto src = random_tensor<T>(c.src_strides[0] * c.shape[0], 0, 100);
+    std::vector<T> dest(compute_size(c.shape));
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::copy(to_datatype<T>(), bytes(src), bytes(dest), c.shape, c.src_strides, dest_strides, context))
+    else
+        BENCH_RUN(state, kernels::copy(to_datatype<T>(), bytes(src), bytes(dest), c.shape, c.src_strides, dest_strides, context))
+    state.SetLabel(shape_label(c.shape) + " src strides " + shape_label(c.src_strides));
+    set_counters(state, 0, 2.0 * dest.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_copy, float);
+BENCH_IMPLS(bm_copy, uint8_t);
+
+const runtime_shape_t transpose_perms[] = {
+    { 0, 2, 3, 1 },
+    { 0, 3, 1, 2 },
+    { 0, 1, 3, 2 },
+};
+
+template <class T>
+void bm_transpose(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 1, 64, 112, 112 };
+    auto &perm = transpose_perms[state.range(0)];
+    runtime_shape_t out_shape(in_shape.size());
+    for (size_t i = 0; i < perm.size(); i++)
+        out_shape[i] = in_shape[perm[i]];
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(in_shape), 0, 100);
+    std::vector<T> output(input.size());
+
+    BENCH_RUN(state, kernels::transpose(to_datatype<T>(), bytes(input), bytes(output), in_shape, perm, in_strides, out_strides))
+    state.SetLabel(shape_label(in_shape) + " perm " + shape_label(perm));
+    set_counters(state, 0, 2.0 * input.size() * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(bm_transpose, float)->DenseRange(0, std::size(transpose_perms) - 1)->ArgName("case");
+
+// number of inputs, axis
+const size_t concat_cases[][2] = {
+    { 2, 1 },
+    { 4, 1 },
+    { 4, 3 },
+};
+
+void bm_concat_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(concat_cases));
+}
+
+template <impl Impl, class T>
+void bm_concat(benchmark::State &state)
+{
+    auto inputs_count = concat_cases[state.range(0)][0], axis = concat_cases[state.range(0)][1];
+    runtime_shape_t in_shape { 1, 32, 56, 56 };
+    auto out_shape = in_shape;
+    out_shape[axis] *= inputs_count;
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+
+    std::vector<std::vector<T>> inputs;
+    std::vector<const gsl::byte *> input_ptrs;
+    std::vector<runtime_shape_t> inputs_strides(inputs_count, in_strides);
+    runtime_shape_t concat_dims(inputs_count, in_shape[axis]);
+    for (size_t i = 0; i < inputs_count; i++)
+    {
+        inputs.emplace_back(random_tensor<T>(compute_size(in_shape), 0, 100));
+        input_ptrs.emplace_back(bytes(inputs.back()));
+    }
+    std::vector<T> output(compute_size(out_shape));
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::concat(to_datatype<T>(), input_ptrs, bytes(output), out_shape, inputs_strides, out_strides, axis, concat_dims, context))
+    else
+        BENCH_RUN(state, kernels::concat(to_datatype<T>(), input_ptrs, bytes(output), out_shape, inputs_strides, out_strides, axis, concat_dims, context))
+    state.SetLabel(std::to_string(inputs_count) + " x " + shape_label(in_shape) + " axis " + std::to_string(axis));
+    set_counters(state, 0, 2.0 * output.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_concat, float);
+
+struct slice_case
+{
+    runtime_shape_t begins;
+    runtime_axis_t ends;
+    runtime_axis_t strides;
+};
+
+const slice_case slice_cases[] = {
+    { { 0, 32, 8, 8 }, { 1, 96, 48, 48 }, { 1, 1, 1, 1 } },
+    { { 0, 0, 0, 0 }, { 1, 128, 56, 56 }, { 1, 1, 2, 2 } },
+    { { 0, 0, 0, 0 }, { 1, 64, 56, 56 }, { 1, 1, 1, 1 } },
+};
+
+void bm_slice_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, std::size(slice_cases));
+}
+
+template <impl Impl, class T>
+void bm_slice(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 1, 128, 56, 56 };
+    auto &c = slice_cases[state.range(0)];
+    runtime_shape_t out_shape(in_shape.size());
+    for (size_t i = 0; i < in_shape.size(); i++)
+        out_shape[i] = (size_t)((c.ends[i] - (int32_t)c.begins[i] + c.strides[i] - 1) / c.strides[i]);
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(in_shape), 0, 100);
+    std::vector<T> output(compute_size(out_shape));
+    auto context = make_context(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::slice(to_datatype<T>(), bytes(input), bytes(output), in_shape, in_strides, out_strides, c.begins, c.ends, c.strides, context))
+    else
+        BENCH_RUN(state, kernels::slice(to_datatype<T>(), bytes(input), bytes(output), in_shape, in_strides, out_strides, c.begins, c.ends, c.strides, context))
+    state.SetLabel(shape_label(in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, 2.0 * output.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_slice, float);
+
+const pad_mode_t pad_cases[] = { pad_constant, pad_reflect, pad_edge };
+
+template <class T>
+void bm_pad(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 1, 64, 56, 56 };
+    const runtime_paddings_t paddings { padding::zero(), padding::zero(), { 1, 1 }, { 1, 1 } };
+    const runtime_shape_t out_shape { 1, 64, 58, 58 };
+    auto mode = pad_cases[state.range(0)];
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(in_shape), 0, 100);
+    std::vector<T> output(compute_size(out_shape));
+
+    BENCH_RUN(state, kernels::pad(to_datatype<T>(), bytes(input), bytes(output), in_shape, in_strides, out_strides, paddings, mode, scalar(0.f)))
+    state.SetLabel(shape_label(in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, (double)(input.size() + output.size()) * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(bm_pad, float)->DenseRange(0, std::size(pad_cases) - 1)->ArgName("case");
+
+const binary_case broadcast_cases[] = {
+    { { 1, 64, 1, 1 }, { 1, 64, 56, 56 } },
+    { { 1, 1, 56, 56 }, { 1, 64, 56, 56 } },
+};
+
+template <class T>
+void bm_broadcast(benchmark::State &state)
+{
+    auto &c = broadcast_cases[state.range(0)];
+    auto in_strides = get_default_strides(c.a_shape), out_strides = get_default_strides(c.b_shape);
+    auto input = random_tensor<T>(compute_size(c.a_shape), 0, 100);
+    std::vector<T> output(compute_size(c.b_shape));
+
+    BENCH_RUN(state, kernels::broadcast(to_datatype<T>(), bytes(input), bytes(output), c.a_shape, in_strides, c.b_shape, out_strides))
+    state.SetLabel(shape_label(c.a_shape) + " -> " + shape_label(c.b_shape));
+    set_counters(state, 0, (double)(input.size() + output.size()) * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(bm_broadcast, float)->DenseRange(0, std::size(broadcast_cases) - 1)->ArgName("case");
+
+void bm_space_to_batch(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 1, 64, 56, 56 }, block_shape { 2, 2 };
+    const runtime_shape_t out_shape { 4, 64, 28, 28 };
+    const runtime_paddings_t paddings { padding::zero(), padding::zero() };
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<float>(compute_size(in_shape));
+    std::vector<float> output(compute_size(out_shape));
+
+    BENCH_RUN(state, kernels::space_to_batch(dt_float32, bytes(input), bytes(output), in_shape, block_shape, paddings, in_strides, out_strides))
+    state.SetLabel(shape_label(in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, 2.0 * output.size() * sizeof(float));
+}
+
+BENCHMARK(bm_space_to_batch);
+
+void bm_batch_to_space(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 4, 64, 28, 28 }, block_shape { 2, 2 };
+    const runtime_shape_t out_shape { 1, 64, 56, 56 };
+    const runtime_paddings_t crops { padding::zero(), padding::zero() };
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<float>(compute_size(in_shape));
+    std::vector<float> output(compute_size(out_shape));
+
+    BENCH_RUN(state, kernels::batch_to_space(dt_float32, bytes(input), bytes(output), in_shape, block_shape, crops, in_strides, out_strides))
+    state.SetLabel(shape_label(in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, 2.0 * output.size() * sizeof(float));
+}
+
+BENCHMARK(bm_batch_to_space);
+
+void bm_trilu(benchmark::State &state)
+{
+    const runtime_shape_t shape { 64, 256, 256 };
+    auto input = random_tensor<float>(compute_size(shape));
+    std::vector<float> output(input.size());
+
+    BENCH_RUN(state, kernels::trilu(input.data(), output.data(), shape, true, 0))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, 2.0 * input.size() * sizeof(float));
+}
+
+BENCHMARK(bm_trilu);
+
+void bm_compress(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 64, 1024 }, condition_shape { 1024 };
+    auto input = random_tensor<float>(compute_size(in_shape));
+    auto condition = random_tensor<uint8_t>(compute_size(condition_shape), 0, 1);
+    size_t selected = 0;
+    for (auto c : condition)
+        selected += c;
+    std::vector<float> output(in_shape[0] * selected);
+
+    BENCH_RUN(state, kernels::compress(input.data(), condition.data(), output.data(), in_shape, condition_shape, 1))
+    state.SetLabel(shape_label(in_shape));
+    set_counters(state, 0, (double)(input.size() + output.size()) * sizeof(float));
+}
+
+BENCHMARK(bm_compress);
+
+// ---------------------------------------------------------------------------
+// Gather and scatter
+// ---------------------------------------------------------------------------
+
+struct gather_case
+{
+    runtime_shape_t in_shape;
+    runtime_shape_t indices_shape;
+    int32_t axis;
+};
+
+const gather_case gather_cases[] = {
+    { { 30522, 768 }, { 1, 128 }, 0 },
+    { { 1, 256, 56, 56 }, { 64 }, 1 },
+};
+
+void bm_gather_args(benchmark::internal::Benchmark *b)
+{
+    case_thread_args(b, std::size(gather_cases));
+}
+
+template <impl Impl, class T>
+void bm_gather(benchmark::State &state)
+{
+    auto &c = gather_cases[state.range(0)];
+    runtime_shape_t out_shape(c.in_shape.begin(), c.in_shape.begin() + c.axis);
+    out_shape.insert(out_shape.end(), c.indices_shape.begin(), c.indices_shape.end());
+    out_shape.insert(out_shape.end(), c.in_shape.begin() + c.axis + 1, c.in_shape.end());
+    auto in_strides = get_default_strides(c.in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(c.in_shape));
+    auto indices = random_tensor<int32_t>(compute_size(c.indices_shape), 0, (double)c.in_shape[c.axis] - 1);
+    std::vector<T> output(compute_size(out_shape));
+    auto context = make_context(state.range(1));
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::gather(to_datatype<T>(), bytes(input), bytes(output), c.in_shape, out_shape, in_strides, out_strides, indices.data(), c.indices_shape, c.axis, context))
+    else
+        BENCH_RUN(state, kernels::gather(to_datatype<T>(), bytes(input), bytes(output), c.in_shape, out_shape, in_strides, out_strides, indices.data(), c.indices_shape, c.axis, context))
+    state.SetLabel(shape_label(c.in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, 2.0 * output.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_gather, float);
+
+void bm_gather_nd_args(benchmark::internal::Benchmark *b)
+{
+    case_thread_args(b, 1);
+}
+
+template <impl Impl, class T>
+void bm_gather_nd(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 64, 56, 56 }, indices_shape { 1024, 2 }, out_shape { 1024, 56 };
+    auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(in_shape));
+    auto indices = random_tensor<int32_t>(compute_size(indices_shape), 0, 55);
+    std::vector<T> output(compute_size(out_shape));
+    auto context = make_context(state.range(1));
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::gather_nd(to_datatype<T>(), bytes(input), bytes(output), in_shape, out_shape, in_strides, out_strides, indices.data(), indices_shape, 0, context))
+    else
+        BENCH_RUN(state, kernels::gather_nd(to_datatype<T>(), bytes(input), bytes(output), in_shape, out_shape, in_strides, out_strides, indices.data(), indices_shape, 0, context))
+    state.SetLabel(shape_label(in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, 2.0 * output.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_gather_nd, float);
+
+void bm_gather_elements(benchmark::State &state)
+{
+    const runtime_shape_t shape { 64, 1024 };
+    auto input = random_tensor<float>(compute_size(shape));
+    auto indices = random_tensor<int64_t>(compute_size(shape), 0, 1023);
+    std::vector<float> output(input.size());
+
+    BENCH_RUN(state, kernels::gather_elements(input.data(), indices.data(), output.data(), shape, shape, 1))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, (double)output.size() * (2 * sizeof(float) + sizeof(int64_t)));
+}
+
+BENCHMARK(bm_gather_elements);
+
+void bm_onehot_args(benchmark::internal::Benchmark *b)
+{
+    case_args(b, 1);
+}
+
+template <impl Impl, class T>
+void bm_onehot(benchmark::State &state)
+{
+    const runtime_shape_t indices_shape { 1024 }, out_shape { 1024, 1000 };
+    auto out_strides = get_default_strides(out_shape);
+    auto indices = random_tensor<int32_t>(compute_size(indices_shape), 0, 999);
+    std::vector<T> output(compute_size(out_shape));
+    T off_value = 0, on_value = 1;
+    // the reference kernel reads depth as T, the dispatched one as size_t
+    T ref_depth = 1000;
+    size_t depth = 1000;
+    auto context = make_context(1);
+    auto depth_p = Impl == impl::ref ? reinterpret_cast<gsl::byte *>(&ref_depth) : reinterpret_cast<gsl::byte *>(&depth);
+    auto off_p = reinterpret_cast<gsl::byte *>(&off_value), on_p = reinterpret_cast<gsl::byte *>(&on_value);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::onehot(to_datatype<T>(), indices.data(), bytes(output), indices_shape, out_shape, out_strides, depth_p, off_p, on_p, 1, onehot_normal, context))
+    else
+        BENCH_RUN(state, kernels::onehot(to_datatype<T>(), indices.data(), bytes(output), indices_shape, out_shape, out_strides, depth_p, off_p, on_p, 1, onehot_normal, context))
+    state.SetLabel(shape_label(indices_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 0, (double)output.size() * sizeof(T));
+}
+
+BENCH_IMPLS(bm_onehot, float);
+
+// ---------------------------------------------------------------------------
+// Image
+// ---------------------------------------------------------------------------
+
+struct resize_case
+{
+    runtime_shape_t in_shape;
+    int32_t out_h;
+    int32_t out_w;
+};
+
+const resize_case resize_cases[] = {
+    { { 1, 64, 56, 56 }, 112, 112 },
+    { { 1, 3, 480, 640 }, 224, 224 },
+};
+
+void bm_resize_args(benchmark::internal::Benchmark *b)
+{
+    case_thread_args(b, std::size(resize_cases));
+}
+
+template <impl Impl, class T, bool Bilinear>
+void bm_resize(benchmark::State &state)
+{
+    auto &c = resize_cases[state.range(0)];
+    const runtime_shape_t out_shape { c.in_shape[0], c.in_shape[1], (size_t)c.out_h, (size_t)c.out_w };
+    auto in_strides = get_default_strides(c.in_shape), out_strides = get_default_strides(out_shape);
+    auto input = random_tensor<T>(compute_size(c.in_shape), 0, 100);
+    std::vector<T> output(compute_size(out_shape));
+    auto context = make_context(state.range(1));
+
+    if constexpr (Impl == impl::ref && Bilinear)
+        BENCH_RUN(state, reference::resize_bilinear(to_datatype<T>(), bytes(input), bytes(output), c.in_shape, in_strides, out_strides, c.out_h, c.out_w, false, true, context))
+    else if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::resize_nearest_neighbor(to_datatype<T>(), bytes(input), bytes(output), c.in_shape, in_strides, out_strides, c.out_h, c.out_w, false, true, context))
+    else if constexpr (Bilinear)
+        BENCH_RUN(state, kernels::resize_bilinear(to_datatype<T>(), bytes(input), bytes(output), c.in_shape, in_strides, out_strides, c.out_h, c.out_w, false, true, context))
+    else
+        BENCH_RUN(state, kernels::resize_nearest_neighbor(to_datatype<T>(), bytes(input), bytes(output), c.in_shape, in_strides, out_strides, c.out_h, c.out_w, false, true, context))
+    state.SetLabel(std::string(Bilinear ? "bilinear " : "nearest ") + shape_label(c.in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, Bilinear ? 8.0 * output.size() : 0, (double)(input.size() + output.size()) * sizeof(T));
+}
+
+BENCH_IMPLS(bm_resize, float, true);
+BENCH_IMPLS(bm_resize, float, false);
+BENCH_IMPLS(bm_resize, uint8_t, true);
+BENCH_IMPLS(bm_resize, uint8_t, false);
+
+void bm_roi_align(benchmark::State &state)
+{
+    const runtime_shape_t in_shape { 1, 256, 56, 56 }, out_shape { 128, 256, 7, 7 };
+    auto input = random_tensor<float>(compute_size(in_shape));
+    auto rois = random_tensor<float>(128 * 4, 0, 800);
+    for (size_t i = 0; i < 128; i++)
+    {
+        auto roi = rois.data() + i * 4;
+        if (roi[0] > roi[2])
+            std::swap(roi[0], roi[2]);
+        if (roi[1] > roi[3])
+            std::swap(roi[1], roi[3]);
+    }
+    std::vector<int64_t> batch_indices(128, 0);
+    std::vector<float> output(compute_size(out_shape));
+
+    BENCH_RUN(state, kernels::roi_align(input.data(), rois.data(), batch_indices.data(), output.data(), in_shape, out_shape, roi_align_avg, 1.f / 16, 2))
+    state.SetLabel(shape_label(in_shape) + " -> " + shape_label(out_shape));
+    set_counters(state, 4.0 * 4 * output.size(), (double)output.size() * sizeof(float));
+}
+
+BENCHMARK(bm_roi_align);
+
+// SSD MobileNet anchors and a 10k+ anchor head, state.range(1) selects regular NMS
+void bm_tflite_detection_postprocess_args(benchmark::internal::Benchmark *b)
+{
+    b->ArgsProduct({ { 1917, 12276 }, { 0, 1 } })->ArgNames({ "anchors", "regular_nms" });
+}
+
+template <impl Impl>
+void bm_tflite_detection_postprocess(benchmark::State &state)
+{
+    const size_t num_boxes = (size_t)state.range(0), num_classes = 90;
+    const runtime_shape_t boxes_shape { 1, num_boxes, 4 }, scores_shape { 1, num_boxes, num_classes + 1 }, anchors_shape { num_boxes, 4 };
+    const int32_t max_detections = 10;
+    const bool regular_nms = state.range(1) != 0;
+    auto boxes = random_tensor<float>(compute_size(boxes_shape));
+    auto scores = random_tensor<float>(compute_size(scores_shape), 0, 1);
+    auto anchors = random_tensor<float>(compute_size(anchors_shape), 0.1, 0.9);
+    std::vector<float> locations(max_detections * 4), classes(max_detections), out_scores(max_detections), num_detections(1);
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::tflite_detection_postprocess(boxes.data(), scores.data(), anchors.data(), locations.data(), classes.data(), out_scores.data(), num_detections.data(),
+                             boxes_shape, scores_shape, anchors_shape, max_detections, 1, 100, regular_nms, 0.3f, 0.6f, (int32_t)num_classes, 10.f, 10.f, 5.f, 5.f))
+    else
+        BENCH_RUN(state, kernels::tflite_detection_postprocess(boxes.data(), scores.data(), anchors.data(), locations.data(), classes.data(), out_scores.data(), num_detections.data(),
+                             boxes_shape, scores_shape, anchors_shape, max_detections, 1, 100, regular_nms, 0.3f, 0.6f, (int32_t)num_classes, 10.f, 10.f, 5.f, 5.f))
+    state.SetLabel(std::string(regular_nms ? "regular nms " : "fast nms ") + shape_label(scores_shape));
+    set_counters(state, 0, (double)(boxes.size() + scores.size() + anchors.size()) * sizeof(float));
+}
+
+BENCHMARK_TEMPLATE(bm_tflite_detection_postprocess, impl::dispatch)->Apply(bm_tflite_detection_postprocess_args);
+BENCHMARK_TEMPLATE(bm_tflite_detection_postprocess, impl::ref)->Apply(bm_tflite_detection_postprocess_args);
+
+// ---------------------------------------------------------------------------
+// Recurrent
+// ---------------------------------------------------------------------------
+
+// seq_length, batch_size, input_size, hidden_size
+const size_t rnn_cases[][4] = {
+    { 16, 1, 256, 256 },
+    { 64, 4, 128, 512 },
+};
+
+void bm_gru_args(benchmark::internal::Benchmark *b)
+{
+    case_thread_args(b, std::size(rnn_cases));
+}
+
+template <impl Impl, class T>
+void bm_gru(benchmark::State &state)
+{
+    auto &c = rnn_cases[state.range(0)];
+    const size_t seq = c[0], batch = c[1], input_size = c[2], hidden = c[3];
+    const runtime_shape_t input_shape { seq, batch, input_size }, w_shape { 1, 3 * hidden, input_size };
+    auto input = random_tensor<T>(seq * batch * input_size);
+    auto w = random_tensor<T>(3 * hidden * input_size, -0.1, 0.1), r = random_tensor<T>(3 * hidden * hidden, -0.1, 0.1);
+    auto b = random_tensor<T>(6 * hidden, -0.1, 0.1);
+    std::vector<T> initial_h(batch * hidden), output(seq * batch * hidden), output_h(batch * hidden);
+    auto context = make_context(state.range(1));
+
+    if constexpr (Impl == impl::ref)
+        BENCH_RUN(state, reference::gru(input.data(), w.data(), r.data(), b.data(), initial_h.data(), output.data(), output_h.data(), input_shape, w_shape, (int)kForward, false))
+    else
+        BENCH_RUN(state, kernels::gru(input.data(), w.data(), r.data(), b.data(), initial_h.data(), output.data(), output_h.data(), input_shape, w_shape, (int)kForward, false, context))
+    state.SetLabel("seq " + std::to_string(seq) + " batch " + std::to_string(batch) + " input " + std::to_string(input_size) + " hidden " + std::to_string(hidden));
+    set_counters(state, 2.0 * seq * batch * 3 * hidden * (input_size + hidden), (double)(w.size() + r.size()) * sizeof(T));
+}
+
+BENCH_IMPLS(bm_gru, float);
+
+void bm_lstm(benchmark::State &state)
+{
+    auto &c = rnn_cases[state.range(0)];
+    const size_t seq = c[0], batch = c[1], input_size = c[2], hidden = c[3];
+    const runtime_shape_t input_shape { seq, batch, input_size }, initial_shape { 1, batch, hidden };
+    const runtime_shape_t w_shape { 1, 4 * hidden, input_size }, b_shape { 1, 8 * hidden };
+    auto input = random_tensor<float>(seq * batch * input_size);
+    auto w = random_tensor<float>(4 * hidden * input_size, -0.1, 0.1), r = random_tensor<float>(4 * hidden * hidden, -0.1, 0.1);
+    auto b = random_tensor<float>(8 * hidden, -0.1, 0.1);
+    std::vector<float> initial_h(batch * hidden), initial_c(batch * hidden), output(seq * batch * hidden), output_h(batch * hidden), output_c(batch * hidden);
+
+    BENCH_RUN(state, kernels::lstm(input.data(), w.data(), r.data(), b.data(), initial_h.data(), initial_c.data(), output.data(), output_h.data(), output_c.data(),
+                         input_shape, initial_shape, w_shape, b_shape, {}, kForward, kOnnx))
+    state.SetLabel("seq " + std::to_string(seq) + " batch " + std::to_string(batch) + " input " + std::to_string(input_size) + " hidden " + std::to_string(hidden));
+    set_counters(state, 2.0 * seq * batch * 4 * hidden * (input_size + hidden), (double)(w.size() + r.size()) * sizeof(float));
+}
+
+BENCHMARK(bm_lstm)->DenseRange(0, std::size(rnn_cases) - 1)->ArgName("case");
+
+// ---------------------------------------------------------------------------
+// Random
+// ---------------------------------------------------------------------------
+
+void bm_random_normal(benchmark::State &state)
+{
+    const runtime_shape_t shape { 1, 64, 112, 112 };
+    std::vector<float> output(compute_size(shape));
+
+    BENCH_RUN(state, kernels::random_normal(output.data(), shape, 0.f, 1.f, 42.f))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, (double)output.size() * sizeof(float));
+}
+
+BENCHMARK(bm_random_normal);
+
+void bm_random_uniform(benchmark::State &state)
+{
+    const runtime_shape_t shape { 1, 64, 112, 112 };
+    std::vector<float> output(compute_size(shape));
+
+    BENCH_RUN(state, kernels::random_uniform(output.data(), shape, 0.f, 1.f, 42.f))
+    state.SetLabel(shape_label(shape));
+    set_counters(state, 0, (double)output.size() * sizeof(float));
+}
+
+BENCHMARK(bm_random_uniform);
+}
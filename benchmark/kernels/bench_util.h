@@ -0,0 +1,131 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <benchmark/benchmark.h>
+#include <nncase/kernels/kernel_context.h>
+#include <nncase/runtime/datatypes.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+
+// dispatch: the public kernels:: entry point, ref: cpu::reference
+enum class impl
+{
+    dispatch,
+    ref
+};
+
+template <class T>
+std::vector<T> random_tensor(size_t size, double low = -1, double high = 1)
+{
+    std::mt19937 gen(size);
+    std::vector<T> data(size);
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        std::uniform_real_distribution<T> dis((T)low, (T)high);
+        for (auto &v : data)
+            v = dis(gen);
+    }
+    else
+    {
+        std::uniform_int_distribution<int64_t> dis((int64_t)low, (int64_t)high);
+        for (auto &v : data)
+            v = (T)dis(gen);
+    }
+
+    return data;
+}
+
+template <class T>
+gsl::byte *bytes(std::vector<T> &data) noexcept
+{
+    return reinterpret_cast<gsl::byte *>(data.data());
+}
+
+template <class T>
+const gsl::byte *bytes(const std::vector<T> &data) noexcept
+{
+    return reinterpret_cast<const gsl::byte *>(data.data());
+}
+
+inline kernel_context make_context(int64_t threads) noexcept
+{
+    kernel_context context;
+    context.num_threads = (uint32_t)threads;
+    return context;
+}
+
+inline std::string shape_label(const runtime_shape_t &shape)
+{
+    std::string label;
+    for (size_t i = 0; i < shape.size(); i++)
+        label += (i ? "x" : "") + std::to_string(shape[i]);
+    return label;
+}
+
+// flops and bytes are per kernel call, reported as FLOP/s and bytes_per_second
+inline void set_counters(benchmark::State &state, double flops, double bytes)
+{
+    state.SetBytesProcessed((int64_t)(state.iterations() * bytes));
+    if (flops > 0)
+        state.counters["FLOP/s"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+}
+
+// Runs every case of a benchmark, state.range(0) is the case index
+inline void case_args(benchmark::internal::Benchmark *b, size_t cases)
+{
+    b->DenseRange(0, (int64_t)cases - 1)->ArgName("case");
+}
+
+// Runs every case for each thread count, state.range(1) is kernel_context::num_threads
+inline void case_thread_args(benchmark::internal::Benchmark *b, size_t cases)
+{
+    std::vector<int64_t> case_ids;
+    for (size_t i = 0; i < cases; i++)
+        case_ids.push_back((int64_t)i);
+
+    auto max_threads = (int64_t)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int64_t> threads { 1 };
+    for (int64_t t = 2; t < max_threads; t *= 2)
+        threads.push_back(t);
+    if (max_threads > 1)
+        threads.push_back(max_threads);
+    b->ArgsProduct({ case_ids, threads })->ArgNames({ "case", "threads" });
+}
+
+#define BENCH_RUN(state, expr)                                   \
+    for (auto _ : state)                                         \
+    {                                                            \
+        if (!(expr).is_ok())                                     \
+        {                                                        \
+            state.SkipWithError(#expr " failed");                \
+            break;                                               \
+        }                                                        \
+        benchmark::ClobberMemory();                              \
+    }
+
+// Registers the dispatched and the reference implementation of a kernel
+#define BENCH_IMPLS(func, ...)                              \
+    BENCHMARK_TEMPLATE(func, impl::dispatch, __VA_ARGS__)   \
+        ->Apply(func##_args);                               \
+    BENCHMARK_TEMPLATE(func, impl::ref, __VA_ARGS__)        \
+        ->Apply(func##_args)
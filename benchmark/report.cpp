@@ -0,0 +1,164 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "bench.h"
+#include <cstdio>
+#include <nncase/version.h>
+
+using namespace nncase;
+using namespace nncase::bench;
+
+namespace
+{
+std::string format(const char *fmt, double value)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), fmt, value);
+    return buffer;
+}
+
+std::string json_string(const std::string &value)
+{
+    std::string str = "\"";
+    for (auto c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            str += "\\\"";
+            break;
+        case '\\':
+            str += "\\\\";
+            break;
+        case '\n':
+            str += "\\n";
+            break;
+        case '\t':
+            str += "\\t";
+            break;
+        default:
+            if ((unsigned char)c < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)c);
+                str += escaped;
+            }
+            else
+                str += c;
+            break;
+        }
+    }
+
+    return str + "\"";
+}
+
+std::string csv_string(const std::string &value)
+{
+    if (value.find_first_of(",\"\n") == std::string::npos)
+        return value;
+
+    std::string str = "\"";
+    for (auto c : value)
+    {
+        if (c == '"')
+            str += '"';
+        str += c;
+    }
+
+    return str + "\"";
+}
+
+void write_text(std::ostream &os, const std::vector<bench_result> &results)
+{
+    char line[256];
+    for (auto &r : results)
+    {
+        snprintf(line, sizeof(line), "%20s  threads = %2u  min = %7.2f  max = %7.2f  avg = %7.2f  p50 = %7.2f  p90 = %7.2f  p99 = %7.2f  fps = %8.2f  rss = %zu KiB\n",
+            r.model.c_str(), r.threads, r.min_ms, r.max_ms, r.avg_ms, r.p50_ms, r.p90_ms, r.p99_ms, r.throughput, r.peak_rss_kb);
+        os << line;
+    }
+}
+
+void write_json(std::ostream &os, const std::vector<bench_result> &results, const bench_options &options)
+{
+    os << "{\n"
+       << "  \"version\": " << json_string(NNCASE_VERSION NNCASE_VERSION_SUFFIX) << ",\n"
+       << "  \"tag\": " << json_string(options.tag) << ",\n"
+       << "  \"warm_up\": " << options.warm_up_count << ",\n"
+       << "  \"time_budget\": " << format("%g", options.time_budget) << ",\n"
+       << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto &r = results[i];
+        os << (i ? ",\n" : "\n")
+           << "    {\n"
+           << "      \"model\": " << json_string(r.model) << ",\n"
+           << "      \"threads\": " << r.threads << ",\n"
+           << "      \"model_size\": " << r.model_size << ",\n"
+           << "      \"iterations\": " << r.iterations << ",\n"
+           << "      \"load_ms\": " << format("%.4f", r.load_ms) << ",\n"
+           << "      \"min_ms\": " << format("%.4f", r.min_ms) << ",\n"
+           << "      \"max_ms\": " << format("%.4f", r.max_ms) << ",\n"
+           << "      \"avg_ms\": " << format("%.4f", r.avg_ms) << ",\n"
+           << "      \"p50_ms\": " << format("%.4f", r.p50_ms) << ",\n"
+           << "      \"p90_ms\": " << format("%.4f", r.p90_ms) << ",\n"
+           << "      \"p99_ms\": " << format("%.4f", r.p99_ms) << ",\n"
+           << "      \"stddev_ms\": " << format("%.4f", r.stddev_ms) << ",\n"
+           << "      \"throughput\": " << format("%.4f", r.throughput) << ",\n"
+           << "      \"peak_rss_kb\": " << r.peak_rss_kb << ",\n"
+           << "      \"arenas\": { "
+           << "\"input\": " << r.arenas.input << ", "
+           << "\"output\": " << r.arenas.output << ", "
+           << "\"rdata\": " << r.arenas.rdata << ", "
+           << "\"data\": " << r.arenas.data << ", "
+           << "\"shared_data\": " << r.arenas.shared_data << ", "
+           << "\"private\": " << r.arenas.private_data << " }\n"
+           << "    }";
+    }
+
+    os << (results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+}
+
+void write_csv(std::ostream &os, const std::vector<bench_result> &results, const bench_options &options)
+{
+    os << "tag,model,threads,model_size,iterations,load_ms,min_ms,max_ms,avg_ms,p50_ms,p90_ms,p99_ms,stddev_ms,throughput,peak_rss_kb,"
+          "arena_input,arena_output,arena_rdata,arena_data,arena_shared_data,arena_private\n";
+    for (auto &r : results)
+    {
+        os << csv_string(options.tag) << ',' << csv_string(r.model) << ',' << r.threads << ',' << r.model_size << ',' << r.iterations << ','
+           << format("%.4f", r.load_ms) << ',' << format("%.4f", r.min_ms) << ',' << format("%.4f", r.max_ms) << ','
+           << format("%.4f", r.avg_ms) << ',' << format("%.4f", r.p50_ms) << ',' << format("%.4f", r.p90_ms) << ','
+           << format("%.4f", r.p99_ms) << ',' << format("%.4f", r.stddev_ms) << ',' << format("%.4f", r.throughput) << ','
+           << r.peak_rss_kb << ',' << r.arenas.input << ',' << r.arenas.output << ',' << r.arenas.rdata << ','
+           << r.arenas.data << ',' << r.arenas.shared_data << ',' << r.arenas.private_data << '\n';
+    }
+}
+}
+
+void bench::write_report(std::ostream &os, const std::vector<bench_result> &results, const bench_options &options)
+{
+    switch (options.format)
+    {
+    case report_format::json:
+        write_json(os, results, options);
+        break;
+    case report_format::csv:
+        write_csv(os, results, options);
+        break;
+    default:
+        write_text(os, results);
+        break;
+    }
+}
@@ -17,6 +17,8 @@ _SET_CONANOPT(CONAN_OPTS "python" BUILD_PYTHON_BINDING)
 _SET_CONANOPT(CONAN_OPTS "openmp" ENABLE_OPENMP)
 _SET_CONANOPT(CONAN_OPTS "vulkan_runtime" ENABLE_VULKAN_RUNTIME)
 _SET_CONANOPT(CONAN_OPTS "halide" ENABLE_HALIDE)
+_SET_CONANOPT(CONAN_OPTS "kernel_benchmark" BUILD_KERNEL_BENCHMARK)
+_SET_CONANOPT(CONAN_OPTS "kmodel_compression" ENABLE_KMODEL_COMPRESSION)
 
 if (NOT DEFINED CMAKE_CXX_STANDARD)
     if (BUILDING_RUNTIME)
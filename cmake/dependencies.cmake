@@ -8,6 +8,11 @@ if ((NOT BUILDING_RUNTIME) OR ENABLE_VULKAN_RUNTIME)
     find_package(Vulkan REQUIRED)
 endif ()
 
+if ((NOT BUILDING_RUNTIME) OR ENABLE_KMODEL_COMPRESSION)
+    find_package(lz4 REQUIRED)
+    find_package(zstd REQUIRED)
+endif ()
+
 if (NOT BUILDING_RUNTIME)
     find_package(flatbuffers REQUIRED)
     find_package(libzip REQUIRED)
@@ -32,6 +37,10 @@ if (BUILD_TESTING)
     find_package(GTest REQUIRED)
 endif ()
 
+if (BUILD_KERNEL_BENCHMARK)
+    find_package(benchmark REQUIRED)
+endif ()
+
 if (ENABLE_HALIDE)
     find_package(hkg REQUIRED)
 endif ()
\ No newline at end of file
@@ -27,7 +27,9 @@ class nncaseConan(ConanFile):
         "halide": [True, False],
         "python": [True, False],
         "vulkan_runtime": [True, False],
-        "openmp": [True, False]
+        "openmp": [True, False],
+        "kernel_benchmark": [True, False],
+        "kmodel_compression": [True, False]
     }
     default_options = {
         "shared": False,
@@ -37,7 +39,9 @@ class nncaseConan(ConanFile):
         "halide": True,
         "python": True,
         "vulkan_runtime": True,
-        "openmp": True
+        "openmp": True,
+        "kernel_benchmark": False,
+        "kmodel_compression": True
     }
 
     def requirements(self):
@@ -46,6 +50,12 @@ class nncaseConan(ConanFile):
         self.requires('hkg/0.0.1')
         if self.options.tests:
             self.requires('gtest/1.10.0')
+        if self.options.kernel_benchmark:
+            self.requires('benchmark/1.6.1')
+
+        if (not self.options.runtime) or self.options.kmodel_compression:
+            self.requires('lz4/1.9.3')
+            self.requires('zstd/1.5.2')
 
         if self.options.python:
             self.requires('pybind11/2.6.1')
@@ -30,14 +30,18 @@ public:
     model_builder(model_builder &&) = delete;
 
     void config_dump(const std::filesystem::path &dump_dir, bool dump_asm);
+    void config_compression(uint32_t compression);
     build_model_result build(std::ostream &output);
 
     size_t max_usage(memory_location_t location) const;
+    // Bytes saved by placing identical buffers once
+    size_t deduplicated_bytes(memory_location_t location) const;
 
 private:
     target &target_;
     const schedule::model_schedule_result &sched_;
     std::filesystem::path dump_dir_;
     bool dump_asm_;
+    uint32_t compression_;
 };
 }
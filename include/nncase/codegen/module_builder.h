@@ -78,7 +78,10 @@ public:
 
     uint32_t alignment() const noexcept { return alignment_; }
     void config_dump(const std::filesystem::path &dump_dir, bool dump_asm);
+    // compression is 0, SECTION_COMPRESSED_LZ4 or SECTION_COMPRESSED_ZSTD
+    void config_compression(uint32_t compression);
     void build(binary_writer &writer);
+    bool has_compressed_sections() const noexcept { return has_compressed_sections_; }
 
     const schedule::buffer_allocation &allocation(ir::output_connector &conn) const;
     const schedule::buffer_allocation &allocation(ir::input_connector &conn) const { return allocation(*conn.connection()); }
@@ -122,6 +125,8 @@ private:
 
 private:
     uint32_t alignment_;
+    uint32_t compression_;
+    bool has_compressed_sections_;
     std::string module_name_;
     const module_builder_params &params_;
     std::map<std::string, section, std::less<>> section_writer_;
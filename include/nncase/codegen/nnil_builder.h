@@ -32,6 +32,12 @@ public:
     void emit_ldc_r4_0() { emit_opcode(runtime::nnil_ldc_r4_0); }
     void emit_ldc_r4_1() { emit_opcode(runtime::nnil_ldc_r4_1); }
 
+    void emit_lda(uint8_t index)
+    {
+        emit_opcode(runtime::nnil_lda);
+        writer_.write(runtime::nnil_lda_t { index });
+    }
+
     void emit_ldc_r4(float value)
     {
         emit_opcode(runtime::nnil_ldc_r4);
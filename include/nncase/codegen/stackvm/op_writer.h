@@ -110,6 +110,17 @@ struct op_writer<nncase::runtime::stackvm::break_op_t>
     }
 };
 
+template <>
+struct op_writer<nncase::runtime::stackvm::br_unused_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::br_unused_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(op.masks);
+        writer.write(op.target);
+    }
+};
+
 template <>
 struct op_writer<nncase::runtime::stackvm::ldc_i4_op_t>
 {
@@ -978,6 +989,7 @@ struct op_writer<nncase::runtime::stackvm::tensor_conv2d_op_t>
         writer.write(static_cast<uint8_t>(op.opcode));
         writer.write(static_cast<uint16_t>(op.funct));
         writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(static_cast<uint8_t>(op.w_datatype));
         writer.write(op.rshape_src);
         writer.write(op.rstride_src);
         writer.write(op.rshape_kernel);
@@ -994,6 +1006,31 @@ struct op_writer<nncase::runtime::stackvm::tensor_conv2d_op_t>
     }
 };
 
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_conv2d_transpose_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_conv2d_transpose_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src);
+        writer.write(op.rstride_src);
+        writer.write(op.rshape_kernel);
+        writer.write(op.rstride_kernel);
+        writer.write(op.rstride_bias);
+        writer.write(op.rshape_dest);
+        writer.write(op.rstride_dest);
+        writer.write(op.groups);
+        writer.write(op.stride_h);
+        writer.write(op.stride_w);
+        writer.write(op.dilation_h);
+        writer.write(op.dilation_w);
+        writer.write(op.fused_clamp_low);
+        writer.write(op.fused_clamp_high);
+    }
+};
+
 template <>
 struct op_writer<nncase::runtime::stackvm::tensor_copy_op_t>
 {
@@ -1123,6 +1160,7 @@ struct op_writer<nncase::runtime::stackvm::tensor_matmul_op_t>
     {
         writer.write(static_cast<uint8_t>(op.opcode));
         writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.w_datatype));
         writer.write(op.rshape_src1);
         writer.write(op.rstride_src1);
         writer.write(op.rshape_src2);
@@ -1543,6 +1581,58 @@ struct op_writer<nncase::runtime::stackvm::tensor_gather_elements_op_t>
     }
 };
 
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_lstm_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_lstm_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(op.input_shape_src);
+        writer.write(op.initial_h_shape_src);
+        writer.write(op.w_shape_src);
+        writer.write(op.b_shape_src);
+        writer.write(op.sequence_lens_src);
+        writer.write(op.direction);
+        writer.write(op.framework);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_conv2d_chain_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_conv2d_chain_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src);
+        writer.write(op.rstride_src);
+        writer.write(op.rstride_dest);
+        writer.write(op.rstage_src);
+        writer.write(op.rpad_src);
+        writer.write(op.stages);
+        writer.write(op.tile_h);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_fused_elementwise_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_fused_elementwise_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_dest);
+        writer.write(op.rstride_dest);
+        writer.write(op.rshape_src);
+        writer.write(op.inputs);
+        writer.write(op.body_size);
+        writer.write_array(std::span<const gsl::byte>(op.body.data(), op.body.size()));
+    }
+};
+
 class NNCASE_API op_builder
 {
 public:
@@ -1559,6 +1649,7 @@ public:
     void ecall_(uint8_t args);
     void throw_();
     void break_();
+    void br_unused_(uint8_t masks, int32_t target);
     void ldc_i4_(int32_t imm);
     void ldnull_();
     void ldc_i4_0_();
@@ -1647,9 +1738,10 @@ public:
     void tensor_batch_to_space_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rshape_block, uint8_t rpad_crops);
     void tensor_broadcast_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_dest, uint8_t rstride_dest);
     void tensor_binary_(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, binary_op_t binary_op, float fused_clamp_low, float fused_clamp_high);
+    void tensor_conv2d_transpose_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rshape_dest, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high);
     void tensor_call_(uint32_t function_id, uint16_t module_id, uint8_t num_src, uint8_t num_dst);
     void tensor_compare_(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, compare_op_t compare_op);
-    void tensor_conv2d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high);
+    void tensor_conv2d_(datatype_t datatype, datatype_t w_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high);
     void tensor_copy_(datatype_t datatype, uint8_t rshape, uint8_t rstride_src, uint8_t rstride_dest);
     void tensor_convert_(datatype_t in_datatype, datatype_t dst_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest);
     void tensor_cumsum_(datatype_t datatype, uint8_t rshape_src, int32_t axis, bool exclusive, bool reverse);
@@ -1658,7 +1750,7 @@ public:
     void tensor_gather_nd_(datatype_t datatype, uint8_t rshape_src, uint8_t rshape_dest, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rshape_indices, uint8_t batch_dims);
     void tensor_hardmax_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, int32_t axis);
     void tensor_lut1d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint16_t table_len);
-    void tensor_matmul_(uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, float fused_clamp_low, float fused_clamp_high);
+    void tensor_matmul_(datatype_t w_datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, float fused_clamp_low, float fused_clamp_high);
     void tensor_onehot_(datatype_t datatype, uint8_t rshape_indices, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t axis, onehot_mode_t onehot_mode);
     void tensor_pad_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rpaddings, pad_mode_t pad_mode);
     void tensor_quantize_(datatype_t in_datatype, datatype_t dst_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest);
@@ -1684,6 +1776,9 @@ public:
     void tensor_layer_normalization_(datatype_t datatype, uint8_t input_shape, int32_t axis, float epsilon);
     void tensor_compress_(uint8_t input_shape_src, uint8_t condition_shape_src, float axis);
     void tensor_gather_elements_(uint8_t input_shape_src, uint8_t indices_shape_src, int32_t axis);
+    void tensor_lstm_(uint8_t input_shape_src, uint8_t initial_h_shape_src, uint8_t w_shape_src, uint8_t b_shape_src, uint8_t sequence_lens_src, uint8_t direction, uint8_t framework);
+    void tensor_conv2d_chain_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rstage_src, uint8_t rpad_src, uint8_t stages, uint16_t tile_h);
+    void tensor_fused_elementwise_(datatype_t datatype, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t rshape_src, uint8_t inputs, uint16_t body_size, gsl::span<const gsl::byte> body);
 
 private:
     section_writer &writer_;
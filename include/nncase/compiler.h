@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <span>
 #include <unordered_map>
@@ -54,9 +55,15 @@ struct compile_options
     std::vector<float> output_range;
     float letterbox_value = 0.f;
     std::vector<int32_t> input_shape {};
+    // Values of named symbolic input dimensions, the model is compiled once for each combination
+    std::map<std::string, std::vector<size_t>> dim_values;
     std::string w_quant_type = "uint8";
     bool use_mse_quant_w = false;
     bool split_w_to_act = false;
+    std::string w_storage_type = "float32";
+    std::string section_compression = "none";
+    // placement of lifetime planned pools such as the K210 KPU RAM, best or first_fit
+    std::string memory_placement = "best";
     std::string input_layout = "NCHW";
     std::string output_layout = "NCHW";
     std::string model_layout;
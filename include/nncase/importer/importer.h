@@ -24,6 +24,8 @@ namespace nncase::importer
 struct import_options
 {
     std::span<const std::string> output_arrays;
+    // Values of named symbolic dimensions, such as ONNX dim_param
+    std::unordered_map<std::string, size_t> dim_values;
 };
 
 void import_tflite(ir::graph &graph, std::span<const uint8_t> model, const import_options &options, std::string &real_inlayout, std::string &real_outlayout);
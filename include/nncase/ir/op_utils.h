@@ -27,6 +27,19 @@ inline shape_t get_transposed_shape(const shape_t &input_shape, const axis_t &pe
     return new_shape;
 }
 
+// Channel-last ops run on the NCHW kernels by viewing NHWC tensors and HWIO weights as NCHW/OIHW with permuted strides
+template <class TShape>
+TShape nhwc_as_nchw(const TShape &value)
+{
+    return { value[0], value[3], value[1], value[2] };
+}
+
+template <class TShape>
+TShape hwio_as_oihw(const TShape &value)
+{
+    return { value[3], value[2], value[0], value[1] };
+}
+
 inline size_t get_windowed_output_size(int32_t size, int32_t filter, int32_t stride, int32_t dilation, bool same, bool ceil_mode = false)
 {
     auto effective_filter_size = (filter - 1) * dilation + 1;
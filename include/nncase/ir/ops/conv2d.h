@@ -44,7 +44,7 @@ public:
     int32_t dilation_w() const noexcept { return dilation_w_; }
     value_range<float> fused_activation() const noexcept { return fused_activation_; }
 
-    conv2d(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation);
+    conv2d(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, datatype_t weights_type = dt_float32);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -0,0 +1,70 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../node.h"
+#include <nncase/runtime/datatypes.h>
+
+namespace nncase::ir
+{
+// A chain of conv2d/reduce_window2d nodes run band by band, see kernels::conv2d_chain
+class NNCASE_API conv2d_chain : public node
+{
+public:
+    struct stage
+    {
+        // false for reduce_window2d, which has no weights and bias inputs
+        bool is_conv2d;
+        // [out_channels, in_channels / groups, filter_h, filter_w], reduce_window2d uses [channels, 1, filter_h, filter_w]
+        shape_t weights_shape;
+        int32_t groups;
+        padding padding_h;
+        padding padding_w;
+        int32_t stride_h;
+        int32_t stride_w;
+        int32_t dilation_h;
+        int32_t dilation_w;
+        reduce_op_t reduce_op;
+        float init_value;
+        value_range<float> fused_activation;
+
+        bool operator==(const stage &other) const noexcept;
+    };
+
+    DEFINE_NODE_OPCODE(op_conv2d_chain);
+
+    input_connector &input() { return input_at(0); }
+    output_connector &output() { return output_at(0); }
+
+    // weights and bias inputs of a conv2d stage
+    input_connector &weights(size_t stage_id) { return input_at(weights_input_ids_.at(stage_id)); }
+    input_connector &bias(size_t stage_id) { return input_at(weights_input_ids_.at(stage_id) + 1); }
+
+    const std::vector<stage> &stages() const noexcept { return stages_; }
+    int32_t tile_h() const noexcept { return tile_h_; }
+
+    conv2d_chain(shape_t input_shape, std::vector<stage> stages, int32_t tile_h);
+
+    // Output shape of every stage
+    static std::vector<shape_t> stage_shapes(const shape_t &input_shape, const std::vector<stage> &stages);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    std::vector<stage> stages_;
+    std::vector<size_t> weights_input_ids_;
+    int32_t tile_h_;
+};
+}
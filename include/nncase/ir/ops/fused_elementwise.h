@@ -0,0 +1,43 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "fused_unary.h"
+
+namespace nncase::ir
+{
+// A tree of float elementwise ops over several broadcastable inputs, run as one nnil program per element,
+// see kernels::nnil_elementwise. ldx ops of the subgraph select the input by index.
+class NNCASE_API fused_elementwise : public node
+{
+public:
+    // A value used again right after it was pushed is dup'ed, other shared values are recomputed
+    static void compile_graph(const std::vector<fused_unary_op> &subgraph, codegen::nnil_builder &builder);
+    // Instructions compile_graph emits for the root, and the evaluation stack depth they need
+    static std::pair<size_t, size_t> program_size(const std::vector<fused_unary_op> &subgraph);
+
+    DEFINE_NODE_OPCODE(op_fused_elementwise);
+
+    output_connector &output() { return output_at(0); }
+    const std::vector<fused_unary_op> &subgraph() const noexcept { return subgraph_; }
+
+    fused_elementwise(std::vector<fused_unary_op> subgraph, const std::vector<shape_t> &input_shapes, shape_t output_shape);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    std::vector<fused_unary_op> subgraph_;
+};
+}
@@ -48,6 +48,8 @@ struct fused_unary_identity
 
 struct fused_unary_ldx
 {
+    // always 0 in fused_unary, the input index in fused_elementwise
+    size_t input;
 };
 
 struct fused_unary_unary
@@ -84,9 +86,10 @@ struct fused_unary_op
         fused_unary_clamp clamp;
     };
 
-    static fused_unary_op make_ldx() noexcept
+    static fused_unary_op make_ldx(size_t input = 0) noexcept
     {
         fused_unary_op op { fu_ldx, {} };
+        op.ldx = { input };
         return op;
     }
 
@@ -132,6 +135,8 @@ class NNCASE_API fused_unary : public node
 {
 public:
     static void compile_graph(const std::vector<fused_unary_op> &subgraph, codegen::nnil_builder &builder);
+    // Emits the nnil instruction of op, operands must already be on the stack
+    static void emit_op(const fused_unary_op &op, codegen::nnil_builder &builder);
 
     DEFINE_NODE_OPCODE(op_fused_unary);
 
@@ -37,9 +37,11 @@ public:
     bool has_static() const noexcept { return has_static_; }
     lstm_direction direction() const noexcept { return direction_; }
     std::string framework() const noexcept { return framework_; }
+    // one length per batch, empty when every batch spans the whole sequence
+    const shape_t &sequence_lens() const noexcept { return sequence_lens_; }
 
     lstm(shape_t input_shape, shape_t w_shape, shape_t r_shape, shape_t b_shape, shape_t output_shape,
-        shape_t output_h_shape, shape_t output_c_shape, bool has_static, lstm_direction direction, std::string framework);
+        shape_t initial_h_shape, shape_t initial_c_shape, bool has_static, lstm_direction direction, std::string framework, shape_t sequence_lens);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -48,5 +50,6 @@ private:
     bool has_static_;
     lstm_direction direction_;
     std::string framework_;
+    shape_t sequence_lens_;
 };
 }
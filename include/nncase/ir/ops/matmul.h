@@ -30,7 +30,7 @@ public:
 
     value_range<float> fused_activation() const noexcept { return fused_activation_; }
 
-    matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation);
+    matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation, datatype_t input_b_type = dt_float32);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -25,4 +25,46 @@ NNCASE_API result<void> conv2d(const float *input, const float *weights, const f
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
 
+// w_shape is [out_channels, in_channels / groups, filter_h, filter_w]; out_shape is needed as output_padding makes it ambiguous
+NNCASE_API result<void> conv2d_transpose(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
+// conv2d with weights stored as half or bfloat16, widened to float one L2 sized block of output channels at a time
+// in the context workspace, each block convolved by the float kernel before the next one is widened
+NNCASE_API result<void> conv2d(const float *input, const half *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
+NNCASE_API result<void> conv2d(const float *input, const bfloat16 *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
+// One stage of conv2d_chain: a conv2d, or a reduce_window2d when weights is nullptr.
+// w_shape is [out_channels, in_channels / groups, filter_h, filter_w], reduce_window2d stages use [channels, 1, filter_h, filter_w].
+struct conv2d_chain_stage
+{
+    const float *weights;
+    const float *bias;
+    runtime_shape_t w_shape;
+    padding padding_h;
+    padding padding_w;
+    int32_t groups;
+    int32_t stride_h;
+    int32_t stride_w;
+    int32_t dilation_h;
+    int32_t dilation_w;
+    reduce_op_t reduce_op;
+    float init_value;
+    value_range<float> fused_activation;
+};
+
+// Runs a chain of NCHW conv2d/reduce_window2d stages band by band: each band of tile_h output rows is computed
+// from the input rows it depends on, so the intermediates only live in per-thread scratch buffers.
+NNCASE_API result<void> conv2d_chain(const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, gsl::span<const conv2d_chain_stage> stages, int32_t tile_h, kernel_context &context = default_kernel_context()) noexcept;
+
 END_NS_NNCASE_KERNELS
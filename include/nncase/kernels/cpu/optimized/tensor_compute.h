@@ -18,6 +18,9 @@
 
 BEGIN_NS_NNCASE_KERNELS_CPU_OPT
 
+NNCASE_API result<void> broadcast(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+
 NNCASE_API result<void> concat(datatype_t type, gsl::span<const gsl::byte *const> inputs, gsl::byte *output, const runtime_shape_t &out_shape,
     gsl::span<const runtime_shape_t> in_strides, const runtime_shape_t &out_strides, size_t axis, const runtime_shape_t &concat_dims,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -30,6 +33,15 @@ NNCASE_API result<void> resize_nearest_neighbor(datatype_t type, const gsl::byte
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
     kernel_context &context = default_kernel_context()) noexcept;
 
+// Channel-last variants, see kernels::detail::is_channel_last
+NNCASE_API result<void> resize_bilinear_nhwc(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
+    kernel_context &context = default_kernel_context()) noexcept;
+
+NNCASE_API result<void> resize_nearest_neighbor_nhwc(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
+    kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> copy(datatype_t type, const gsl::byte *src, gsl::byte *dest,
     const runtime_shape_t &shape, const runtime_shape_t &src_strides, const runtime_shape_t &dest_strides,
     int dims_offset, copy_impl_select impl_select, kernel_context &context) noexcept;
@@ -39,6 +51,27 @@ NNCASE_API result<void> conv2d(const float *input, const float *weights, const f
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
 
+// Weights are [out_channels, in_channels / groups, filter_h, filter_w] with dense out_channels, i.e. a strided HWIO tensor
+NNCASE_API result<void> conv2d_nhwc(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+// Input rows must be dense
+NNCASE_API result<void> conv2d_transpose(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+NNCASE_API result<void> reduce_window2d_nhwc(reduce_op_t op, const float *input, float init_value, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    kernel_context &context) noexcept;
+
+// float32 to and from float16/bfloat16, dense tensors only
+NNCASE_API result<void> convert(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept;
+
 NNCASE_API result<void> dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept;
@@ -58,6 +91,11 @@ NNCASE_API result<void> quantize(datatype_t in_type, datatype_t out_type, const
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept;
 
+// Fails with not_supported for interior padding
+NNCASE_API result<void> pad(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode,
+    const scalar &pad_value, kernel_context &context) noexcept;
+
 NNCASE_API result<void> slice(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_shape_t &begins, const runtime_axis_t &ends, const runtime_axis_t &strides,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -77,6 +115,33 @@ NNCASE_API result<void> matmul(const T *input_a, const T *input_b, const T *bias
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
     value_range<float> fused_activation) noexcept;
 
+NNCASE_API result<void> matmul(const float *input_a, const half *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
+NNCASE_API result<void> matmul(const float *input_a, const bfloat16 *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
+// Heap based for sorted outputs, rows run in parallel. Outputs are identical to reference::topk
+template <typename T>
+NNCASE_API result<void> topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &output_values_strides,
+    const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept;
+
+template <typename T>
+NNCASE_API result<void> tflite_detection_postprocess(const T *boxes, const T *scores, const T *anchors, T *output_locations, T *output_classes, T *output_scores, T *output_num_detections,
+    const runtime_shape_t &boxes_shape, const runtime_shape_t &scores_shape, const runtime_shape_t &anchors_shape,
+    const int32_t max_detections, const int32_t max_classes_per_detection, const int32_t detections_per_class,
+    const bool use_regular_non_max_suppression, const float nms_score_threshold, const float nms_iou_threshold,
+    const int32_t num_classes, const float y_scale, const float x_scale, const float h_scale, const float w_scale) noexcept;
+
+// Widens count half/bfloat16 values to float
+NNCASE_API void widen_to_float(const half *input, float *output, size_t count) noexcept;
+NNCASE_API void widen_to_float(const bfloat16 *input, float *output, size_t count) noexcept;
+
 template <typename T>
 NNCASE_API result<void> softmax(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     const runtime_shape_t &out_strides, int32_t axis, float beta) noexcept;
@@ -97,4 +162,13 @@ NNCASE_API result<void> ternary(const float *input_a, const T *input_b, const T
 template <typename T>
 result<void> reduce(reduce_op_t op, T init_value, const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &axis,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, bool keep_dims, kernel_context &context) noexcept;
+
+template <typename T>
+NNCASE_API result<void> gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h,
+    const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset, kernel_context &context) noexcept;
+
+template <typename T>
+NNCASE_API result<void> lstm(const T *input, const T *w, const T *r, const T *b, const T *initial_h, const T *initial_c, T *output, T *output_h, T *output_c,
+    const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape, const runtime_shape_t &w_shape, const runtime_shape_t &b_shape,
+    const runtime_shape_t &sequence_lens, lstm_direction direction, lstm_framework framework, kernel_context &context) noexcept;
 END_NS_NNCASE_KERNELS_CPU_OPT
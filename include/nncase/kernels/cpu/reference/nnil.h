@@ -20,4 +20,7 @@ BEGIN_NS_NNCASE_KERNELS_CPU_REF
 
 NNCASE_API result<void> nnil_unary_method(const float *input, float *output, size_t count, gsl::span<const gsl::byte> body, kernel_context &context) noexcept;
 
+NNCASE_API result<void> nnil_elementwise(gsl::span<const float *const> inputs, gsl::span<const runtime_shape_t> in_shapes, gsl::span<const runtime_shape_t> in_strides,
+    float *output, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, gsl::span<const gsl::byte> body, kernel_context &context) noexcept;
+
 END_NS_NNCASE_KERNELS_CPU_REF
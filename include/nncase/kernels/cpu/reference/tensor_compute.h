@@ -223,6 +223,12 @@ NNCASE_API result<void>
 gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h,
     const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset) noexcept;
 
+template <typename T>
+NNCASE_API result<void>
+lstm(const T *input, const T *w, const T *r, const T *b, const T *initial_h, const T *initial_c, T *output, T *output_h, T *output_c,
+    const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape, const runtime_shape_t &w_shape, const runtime_shape_t &b_shape,
+    const runtime_shape_t &sequence_lens, lstm_direction direction, lstm_framework framework) noexcept;
+
 template <typename T>
 NNCASE_API result<void>
 tflite_detection_postprocess(const T *boxes, const T *scores, const T *anchors, T *output_locations,
@@ -14,12 +14,60 @@
  */
 #pragma once
 #include <nncase/runtime/result.h>
+#include <vector>
 
 BEGIN_NS_NNCASE_KERNELS
 
+// Grow-only scratch memory, reused by every kernel running on the contexts that point to it
+class NNCASE_API kernel_workspace
+{
+public:
+    template <class T>
+    result<T *> get(size_t count) noexcept
+    {
+        auto bytes = count * sizeof(T);
+        if (buffer_.size() < bytes)
+        {
+            try
+            {
+                buffer_.resize(bytes);
+            }
+            catch (...)
+            {
+                return err(std::errc::not_enough_memory);
+            }
+        }
+
+        return ok(reinterpret_cast<T *>(buffer_.data()));
+    }
+
+    size_t size() const noexcept { return buffer_.size(); }
+    // Frees the memory, the next kernel that needs some allocates it again
+    void release() noexcept { std::vector<uint8_t>().swap(buffer_); }
+
+private:
+    std::vector<uint8_t> buffer_;
+};
+
+// One per thread, so it is never shared between threads
+NNCASE_API kernel_workspace &default_kernel_workspace() noexcept;
+
 struct NNCASE_API kernel_context
 {
     uint32_t num_threads;
+    // Owned by the caller, the calling thread's default_kernel_workspace() when null
+    kernel_workspace *memory = nullptr;
+
+    template <class T>
+    result<T *> workspace(size_t count) noexcept
+    {
+        return (memory ? *memory : default_kernel_workspace()).get<T>(count);
+    }
+
+    void release_workspace() noexcept
+    {
+        (memory ? *memory : default_kernel_workspace()).release();
+    }
 };
 
 NNCASE_API kernel_context &default_kernel_context();
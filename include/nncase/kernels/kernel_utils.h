@@ -19,6 +19,8 @@
 #include <cstddef>
 #include <nncase/runtime/datatypes.h>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 #ifdef __GNUC__
 #define CXX_RESTRICT __restrict__
@@ -88,6 +90,12 @@ inline size_t get_windowed_output_size(size_t size, int32_t filter, int32_t stri
     return (size_t)((int32_t)size + padding.before + padding.after - effective_filter_size + stride) / stride;
 }
 
+// NHWC tensors are passed to the NCHW kernels as NCHW shapes with permuted strides, so their channels are dense
+inline bool is_channel_last(const runtime_shape_t &shape, const runtime_shape_t &strides) noexcept
+{
+    return shape.size() == 4 && shape[1] > 1 && strides[1] == 1;
+}
+
 inline runtime_shape_t get_binary_output_shape(const runtime_shape_t &input_a_shape, const runtime_shape_t &input_b_shape)
 {
     runtime_shape_t out_shape;
@@ -289,5 +297,76 @@ inline size_t get_nearest_neighbor(T input_value, size_t shape_size, float scale
     return output_value;
 }
 
+// Partial quicksort of (value, index) pairs used by topk, k ends up at its sorted place
+template <typename T>
+int64_t quick_partition(std::vector<std::pair<T, size_t>> &nums, int64_t lo, int64_t hi, bool largest)
+{
+    int64_t i = lo;
+    int64_t j = hi + 1;
+    T pivot = nums[lo].first;
+
+    while (true)
+    {
+        if (largest)
+        {
+            while (++i < hi && nums[i].first > pivot)
+                ;
+            while (--j > lo && nums[j].first < pivot)
+                ;
+        }
+        else
+        {
+            while (++i < hi && nums[i].first < pivot)
+                ;
+            while (--j > lo && nums[j].first > pivot)
+                ;
+        }
+
+        if (i >= j)
+        {
+            break;
+        }
+
+        std::swap(nums[i].first, nums[j].first);
+        std::swap(nums[i].second, nums[j].second);
+    }
+
+    std::swap(nums[lo].first, nums[j].first);
+    std::swap(nums[lo].second, nums[j].second);
+
+    return j;
+}
+
+template <typename T>
+void quick_select(std::vector<std::pair<T, size_t>> &nums, int64_t lo, int64_t hi, int64_t k, bool largest)
+{
+    if (lo >= hi)
+    {
+        return;
+    }
+
+    int64_t idx = quick_partition(nums, lo, hi, largest);
+    if (idx == k)
+    {
+        return;
+    }
+
+    return idx > k ? quick_select(nums, lo, idx - 1, k, largest) : quick_select(nums, idx + 1, hi, k, largest);
+}
+
+// Per-batch sequence lengths of the recurrent ops, empty means every batch spans the whole sequence
+inline bool sequence_lens_valid(const runtime_shape_t &sequence_lens, size_t seq_length, size_t batch_size) noexcept
+{
+    if (sequence_lens.empty())
+        return true;
+    if (sequence_lens.size() != batch_size)
+        return false;
+    return std::all_of(sequence_lens.begin(), sequence_lens.end(), [=](size_t len) { return len >= 1 && len <= seq_length; });
+}
+
+inline bool in_sequence(const runtime_shape_t &sequence_lens, size_t batch, size_t step) noexcept
+{
+    return sequence_lens.empty() || step < sequence_lens[batch];
+}
 }
 END_NS_NNCASE_KERNELS
@@ -22,4 +22,8 @@ BEGIN_NS_NNCASE_KERNELS
 
 NNCASE_API result<void> nnil_unary_method(const float *input, float *output, size_t count, gsl::span<const gsl::byte> body, kernel_context &context = default_kernel_context()) noexcept;
 
+// Evaluates body for every element of output, argument i of body (lda i) is inputs[i] broadcast to out_shape
+NNCASE_API result<void> nnil_elementwise(gsl::span<const float *const> inputs, gsl::span<const runtime_shape_t> in_shapes, gsl::span<const runtime_shape_t> in_strides,
+    float *output, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, gsl::span<const gsl::byte> body, kernel_context &context = default_kernel_context()) noexcept;
+
 END_NS_NNCASE_KERNELS
@@ -64,6 +64,17 @@ NNCASE_API result<void> matmul(const T *input_a, const T *input_b, const T *bias
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
     value_range<float> fused_activation) noexcept;
 
+// matmul with input_b stored as half or bfloat16, widened to float one block of rows at a time
+NNCASE_API result<void> matmul(const float *input_a, const half *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
+NNCASE_API result<void> matmul(const float *input_a, const bfloat16 *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> onehot(datatype_t type, const int32_t *indices, gsl::byte *output, const runtime_shape_t &indices_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &out_strides, gsl::byte *depth, gsl::byte *off_value, gsl::byte *on_value, size_t axis, onehot_mode_t mode,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -153,7 +164,14 @@ template <typename T>
 NNCASE_API result<void> trilu(const T *input, T *output, const runtime_shape_t &in_shape, const bool upper, const int64_t k) noexcept;
 
 template <typename T>
-NNCASE_API result<void> gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset) noexcept;
+NNCASE_API result<void> gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset, kernel_context &context = default_kernel_context()) noexcept;
+
+// sequence_lens holds the length of every batch, or is empty when they all span input_shape[0] steps. A batch's states stop
+// updating after its last step and its outputs past that are zero, the reverse direction starts from its last step
+template <typename T>
+NNCASE_API result<void> lstm(const T *input, const T *w, const T *r, const T *b, const T *initial_h, const T *initial_c, T *output, T *output_h, T *output_c,
+    const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape, const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens,
+    lstm_direction direction, lstm_framework framework, kernel_context &context = default_kernel_context()) noexcept;
 
 template <typename T>
 NNCASE_API result<void> tflite_detection_postprocess(const T *boxes, const T *scores, const T *anchors, T *output_locations, T *output_classes, T *output_scores, T *output_num_detections,
@@ -13,22 +13,79 @@
  * limitations under the License.
  */
 #pragma once
-#include <memory>
+#include <atomic>
+#include <limits>
+#include <map>
 #include <nncase/runtime/compiler_defs.h>
+#include <vector>
 
 BEGIN_NS_NNCASE_RUNTIME
 
-class NNCASE_API allocation_state
+// Every buffer a host_allocator hands out starts on this boundary
+constexpr size_t host_buffer_alignment = 64;
+
+class NNCASE_API host_allocator
 {
 public:
-    virtual ~allocation_state();
+    virtual ~host_allocator();
+
+    // Returns nullptr when out of memory
+    virtual gsl::byte *allocate(size_t bytes) noexcept = 0;
+    // bytes is the size the buffer was allocated with
+    virtual void free(gsl::byte *buffer, size_t bytes) noexcept = 0;
 };
 
-class NNCASE_API host_allocator
+// Goes to the heap for every allocation
+class NNCASE_API heap_host_allocator : public host_allocator
 {
 public:
-    virtual ~host_allocator();
-    virtual gsl::span<gsl::byte> allocate(allocation_state &state, size_t bytes) = 0;
+    gsl::byte *allocate(size_t bytes) noexcept override;
+    void free(gsl::byte *buffer, size_t bytes) noexcept override;
 };
 
+struct host_allocator_stats
+{
+    size_t hits;
+    size_t misses;
+    size_t bytes_held;
+};
+
+// Keeps released buffers in free lists by size class and hands them out again, so a serving loop
+// that creates the same tensors for every request only goes to the heap for the first one.
+// Size classes take 4 steps per power of two from 64 bytes, a buffer wastes at most a quarter.
+class NNCASE_API pooled_host_allocator : public host_allocator
+{
+public:
+    // Buffers released while the pool already holds max_bytes_held go back to the heap
+    explicit pooled_host_allocator(size_t max_bytes_held = std::numeric_limits<size_t>::max()) noexcept;
+    pooled_host_allocator(const pooled_host_allocator &) = delete;
+    pooled_host_allocator &operator=(const pooled_host_allocator &) = delete;
+    ~pooled_host_allocator() override;
+
+    gsl::byte *allocate(size_t bytes) noexcept override;
+    void free(gsl::byte *buffer, size_t bytes) noexcept override;
+
+    host_allocator_stats stats() const noexcept;
+    // Returns every held buffer to the heap
+    void trim() noexcept;
+
+    static size_t size_class(size_t bytes) noexcept;
+
+private:
+    void lock() const noexcept;
+    void unlock() const noexcept;
+
+private:
+    size_t max_bytes_held_;
+    mutable std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+    std::map<size_t, std::vector<gsl::byte *>> free_lists_;
+    host_allocator_stats stats_;
+};
+
+// The allocator hrt::create uses when none is given, the heap unless replaced.
+// An allocator must outlive every tensor allocated from it.
+NNCASE_API host_allocator &default_host_allocator() noexcept;
+// nullptr goes back to the heap
+NNCASE_API void default_host_allocator(host_allocator *allocator) noexcept;
+
 END_NS_NNCASE_RUNTIME
@@ -371,6 +371,12 @@ typedef enum _lstm_direction
     kBidirectional
 } lstm_direction;
 
+typedef enum _lstm_framework
+{
+    kOnnx,
+    kCaffe
+} lstm_framework;
+
 typedef struct _quant_param
 {
     int32_t zero_point;
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "allocator.h"
 #include "runtime_tensor_impl.h"
 #include "shared_runtime_tensor.h"
 
@@ -33,6 +34,7 @@ struct host_memory_block
     uintptr_t virtual_address;
     size_t size_bytes;
     host_runtime_tensor::data_deleter_t deleter;
+    host_allocator *allocator;
     cache_status_t cache_status;
     physical_memory_block physical_block;
 
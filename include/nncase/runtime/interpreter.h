@@ -17,12 +17,18 @@
 #include "model.h"
 #include "result.h"
 #include "runtime_module.h"
+#include "scratch_arena.h"
+#include <functional>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
 #include <unordered_map>
 
 BEGIN_NS_NNCASE_RUNTIME
 
+class interpreter_pipeline;
+
+typedef std::function<void(result<void>)> run_async_callback_t;
+
 class NNCASE_API options_dict
 {
 public:
@@ -52,7 +58,9 @@ class NNCASE_API interpreter
 public:
     interpreter() noexcept;
     interpreter(interpreter &) = delete;
-    interpreter(interpreter &&) = default;
+    // Modules and the run_async pipeline keep a reference to their interpreter
+    interpreter(interpreter &&) = delete;
+    ~interpreter();
 
     NNCASE_NODISCARD result<void> load_model(gsl::span<const gsl::byte> buffer) noexcept;
 
@@ -67,15 +75,44 @@ public:
     result<runtime_tensor> output_tensor(size_t index) noexcept;
     result<void> output_tensor(size_t index, runtime_tensor tensor) noexcept;
 
+    // Every output is required by default. run() leaves the tensors of outputs that are not required untouched
+    // and, in models compiled with output dependencies, skips the ops that only feed them
+    bool output_required(size_t index) const noexcept;
+    result<void> output_required(size_t index, bool required) noexcept;
+
+    // Models compiled for several input shapes run the variant whose input shapes are exactly these, each with
+    // its own memory plan. Tensors bound to the previous shapes have to be set again, output_required carries over
+    result<void> reshape_inputs(gsl::span<const runtime_shape_t> shapes) noexcept;
+
     result<void> run() noexcept;
 
+    // inputs/outputs must not be touched until callback is invoked, don't mix with run() while requests are in flight.
+    // Outputs that are not required are left untouched and may be empty
+    result<void> run_async(std::vector<runtime_tensor> inputs, std::vector<runtime_tensor> outputs, run_async_callback_t callback) noexcept;
+    void wait_async_idle() noexcept;
+
+    size_t modules_size() const noexcept;
     result<runtime_module *> find_module_by_id(size_t index) noexcept;
     options_dict &options() noexcept;
 
+    // Allocator of the tensors the runtime creates for this interpreter, default_host_allocator() unless set.
+    // Set it before load_model, it must outlive the interpreter and every tensor it hands out
+    host_allocator &allocator() const noexcept;
+    void allocator(host_allocator &allocator) noexcept;
+
+    // Scratch memory shared with other interpreters, nullptr unless set. Set it before load_model,
+    // see scratch_arena for the contract
+    scratch_arena *scratch() const noexcept;
+    void scratch(scratch_arena &arena) noexcept;
+
 private:
     std::vector<std::unique_ptr<runtime_module>> modules_;
     runtime_function *entry_function_;
+    std::vector<runtime_function *> entry_variants_;
     options_dict options_;
+    host_allocator *allocator_;
+    scratch_arena *scratch_;
+    std::unique_ptr<interpreter_pipeline> pipeline_;
 };
 
 END_NS_NNCASE_RUNTIME
@@ -20,6 +20,12 @@ BEGIN_NS_NNCASE_RUNTIME
 
 NNCASE_INLINE_VAR constexpr size_t MAX_SECTION_NAME_LENGTH = 16;
 
+// model_header flags, set when some section body is stored compressed
+NNCASE_INLINE_VAR constexpr uint32_t MODEL_HAS_COMPRESSED_SECTIONS = 1;
+// model_header flags, set when the entry module holds the model compiled for several input shapes.
+// A uint32_t count and that many function ids of the entry module follow the header, entry_function first
+NNCASE_INLINE_VAR constexpr uint32_t MODEL_HAS_ENTRY_VARIANTS = 2;
+
 struct model_header
 {
     uint32_t identifier;
@@ -76,10 +82,14 @@ struct section_header
     uint32_t flags;
     uint32_t body_start;
     uint32_t body_size;
-    uint32_t reserved0;
+    uint32_t uncompressed_size;
 };
 
 NNCASE_INLINE_VAR constexpr uint32_t SECTION_MERGED_INTO_RDATA = 1;
+// body_size bytes of compressed data that decompress to uncompressed_size bytes
+NNCASE_INLINE_VAR constexpr uint32_t SECTION_COMPRESSED_LZ4 = 2;
+NNCASE_INLINE_VAR constexpr uint32_t SECTION_COMPRESSED_ZSTD = 4;
+NNCASE_INLINE_VAR constexpr uint32_t SECTION_COMPRESSION_MASK = SECTION_COMPRESSED_LZ4 | SECTION_COMPRESSED_ZSTD;
 
 struct shape_header
 {
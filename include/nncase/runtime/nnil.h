@@ -29,6 +29,7 @@ typedef enum _nnil_opcode
     nnil_ldc_r4_0 = 0x04,
     nnil_ldc_r4_1 = 0x05,
     nnil_ldc_r4 = 0x06,
+    nnil_lda = 0x07,
     nnil_abs = 0x20,
     nnil_ceil = 0x21,
     nnil_cos = 0x22,
@@ -64,6 +65,11 @@ typedef struct _nnil_ldc_r4
     float r4;
 } nnil_ldc_r4_t;
 
+typedef struct _nnil_lda
+{
+    uint8_t index;
+} nnil_lda_t;
+
 typedef struct _nnil_op
 {
     nnil_opcode_t opcode;
@@ -71,6 +77,7 @@ typedef struct _nnil_op
     union
     {
         nnil_ldc_r4_t ldc_r4;
+        nnil_lda_t lda;
     };
 } nnil_op_t;
 
@@ -93,6 +100,9 @@ public:
         case nnil_ldc_r4:
             op.ldc_r4 = reader_.read_unaligned<nnil_ldc_r4_t>();
             break;
+        case nnil_lda:
+            op.lda = reader_.read_unaligned<nnil_lda_t>();
+            break;
         default:
             break;
         }
@@ -41,6 +41,7 @@ private:
         runtime_tensor bind_tensor;
         runtime_tensor staging_tensor;
         runtime_tensor device_tensor;
+        bool required = true;
     };
 
 public:
@@ -63,6 +64,8 @@ public:
     const memory_range &output_desc(size_t index) const noexcept;
     result<runtime_tensor> output_tensor(size_t index) noexcept;
     result<void> output_tensor(size_t index, runtime_tensor tensor) noexcept;
+    bool output_required(size_t index) const noexcept;
+    result<void> output_required(size_t index, bool required) noexcept;
 
     result<void> invoke() noexcept;
 
@@ -63,6 +63,7 @@ private:
     std::vector<mempool_desc> mempools_;
     std::vector<mempool_desc> shared_mempools_;
     std::vector<std::unique_ptr<runtime_function>> functions_;
+    std::vector<runtime_tensor> section_buffers_;
     interpreter *interp_ = nullptr;
 };
 
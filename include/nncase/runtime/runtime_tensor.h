@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "allocator.h"
 #include "model.h"
 #include "result.h"
 #include <functional>
@@ -138,6 +139,9 @@ NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t sh
 NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, gsl::span<gsl::byte> data, bool copy, memory_pool_t pool = pool_shared, uintptr_t physical_address = 0) noexcept;
 NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, gsl::span<gsl::byte> data, data_deleter_t data_deleter, memory_pool_t pool = pool_shared, uintptr_t physical_address = 0) noexcept;
 NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, runtime_shape_t strides, memory_pool_t pool = pool_shared, uintptr_t physical_address = 0) noexcept;
+// The buffer comes from allocator and goes back to it when the tensor is released
+NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, host_allocator &allocator, memory_pool_t pool = pool_shared) noexcept;
+NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, runtime_shape_t strides, host_allocator &allocator, memory_pool_t pool = pool_shared) noexcept;
 NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, runtime_shape_t strides, gsl::span<gsl::byte> data, bool copy, memory_pool_t pool = pool_shared, uintptr_t physical_address = 0) noexcept;
 NNCASE_API result<runtime_tensor> create(datatype_t datatype, runtime_shape_t shape, runtime_shape_t strides, gsl::span<gsl::byte> data, data_deleter_t data_deleter, memory_pool_t pool = pool_shared, uintptr_t physical_address = 0) noexcept;
 NNCASE_API result<memory_pool_t> memory_pool(const runtime_tensor &tensor) noexcept;
@@ -0,0 +1,50 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "allocator.h"
+#include "runtime_tensor.h"
+#include <nncase/kernels/kernel_context.h>
+
+BEGIN_NS_NNCASE_RUNTIME
+
+// Scratch memory several interpreters can share instead of each owning its own: the mem_data pool of their
+// stackvm modules and the kernel workspace. It is sized to the largest model loaded with it, so interpreters
+// sharing an arena must never run at the same time, run_async requests in flight included. Nothing in it
+// survives from one run to the next. Set it before load_model, it must outlive the interpreters.
+class NNCASE_API scratch_arena
+{
+public:
+    scratch_arena() noexcept;
+    explicit scratch_arena(host_allocator &allocator) noexcept;
+
+    // Grows the arena to at least bytes, the memory is allocated on the next run
+    void reserve(size_t bytes) noexcept;
+    size_t capacity() const noexcept;
+
+    // Holds the arena's memory for a run, the buffer has capacity() bytes
+    result<runtime_tensor> acquire() noexcept;
+    kernels::kernel_context &kernel_context() noexcept;
+    // Frees the buffer and the kernel workspace until the next run, the capacity is kept
+    void trim() noexcept;
+
+private:
+    host_allocator *allocator_;
+    size_t capacity_;
+    runtime_tensor data_;
+    kernels::kernel_workspace workspace_;
+    kernels::kernel_context kernel_context_;
+};
+
+END_NS_NNCASE_RUNTIME
@@ -130,6 +130,19 @@ struct op_reader<break_op_t>
     }
 };
 
+template <>
+struct op_reader<br_unused_op_t>
+{
+    br_unused_op_t operator()(span_reader &reader) const
+    {
+        br_unused_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.masks = reader.read_unaligned<uint8_t>();
+        op.target = reader.read_unaligned<int32_t>();
+        return op;
+    }
+};
+
 template <>
 struct op_reader<ldc_i4_op_t>
 {
@@ -1179,11 +1192,39 @@ struct op_reader<tensor_conv2d_op_t>
         op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
         op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
         op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.w_datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.rstride_src = reader.read_unaligned<uint8_t>();
+        op.rshape_kernel = reader.read_unaligned<uint8_t>();
+        op.rstride_kernel = reader.read_unaligned<uint8_t>();
+        op.rstride_bias = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.groups = reader.read_unaligned<uint16_t>();
+        op.stride_h = reader.read_unaligned<uint16_t>();
+        op.stride_w = reader.read_unaligned<uint16_t>();
+        op.dilation_h = reader.read_unaligned<uint16_t>();
+        op.dilation_w = reader.read_unaligned<uint16_t>();
+        op.fused_clamp_low = reader.read_unaligned<float>();
+        op.fused_clamp_high = reader.read_unaligned<float>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_conv2d_transpose_op_t>
+{
+    tensor_conv2d_transpose_op_t operator()(span_reader &reader) const
+    {
+        tensor_conv2d_transpose_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
         op.rshape_src = reader.read_unaligned<uint8_t>();
         op.rstride_src = reader.read_unaligned<uint8_t>();
         op.rshape_kernel = reader.read_unaligned<uint8_t>();
         op.rstride_kernel = reader.read_unaligned<uint8_t>();
         op.rstride_bias = reader.read_unaligned<uint8_t>();
+        op.rshape_dest = reader.read_unaligned<uint8_t>();
         op.rstride_dest = reader.read_unaligned<uint8_t>();
         op.groups = reader.read_unaligned<uint16_t>();
         op.stride_h = reader.read_unaligned<uint16_t>();
@@ -1342,6 +1383,7 @@ struct op_reader<tensor_matmul_op_t>
         tensor_matmul_op_t op(default_init);
         op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
         op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.w_datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
         op.rshape_src1 = reader.read_unaligned<uint8_t>();
         op.rstride_src1 = reader.read_unaligned<uint8_t>();
         op.rshape_src2 = reader.read_unaligned<uint8_t>();
@@ -1813,6 +1855,64 @@ struct op_reader<tensor_gather_elements_op_t>
     }
 };
 
+template <>
+struct op_reader<tensor_lstm_op_t>
+{
+    tensor_lstm_op_t operator()(span_reader &reader) const
+    {
+        tensor_lstm_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.input_shape_src = reader.read_unaligned<uint8_t>();
+        op.initial_h_shape_src = reader.read_unaligned<uint8_t>();
+        op.w_shape_src = reader.read_unaligned<uint8_t>();
+        op.b_shape_src = reader.read_unaligned<uint8_t>();
+        op.sequence_lens_src = reader.read_unaligned<uint8_t>();
+        op.direction = reader.read_unaligned<uint8_t>();
+        op.framework = reader.read_unaligned<uint8_t>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_conv2d_chain_op_t>
+{
+    tensor_conv2d_chain_op_t operator()(span_reader &reader) const
+    {
+        tensor_conv2d_chain_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.rstride_src = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.rstage_src = reader.read_unaligned<uint8_t>();
+        op.rpad_src = reader.read_unaligned<uint8_t>();
+        op.stages = reader.read_unaligned<uint8_t>();
+        op.tile_h = reader.read_unaligned<uint16_t>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_fused_elementwise_op_t>
+{
+    tensor_fused_elementwise_op_t operator()(span_reader &reader) const
+    {
+        tensor_fused_elementwise_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_dest = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.inputs = reader.read_unaligned<uint8_t>();
+        op.body_size = reader.read_unaligned<uint16_t>();
+        op.body = reader.read_span(op.body_size);
+        return op;
+    }
+};
+
 class NNCASE_API op_visitor
 {
 public:
@@ -1834,6 +1934,7 @@ public:
     virtual result<void> visit(NNCASE_UNUSED const ecall_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const throw_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const break_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const br_unused_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const ldc_i4_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const ldnull_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const ldc_i4_0_op_t &op) noexcept { return ok(); }
@@ -1925,6 +2026,7 @@ public:
     virtual result<void> visit(NNCASE_UNUSED const tensor_call_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_compare_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_conv2d_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_conv2d_transpose_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_copy_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_convert_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_cumsum_op_t &op) noexcept { return ok(); }
@@ -1959,6 +2061,9 @@ public:
     virtual result<void> visit(NNCASE_UNUSED const tensor_layer_normalization_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_compress_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_gather_elements_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_lstm_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_conv2d_chain_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_fused_elementwise_op_t &op) noexcept { return ok(); }
 
 protected:
     bool interrupted_;
@@ -118,6 +118,7 @@ enum class opcode_t
     THROW = 0x5C,
     BREAK = 0x5D,
     TENSOR = 0x5E,
+    BR_UNUSED = 0x5F,
 };
 
 enum class tensor_function_t
@@ -166,6 +167,9 @@ enum class tensor_function_t
     LAYER_NORMALIZATION = 0x0029,
     COMPRESS = 0x002A,
     GATHER_ELEMENTS = 0x002B,
+    LSTM = 0x002C,
+    CONV2D_CHAIN = 0x002D,
+    FUSED_ELEMENTWISE = 0x002E,
 };
 
 // Instructions
@@ -275,6 +279,19 @@ struct break_op_t
     }
 };
 
+struct br_unused_op_t
+{
+    opcode_t opcode;
+    uint8_t masks;
+    int32_t target;
+
+    br_unused_op_t(default_init_t) noexcept { }
+    explicit br_unused_op_t(uint8_t masks, int32_t target) noexcept
+        : opcode(opcode_t::BR_UNUSED), masks(masks), target(target)
+    {
+    }
+};
+
 struct ldc_i4_op_t
 {
     opcode_t opcode;
@@ -1320,6 +1337,7 @@ struct tensor_conv2d_op_t
     opcode_t opcode;
     tensor_function_t funct;
     datatype_t datatype;
+    datatype_t w_datatype;
     uint8_t rshape_src;
     uint8_t rstride_src;
     uint8_t rshape_kernel;
@@ -1335,8 +1353,35 @@ struct tensor_conv2d_op_t
     float fused_clamp_high;
 
     tensor_conv2d_op_t(default_init_t) noexcept { }
-    explicit tensor_conv2d_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high) noexcept
-        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_kernel(rshape_kernel), rstride_kernel(rstride_kernel), rstride_bias(rstride_bias), rstride_dest(rstride_dest), groups(groups), stride_h(stride_h), stride_w(stride_w), dilation_h(dilation_h), dilation_w(dilation_w), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
+    explicit tensor_conv2d_op_t(datatype_t datatype, datatype_t w_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D), datatype(datatype), w_datatype(w_datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_kernel(rshape_kernel), rstride_kernel(rstride_kernel), rstride_bias(rstride_bias), rstride_dest(rstride_dest), groups(groups), stride_h(stride_h), stride_w(stride_w), dilation_h(dilation_h), dilation_w(dilation_w), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
+    {
+    }
+};
+
+struct tensor_conv2d_transpose_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src;
+    uint8_t rstride_src;
+    uint8_t rshape_kernel;
+    uint8_t rstride_kernel;
+    uint8_t rstride_bias;
+    uint8_t rshape_dest;
+    uint8_t rstride_dest;
+    uint16_t groups;
+    uint16_t stride_h;
+    uint16_t stride_w;
+    uint16_t dilation_h;
+    uint16_t dilation_w;
+    float fused_clamp_low;
+    float fused_clamp_high;
+
+    tensor_conv2d_transpose_op_t(default_init_t) noexcept { }
+    explicit tensor_conv2d_transpose_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rshape_dest, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D_TRANSPOSE), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_kernel(rshape_kernel), rstride_kernel(rstride_kernel), rstride_bias(rstride_bias), rshape_dest(rshape_dest), rstride_dest(rstride_dest), groups(groups), stride_h(stride_h), stride_w(stride_w), dilation_h(dilation_h), dilation_w(dilation_w), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
     {
     }
 };
@@ -1483,6 +1528,7 @@ struct tensor_matmul_op_t
 {
     opcode_t opcode;
     tensor_function_t funct;
+    datatype_t w_datatype;
     uint8_t rshape_src1;
     uint8_t rstride_src1;
     uint8_t rshape_src2;
@@ -1493,8 +1539,8 @@ struct tensor_matmul_op_t
     float fused_clamp_high;
 
     tensor_matmul_op_t(default_init_t) noexcept { }
-    explicit tensor_matmul_op_t(uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, float fused_clamp_low, float fused_clamp_high) noexcept
-        : opcode(opcode_t::TENSOR), funct(tensor_function_t::MATMUL), rshape_src1(rshape_src1), rstride_src1(rstride_src1), rshape_src2(rshape_src2), rstride_src2(rstride_src2), rshape_dest(rshape_dest), rstride_dest(rstride_dest), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
+    explicit tensor_matmul_op_t(datatype_t w_datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, float fused_clamp_low, float fused_clamp_high) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::MATMUL), w_datatype(w_datatype), rshape_src1(rshape_src1), rstride_src1(rstride_src1), rshape_src2(rshape_src2), rstride_src2(rstride_src2), rshape_dest(rshape_dest), rstride_dest(rstride_dest), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
     {
     }
 };
@@ -1958,4 +2004,62 @@ struct tensor_gather_elements_op_t
     }
 };
 
+struct tensor_lstm_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    uint8_t input_shape_src;
+    uint8_t initial_h_shape_src;
+    uint8_t w_shape_src;
+    uint8_t b_shape_src;
+    uint8_t sequence_lens_src;
+    uint8_t direction;
+    uint8_t framework;
+
+    tensor_lstm_op_t(default_init_t) noexcept { }
+    explicit tensor_lstm_op_t(uint8_t input_shape_src, uint8_t initial_h_shape_src, uint8_t w_shape_src, uint8_t b_shape_src, uint8_t sequence_lens_src, uint8_t direction, uint8_t framework) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::LSTM), input_shape_src(input_shape_src), initial_h_shape_src(initial_h_shape_src), w_shape_src(w_shape_src), b_shape_src(b_shape_src), sequence_lens_src(sequence_lens_src), direction(direction), framework(framework)
+    {
+    }
+};
+
+struct tensor_conv2d_chain_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src;
+    uint8_t rstride_src;
+    uint8_t rstride_dest;
+    uint8_t rstage_src;
+    uint8_t rpad_src;
+    uint8_t stages;
+    uint16_t tile_h;
+
+    tensor_conv2d_chain_op_t(default_init_t) noexcept { }
+    explicit tensor_conv2d_chain_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rstage_src, uint8_t rpad_src, uint8_t stages, uint16_t tile_h) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D_CHAIN), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rstride_dest(rstride_dest), rstage_src(rstage_src), rpad_src(rpad_src), stages(stages), tile_h(tile_h)
+    {
+    }
+};
+
+struct tensor_fused_elementwise_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_dest;
+    uint8_t rstride_dest;
+    uint8_t rshape_src;
+    uint8_t inputs;
+    uint16_t body_size;
+    gsl::span<const gsl::byte> body;
+
+    tensor_fused_elementwise_op_t(default_init_t) noexcept { }
+    explicit tensor_fused_elementwise_op_t(datatype_t datatype, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t rshape_src, uint8_t inputs, uint16_t body_size, gsl::span<const gsl::byte> body) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::FUSED_ELEMENTWISE), datatype(datatype), rshape_dest(rshape_dest), rstride_dest(rstride_dest), rshape_src(rshape_src), inputs(inputs), body_size(body_size), body(body)
+    {
+    }
+};
+
 END_NS_NNCASE_RT_MODULE
@@ -15,6 +15,7 @@
 #pragma once
 #include "buffers.h"
 #include "freelist.h"
+#include "memory_planner.h"
 #include <list>
 #include <nncase/ir/ir_types.h>
 #include <nncase/runtime/datatypes.h>
@@ -37,6 +38,7 @@ public:
     virtual void mark(const physical_buffer &buffer) = 0;
     virtual void finish() = 0;
     size_t max_usage() const noexcept { return max_usage_; }
+    size_t deduplicated_bytes() const noexcept { return deduplicated_bytes_; }
     const std::unordered_map<const physical_buffer *, allocated_buffer> &allocations() const noexcept { return allocations_; }
 
     virtual size_t get_size_in_bytes(const logical_buffer &buffer);
@@ -47,6 +49,7 @@ protected:
 
 protected:
     size_t max_usage_;
+    size_t deduplicated_bytes_ = 0;
     std::unordered_map<const physical_buffer *, allocated_buffer> allocations_;
 };
 
@@ -58,6 +61,16 @@ public:
     void finish() override;
 };
 
+// Linear allocator for read only data, constants with identical bytes share one allocation
+class NNCASE_API constant_buffer_allocator : public linear_buffer_allocator
+{
+public:
+    void mark(const physical_buffer &buffer) override;
+
+private:
+    std::unordered_multimap<size_t, allocated_buffer> constants_;
+};
+
 class NNCASE_API first_fit_allocator : public buffer_allocator
 {
 public:
@@ -72,6 +85,23 @@ private:
     std::vector<const physical_buffer *> living_buffers_;
 };
 
+// Collects every buffer and places them all at finish, keeping the better of first fit and greedy by size
+class NNCASE_API lifetime_aware_allocator : public buffer_allocator
+{
+public:
+    lifetime_aware_allocator(std::optional<size_t> fixed_size = std::nullopt);
+
+    void placement(memory_placement value) noexcept { placement_ = value; }
+    void base_offset(size_t value) override;
+    void mark(const physical_buffer &buffer) override;
+    void finish() override;
+
+private:
+    std::optional<size_t> fixed_size_;
+    memory_placement placement_ = memory_placement::best;
+    std::vector<allocated_buffer> buffers_;
+};
+
 using allocator_map_t = std::unordered_map<memory_location_t, buffer_allocator *>;
 using shared_allocator_map_t = std::unordered_map<module_type_t, buffer_allocator *>;
 }
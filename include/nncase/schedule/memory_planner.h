@@ -0,0 +1,48 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nncase/runtime/compiler_defs.h>
+#include <span>
+#include <stddef.h>
+
+namespace nncase::schedule
+{
+// A buffer of size bytes alive in [birth, end), placed at start by the planners below
+struct planned_buffer
+{
+    size_t size;
+    size_t birth;
+    size_t end;
+    size_t start = 0;
+
+    bool overlaps(const planned_buffer &other) const noexcept { return birth < other.end && other.birth < end; }
+};
+
+// How lifetime_aware_allocator places its buffers
+enum class memory_placement
+{
+    // the lower peak of plan_first_fit and plan_greedy_by_size
+    best,
+    // plan_first_fit only, the placement first_fit_allocator gives, to compare against
+    first_fit
+};
+
+// Places buffers in birth order at the lowest free address, what first_fit_allocator does. Returns the peak usage.
+NNCASE_API size_t plan_first_fit(std::span<planned_buffer> buffers);
+
+// Places the largest buffers first, each in the smallest gap left by the placed buffers it overlaps in time.
+// Returns the peak usage.
+NNCASE_API size_t plan_greedy_by_size(std::span<planned_buffer> buffers);
+}
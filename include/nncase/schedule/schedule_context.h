@@ -115,9 +115,12 @@ public:
     bool skip_buffer_alias() const noexcept { return skip_buffer_alias_; }
     void config_dump(std::filesystem::path dump_dir);
     const std::filesystem::path &dump_dir() const noexcept { return dump_dir_; }
+    void config_placement(memory_placement placement) noexcept { placement_ = placement; }
     model_schedule_result &model_result() const noexcept { return result_; }
+    // The target's allocators, lifetime aware ones use the configured placement
+    void register_allocators(const module_type_t &type, allocator_map_t &allocators, std::vector<std::shared_ptr<buffer_allocator>> &allocator_holders);
 
-    void schedule(ir::graph &entry_function);
+    void schedule(ir::graph &entry_function, std::span<ir::graph *const> entry_variants = {});
     void visit_function(ir::graph &graph, caller_context &caller_ctx);
 
 private:
@@ -128,8 +131,10 @@ private:
     nncase::target &target_;
     bool skip_buffer_alias_;
     std::filesystem::path dump_dir_;
+    memory_placement placement_ = memory_placement::best;
     module_schedule_context *entry_module_;
     ir::graph *entry_function_;
+    std::vector<ir::graph *> entry_variants_;
     std::unordered_map<module_type_t, module_schedule_context> module_contexts_;
 };
 }
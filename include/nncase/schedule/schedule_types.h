@@ -64,6 +64,7 @@ struct module_schedule_result
     std::unordered_map<ir::graph *, function_schedule_result *> functions_map;
     allocation_map_t allocations;
     std::unordered_map<memory_location_t, size_t> max_usages;
+    std::unordered_map<memory_location_t, size_t> deduplicated_bytes;
     std::unordered_map<module_type_t, size_t> shared_max_usages;
 };
 
@@ -71,5 +72,7 @@ struct model_schedule_result
 {
     std::vector<module_schedule_result> modules;
     function_schedule_result *entry_function;
+    // The entry function followed by the same model compiled for other input shapes, empty if there are none
+    std::vector<function_schedule_result *> entry_variants;
 };
 }
@@ -31,12 +31,17 @@ namespace schedule
 
         model_schedule_result schedule(bool skip_buffer_alias = false);
         void config_dump(std::filesystem::path dump_dir);
+        void config_placement(memory_placement placement);
+        // Main graphs of the same model for other input shapes, they share rdata and mem_data with main_graph
+        void entry_variants(std::vector<ir::graph *> graphs);
 
     private:
         target &target_;
         ir::graph &main_graph_;
         std::span<ir::output_node *> outputs_;
         std::filesystem::path dump_dir_;
+        memory_placement placement_ = memory_placement::best;
+        std::vector<ir::graph *> entry_variants_;
     };
 }
 }
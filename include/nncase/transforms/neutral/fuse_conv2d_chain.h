@@ -0,0 +1,39 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../transform.h"
+
+namespace nncase::ir::transforms
+{
+// Fuses conv2d -> conv2d and conv2d -> reduce_window2d into a conv2d_chain when the intermediate
+// doesn't fit in cache_size, so that every band of output rows keeps its intermediates in cache
+class NNCASE_API fuse_conv2d_chain_transform : public transform
+{
+public:
+    fuse_conv2d_chain_transform(size_t cache_size = 256 * 1024, size_t max_stages = 4) noexcept
+        : cache_size_(cache_size), max_stages_(max_stages)
+    {
+    }
+
+    void process(transform_context &context) override;
+
+protected:
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    size_t cache_size_;
+    size_t max_stages_;
+};
+}
@@ -0,0 +1,39 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../transform.h"
+
+namespace nncase::ir::transforms
+{
+// Fuses a float elementwise producer (binary, unary, clamp, fused_unary, fused_elementwise) into its elementwise
+// consumer, so that chains of elementwise ops run as one fused_elementwise pass over memory
+class NNCASE_API fuse_elementwise_transform : public transform
+{
+public:
+    fuse_elementwise_transform(size_t max_inputs = 8, size_t max_instructions = 128) noexcept
+        : max_inputs_(max_inputs), max_instructions_(max_instructions)
+    {
+    }
+
+    void process(transform_context &context) override;
+
+protected:
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    size_t max_inputs_;
+    size_t max_instructions_;
+};
+}
@@ -0,0 +1,40 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../transform.h"
+
+namespace nncase::ir::transforms
+{
+// Moves a transpose {0, 3, 1, 2} below an op by switching the op to its NHWC variant, so NHWC regions of
+// TFLite models run without transposes. Together with the transpose motions these push the input transpose
+// down until it cancels against a transpose back to NHWC.
+#define DEFINE_NHWC_MOTION(name)                                                  \
+    class NNCASE_API transpose_##name##_nhwc_motion_transform : public transform  \
+    {                                                                             \
+    public:                                                                       \
+        void process(transform_context &context) override;                        \
+                                                                                  \
+    protected:                                                                    \
+        bool skip_self_contained_check() const noexcept override { return true; } \
+        bool on_try_match(ir::node &node, transform_context &context) override;   \
+    };
+
+DEFINE_NHWC_MOTION(conv2d)
+DEFINE_NHWC_MOTION(reduce_window2d)
+DEFINE_NHWC_MOTION(resize_image)
+DEFINE_NHWC_MOTION(pad)
+
+#undef DEFINE_NHWC_MOTION
+}
@@ -148,6 +148,16 @@ class NNCASE_API alias_slice_buffer_pass : public graph_pass
 public:
     using graph_pass::graph_pass;
 
+protected:
+    void run_core(graph &graph, nncase::target &target, const run_pass_options &options) override;
+};
+
+// Lets the output of an elementwise op share the buffer of an input that dies at that op
+class NNCASE_API alias_inplace_buffer_pass : public graph_pass
+{
+public:
+    using graph_pass::graph_pass;
+
 protected:
     void run_core(graph &graph, nncase::target &target, const run_pass_options &options) override;
 };
@@ -0,0 +1,39 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../transform.h"
+
+namespace nncase::ir::transforms
+{
+// Stores the constant float32 weights of conv2d, conv2d_nhwc and matmul as float16 or bfloat16,
+// the kernels widen them back to float32 so only the model size and weight bandwidth change.
+// Convs already fused into a conv2d_chain keep their float32 weights
+class NNCASE_API convert_weights_storage_transform : public transform
+{
+public:
+    convert_weights_storage_transform(datatype_t storage_type) noexcept
+        : storage_type_(storage_type)
+    {
+    }
+
+    void process(transform_context &context) override;
+
+protected:
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    datatype_t storage_type_;
+};
+}
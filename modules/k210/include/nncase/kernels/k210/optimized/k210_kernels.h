@@ -0,0 +1,228 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <nncase/kernels/k210/k210_kernels.h>
+#include <numeric>
+#include <vector>
+
+BEGIN_NS_NNCASE_KERNELS_K210
+
+// Row at a time versions of the simulator kernels in k210_kernels.h. Each output keeps the
+// accumulation order of the plain loops, so results are bit-exact; the inner loops run over
+// contiguous rows so the compiler vectorizes them, and output rows are spread over OpenMP threads.
+namespace optimized
+{
+namespace detail
+{
+// Input planes with the 1 pixel border of 3x3 filters filled with pad_value
+inline std::vector<uint8_t> kpu_pad_input(const uint8_t *input, int32_t in_h, int32_t in_w, int32_t in_channels, uint8_t pad_value)
+{
+    const auto pw = in_w + 2, ph = in_h + 2;
+    std::vector<uint8_t> padded((size_t)in_channels * ph * pw, pad_value);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int32_t row = 0; row < in_channels * in_h; row++)
+    {
+        auto c = row / in_h, y = row % in_h;
+        std::memcpy(padded.data() + ((size_t)c * ph + y + 1) * pw + 1, input + (size_t)row * in_w, in_w);
+    }
+
+    return padded;
+}
+
+inline uint8_t kpu_bn_act(int64_t alu_out, const runtime::k210::kpu_batchnorm_segment &bn, const runtime::k210::kpu_activation_table_t &activation)
+{
+    auto value = (alu_out * bn.mul >> bn.shift) + bn.add;
+    assert(runtime::within_range<36>(value));
+    size_t i = activation.size() - 1;
+    while (i > 0 && !(value > activation[i].start_x))
+        i--;
+    auto &seg = activation[i];
+    auto act_value = runtime::carry_shift<int64_t, true>((value - seg.start_x) * seg.mul, seg.shift) + seg.add;
+    return (uint8_t)kernels::detail::clamp(act_value, int64_t(0), int64_t(255));
+}
+}
+
+template <bool IsDepthwise, int32_t FilterSize>
+void kpu_conv2d(const uint8_t *input, int64_t *workspace, uint8_t *output, const uint8_t *weights, int32_t in_h, int32_t in_w, int32_t in_channels, int32_t out_channels, uint8_t pad_value, int32_t arg_x,
+    int32_t shift_x, int32_t arg_w, int32_t shift_w, int64_t arg_add, const runtime::k210::kpu_batchnorm_segment *batchnorm, const runtime::k210::kpu_activation_table_t &activation)
+{
+    constexpr int32_t filter_area = FilterSize * FilterSize;
+    const auto channel_size = size_t(in_h) * in_w;
+    const auto groups = IsDepthwise ? out_channels : 1;
+    const auto g_ic = IsDepthwise ? 1 : in_channels / groups;
+
+    std::vector<uint8_t> padded;
+    if constexpr (FilterSize == 3)
+        padded = detail::kpu_pad_input(input, in_h, in_w, in_channels, pad_value);
+    const auto pw = FilterSize == 1 ? in_w : in_w + 2;
+    const auto ph = FilterSize == 1 ? in_h : in_h + 2;
+    const uint8_t *src = FilterSize == 1 ? input : padded.data();
+
+    // sum_x is shared by every output channel of a group, sum_w is per output channel
+    std::vector<int32_t> sum_x((size_t)groups * channel_size);
+    std::vector<int64_t> sum_w(out_channels);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int32_t row = 0; row < groups * in_h; row++)
+    {
+        auto g = row / in_h, oy = row % in_h;
+        auto sum = sum_x.data() + (size_t)row * in_w;
+        for (int32_t ic = 0; ic < g_ic; ic++)
+        {
+            auto in_c_p = src + ((size_t)g * g_ic + ic) * ph * pw;
+            for (int32_t ky = 0; ky < FilterSize; ky++)
+            {
+                for (int32_t kx = 0; kx < FilterSize; kx++)
+                {
+                    auto in_p = in_c_p + (size_t)(oy + ky) * pw + kx;
+                    for (int32_t ox = 0; ox < in_w; ox++)
+                        sum[ox] += in_p[ox];
+                }
+            }
+        }
+    }
+
+    for (int32_t oc = 0; oc < out_channels; oc++)
+    {
+        auto w_oc_p = weights + (size_t)oc * g_ic * filter_area;
+        sum_w[oc] = std::accumulate(w_oc_p, w_oc_p + (size_t)g_ic * filter_area, int64_t(0));
+    }
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        // KPU has at most 1024 input channels, 1024 * 9 * 255 * 255 fits int32
+        std::vector<int32_t> acc(in_w);
+#ifdef NNCASE_OPENMP
+#pragma omp for
+#endif
+        for (int32_t row = 0; row < out_channels * in_h; row++)
+        {
+            auto oc = row / in_h, oy = row % in_h;
+            auto g = IsDepthwise ? oc : 0;
+            auto w_oc_p = weights + (size_t)oc * g_ic * filter_area;
+            std::fill(acc.begin(), acc.end(), 0);
+
+            for (int32_t ic = 0; ic < g_ic; ic++)
+            {
+                auto in_c_p = src + ((size_t)g * g_ic + ic) * ph * pw;
+                auto w_ic_p = w_oc_p + (size_t)ic * filter_area;
+                for (int32_t ky = 0; ky < FilterSize; ky++)
+                {
+                    for (int32_t kx = 0; kx < FilterSize; kx++)
+                    {
+                        const int32_t w = w_ic_p[ky * FilterSize + kx];
+                        auto in_p = in_c_p + (size_t)(oy + ky) * pw + kx;
+                        for (int32_t ox = 0; ox < in_w; ox++)
+                            acc[ox] += in_p[ox] * w;
+                    }
+                }
+            }
+
+            const auto sum_x_p = sum_x.data() + ((size_t)g * in_h + oy) * in_w;
+            const auto w_term = (arg_w * sum_w[oc] >> shift_w) + arg_add * g_ic;
+            const auto out_offset = (size_t)row * in_w;
+            for (int32_t ox = 0; ox < in_w; ox++)
+            {
+                auto alu_out = acc[ox] + (arg_x * (int64_t)sum_x_p[ox] >> shift_x) + w_term;
+                assert(runtime::within_range<36>(alu_out));
+                workspace[out_offset + ox] = alu_out;
+                output[out_offset + ox] = detail::kpu_bn_act(alu_out, batchnorm[oc], activation);
+            }
+        }
+    }
+}
+
+template <class T>
+inline void kpu_pool2d(const T *input, T *output, int32_t in_h, int32_t in_w, int32_t in_channels, runtime::k210::kpu_pool_type_t pool_type)
+{
+    using namespace runtime::k210;
+
+    const auto in_size = (size_t)in_h * in_w;
+    if (pool_type == kpu_pool_bypass)
+    {
+        std::copy(input, input + in_size * in_channels, output);
+        return;
+    }
+
+    const auto out_size = (size_t)get_kpu_pool_output_size(in_h, pool_type) * get_kpu_pool_output_size(in_w, pool_type);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int32_t oc = 0; oc < in_channels; oc++)
+        k210::kpu_pool2d(input + oc * in_size, output + oc * out_size, in_h, in_w, 1, pool_type);
+}
+
+template <bool IsDepthwise, int32_t FilterSize>
+void fake_kpu_conv2d(const float *input, float *output, const float *weights, const float *bias, int32_t in_h, int32_t in_w, int32_t in_channels, int32_t out_channels, value_range<float> fused_activation)
+{
+    constexpr int32_t filter_area = FilterSize * FilterSize;
+    const auto pad = FilterSize == 1 ? 0 : 1;
+    const auto groups = IsDepthwise ? out_channels : 1;
+    const auto g_ic = IsDepthwise ? 1 : in_channels / groups;
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<float> acc(in_w);
+#ifdef NNCASE_OPENMP
+#pragma omp for
+#endif
+        for (int32_t row = 0; row < out_channels * in_h; row++)
+        {
+            auto oc = row / in_h, oy = row % in_h;
+            auto g = IsDepthwise ? oc : 0;
+            auto w_oc_p = weights + (size_t)oc * g_ic * filter_area;
+            std::fill(acc.begin(), acc.end(), bias[oc]);
+
+            // taps falling on the padding are skipped rather than added as zero, as the plain loop does
+            for (int32_t ic = 0; ic < g_ic; ic++)
+            {
+                auto in_c_p = input + ((size_t)g * g_ic + ic) * in_h * in_w;
+                auto w_ic_p = w_oc_p + (size_t)ic * filter_area;
+                for (int32_t ky = 0; ky < FilterSize; ky++)
+                {
+                    const int32_t in_y = oy - pad + ky;
+                    if (in_y < 0 || in_y >= in_h)
+                        continue;
+
+                    for (int32_t kx = 0; kx < FilterSize; kx++)
+                    {
+                        const auto w = w_ic_p[ky * FilterSize + kx];
+                        const int32_t ox_begin = std::max(0, pad - kx);
+                        const int32_t ox_end = std::min(in_w, in_w + pad - kx);
+                        auto in_row = in_c_p + (size_t)in_y * in_w;
+                        for (int32_t ox = ox_begin; ox < ox_end; ox++)
+                            acc[ox] += in_row[ox + kx - pad] * w;
+                    }
+                }
+            }
+
+            auto out_p = output + (size_t)row * in_w;
+            for (int32_t ox = 0; ox < in_w; ox++)
+                out_p[ox] = kernels::detail::apply_activation(acc[ox], fused_activation);
+        }
+    }
+}
+}
+
+END_NS_NNCASE_KERNELS_K210
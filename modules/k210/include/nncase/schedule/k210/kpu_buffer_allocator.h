@@ -18,7 +18,7 @@
 
 namespace nncase::schedule::k210
 {
-class NNCASE_MODULES_K210_API kpu_buffer_allocator : public first_fit_allocator
+class NNCASE_MODULES_K210_API kpu_buffer_allocator : public lifetime_aware_allocator
 {
 public:
     kpu_buffer_allocator();
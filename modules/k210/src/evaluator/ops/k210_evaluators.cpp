@@ -18,7 +18,7 @@
 #include <nncase/ir/ops/k210/kpu_conv2d.h>
 #include <nncase/ir/ops/k210/kpu_data_exchange.h>
 #include <nncase/ir/ops/k210/opcode.h>
-#include <nncase/kernels/k210/k210_kernels.h>
+#include <nncase/kernels/k210/optimized/k210_kernels.h>
 #include <nncase/runtime/k210/runtime_op_utility.h>
 
 using namespace nncase;
@@ -86,7 +86,7 @@ void ir::k210::register_k210_evaluators()
 
 #define FAKE_KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                 \
     if (rnode.is_depthwise() == is_depthwise_val && runtime::k210::get_kpu_filter_size(rnode.filter_type()) == filter_size_val) \
-    kernels::k210::fake_kpu_conv2d<is_depthwise_val, filter_size_val>(p_input, p_conv_ouput_tmp, weights_mem.data(),            \
+    kernels::k210::optimized::fake_kpu_conv2d<is_depthwise_val, filter_size_val>(p_input, p_conv_ouput_tmp, weights_mem.data(), \
         bias_mem.data(), in_shape[2], in_shape[3], in_shape[1], rnode.output_channels(), rnode.fused_activation())
 
         for (size_t n = 0; n < batch; n++)
@@ -96,7 +96,7 @@ void ir::k210::register_k210_evaluators()
             else FAKE_KPU_CONV2D_IMPL(false, 1);
             else FAKE_KPU_CONV2D_IMPL(false, 3);
 
-            kernels::k210::kpu_pool2d(p_conv_ouput_tmp, p_output, in_shape[2], in_shape[3], rnode.output_channels(),
+            kernels::k210::optimized::kpu_pool2d(p_conv_ouput_tmp, p_output, in_shape[2], in_shape[3], rnode.output_channels(),
                 rnode.pool_type());
 
             p_input += in_size_per_batch;
@@ -149,12 +149,12 @@ void ir::k210::register_k210_evaluators()
 
         [[maybe_unused]] auto ret_dl = kernels::k210::kpu_download(p_input, p_download_output_tmp, kpu_in_shape);
 
-#define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                         \
-    if (rnode.is_depthwise() == is_depthwise_val && runtime::k210::get_kpu_filter_size(rnode.filter_type()) == filter_size_val)                    \
-    {                                                                                                                                              \
-        kernels::k210::kpu_conv2d<is_depthwise_val, filter_size_val>(p_download_output_tmp, workspace.get(), p_conv_ouput_tmp, weights_mem.data(), \
-            in_shape[2], in_shape[3], in_shape[1], rnode.output_channels(), pad_value, quant_args.arg_x, quant_args.shift_x,                       \
-            quant_args.arg_w, quant_args.shift_w, quant_args.arg_add, &bn[0], act);                                                                \
+#define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                                    \
+    if (rnode.is_depthwise() == is_depthwise_val && runtime::k210::get_kpu_filter_size(rnode.filter_type()) == filter_size_val)                               \
+    {                                                                                                                                                         \
+        kernels::k210::optimized::kpu_conv2d<is_depthwise_val, filter_size_val>(p_download_output_tmp, workspace.get(), p_conv_ouput_tmp, weights_mem.data(), \
+            in_shape[2], in_shape[3], in_shape[1], rnode.output_channels(), pad_value, quant_args.arg_x, quant_args.shift_x,                                  \
+            quant_args.arg_w, quant_args.shift_w, quant_args.arg_add, &bn[0], act);                                                                           \
     }
 
         auto workspace = std::make_unique<int64_t[]>(groups * g_oc * in_shape[2] * in_shape[3]);
@@ -164,7 +164,7 @@ void ir::k210::register_k210_evaluators()
             KPU_CONV2D_IMPL(true, 1)
             else KPU_CONV2D_IMPL(true, 3) else KPU_CONV2D_IMPL(false, 1) else KPU_CONV2D_IMPL(false, 3)
 
-                kernels::k210::kpu_pool2d(p_conv_ouput_tmp, p_pool_output_tmp, in_shape[2], in_shape[3], rnode.output_channels(),
+                kernels::k210::optimized::kpu_pool2d(p_conv_ouput_tmp, p_pool_output_tmp, in_shape[2], in_shape[3], rnode.output_channels(),
                     rnode.pool_type());
 
             p_input += in_size_per_batch;
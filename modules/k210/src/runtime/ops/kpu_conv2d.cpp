@@ -13,7 +13,7 @@
  * limitations under the License.
  */
 #include "../runtime_function.h"
-#include <nncase/kernels/k210/k210_kernels.h>
+#include <nncase/kernels/k210/optimized/k210_kernels.h>
 #include <nncase/runtime/dbg.h>
 #ifndef NNCASE_SIMULATOR
 #include <kpu.h>
@@ -157,9 +157,9 @@ result<void> k210_runtime_function::visit(const kpu_conv2d_options &op) noexcept
             dest.add = act_table.activate_para_bias1.data.result_bias[i - 8];
     }
 
-#define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                                  \
-    if (is_depthwise == is_depthwise_val && filter_size == filter_size_val)                                                                                 \
-    kernels::k210::kpu_conv2d<is_depthwise_val, filter_size_val>(p_input, p_workspace, p_conv_ouput_tmp, reinterpret_cast<const uint8_t *>(weights.data()), \
+#define KPU_CONV2D_IMPL(is_depthwise_val, filter_size_val)                                                                                                             \
+    if (is_depthwise == is_depthwise_val && filter_size == filter_size_val)                                                                                            \
+    kernels::k210::optimized::kpu_conv2d<is_depthwise_val, filter_size_val>(p_input, p_workspace, p_conv_ouput_tmp, reinterpret_cast<const uint8_t *>(weights.data()), \
         in_h, in_w, in_ch, out_ch, pad_value, arg_x, shift_x, arg_w, shift_w, arg_add, batchnorm.get(), activation)
 
     for (size_t n = 0; n < batch; n++)
@@ -169,7 +169,7 @@ result<void> k210_runtime_function::visit(const kpu_conv2d_options &op) noexcept
         else KPU_CONV2D_IMPL(false, 1);
         else KPU_CONV2D_IMPL(false, 3);
 
-        kernels::k210::kpu_pool2d(p_conv_ouput_tmp, p_output_tmp, in_h, in_w, out_ch, (kpu_pool_type_t)layer.kernel_pool_type_cfg.data.pool_type);
+        kernels::k210::optimized::kpu_pool2d(p_conv_ouput_tmp, p_output_tmp, in_h, in_w, out_ch, (kpu_pool_type_t)layer.kernel_pool_type_cfg.data.pool_type);
 
         p_input += in_size_per_batch;
         p_workspace += conv_output_tmp_size_per_batch;
@@ -40,12 +40,12 @@ result<void> k210_runtime_function::initialize_core(runtime_function_init_contex
 
 result<runtime_tensor> k210_runtime_function::allocate_input_tensor(size_t index) noexcept
 {
-    return hrt::create(input_desc(index).datatype, input_shape(index), hrt::pool_shared);
+    return hrt::create(input_desc(index).datatype, input_shape(index), module().interp().allocator(), hrt::pool_shared);
 }
 
 result<runtime_tensor> k210_runtime_function::allocate_output_tensor(size_t index) noexcept
 {
-    return hrt::create(output_desc(index).datatype, output_shape(index), hrt::pool_shared);
+    return hrt::create(output_desc(index).datatype, output_shape(index), module().interp().allocator(), hrt::pool_shared);
 }
 
 result<void> k210_runtime_function::validate_input_tensor(NNCASE_UNUSED size_t index, runtime_tensor tensor) noexcept
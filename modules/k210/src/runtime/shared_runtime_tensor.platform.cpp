@@ -50,10 +50,10 @@ physical_memory_block &physical_memory_block::operator=(physical_memory_block &&
     return *this;
 }
 
-void physical_memory_block::free(NNCASE_UNUSED host_memory_block &block) noexcept
+void physical_memory_block::free(host_memory_block &block) noexcept
 {
     if (owned)
-        delete[] reinterpret_cast<gsl::byte *>(physical_address + IOMEM);
+        block.allocator->free(reinterpret_cast<gsl::byte *>(physical_address + IOMEM), block.size_bytes);
     physical_address = 0;
     owned = false;
 }
@@ -76,7 +76,7 @@ result<void> physical_memory_block::acknowledge(host_memory_block &block) noexce
 
 result<void> physical_memory_block::allocate(host_memory_block &block) noexcept
 {
-    auto buffer = new (std::nothrow) gsl::byte[block.size_bytes];
+    auto buffer = block.allocator->allocate(block.size_bytes);
     CHECK_WITH_ERR(buffer, std::errc::not_enough_memory);
     block.virtual_address = reinterpret_cast<uintptr_t>(buffer);
     block.physical_block.physical_address = block.virtual_address - IOMEM;
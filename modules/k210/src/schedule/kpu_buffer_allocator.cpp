@@ -20,7 +20,7 @@ using namespace nncase::schedule;
 using namespace nncase::schedule::k210;
 
 kpu_buffer_allocator::kpu_buffer_allocator()
-    : first_fit_allocator(2 * 1024 * 1024)
+    : lifetime_aware_allocator(2 * 1024 * 1024)
 {
 }
 
@@ -16,6 +16,7 @@
 #include "vulkan_error.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_loader.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
@@ -47,12 +48,12 @@ result<void> vulkan_runtime_function::initialize_core(runtime_function_init_cont
 
 result<runtime_tensor> vulkan_runtime_function::allocate_input_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(input_desc(index).datatype, input_shape(index));
+    return host_runtime_tensor::create(input_desc(index).datatype, input_shape(index), module().interp().allocator());
 }
 
 result<runtime_tensor> vulkan_runtime_function::allocate_output_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(output_desc(index).datatype, output_shape(index));
+    return host_runtime_tensor::create(output_desc(index).datatype, output_shape(index), module().interp().allocator());
 }
 
 result<void> vulkan_runtime_function::validate_input_tensor(NNCASE_UNUSED size_t index, runtime_tensor tensor) noexcept
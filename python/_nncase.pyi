@@ -1,4 +1,4 @@
-from typing import Any, List, BinaryIO
+from typing import Any, Dict, List, BinaryIO
 
 import numpy
 
@@ -11,6 +11,7 @@ class CompileOptions:
     swapRB: bool
     input_range: List[float]
     input_shape: List[int]
+    dim_values: Dict[str, List[int]]
     input_type: str
     is_fpga: bool
     mean: List[float]
@@ -22,6 +23,9 @@ class CompileOptions:
     w_quant_type: str
     use_mse_quant_w: bool
     split_w_to_act: bool
+    w_storage_type: str
+    section_compression: str
+    memory_placement: str
     input_layout: str
     output_layout: str
     letterbox_value: float
@@ -90,10 +94,13 @@ class Simulator:
     def get_input_desc(self, index: int) -> MemoryRange: ...
     def get_input_tensor(self, index: int) -> RuntimeTensor: ...
     def get_output_desc(self, index: int) -> MemoryRange: ...
+    def get_output_required(self, index: int) -> bool: ...
     def get_output_tensor(self, index: int) -> RuntimeTensor: ...
     def load_model(self, model: bytes) -> None: ...
+    def reshape_inputs(self, shapes: List[List[int]]) -> None: ...
     def run(self) -> None: ...
     def set_input_tensor(self, index: int, tensor: RuntimeTensor) -> None: ...
+    def set_output_required(self, index: int, required: bool) -> None: ...
     def set_output_tensor(self, index: int, tensor: RuntimeTensor) -> None: ...
     @property
     def inputs_size(self) -> int: ...
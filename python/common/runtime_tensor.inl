@@ -20,33 +20,51 @@ py::class_<memory_range>(m, "MemoryRange")
     .def_readwrite("start", &memory_range::start)
     .def_readwrite("size", &memory_range::size);
 
+struct mapped_runtime_tensor
+{
+    runtime_tensor tensor;
+    hrt::mapped_buffer map;
+};
+
 py::class_<runtime_tensor>(m, "RuntimeTensor")
     .def_static("from_numpy", [](py::array arr) {
+        // Wrap the numpy buffer without copying, the array is kept alive until the tensor is freed
         auto src_buffer = arr.request();
         auto datatype = from_dtype(arr.dtype());
+        auto owner = arr.ptr();
         auto tensor = host_runtime_tensor::create(
             datatype,
             to_rt_shape(src_buffer.shape),
             to_rt_strides(src_buffer.itemsize, src_buffer.strides),
             gsl::make_span(reinterpret_cast<gsl::byte *>(src_buffer.ptr), src_buffer.size * src_buffer.itemsize),
-            [=](gsl::byte *) { arr.dec_ref(); })
+            [owner](gsl::byte *) {
+                // Tensors may be released by a thread that doesn't hold the GIL
+                py::gil_scoped_acquire acquire;
+                Py_DECREF(owner);
+            })
                           .unwrap_or_throw();
-        arr.inc_ref();
+        Py_INCREF(owner);
         return tensor;
     })
     .def("copy_to", [](runtime_tensor &from, runtime_tensor &to) {
         from.copy_to(to).unwrap_or_throw();
     })
-    .def("to_numpy", [](runtime_tensor &tensor) {
-        auto host = tensor.as_host().unwrap_or_throw();
-        auto src_map = std::move(hrt::map(host, hrt::map_read).unwrap_or_throw());
-        auto src_buffer = src_map.buffer();
-        return py::array(
-            to_dtype(tensor.datatype()),
-            tensor.shape(),
-            to_py_strides(runtime::get_bytes(tensor.datatype()), tensor.strides()),
-            src_buffer.data());
-    })
+    .def(
+        "to_numpy", [](runtime_tensor &tensor, bool copy) {
+            auto host = tensor.as_host().unwrap_or_throw();
+            auto src_map = std::move(hrt::map(host, hrt::map_read).unwrap_or_throw());
+            auto src_buffer = src_map.buffer();
+            auto dtype = to_dtype(tensor.datatype());
+            auto strides = to_py_strides(runtime::get_bytes(tensor.datatype()), tensor.strides());
+            if (copy)
+                return py::array(dtype, tensor.shape(), strides, src_buffer.data());
+
+            // The view keeps the tensor mapped, so it is only valid until the next run overwrites it
+            auto holder = new mapped_runtime_tensor { host, std::move(src_map) };
+            py::capsule base(holder, [](void *p) { delete reinterpret_cast<mapped_runtime_tensor *>(p); });
+            return py::array(dtype, tensor.shape(), strides, src_buffer.data(), base);
+        },
+        py::arg("copy") = true)
     .def_property_readonly("dtype", [](runtime_tensor &tensor) {
         return to_dtype(tensor.datatype());
     })
@@ -140,6 +140,9 @@ PYBIND11_MODULE(_nncase, m)
         .def_readwrite("w_quant_type", &compile_options::w_quant_type)
         .def_readwrite("use_mse_quant_w", &compile_options::use_mse_quant_w)
         .def_readwrite("split_w_to_act", &compile_options::split_w_to_act)
+        .def_readwrite("w_storage_type", &compile_options::w_storage_type)
+        .def_readwrite("section_compression", &compile_options::section_compression)
+        .def_readwrite("memory_placement", &compile_options::memory_placement)
         .def_readwrite("preprocess", &compile_options::preprocess)
         .def_readwrite("swapRB", &compile_options::swapRB)
         .def_readwrite("mean", &compile_options::mean)
@@ -147,6 +150,7 @@ PYBIND11_MODULE(_nncase, m)
         .def_readwrite("input_range", &compile_options::input_range)
         .def_readwrite("output_range", &compile_options::output_range)
         .def_readwrite("input_shape", &compile_options::input_shape)
+        .def_readwrite("dim_values", &compile_options::dim_values)
         .def_readwrite("letterbox_value", &compile_options::letterbox_value)
         .def_readwrite("input_type", &compile_options::input_type)
         .def_readwrite("output_type", &compile_options::output_type)
@@ -193,15 +197,15 @@ PYBIND11_MODULE(_nncase, m)
         .def_property_readonly("outputs_size", &graph_evaluator::outputs_size)
         .def("get_input_tensor", &graph_evaluator::input_at)
         .def("get_output_tensor", &graph_evaluator::output_at)
-        .def("run", &graph_evaluator::run);
+        .def("run", &graph_evaluator::run, py::call_guard<py::gil_scoped_release>());
 
     py::class_<compiler>(m, "Compiler")
         .def(py::init(&compiler::create))
         .def("import_tflite", &compiler::import_tflite)
         .def("import_onnx", &compiler::import_onnx)
         .def("import_caffe", &compiler::import_caffe)
-        .def("compile", &compiler::compile)
-        .def("use_ptq", py::overload_cast<ptq_tensor_options>(&compiler::use_ptq))
+        .def("compile", &compiler::compile, py::call_guard<py::gil_scoped_release>())
+        .def("use_ptq", py::overload_cast<ptq_tensor_options>(&compiler::use_ptq), py::call_guard<py::gil_scoped_release>())
         .def("dump_range_options", py::overload_cast<dump_range_tensor_options>(&compiler::dump_range_options))
         .def("gencode", [](compiler &c, std::ostream &stream) { c.gencode(stream); })
         .def("gencode_tobytes", [](compiler &c) {
@@ -227,7 +231,16 @@ PYBIND11_MODULE(_nncase, m)
         .def("set_input_tensor", [](interpreter &interp, size_t index, runtime_tensor tensor) { return interp.input_tensor(index, tensor).unwrap_or_throw(); })
         .def("get_output_tensor", [](interpreter &interp, size_t index) { return interp.output_tensor(index).unwrap_or_throw(); })
         .def("set_output_tensor", [](interpreter &interp, size_t index, runtime_tensor tensor) { return interp.output_tensor(index, tensor).unwrap_or_throw(); })
-        .def("run", [](interpreter &interp) { interp.run().unwrap_or_throw(); });
+        .def("get_output_required", [](interpreter &interp, size_t index) { return interp.output_required(index); })
+        .def("set_output_required", [](interpreter &interp, size_t index, bool required) { interp.output_required(index, required).unwrap_or_throw(); })
+        .def("reshape_inputs", [](interpreter &interp, const std::vector<std::vector<py::ssize_t>> &shapes) {
+            std::vector<runtime_shape_t> rt_shapes;
+            for (auto &shape : shapes)
+                rt_shapes.emplace_back(to_rt_shape(shape));
+            interp.reshape_inputs(rt_shapes).unwrap_or_throw();
+        })
+        .def(
+            "run", [](interpreter &interp) { interp.run().unwrap_or_throw(); }, py::call_guard<py::gil_scoped_release>());
 
     m.def("test_target", [](std::string name) {
         try
@@ -32,6 +32,9 @@ compile_command::compile_command(lyra::cli &cli)
                          .add_argument(lyra::opt(w_quant_type_, "w quant type").name("--w-quant-type").optional().help("post trainning weights quantize type, e.g uint8|int8|int16, default is " + w_quant_type_))
                          .add_argument(lyra::opt(use_mse_quant_w_).name("--use-mse-quant-w").optional().help("use min mse algorithm to refine weights quantilization or not, default is " + std::to_string(use_mse_quant_w_)))
                          .add_argument(lyra::opt(split_w_to_act_).name("--split-w-to-act").optional().help("split weights to act or not, default is " + std::to_string(split_w_to_act_)))
+                         .add_argument(lyra::opt(w_storage_type_, "w storage type").name("--w-storage-type").optional().help("storage type of float conv2d/matmul weights, e.g. float32|float16|bfloat16, default is " + w_storage_type_))
+                         .add_argument(lyra::opt(section_compression_, "section compression").name("--section-compression").optional().help("compress kmodel sections, e.g. none|lz4|zstd, default is " + section_compression_))
+                         .add_argument(lyra::opt(memory_placement_, "memory placement").name("--memory-placement").optional().help("placement of lifetime planned memory such as the k210 KPU RAM, e.g. best|first_fit, default is " + memory_placement_))
                          .add_argument(lyra::opt(dataset_, "dataset path").name("--dataset").optional().help("calibration dataset, used in post quantization"))
                          .add_argument(lyra::opt(dataset_format_, "dataset format").name("--dataset-format").optional().help("datset format: e.g. image|raw, default is " + dataset_format_))
                          .add_argument(lyra::opt(dump_range_dataset_, "dataset path").name("--dump-range-dataset").optional().help("dump import op range dataset"))
@@ -44,6 +47,7 @@ compile_command::compile_command(lyra::cli &cli)
                          .add_argument(lyra::opt(cli_input_range_, "input range").name("--input-range").optional().help("float range after preprocess"))
                          .add_argument(lyra::opt(cli_output_range_, "output range").name("--output-range").optional().help("float range to quantize output"))
                          .add_argument(lyra::opt(cli_input_shape_, "input shape").name("--input-shape").optional().help("shape for input data"))
+                         .add_argument(lyra::opt(cli_dim_values_, "dim values").name("--dim-values").optional().help("values of a symbolic input dimension, e.g. \"seq=16 32 64\", the model is compiled for each value"))
                          .add_argument(lyra::opt(letterbox_value_, "letter box value").name("--letterbox-value").optional().help("letter box pad value, default is " + std::to_string(letterbox_value_)))
                          .add_argument(lyra::opt(input_type_, "input type").name("--input-type").optional().help("input type, e.g float32|uint8|default, default is " + input_type_))
                          .add_argument(lyra::opt(output_type_, "output type").name("--output-type").optional().help("output type, e.g float32|uint8, default is " + output_type_))
@@ -101,10 +105,24 @@ void compile_command::run()
     c_options.preprocess = preprocess_;
     c_options.use_mse_quant_w = use_mse_quant_w_;
     c_options.split_w_to_act = split_w_to_act_;
+    c_options.w_storage_type = w_storage_type_;
+    c_options.section_compression = section_compression_;
+    c_options.memory_placement = memory_placement_;
     c_options.input_layout = input_layout_;
     c_options.output_layout = output_layout_;
     c_options.model_layout = model_layout_;
     c_options.letterbox_value = letterbox_value_;
+    for (auto &cli_dim : cli_dim_values_)
+    {
+        auto pos = cli_dim.find('=');
+        if (pos == std::string::npos)
+            throw std::invalid_argument("Invalid dim values " + cli_dim + ", expect name=values");
+        std::vector<int32_t> values;
+        parser_vector_opt(cli_dim.substr(pos + 1), values);
+        auto &dim_values = c_options.dim_values[cli_dim.substr(0, pos)];
+        for (auto value : values)
+            dim_values.emplace_back((size_t)value);
+    }
     if (c_options.preprocess)
     {
         if (c_options.input_shape.empty())
@@ -78,6 +78,9 @@ private:
     std::string model_layout_;
     bool use_mse_quant_w_ = false;
     bool split_w_to_act_ = false;
+    std::string w_storage_type_ = "float32";
+    std::string section_compression_ = "none";
+    std::string memory_placement_ = "best";
     std::vector<float> mean_ = { 0.f, 0.f, 0.f };
     std::vector<float> std_ = { 1.f, 1.f, 1.f };
     std::vector<float> input_range_;
@@ -89,6 +92,7 @@ private:
     std::string cli_std_ = "1. 1. 1.";
     std::string cli_input_range_;
     std::string cli_input_shape_;
+    std::vector<std::string> cli_dim_values_;
     std::string cli_output_range_;
 
     bool swapRB_ = false;
@@ -24,7 +24,7 @@ using namespace nncase::schedule;
 using namespace nncase::runtime;
 
 model_builder::model_builder(target &target, const schedule::model_schedule_result &sched)
-    : target_(target), sched_(sched), dump_asm_(false)
+    : target_(target), sched_(sched), dump_asm_(false), compression_(0)
 {
 }
 
@@ -34,6 +34,11 @@ void model_builder::config_dump(const std::filesystem::path &dump_dir, bool dump
     dump_asm_ = dump_asm;
 }
 
+void model_builder::config_compression(uint32_t compression)
+{
+    compression_ = compression;
+}
+
 build_model_result model_builder::build(std::ostream &output)
 {
     binary_writer writer(output);
@@ -46,18 +51,26 @@ build_model_result model_builder::build(std::ostream &output)
     header.flags = 0;
     header.alignment = 8;
     header.modules = (uint32_t)sched_.modules.size();
+    if (!sched_.entry_variants.empty())
+    {
+        header.flags |= MODEL_HAS_ENTRY_VARIANTS;
+        header.header_size += (uint32_t)(sizeof(uint32_t) * (1 + sched_.entry_variants.size()));
+    }
 
     // Skip model header
     auto header_pos = writer.position();
-    writer.skip(sizeof(header));
+    writer.skip(header.header_size);
 
     for (auto &mod_sched : sched_.modules)
     {
         module_builder_params params { sched_, mod_sched };
         auto builder = target_.create_module_builder(mod_sched.type, mod_sched.type.data(), params);
         builder->config_dump(dump_dir_ / mod_sched.type.data(), dump_asm_);
+        builder->config_compression(compression_);
         builder->build(writer);
         header.alignment = std::max(header.alignment, builder->alignment());
+        if (builder->has_compressed_sections())
+            header.flags |= MODEL_HAS_COMPRESSED_SECTIONS;
     }
 
     // Entry point
@@ -78,6 +91,13 @@ build_model_result model_builder::build(std::ostream &output)
     // header
     writer.position(header_pos);
     writer.write(header);
+    if (!sched_.entry_variants.empty())
+    {
+        auto &entry_functions = sched_.modules[header.entry_module].functions;
+        writer.write((uint32_t)sched_.entry_variants.size());
+        for (auto variant : sched_.entry_variants)
+            writer.write((uint32_t)(variant - entry_functions.data()));
+    }
     writer.position(end_pos);
 
     build_model_result result;
@@ -89,21 +109,28 @@ size_t model_builder::max_usage(memory_location_t location) const
 {
     size_t usage = 0;
 
-    if (location == mem_input)
-    {
-        // Only take into account of main function's inputs
-        auto graph = sched_.entry_function->graph;
-        auto &entry_in_allocs = sched_.entry_function->module->allocations;
-        for (auto in : graph->inputs())
-            usage += entry_in_allocs.at(&in->output()).size;
-    }
-    else if (location == mem_output)
+    if (location == mem_input || location == mem_output)
     {
-        // Only take into account of main function's outputs
-        auto graph = sched_.entry_function->graph;
-        auto &entry_out_allocs = sched_.entry_function->module->allocations;
-        for (auto out : graph->outputs())
-            usage += entry_out_allocs.at(out->input().connection()).size;
+        // Only take into account of main function's inputs and outputs, the largest if there are variants
+        std::span<function_schedule_result *const> entries(&sched_.entry_function, 1);
+        if (!sched_.entry_variants.empty())
+            entries = sched_.entry_variants;
+        for (auto entry : entries)
+        {
+            size_t entry_usage = 0;
+            auto &entry_allocs = entry->module->allocations;
+            if (location == mem_input)
+            {
+                for (auto in : entry->graph->inputs())
+                    entry_usage += entry_allocs.at(&in->output()).size;
+            }
+            else
+            {
+                for (auto out : entry->graph->outputs())
+                    entry_usage += entry_allocs.at(out->input().connection()).size;
+            }
+            usage = std::max(usage, entry_usage);
+        }
     }
     else if (location != mem_shared_data)
     {
@@ -125,3 +152,16 @@ size_t model_builder::max_usage(memory_location_t location) const
 
     return usage;
 }
+
+size_t model_builder::deduplicated_bytes(memory_location_t location) const
+{
+    size_t bytes = 0;
+    for (auto &mod : sched_.modules)
+    {
+        auto it = mod.deduplicated_bytes.find(location);
+        if (it != mod.deduplicated_bytes.end())
+            bytes += it->second;
+    }
+
+    return bytes;
+}
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include <fstream>
+#include <lz4hc.h>
 #include <nncase/codegen/module_builder.h>
 #include <nncase/io_utils.h>
 #include <nncase/ir/debug.h>
@@ -25,6 +26,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <zstd.h>
 
 using namespace nncase;
 using namespace nncase::codegen;
@@ -35,10 +37,38 @@ using namespace nncase::runtime;
 namespace
 {
 std::unordered_set<node_opcode> non_runtime_opcodes { op_input_node, op_output_node, op_uninitialized, op_ignore_node, op_constant };
+
+std::vector<uint8_t> compress_section(uint32_t compression, std::span<const uint8_t> body)
+{
+    std::vector<uint8_t> compressed;
+    if (compression == SECTION_COMPRESSED_LZ4)
+    {
+        if (body.size() > LZ4_MAX_INPUT_SIZE)
+            return {};
+        compressed.resize(LZ4_compressBound((int)body.size()));
+        auto size = LZ4_compress_HC(reinterpret_cast<const char *>(body.data()), reinterpret_cast<char *>(compressed.data()),
+            (int)body.size(), (int)compressed.size(), LZ4HC_CLEVEL_DEFAULT);
+        compressed.resize(size);
+    }
+    else if (compression == SECTION_COMPRESSED_ZSTD)
+    {
+        compressed.resize(ZSTD_compressBound(body.size()));
+        auto size = ZSTD_compress(compressed.data(), compressed.size(), body.data(), body.size(), 19);
+        if (ZSTD_isError(size))
+            throw std::runtime_error(std::string("Failed to compress section: ") + ZSTD_getErrorName(size));
+        compressed.resize(size);
+    }
+    else
+    {
+        throw std::invalid_argument("Unsupported section compression: " + std::to_string(compression));
+    }
+
+    return compressed;
+}
 }
 
 module_builder::module_builder(uint32_t alignment, std::string_view module_name, const module_builder_params &params)
-    : dump_asm_(false), alignment_(alignment), module_name_(module_name), params_(params)
+    : dump_asm_(false), alignment_(alignment), compression_(0), has_compressed_sections_(false), module_name_(module_name), params_(params)
 {
 }
 
@@ -52,6 +82,11 @@ void module_builder::config_dump(const std::filesystem::path &dump_dir, bool dum
     }
 }
 
+void module_builder::config_compression(uint32_t compression)
+{
+    compression_ = compression;
+}
+
 const schedule::buffer_allocation &module_builder::allocation(ir::output_connector &conn) const
 {
     return params_.module_sched.allocations.at(&conn);
@@ -345,11 +380,27 @@ void module_builder::write_binary(binary_writer &writer)
         strncpy(header.name, section.first.c_str(), std::size(header.name) - 1);
 
         auto merge_it = rdata_section_merges_.find(section.first);
+        std::span<const uint8_t> body = section.second.body;
+        std::vector<uint8_t> compressed;
         if (merge_it == rdata_section_merges_.end())
         {
             header.flags = 0;
             header.body_start = 0;
-            header.body_size = (uint32_t)section.second.body.size();
+
+            // kept as is unless compression makes it smaller
+            if (compression_ && !body.empty())
+            {
+                compressed = compress_section(compression_, body);
+                if (!compressed.empty() && compressed.size() < body.size())
+                {
+                    header.flags = compression_;
+                    header.uncompressed_size = (uint32_t)body.size();
+                    body = compressed;
+                    has_compressed_sections_ = true;
+                }
+            }
+
+            header.body_size = (uint32_t)body.size();
         }
         else
         {
@@ -366,7 +417,7 @@ void module_builder::write_binary(binary_writer &writer)
         {
             header.body_start = (uint32_t)writer.align_position(alignment_);
             // write content
-            writer.write_array(std::span<uint8_t const>(section.second.body));
+            writer.write_array(body);
         }
 
         // write section header
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "module_builder.h"
+#include <nncase/ir/visitor.h>
 #include <nncase/runtime/stackvm/opcode.h>
 #include <nncase/runtime/stackvm/runtime_module.h>
 
@@ -49,18 +50,98 @@ section_writer &stackvm_module_builder::text_writer()
     return writer(".text");
 }
 
-void stackvm_module_builder::begin_emit_function([[maybe_unused]] const schedule::function_schedule_result &function)
+void stackvm_module_builder::begin_emit_function(const schedule::function_schedule_result &function)
 {
     set_current_entry_point(text_writer().position());
+    compute_output_masks(function);
 }
 
 void stackvm_module_builder::end_emit_function([[maybe_unused]] const schedule::function_schedule_result &function)
 {
+    end_output_guard();
     set_current_function_text_end(text_writer().position());
 }
 
+void stackvm_module_builder::compute_output_masks(const schedule::function_schedule_result &function)
+{
+    output_masks_.clear();
+
+    // Same order as the outputs in the function header
+    std::vector<output_node *> outputs;
+    for (auto node : function.compute_sequence)
+    {
+        if (auto out = node_cast<output_node>(*node))
+            outputs.emplace_back(out);
+    }
+
+    if (outputs.size() < 2)
+        return;
+
+    const auto words = (outputs.size() + 31) / 32;
+    if (words > std::numeric_limits<uint8_t>::max())
+        return;
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        std::vector<ir::node *> stack { outputs[i] };
+        while (!stack.empty())
+        {
+            auto n = stack.back();
+            stack.pop_back();
+            auto &mask = output_masks_[n];
+            if (mask.empty())
+                mask.resize(words);
+            if (mask[i / 32] & (1u << (i % 32)))
+                continue;
+
+            mask[i / 32] |= 1u << (i % 32);
+            for (auto in : n->inputs())
+                stack.emplace_back(&in->connection()->owner());
+        }
+    }
+
+    // Nodes feeding every output are never skipped
+    output_mask_t all(words);
+    for (size_t i = 0; i < outputs.size(); i++)
+        all[i / 32] |= 1u << (i % 32);
+    std::erase_if(output_masks_, [&](auto &p) { return p.second == all; });
+}
+
+void stackvm_module_builder::begin_output_guard(ir::node &node, const output_mask_t &mask)
+{
+    stackvm_op_builder builder(node, text_writer());
+    for (auto word : mask)
+        builder.ldc_i4_((int32_t)word);
+    guard_pos_ = text_writer().position();
+    builder.br_unused_((uint8_t)mask.size(), 0);
+    guard_end_ = text_writer().position();
+    guard_mask_ = mask;
+}
+
+void stackvm_module_builder::end_output_guard()
+{
+    if (!guard_mask_)
+        return;
+
+    // Patch the branch to jump over the guarded ops
+    auto &writer = text_writer();
+    auto end_pos = writer.position();
+    writer.position(guard_pos_);
+    auto target = (int32_t)(end_pos - guard_end_);
+    op_writer<br_unused_op_t>()(br_unused_op_t((uint8_t)guard_mask_->size(), target), writer);
+    writer.position(end_pos);
+    guard_mask_.reset();
+}
+
 void stackvm_module_builder::emit(ir::node &node)
 {
+    // Consecutive ops feeding the same outputs share one guard
+    auto mask_it = output_masks_.find(&node);
+    if (guard_mask_ && (mask_it == output_masks_.end() || mask_it->second != *guard_mask_))
+        end_output_guard();
+    if (!guard_mask_ && mask_it != output_masks_.end())
+        begin_output_guard(node, mask_it->second);
+
     stackvm_op_builder builder(node, text_writer());
 #define DEFINE_OP(op)                          \
     if (node.runtime_opcode() == op::opcode()) \
@@ -22,16 +22,21 @@
 #include <nncase/ir/ops/compare.h>
 #include <nncase/ir/ops/compress.h>
 #include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_chain.h>
+#include <nncase/ir/ops/conv2d_nhwc.h>
+#include <nncase/ir/ops/conv2d_transpose.h>
 #include <nncase/ir/ops/convert.h>
 #include <nncase/ir/ops/copy.h>
 #include <nncase/ir/ops/cumsum.h>
 #include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/fused_elementwise.h>
 #include <nncase/ir/ops/gather.h>
 #include <nncase/ir/ops/gather_elements.h>
 #include <nncase/ir/ops/gather_nd.h>
 #include <nncase/ir/ops/gru.h>
 #include <nncase/ir/ops/hardmax.h>
 #include <nncase/ir/ops/layernorm.h>
+#include <nncase/ir/ops/lstm.h>
 #include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/onehot.h>
 #include <nncase/ir/ops/pad.h>
@@ -42,7 +47,9 @@
 #include <nncase/ir/ops/reduce_arg.h>
 #include <nncase/ir/ops/reduce_prod.h>
 #include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/ops/reduce_window2d_nhwc.h>
 #include <nncase/ir/ops/resize_image.h>
+#include <nncase/ir/ops/resize_image_nhwc.h>
 #include <nncase/ir/ops/roi_align.h>
 #include <nncase/ir/ops/sigmoid.h>
 #include <nncase/ir/ops/slice.h>
@@ -57,6 +64,8 @@
 #include <nncase/ir/ops/unary.h>
 #include <nncase/ir/placeholders.h>
 #include <nncase/schedule/scheduler.h>
+#include <optional>
+#include <unordered_map>
 
 namespace nncase::codegen::stackvm
 {
@@ -89,6 +98,18 @@ protected:
     void emit(ir::node &node) override;
 
 private:
+    // Output masks of the nodes feeding only some outputs of the function, a bit for every output they feed
+    using output_mask_t = std::vector<uint32_t>;
+
+    void compute_output_masks(const schedule::function_schedule_result &function);
+    void begin_output_guard(ir::node &node, const output_mask_t &mask);
+    void end_output_guard();
+
+    std::unordered_map<ir::node *, output_mask_t> output_masks_;
+    std::optional<output_mask_t> guard_mask_;
+    std::streampos guard_pos_;
+    std::streampos guard_end_;
+
 #define DEFINE_OP(op_) void emit(ir::op_ &op, stackvm_op_builder &builder);
 #include "ops.def"
 #undef DEFINE_OP
@@ -73,6 +73,11 @@ void op_builder::break_()
     op_writer<break_op_t>()(break_op_t(), writer_);
 }
 
+void op_builder::br_unused_(uint8_t masks, int32_t target)
+{
+    op_writer<br_unused_op_t>()(br_unused_op_t(masks, target), writer_);
+}
+
 void op_builder::ldc_i4_(int32_t imm)
 {
     op_writer<ldc_i4_op_t>()(ldc_i4_op_t(imm), writer_);
@@ -523,9 +528,14 @@ void op_builder::tensor_compare_(datatype_t datatype, uint8_t rshape_src1, uint8
     op_writer<tensor_compare_op_t>()(tensor_compare_op_t(datatype, rshape_src1, rstride_src1, rshape_src2, rstride_src2, rshape_dest, rstride_dest, compare_op), writer_);
 }
 
-void op_builder::tensor_conv2d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high)
+void op_builder::tensor_conv2d_(datatype_t datatype, datatype_t w_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high)
+{
+    op_writer<tensor_conv2d_op_t>()(tensor_conv2d_op_t(datatype, w_datatype, rshape_src, rstride_src, rshape_kernel, rstride_kernel, rstride_bias, rstride_dest, groups, stride_h, stride_w, dilation_h, dilation_w, fused_clamp_low, fused_clamp_high), writer_);
+}
+
+void op_builder::tensor_conv2d_transpose_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rshape_dest, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high)
 {
-    op_writer<tensor_conv2d_op_t>()(tensor_conv2d_op_t(datatype, rshape_src, rstride_src, rshape_kernel, rstride_kernel, rstride_bias, rstride_dest, groups, stride_h, stride_w, dilation_h, dilation_w, fused_clamp_low, fused_clamp_high), writer_);
+    op_writer<tensor_conv2d_transpose_op_t>()(tensor_conv2d_transpose_op_t(datatype, rshape_src, rstride_src, rshape_kernel, rstride_kernel, rstride_bias, rshape_dest, rstride_dest, groups, stride_h, stride_w, dilation_h, dilation_w, fused_clamp_low, fused_clamp_high), writer_);
 }
 
 void op_builder::tensor_copy_(datatype_t datatype, uint8_t rshape, uint8_t rstride_src, uint8_t rstride_dest)
@@ -568,9 +578,9 @@ void op_builder::tensor_lut1d_(datatype_t datatype, uint8_t rshape_src, uint8_t
     op_writer<tensor_lut1d_op_t>()(tensor_lut1d_op_t(datatype, rshape_src, rstride_src, rstride_dest, table_len), writer_);
 }
 
-void op_builder::tensor_matmul_(uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, float fused_clamp_low, float fused_clamp_high)
+void op_builder::tensor_matmul_(datatype_t w_datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_dest, uint8_t rstride_dest, float fused_clamp_low, float fused_clamp_high)
 {
-    op_writer<tensor_matmul_op_t>()(tensor_matmul_op_t(rshape_src1, rstride_src1, rshape_src2, rstride_src2, rshape_dest, rstride_dest, fused_clamp_low, fused_clamp_high), writer_);
+    op_writer<tensor_matmul_op_t>()(tensor_matmul_op_t(w_datatype, rshape_src1, rstride_src1, rshape_src2, rstride_src2, rshape_dest, rstride_dest, fused_clamp_low, fused_clamp_high), writer_);
 }
 
 void op_builder::tensor_onehot_(datatype_t datatype, uint8_t rshape_indices, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t axis, onehot_mode_t onehot_mode)
@@ -697,3 +707,18 @@ void op_builder::tensor_gather_elements_(uint8_t input_shape_src, uint8_t indice
 {
     op_writer<tensor_gather_elements_op_t>()(tensor_gather_elements_op_t(input_shape_src, indices_shape_src, axis), writer_);
 }
+
+void op_builder::tensor_lstm_(uint8_t input_shape_src, uint8_t initial_h_shape_src, uint8_t w_shape_src, uint8_t b_shape_src, uint8_t sequence_lens_src, uint8_t direction, uint8_t framework)
+{
+    op_writer<tensor_lstm_op_t>()(tensor_lstm_op_t(input_shape_src, initial_h_shape_src, w_shape_src, b_shape_src, sequence_lens_src, direction, framework), writer_);
+}
+
+void op_builder::tensor_conv2d_chain_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rstage_src, uint8_t rpad_src, uint8_t stages, uint16_t tile_h)
+{
+    op_writer<tensor_conv2d_chain_op_t>()(tensor_conv2d_chain_op_t(datatype, rshape_src, rstride_src, rstride_dest, rstage_src, rpad_src, stages, tile_h), writer_);
+}
+
+void op_builder::tensor_fused_elementwise_(datatype_t datatype, uint8_t rshape_dest, uint8_t rstride_dest, uint8_t rshape_src, uint8_t inputs, uint16_t body_size, gsl::span<const gsl::byte> body)
+{
+    op_writer<tensor_fused_elementwise_op_t>()(tensor_fused_elementwise_op_t(datatype, rshape_dest, rstride_dest, rshape_src, inputs, body_size, body), writer_);
+}
@@ -38,6 +38,6 @@ void stackvm_module_builder::emit(conv2d &node, stackvm_op_builder &builder)
     builder.stshape(3, weights.strides);
     builder.stshape(4, bias.strides);
     builder.stshape(5, output.strides);
-    builder.tensor_conv2d_(node.input().type(), 0, 1, 2, 3, 4, 5, (uint16_t)node.groups(), (uint16_t)node.stride_h(), (uint16_t)node.stride_w(),
+    builder.tensor_conv2d_(node.input().type(), node.weights().type(), 0, 1, 2, 3, 4, 5, (uint16_t)node.groups(), (uint16_t)node.stride_h(), (uint16_t)node.stride_w(),
         (uint16_t)node.dilation_h(), (uint16_t)node.dilation_w(), node.fused_activation().min, node.fused_activation().max);
 }
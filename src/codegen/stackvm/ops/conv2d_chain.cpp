@@ -0,0 +1,58 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../module_builder.h"
+
+using namespace nncase;
+using namespace nncase::codegen;
+using namespace nncase::codegen::stackvm;
+using namespace nncase::ir;
+
+void stackvm_module_builder::emit(conv2d_chain &node, stackvm_op_builder &builder)
+{
+    auto &input = allocation(node.input());
+    auto &output = allocation(node.output());
+    builder.lea_buffer(input);
+    builder.lea_buffer(output);
+
+    builder.stshape(0, input.shape);
+    builder.stshape(1, input.strides);
+    builder.stshape(2, output.strides);
+
+    auto &stages = node.stages();
+    for (size_t i = 0; i < stages.size(); i++)
+    {
+        auto &stage = stages[i];
+        if (stage.is_conv2d)
+        {
+            builder.lea_buffer(allocation(node.weights(i)));
+            builder.lea_buffer(allocation(node.bias(i)));
+        }
+        else
+        {
+            builder.ldnull_();
+            builder.ldnull_();
+        }
+
+        builder.ldc_r4_(stage.init_value);
+        builder.ldc_r4_(stage.fused_activation.min);
+        builder.ldc_r4_(stage.fused_activation.max);
+
+        builder.stshape((uint8_t)(3 + i * 2), stage.weights_shape);
+        builder.staxis((uint8_t)(4 + i * 2), axis_t { stage.groups, stage.stride_h, stage.stride_w, stage.dilation_h, stage.dilation_w, (int32_t)stage.reduce_op });
+        builder.stpaddings((uint8_t)i, std::vector<padding> { stage.padding_h, stage.padding_w });
+    }
+
+    builder.tensor_conv2d_chain_(node.input().type(), 0, 1, 2, 3, 0, (uint8_t)stages.size(), (uint16_t)node.tile_h());
+}
@@ -0,0 +1,50 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../module_builder.h"
+#include <sstream>
+
+using namespace nncase;
+using namespace nncase::codegen;
+using namespace nncase::codegen::stackvm;
+using namespace nncase::ir;
+
+void stackvm_module_builder::emit(fused_elementwise &node, stackvm_op_builder &builder)
+{
+    std::stringstream ss;
+    {
+        binary_writer bw(ss);
+        nnil_builder nnil(bw);
+        fused_elementwise::compile_graph(node.subgraph(), nnil);
+    }
+
+    auto body = ss.str();
+    if (body.size() > std::numeric_limits<uint16_t>::max())
+        throw std::runtime_error("Fused elementwise body of " + node.name() + " is too large");
+
+    auto &output = allocation(node.output());
+    builder.stshape(0, output.shape);
+    builder.stshape(1, output.strides);
+    for (size_t i = 0; i < node.inputs().size(); i++)
+    {
+        auto &input = allocation(node.input_at(i));
+        builder.lea_buffer(input);
+        builder.stshape((uint8_t)(2 + i * 2), input.shape);
+        builder.stshape((uint8_t)(3 + i * 2), input.strides);
+    }
+
+    builder.lea_buffer(output);
+    builder.tensor_fused_elementwise_(dt_float32, 0, 1, 2, (uint8_t)node.inputs().size(), (uint16_t)body.size(),
+        gsl::span<const gsl::byte>(reinterpret_cast<const gsl::byte *>(body.data()), body.size()));
+}
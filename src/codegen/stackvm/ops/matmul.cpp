@@ -37,5 +37,5 @@ void stackvm_module_builder::emit(matmul &node, stackvm_op_builder &builder)
     builder.stshape(4, output.shape);
     builder.stshape(5, output.strides);
 
-    builder.tensor_matmul_(0, 1, 2, 3, 4, 5, node.fused_activation().min, node.fused_activation().max);
+    builder.tensor_matmul_(node.input_b().type(), 0, 1, 2, 3, 4, 5, node.fused_activation().min, node.fused_activation().max);
 }
@@ -24,10 +24,13 @@
 #include <nncase/ir/ops/compress.h>
 #include <nncase/ir/ops/concat.h>
 #include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_chain.h>
+#include <nncase/ir/ops/conv2d_nhwc.h>
 #include <nncase/ir/ops/conv2d_transpose.h>
 #include <nncase/ir/ops/convert.h>
 #include <nncase/ir/ops/cumsum.h>
 #include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/fused_elementwise.h>
 #include <nncase/ir/ops/fused_unary.h>
 #include <nncase/ir/ops/gather.h>
 #include <nncase/ir/ops/gather_elements.h>
@@ -35,6 +38,7 @@
 #include <nncase/ir/ops/gru.h>
 #include <nncase/ir/ops/hardmax.h>
 #include <nncase/ir/ops/layernorm.h>
+#include <nncase/ir/ops/lstm.h>
 #include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/onehot.h>
 #include <nncase/ir/ops/pad.h>
@@ -45,7 +49,9 @@
 #include <nncase/ir/ops/reduce_arg.h>
 #include <nncase/ir/ops/reduce_prod.h>
 #include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/ops/reduce_window2d_nhwc.h>
 #include <nncase/ir/ops/resize_image.h>
+#include <nncase/ir/ops/resize_image_nhwc.h>
 #include <nncase/ir/ops/roi_align.h>
 #include <nncase/ir/ops/sigmoid.h>
 #include <nncase/ir/ops/slice.h>
@@ -93,6 +99,26 @@ namespace
 void nop_evaluator(ir::node &, function_evaluate_context &)
 {
 }
+
+// Calls f with the weights typed by their storage datatype
+template <class F>
+void visit_weights(evaluate_tensor &weights, F &&f)
+{
+    switch (weights.datatype())
+    {
+    case dt_float32:
+        f(weights.buffer().as_span<float>().data());
+        break;
+    case dt_float16:
+        f(weights.buffer().as_span<half>().data());
+        break;
+    case dt_bfloat16:
+        f(weights.buffer().as_span<bfloat16>().data());
+        break;
+    default:
+        throw std::runtime_error("Not supported weights type");
+    }
+}
 }
 
 namespace nncase::ir
@@ -185,27 +211,86 @@ void register_neutral_evaluators()
         auto bias = context.memory_at(rnode.bias());
         auto output = context.memory_at(rnode.output());
         auto input_mem = input.buffer().as_span<float>();
-        auto weights_mem = weights.buffer().as_span<float>();
         auto bias_mem = bias.buffer().as_span<float>();
         auto output_mem = output.buffer().as_span<float>();
 
-        kernels::conv2d(input_mem.data(), weights_mem.data(), bias_mem.data(), output_mem.data(), input.shape(), input.strides(),
-            weights.shape(), weights.strides(), bias.strides(), output.strides(), rnode.padding_h(), rnode.padding_w(),
-            rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
+        visit_weights(weights, [&](auto weights_ptr) {
+            kernels::conv2d(input_mem.data(), weights_ptr, bias_mem.data(), output_mem.data(), input.shape(), input.strides(),
+                weights.shape(), weights.strides(), bias.strides(), output.strides(), rnode.padding_h(), rnode.padding_w(),
+                rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
+                .unwrap_or_throw();
+        }); });
+
+    register_evaluator(op_conv2d_nhwc, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<conv2d_nhwc &>(node);
+
+        assert(rnode.input().type() == dt_float32);
+
+        auto input = context.memory_at(rnode.input());
+        auto weights = context.memory_at(rnode.weights());
+        auto bias = context.memory_at(rnode.bias());
+        auto output = context.memory_at(rnode.output());
+        auto input_mem = input.buffer().as_span<float>();
+        auto bias_mem = bias.buffer().as_span<float>();
+        auto output_mem = output.buffer().as_span<float>();
+
+        visit_weights(weights, [&](auto weights_ptr) {
+            kernels::conv2d(input_mem.data(), weights_ptr, bias_mem.data(), output_mem.data(), nhwc_as_nchw(input.shape()), nhwc_as_nchw(input.strides()),
+                hwio_as_oihw(weights.shape()), hwio_as_oihw(weights.strides()), bias.strides(), nhwc_as_nchw(output.strides()), rnode.padding_h(), rnode.padding_w(),
+                rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
+                .unwrap_or_throw();
+        }); });
+
+    register_evaluator(op_conv2d_chain, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<conv2d_chain &>(node);
+
+        assert(rnode.input().type() == dt_float32);
+
+        auto input = context.memory_at(rnode.input());
+        auto output = context.memory_at(rnode.output());
+        std::vector<kernels::conv2d_chain_stage> stages;
+        for (size_t i = 0; i < rnode.stages().size(); i++)
+        {
+            auto &s = rnode.stages()[i];
+            kernels::conv2d_chain_stage stage {};
+            if (s.is_conv2d)
+            {
+                stage.weights = context.memory_at(rnode.weights(i)).buffer().as_span<float>().data();
+                stage.bias = context.memory_at(rnode.bias(i)).buffer().as_span<float>().data();
+            }
+
+            stage.w_shape = to(s.weights_shape);
+            stage.padding_h = s.padding_h;
+            stage.padding_w = s.padding_w;
+            stage.groups = s.groups;
+            stage.stride_h = s.stride_h;
+            stage.stride_w = s.stride_w;
+            stage.dilation_h = s.dilation_h;
+            stage.dilation_w = s.dilation_w;
+            stage.reduce_op = s.reduce_op;
+            stage.init_value = s.init_value;
+            stage.fused_activation = s.fused_activation;
+            stages.emplace_back(stage);
+        }
+
+        kernels::conv2d_chain(input.buffer().as_span<float>().data(), output.buffer().as_span<float>().data(), input.shape(), input.strides(),
+            output.strides(), stages, rnode.tile_h())
             .unwrap_or_throw(); });
 
     register_evaluator(op_conv2d_transpose, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<conv2d_transpose &>(node);
 
         assert(rnode.input().type() == dt_float32);
-        auto input = context.memory_at(rnode.input()).buffer().as_span<float>();
-        auto weights = context.memory_at(rnode.weights()).buffer().as_span<float>();
-        auto bias = context.memory_at(rnode.bias()).buffer().as_span<float>();
-        auto output = context.memory_at(rnode.output()).buffer().as_span<float>();
 
-        neutral::conv2d_transpose(input.data(), output.data(), weights.data(), bias.data(), to(rnode.input().shape()),
-            rnode.groups(), to(rnode.output().shape()), rnode.filter_h(), rnode.filter_w(), rnode.stride_h(), rnode.stride_w(),
-            rnode.dilation_h(), rnode.dilation_w(), rnode.padding_h(), rnode.padding_w(), rnode.fused_activation()); });
+        auto input = context.memory_at(rnode.input());
+        auto weights = context.memory_at(rnode.weights());
+        auto bias = context.memory_at(rnode.bias());
+        auto output = context.memory_at(rnode.output());
+        kernels::conv2d_transpose(input.buffer().as_span<float>().data(), weights.buffer().as_span<float>().data(), bias.buffer().as_span<float>().data(),
+            output.buffer().as_span<float>().data(), input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), output.shape(),
+            output.strides(), rnode.padding_h(), rnode.padding_w(), rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(),
+            rnode.dilation_w(), rnode.fused_activation())
+            .unwrap_or_throw(); });
 
     register_evaluator(op_dequantize, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<dequantize &>(node);
@@ -286,23 +371,49 @@ void register_neutral_evaluators()
         kernels::nnil_unary_method(input.data(), output.data(), input.size(), body)
             .unwrap_or_throw(); });
 
+    register_evaluator(op_fused_elementwise, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<fused_elementwise &>(node);
+
+        std::vector<const float *> inputs;
+        std::vector<runtime_shape_t> in_shapes, in_strides;
+        for (auto in : rnode.inputs())
+        {
+            auto input = context.memory_at(*in);
+            inputs.emplace_back(input.buffer().as_span<float>().data());
+            in_shapes.emplace_back(input.shape());
+            in_strides.emplace_back(input.strides());
+        }
+
+        auto output = context.memory_at(rnode.output());
+
+        using namespace nncase::codegen;
+        std::stringstream ss;
+        binary_writer bw(ss);
+        nnil_builder builder(bw);
+
+        fused_elementwise::compile_graph(rnode.subgraph(), builder);
+        auto buf = ss.str();
+        std::vector<gsl::byte> body(reinterpret_cast<gsl::byte *>(buf.data()), reinterpret_cast<gsl::byte *>(buf.data() + buf.size()));
+        kernels::nnil_elementwise(inputs, in_shapes, in_strides, output.buffer().as_span<float>().data(), output.shape(), output.strides(), body)
+            .unwrap_or_throw(); });
+
     register_evaluator(op_matmul, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<matmul &>(node);
 
         assert(rnode.input_a().type() == dt_float32);
-        assert(rnode.input_b().type() == dt_float32);
         auto input_a = context.memory_at(rnode.input_a());
         auto input_b = context.memory_at(rnode.input_b());
         auto bias = context.memory_at(rnode.bias());
         auto output = context.memory_at(rnode.output());
         auto input_a_mem = input_a.buffer().as_span<float>();
-        auto input_b_mem = input_b.buffer().as_span<float>();
         auto bias_mem = bias.buffer().as_span<float>();
         auto output_mem = output.buffer().as_span<float>();
 
-        kernels::matmul(input_a_mem.data(), input_b_mem.data(), bias_mem.data(), output_mem.data(), input_a.shape(), input_a.strides(),
-            input_b.shape(), input_b.strides(), output.shape(), output.strides(), rnode.fused_activation())
-            .unwrap_or_throw(); });
+        visit_weights(input_b, [&](auto input_b_ptr) {
+            kernels::matmul(input_a_mem.data(), input_b_ptr, bias_mem.data(), output_mem.data(), input_a.shape(), input_a.strides(),
+                input_b.shape(), input_b.strides(), output.shape(), output.strides(), rnode.fused_activation())
+                .unwrap_or_throw();
+        }); });
 
     register_evaluator(op_pad, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<pad &>(node);
@@ -425,6 +536,20 @@ void register_neutral_evaluators()
             rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
             .unwrap_or_throw(); });
 
+    register_evaluator(op_reduce_window2d_nhwc, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<reduce_window2d_nhwc &>(node);
+
+        assert(rnode.input().type() == dt_float32);
+        auto input = context.memory_at(rnode.input());
+        auto output = context.memory_at(rnode.output());
+        auto input_mem = input.buffer().as_span<float>();
+        auto output_mem = output.buffer().as_span<float>();
+
+        kernels::reduce_window2d(rnode.reduce_op(), input_mem.data(), rnode.init_value(), output_mem.data(),
+            nhwc_as_nchw(input.shape()), nhwc_as_nchw(input.strides()), nhwc_as_nchw(output.strides()), rnode.padding_h(), rnode.padding_w(),
+            rnode.filter_h(), rnode.filter_w(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
+            .unwrap_or_throw(); });
+
     register_evaluator(op_bitcast, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<bitcast &>(node);
 
@@ -456,6 +581,28 @@ void register_neutral_evaluators()
                 .unwrap_or_throw();
         } });
 
+    register_evaluator(op_resize_image_nhwc, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<resize_image_nhwc &>(node);
+
+        auto input = context.memory_at(rnode.input());
+        auto output = context.memory_at(rnode.output());
+        auto input_data = input.buffer().data();
+        auto output_data = output.buffer().data();
+        auto new_size = rnode.new_size();
+        auto in_shape = nhwc_as_nchw(input.shape()), in_strides = nhwc_as_nchw(input.strides()), out_strides = nhwc_as_nchw(output.strides());
+        if (rnode.mode() == image_resize_bilinear)
+        {
+            kernels::resize_bilinear(input.datatype(), input_data, output_data,
+                in_shape, in_strides, out_strides, new_size[0], new_size[1], rnode.align_corners(), rnode.half_pixel_centers())
+                .unwrap_or_throw();
+        }
+        else
+        {
+            kernels::resize_nearest_neighbor(input.datatype(), input_data, output_data,
+                in_shape, in_strides, out_strides, new_size[0], new_size[1], rnode.align_corners(), rnode.half_pixel_centers())
+                .unwrap_or_throw();
+        } });
+
     register_evaluator(op_roi_align, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<roi_align &>(node);
 
@@ -851,6 +998,24 @@ void register_neutral_evaluators()
             input.shape(), W.shape(), rnode.direction(), rnode.linear_before_reset())
             .unwrap_or_throw(); });
 
+    register_evaluator(op_lstm, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<lstm &>(node);
+        auto input = context.memory_at(rnode.input());
+        auto W = context.memory_at(rnode.w());
+        auto R = context.memory_at(rnode.r());
+        auto B = context.memory_at(rnode.b());
+        auto initial_h = context.memory_at(rnode.initial_h());
+        auto initial_c = context.memory_at(rnode.initial_c());
+        auto output = context.memory_at(rnode.output());
+        auto output_h = context.memory_at(rnode.output_h());
+        auto output_c = context.memory_at(rnode.output_c());
+        runtime_shape_t sequence_lens { rnode.sequence_lens().begin(), rnode.sequence_lens().end() };
+        kernels::lstm(input.buffer().as_span<float>().data(), W.buffer().as_span<float>().data(), R.buffer().as_span<float>().data(),
+            B.buffer().as_span<float>().data(), initial_h.buffer().as_span<float>().data(), initial_c.buffer().as_span<float>().data(),
+            output.buffer().as_span<float>().data(), output_h.buffer().as_span<float>().data(), output_c.buffer().as_span<float>().data(),
+            input.shape(), initial_h.shape(), W.shape(), B.shape(), sequence_lens, rnode.direction(), rnode.framework() == "caffe" ? kCaffe : kOnnx)
+            .unwrap_or_throw(); });
+
     register_evaluator(op_tflite_detection_postprocess, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<tflite_detection_postprocess &>(node);
         auto box = context.memory_at(rnode.boxes());
@@ -91,7 +91,7 @@ DEFINE_CAFFE_LOWER(LSTM)
         auto in_shape = rshape->output().shape();
         shape_t output_shape { in_shape[0], in_shape[1], n_output };
         auto node = graph_.emplace<lstm>(rshape->output().shape(), w_xc_shape, w_rc_shape, bias_shape, output_shape,
-            init_h->output().shape(), init_c->output().shape(), has_static, direction, "caffe");
+            init_h->output().shape(), init_c->output().shape(), has_static, direction, "caffe", shape_t {});
 
         node->name(op.name() + "/lstm");
         input_tensors_.emplace(&rshape->input(), input_name);
@@ -128,7 +128,7 @@ DEFINE_CAFFE_LOWER(LSTM)
         auto in_shape = input.shape();
         shape_t output_shape { in_shape[0], in_shape[1], n_output };
         auto node = graph_.emplace<lstm>(input.shape(), w_xc_shape, w_rc_shape, bias_shape, output_shape,
-            init_h->output().shape(), init_c->output().shape(), has_static, direction, "caffe");
+            init_h->output().shape(), init_c->output().shape(), has_static, direction, "caffe", shape_t {});
         node->name(op.name() + "/lstm");
         input_tensors_.emplace(&node->input(), input_name);
 
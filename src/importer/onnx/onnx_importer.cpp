@@ -117,6 +117,7 @@ void onnx_importer::import(const struct import_options &options, std::string &re
 {
     for (auto &opset : model_.opset_import())
         opset_map_.emplace(opset.domain(), opset.version());
+    dim_values_ = options.dim_values;
 
     const auto &graph = model_.graph();
 
@@ -265,7 +266,7 @@ shape_t onnx_importer::get_shape(const string &value) const
     throw std::runtime_error("Can't find value info for " + value + " to parse its shape");
 }
 
-shape_t onnx_importer::get_shape(const ValueInfoProto &value_info)
+shape_t onnx_importer::get_shape(const ValueInfoProto &value_info) const
 {
     const auto &type = value_info.type();
     assert(type.value_case() == TypeProto::kTensorType);
@@ -282,8 +283,11 @@ shape_t onnx_importer::get_shape(const ValueInfoProto &value_info)
             break;
 
         case TensorShapeProto_Dimension::kDimParam:
-            result_shape.push_back(-1);
+        {
+            auto it = dim_values_.find(dim.dim_param());
+            result_shape.push_back(it != dim_values_.end() ? it->second : -1);
             break;
+        }
 
         case TensorShapeProto_Dimension::VALUE_NOT_SET:
             result_shape.push_back(-1);
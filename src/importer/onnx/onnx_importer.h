@@ -63,7 +63,7 @@ private:
 
     std::optional<onnx::ValueInfoProto> find_value_info(const std::string &value) const;
     nncase::ir::shape_t get_shape(const std::string &value) const;
-    static nncase::ir::shape_t get_shape(const onnx::ValueInfoProto &value);
+    nncase::ir::shape_t get_shape(const onnx::ValueInfoProto &value) const;
     static nncase::ir::shape_t get_shape(const onnx::TensorProto &value);
     std::optional<nncase::datatype_t> get_datatype(const std::string &value) const;
     static std::optional<nncase::datatype_t> get_datatype(const onnx::ValueInfoProto &value);
@@ -129,6 +129,7 @@ private:
     ir::graph &graph_;
     onnx::ModelProto model_;
     std::unordered_map<std::string, int64_t> opset_map_;
+    std::unordered_map<std::string, size_t> dim_values_;
     std::unordered_map<ir::input_connector *, std::string> input_tensors_;
     std::unordered_map<std::string, ir::output_connector *> output_tensors_;
     std::unordered_map<std::string, std::string> passthrough_connections_;
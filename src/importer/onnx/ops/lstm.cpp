@@ -14,6 +14,7 @@
  */
 
 #include "../onnx_importer.h"
+#include <algorithm>
 #include <cassert>
 #include <nncase/ir/graph.h>
 #include <nncase/ir/ops/bitcast.h>
@@ -64,10 +65,23 @@ void onnx_importer::convert_op_LSTM(const NodeProto &node)
         B = node.input()[3];
     }
 
-    // sequence_lens
-    // if (input_size >= 5)
-    // {
-    // }
+    // sequence_lens: kept as an attribute, so it must be a constant with one length in [1, seq_length] per batch.
+    // Lengths that all equal seq_length are dropped, the kernel then runs every batch over the whole sequence
+    shape_t sequence_lens;
+    if (input_size >= 5 && !node.input()[4].empty())
+    {
+        const auto &lens_name = node.input()[4];
+        if (!get_initializer(lens_name) && !get_constant_input_data<int32_t>(lens_name))
+            throw std::runtime_error("LSTM " + op_name + ": non-constant sequence_lens is not supported");
+
+        auto lens = get_constant_value<int32_t>(lens_name);
+        if (lens.size() != batch_size)
+            throw std::runtime_error("LSTM " + op_name + ": sequence_lens must have one length per batch");
+        if (std::any_of(lens.begin(), lens.end(), [=](int32_t len) { return len < 1 || (size_t)len > seq_length; }))
+            throw std::runtime_error("LSTM " + op_name + ": sequence_lens must be within [1, seq_length]");
+        if (std::any_of(lens.begin(), lens.end(), [=](int32_t len) { return (size_t)len != seq_length; }))
+            sequence_lens.assign(lens.begin(), lens.end());
+    }
 
     // initial_h
     std::string initial_h;
@@ -101,7 +115,7 @@ void onnx_importer::convert_op_LSTM(const NodeProto &node)
 
     shape_t output_shape { seq_length, num_directions, batch_size, hidden_size };
     auto lstm_node = graph_.emplace<lstm>(input_shape, W_shape, R_shape, B_shape, output_shape, initial_shape,
-        initial_shape, false, direction, "onnx");
+        initial_shape, false, direction, "onnx", sequence_lens);
     lstm_node->name(op_name);
 
     input_tensors_.emplace(&lstm_node->input_at(0), input);
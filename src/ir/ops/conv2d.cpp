@@ -18,11 +18,11 @@
 using namespace nncase;
 using namespace nncase::ir;
 
-conv2d::conv2d(shape_t input_shape, shape_t weighs_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation)
+conv2d::conv2d(shape_t input_shape, shape_t weighs_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, datatype_t weights_type)
     : groups_(groups), padding_h_(padding_h), padding_w_(padding_w), stride_h_(stride_h), stride_w_(stride_w), dilation_h_(dilation_h), dilation_w_(dilation_w), fused_activation_(fused_activation)
 {
     add_input("input", dt_float32, input_shape);
-    add_input("weights", dt_float32, weighs_shape);
+    add_input("weights", weights_type, weighs_shape);
     add_input("bias", dt_float32, shape_t { (size_t)output_channels() });
     add_output("output", dt_float32,
         shape_t {
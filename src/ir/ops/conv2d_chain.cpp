@@ -0,0 +1,76 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/conv2d_chain.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+bool conv2d_chain::stage::operator==(const stage &other) const noexcept
+{
+    return is_conv2d == other.is_conv2d && weights_shape == other.weights_shape && groups == other.groups
+        && padding_h == other.padding_h && padding_w == other.padding_w && stride_h == other.stride_h
+        && stride_w == other.stride_w && dilation_h == other.dilation_h && dilation_w == other.dilation_w
+        && reduce_op == other.reduce_op && init_value == other.init_value && fused_activation == other.fused_activation;
+}
+
+std::vector<shape_t> conv2d_chain::stage_shapes(const shape_t &input_shape, const std::vector<stage> &stages)
+{
+    std::vector<shape_t> shapes;
+    auto in_shape = input_shape;
+    for (auto &s : stages)
+    {
+        in_shape = shape_t {
+            in_shape[0],
+            s.weights_shape[0],
+            get_windowed_output_size((int32_t)in_shape[2] + s.padding_h.sum(), (int32_t)s.weights_shape[2], s.stride_h, s.dilation_h, false),
+            get_windowed_output_size((int32_t)in_shape[3] + s.padding_w.sum(), (int32_t)s.weights_shape[3], s.stride_w, s.dilation_w, false)
+        };
+        shapes.emplace_back(in_shape);
+    }
+
+    return shapes;
+}
+
+conv2d_chain::conv2d_chain(shape_t input_shape, std::vector<stage> stages, int32_t tile_h)
+    : stages_(std::move(stages)), tile_h_(tile_h)
+{
+    if (stages_.empty())
+        throw std::invalid_argument("conv2d_chain needs at least one stage");
+
+    add_input("input", dt_float32, input_shape);
+    for (size_t i = 0; i < stages_.size(); i++)
+    {
+        auto &s = stages_[i];
+        if (s.is_conv2d)
+        {
+            weights_input_ids_.emplace_back(inputs().size());
+            add_input("weights_" + std::to_string(i), dt_float32, s.weights_shape);
+            add_input("bias_" + std::to_string(i), dt_float32, shape_t { s.weights_shape[0] });
+        }
+        else
+        {
+            weights_input_ids_.emplace_back(SIZE_MAX);
+        }
+    }
+
+    add_output("output", dt_float32, stage_shapes(input_shape, stages_).back());
+}
+
+bool conv2d_chain::properties_equal(node &other) const
+{
+    auto &r = static_cast<conv2d_chain &>(other);
+    return stages() == r.stages() && tile_h() == r.tile_h();
+}
@@ -0,0 +1,126 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/fused_elementwise.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+std::vector<size_t> operands(const fused_unary_op &op)
+{
+    switch (op.opcode)
+    {
+    case fu_constant:
+    case fu_ldx:
+        return {};
+    case fu_identity:
+        return { op.identity.input.op_id };
+    case fu_unary:
+        return { op.unary.input.op_id };
+    case fu_binary:
+        return { op.binary.input_a.op_id, op.binary.input_b.op_id };
+    case fu_clamp:
+        return { op.clamp.input.op_id, op.clamp.low.op_id, op.clamp.high.op_id };
+    default:
+        throw std::invalid_argument("Invalid fused unary op");
+    }
+}
+
+// Emits the subgraph in post order and tracks which op each evaluation stack entry holds. nnil has no swap
+// or locals, so a value left below other entries can't be reached again. A shared value is dup'ed when it is
+// needed right after it was pushed, e.g. x * x or x * sigmoid(x), and recomputed otherwise
+class program_emitter
+{
+public:
+    program_emitter(const std::vector<fused_unary_op> &subgraph, codegen::nnil_builder *builder)
+        : subgraph_(subgraph), builder_(builder)
+    {
+    }
+
+    void emit(size_t id)
+    {
+        auto &op = subgraph_.at(id);
+        if (op.opcode == fu_identity)
+            return emit(op.identity.input.op_id);
+
+        if (!stack_.empty() && stack_.back() == id)
+        {
+            if (builder_)
+                builder_->emit_dup();
+        }
+        else
+        {
+            auto ops = operands(op);
+            for (auto operand : ops)
+                emit(operand);
+            if (builder_)
+                fused_unary::emit_op(op, *builder_);
+            stack_.resize(stack_.size() - ops.size());
+        }
+
+        stack_.emplace_back(id);
+        instructions_++;
+        depth_ = std::max(depth_, stack_.size());
+    }
+
+    size_t instructions() const noexcept { return instructions_; }
+    size_t depth() const noexcept { return depth_; }
+
+private:
+    const std::vector<fused_unary_op> &subgraph_;
+    codegen::nnil_builder *builder_;
+    std::vector<size_t> stack_;
+    size_t instructions_ = 0;
+    size_t depth_ = 0;
+};
+}
+
+void fused_elementwise::compile_graph(const std::vector<fused_unary_op> &subgraph, codegen::nnil_builder &builder)
+{
+    program_emitter(subgraph, &builder).emit(subgraph.size() - 1);
+    builder.emit_ret();
+}
+
+std::pair<size_t, size_t> fused_elementwise::program_size(const std::vector<fused_unary_op> &subgraph)
+{
+    program_emitter emitter(subgraph, nullptr);
+    emitter.emit(subgraph.size() - 1);
+    return { emitter.instructions(), emitter.depth() };
+}
+
+fused_elementwise::fused_elementwise(std::vector<fused_unary_op> subgraph, const std::vector<shape_t> &input_shapes, shape_t output_shape)
+    : subgraph_(std::move(subgraph))
+{
+    if (subgraph_.empty() || input_shapes.empty())
+        throw std::invalid_argument("fused_elementwise needs a subgraph and at least one input");
+
+    for (size_t i = 0; i < input_shapes.size(); i++)
+    {
+        if (get_binary_output_shape(input_shapes[i], output_shape) != output_shape)
+            throw std::invalid_argument("fused_elementwise input " + std::to_string(i) + " doesn't broadcast to the output");
+        add_input("input_" + std::to_string(i), dt_float32, input_shapes[i]);
+    }
+
+    add_output("output", dt_float32, output_shape);
+}
+
+bool fused_elementwise::properties_equal(node &other) const
+{
+    [[maybe_unused]] auto &r = static_cast<fused_elementwise &>(other);
+    // TODO: compare subgraph
+    return false;
+}
@@ -71,125 +71,132 @@ void fused_unary::compile_graph(const std::vector<fused_unary_op> &subgraph, cod
         if (!access)
             continue;
 
-        switch (op.opcode)
+        emit_op(op, builder);
+        for (size_t i = 0; i < access - 1; i++)
+            builder.emit_dup();
+    }
+
+    builder.emit_ret();
+}
+
+void fused_unary::emit_op(const fused_unary_op &op, codegen::nnil_builder &builder)
+{
+    switch (op.opcode)
+    {
+    case fu_constant:
+        builder.emit_ldc_r4(op.constant.value);
+        break;
+    case fu_identity:
+        builder.emit_dup();
+        break;
+    case fu_ldx:
+        if (op.ldx.input)
+            builder.emit_lda((uint8_t)op.ldx.input);
+        else
+            builder.emit_lda_0();
+        break;
+    case fu_unary:
+    {
+        switch (op.unary.unary_op)
         {
-        case fu_constant:
-            builder.emit_ldc_r4(op.constant.value);
+        case unary_abs:
+            builder.emit_abs();
             break;
-        case fu_identity:
-            builder.emit_dup();
+        case unary_acos:
+            builder.emit_acos();
             break;
-        case fu_ldx:
-            builder.emit_lda_0();
+        case unary_asin:
+            builder.emit_asin();
             break;
-        case fu_unary:
-        {
-            switch (op.unary.unary_op)
-            {
-            case unary_abs:
-                builder.emit_abs();
-                break;
-            case unary_acos:
-                builder.emit_acos();
-                break;
-            case unary_asin:
-                builder.emit_asin();
-                break;
-            case unary_ceil:
-                builder.emit_ceil();
-                break;
-            case unary_cos:
-                builder.emit_cos();
-                break;
-            case unary_exp:
-                builder.emit_exp();
-                break;
-            case unary_floor:
-                builder.emit_floor();
-                break;
-            case unary_log:
-                builder.emit_log();
-                break;
-            case unary_neg:
-                builder.emit_neg();
-                break;
-            case unary_round:
-                builder.emit_round();
-                break;
-            case unary_rsqrt:
-                builder.emit_rsqrt();
-                break;
-            case unary_sign:
-                builder.emit_sign();
-                break;
-            case unary_sin:
-                builder.emit_sin();
-                break;
-            case unary_sqrt:
-                builder.emit_sqrt();
-                break;
-            case unary_square:
-                builder.emit_square();
-                break;
-            case unary_tanh:
-                builder.emit_tanh();
-                break;
-            case unary_bitwise_not:
-                builder.emit_bitwise_not();
-                break;
-            case unary_logical_not:
-                builder.emit_logical_not();
-                break;
-            case unary_erf:
-                builder.emit_erf();
-                break;
-            default:
-                throw std::invalid_argument("Unsupported unary op for nnil: " + (std::string)magic_enum::enum_name(op.unary.unary_op));
-            }
+        case unary_ceil:
+            builder.emit_ceil();
+            break;
+        case unary_cos:
+            builder.emit_cos();
+            break;
+        case unary_exp:
+            builder.emit_exp();
+            break;
+        case unary_floor:
+            builder.emit_floor();
+            break;
+        case unary_log:
+            builder.emit_log();
+            break;
+        case unary_neg:
+            builder.emit_neg();
+            break;
+        case unary_round:
+            builder.emit_round();
+            break;
+        case unary_rsqrt:
+            builder.emit_rsqrt();
             break;
+        case unary_sign:
+            builder.emit_sign();
+            break;
+        case unary_sin:
+            builder.emit_sin();
+            break;
+        case unary_sqrt:
+            builder.emit_sqrt();
+            break;
+        case unary_square:
+            builder.emit_square();
+            break;
+        case unary_tanh:
+            builder.emit_tanh();
+            break;
+        case unary_bitwise_not:
+            builder.emit_bitwise_not();
+            break;
+        case unary_logical_not:
+            builder.emit_logical_not();
+            break;
+        case unary_erf:
+            builder.emit_erf();
+            break;
+        default:
+            throw std::invalid_argument("Unsupported unary op for nnil: " + (std::string)magic_enum::enum_name(op.unary.unary_op));
         }
-        case fu_binary:
+        break;
+    }
+    case fu_binary:
+    {
+        switch (op.binary.binary_op)
         {
-            switch (op.binary.binary_op)
-            {
-            case binary_add:
-                builder.emit_add();
-                break;
-            case binary_sub:
-                builder.emit_sub();
-                break;
-            case binary_mul:
-                builder.emit_mul();
-                break;
-            case binary_div:
-                builder.emit_div();
-                break;
-            case binary_min:
-                builder.emit_min();
-                break;
-            case binary_max:
-                builder.emit_max();
-                break;
-            case binary_pow:
-                builder.emit_pow();
-                break;
-            default:
-                throw std::invalid_argument("Unsupported binary op: " + (std::string)magic_enum::enum_name(op.binary.binary_op));
-            }
+        case binary_add:
+            builder.emit_add();
             break;
-        }
-        case fu_clamp:
-            builder.emit_clamp();
+        case binary_sub:
+            builder.emit_sub();
+            break;
+        case binary_mul:
+            builder.emit_mul();
+            break;
+        case binary_div:
+            builder.emit_div();
+            break;
+        case binary_min:
+            builder.emit_min();
+            break;
+        case binary_max:
+            builder.emit_max();
+            break;
+        case binary_pow:
+            builder.emit_pow();
             break;
         default:
-            throw std::invalid_argument("Invalid fused unary op");
+            throw std::invalid_argument("Unsupported binary op: " + (std::string)magic_enum::enum_name(op.binary.binary_op));
         }
-
-        for (size_t i = 0; i < access - 1; i++)
-            builder.emit_dup();
+        break;
+    }
+    case fu_clamp:
+        builder.emit_clamp();
+        break;
+    default:
+        throw std::invalid_argument("Invalid fused unary op");
     }
-
-    builder.emit_ret();
 }
 
 fused_unary::fused_unary(std::vector<fused_unary_op> subgraph, datatype_t in_type, shape_t in_shape)
@@ -20,25 +20,27 @@ using namespace nncase;
 using namespace nncase::ir;
 
 lstm::lstm(shape_t input_shape, shape_t w_shape, shape_t r_shape, shape_t b_shape, shape_t output_shape,
-    shape_t output_h_shape, shape_t output_c_shape, bool has_static, lstm_direction direction, std::string framework)
-    : has_static_(has_static), direction_(direction), framework_(framework)
+    shape_t initial_h_shape, shape_t initial_c_shape, bool has_static, lstm_direction direction, std::string framework, shape_t sequence_lens)
+    : has_static_(has_static), direction_(direction), framework_(framework), sequence_lens_(std::move(sequence_lens))
 {
     add_input("input", dt_float32, input_shape);
     add_input("w", dt_float32, w_shape);
     add_input("r", dt_float32, r_shape);
     add_input("b", dt_float32, b_shape);
-    add_input("initial_h", dt_float32, output_h_shape);
-    add_input("initial_h", dt_float32, output_c_shape);
+    add_input("initial_h", dt_float32, initial_h_shape);
+    add_input("initial_c", dt_float32, initial_c_shape);
     if (has_static)
         add_input("w_static", dt_float32, shape_t { w_shape[1], w_shape[2] });
 
     add_output("output", dt_float32, output_shape);
-    add_output("output_h", dt_float32, output_h_shape);
-    add_output("output_c", dt_float32, output_c_shape);
+    // initial states may be broadcast over the batch, the final states are per batch
+    add_output("output_h", dt_float32, shape_t { initial_h_shape[0], input_shape[1], initial_h_shape[2] });
+    add_output("output_c", dt_float32, shape_t { initial_c_shape[0], input_shape[1], initial_c_shape[2] });
 }
 
 bool lstm::properties_equal(node &other) const
 {
     auto &r = static_cast<lstm &>(other);
-    return has_static() == r.has_static() && direction() == r.direction() && framework() == r.framework();
+    return has_static() == r.has_static() && direction() == r.direction() && framework() == r.framework()
+        && sequence_lens() == r.sequence_lens();
 }
@@ -19,11 +19,11 @@
 using namespace nncase;
 using namespace nncase::ir;
 
-matmul::matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation)
+matmul::matmul(shape_t input_a_shape, shape_t input_b_shape, value_range<float> fused_activation, datatype_t input_b_type)
     : fused_activation_(fused_activation)
 {
     add_input("input_a", dt_float32, input_a_shape);
-    add_input("input_b", dt_float32, input_b_shape);
+    add_input("input_b", input_b_type, input_b_shape);
     add_input("bias", dt_float32, shape_t { input_b_shape.back() });
     add_output("output", dt_float32, get_matmul_output_shape(input_a_shape, input_b_shape));
 }
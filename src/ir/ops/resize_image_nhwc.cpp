@@ -0,0 +1,33 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/resize_image_nhwc.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+resize_image_nhwc::resize_image_nhwc(datatype_t type, image_resize_mode_t mode, shape_t input_shape, std::array<int32_t, 2> new_size,
+    bool align_corners, bool half_pixel_centers)
+    : new_size_(new_size), mode_(mode), align_corners_(align_corners), half_pixel_centers_(half_pixel_centers)
+{
+    add_input("input", type, input_shape);
+    add_output("output", type, shape_t { input_shape[0], (size_t)new_size[0], (size_t)new_size[1], input_shape[3] });
+}
+
+bool resize_image_nhwc::properties_equal(node &other) const
+{
+    auto &r = static_cast<resize_image_nhwc &>(other);
+    return mode() == r.mode() && new_size() == r.new_size() && align_corners() == r.align_corners()
+        && half_pixel_centers() == r.half_pixel_centers();
+}
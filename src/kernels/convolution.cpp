@@ -12,16 +12,124 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <nncase/kernels/convolution.h>
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/convolution.h>
 #include <nncase/kernels/kernel_utils.h>
+#include <nncase/kernels/reduce_window.h>
+#include <nncase/runtime/dbg.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
 using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::kernels;
 
+namespace
+{
+// The optimized kernels walk each channel plane linearly, so only the planes have to be dense
+bool is_plane_contiguous(const runtime_shape_t &shape, const runtime_shape_t &strides) noexcept
+{
+    return (shape[3] == 1 || strides[3] == 1) && (shape[2] == 1 || strides[2] == shape[3]);
+}
+
+struct row_range
+{
+    size_t begin;
+    size_t end;
+};
+
+int32_t effective_filter(int32_t filter, int32_t dilation) noexcept
+{
+    return (filter - 1) * dilation + 1;
+}
+
+// Input rows a stage reads to produce its output rows
+row_range input_rows(const conv2d_chain_stage &stage, size_t in_h, row_range out) noexcept
+{
+    auto first = (int64_t)out.begin * stage.stride_h - stage.padding_h.before;
+    auto last = ((int64_t)out.end - 1) * stage.stride_h - stage.padding_h.before + effective_filter((int32_t)stage.w_shape[2], stage.dilation_h);
+    auto begin = (size_t)std::clamp<int64_t>(first, 0, (int64_t)in_h);
+    auto end = (size_t)std::clamp<int64_t>(last, (int64_t)begin, (int64_t)in_h);
+    return { begin, end };
+}
+
+result<void> run_stage(const conv2d_chain_stage &stage, const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &w_strides, const runtime_shape_t &out_strides, row_range in_rows, row_range out_rows, kernel_context &context) noexcept
+{
+    // Rows beyond the band are real data owned by the neighbouring bands, only the image border keeps its padding
+    const auto filter_h = effective_filter((int32_t)stage.w_shape[2], stage.dilation_h);
+    padding padding_h;
+    padding_h.before = (int32_t)((int64_t)in_rows.begin + stage.padding_h.before - (int64_t)out_rows.begin * stage.stride_h);
+    padding_h.after = (int32_t)(((int64_t)out_rows.end - 1) * stage.stride_h - stage.padding_h.before + filter_h - (int64_t)in_rows.end);
+
+    runtime_shape_t band_shape { in_shape[0], in_shape[1], in_rows.end - in_rows.begin, in_shape[3] };
+    if (stage.weights)
+    {
+        return kernels::conv2d(input, stage.weights, stage.bias, output, band_shape, in_strides, stage.w_shape, w_strides, { 1 }, out_strides,
+            padding_h, stage.padding_w, stage.groups, stage.stride_h, stage.stride_w, stage.dilation_h, stage.dilation_w, stage.fused_activation, context);
+    }
+    else
+    {
+        return kernels::reduce_window2d(stage.reduce_op, input, stage.init_value, output, band_shape, in_strides, out_strides, padding_h, stage.padding_w,
+            (int32_t)stage.w_shape[2], (int32_t)stage.w_shape[3], stage.stride_h, stage.stride_w, stage.dilation_h, stage.dilation_w, stage.fused_activation, context);
+    }
+}
+
+// Weights of the output channels one conv2d_widened block widens at once, capped so the float copy stays in L2
+constexpr size_t widened_block_floats = 32 * 1024;
+
+template <class TWeights>
+void widen_out_channels(const TWeights *weights, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    size_t oc_begin, size_t oc_count, float *output) noexcept
+{
+    if (is_contiguous(w_shape, w_strides))
+    {
+        cpu::optimized::widen_to_float(weights + oc_begin * w_strides[0], output, oc_count * w_strides[0]);
+        return;
+    }
+
+    for (size_t oc = oc_begin; oc < oc_begin + oc_count; oc++)
+        for (size_t ic = 0; ic < w_shape[1]; ic++)
+            for (size_t ky = 0; ky < w_shape[2]; ky++)
+                for (size_t kx = 0; kx < w_shape[3]; kx++)
+                    *output++ = weights[oc * w_strides[0] + ic * w_strides[1] + ky * w_strides[2] + kx * w_strides[3]];
+}
+
+template <class TWeights>
+result<void> conv2d_widened(const float *input, const TWeights *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    // The float kernel runs on one block of output channels at a time, right after the block is widened,
+    // so every weight is read once in its storage type and its float copy is used while still in cache.
+    // Grouped convs are split on whole groups, each block then reads only its groups' input channels.
+    // The float conv2d paths don't use the workspace, so the block stays intact while they run
+    const auto out_channels = w_shape[0];
+    const auto unit_channels = groups == 1 ? 1 : out_channels / groups;
+    const auto unit_in_channels = groups == 1 ? 0 : w_shape[1];
+    const auto channel_floats = w_shape[1] * w_shape[2] * w_shape[3];
+    const auto units = out_channels / unit_channels;
+    const auto block_units = std::clamp<size_t>(widened_block_floats / std::max<size_t>(unit_channels * channel_floats, 1), 1, std::max<size_t>(units, 1));
+    try_var(block, context.workspace<float>(block_units * unit_channels * channel_floats));
+
+    for (size_t u0 = 0; u0 < units; u0 += block_units)
+    {
+        const auto n = std::min(block_units, units - u0);
+        const auto oc_begin = u0 * unit_channels, oc_count = n * unit_channels;
+        runtime_shape_t block_w_shape { oc_count, w_shape[1], w_shape[2], w_shape[3] };
+        runtime_shape_t block_in_shape { in_shape[0], groups == 1 ? in_shape[1] : n * unit_in_channels, in_shape[2], in_shape[3] };
+        widen_out_channels(weights, w_shape, w_strides, oc_begin, oc_count, block);
+        try_(kernels::conv2d(input + u0 * unit_in_channels * in_strides[1], block, bias + oc_begin * bias_strides[0], output + oc_begin * out_strides[1],
+            block_in_shape, in_strides, block_w_shape, get_default_strides(block_w_shape), bias_strides, out_strides,
+            padding_h, padding_w, groups == 1 ? 1 : (int32_t)n, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context));
+    }
+
+    return ok();
+}
+}
+
 result<void> kernels::conv2d(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
@@ -33,9 +141,9 @@ result<void> kernels::conv2d(const float *input, const float *weights, const flo
     const auto out_h = kernels::detail::get_windowed_output_size(in_h, filter_h, stride_h, dilation_h, padding_h);
     const auto out_w = kernels::detail::get_windowed_output_size(in_w, filter_w, stride_w, dilation_w, padding_w);
 
-    if (is_contiguous(in_shape, in_strides)
+    if (is_plane_contiguous(in_shape, in_strides)
         && is_contiguous(w_shape, w_strides)
-        && is_contiguous({ batch, out_channels, out_h, out_w }, w_strides)
+        && is_plane_contiguous({ batch, out_channels, out_h, out_w }, out_strides)
         && dilation_h == 1
         && dilation_w == 1)
     {
@@ -49,6 +157,13 @@ result<void> kernels::conv2d(const float *input, const float *weights, const flo
             return ok();
         }
     }
+    else if (kernels::detail::is_channel_last(in_shape, in_strides)
+        && kernels::detail::is_channel_last({ batch, out_channels, out_h, out_w }, out_strides)
+        && w_strides[0] == 1)
+    {
+        return cpu::optimized::conv2d_nhwc(input, weights, bias, output, in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
+            padding_h, padding_w, groups, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
+    }
     // general conv
     return cpu::reference::conv2d(input, weights, bias, output,
         in_shape, in_strides, w_shape,
@@ -56,3 +171,142 @@ result<void> kernels::conv2d(const float *input, const float *weights, const flo
         padding_h, padding_w, groups, stride_h,
         stride_w, dilation_h, dilation_w, fused_activation, context);
 }
+
+result<void> kernels::conv2d(const float *input, const half *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    return conv2d_widened(input, weights, bias, output, in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
+        padding_h, padding_w, groups, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
+}
+
+result<void> kernels::conv2d(const float *input, const bfloat16 *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    return conv2d_widened(input, weights, bias, output, in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
+        padding_h, padding_w, groups, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
+}
+
+result<void> kernels::conv2d_transpose(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    if (in_strides[3] == 1)
+        return cpu::optimized::conv2d_transpose(input, weights, bias, output, in_shape, in_strides, w_shape, w_strides, bias_strides, out_shape, out_strides,
+            padding_h, padding_w, groups, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
+    return cpu::reference::conv2d_transpose(input, weights, bias, output, in_shape, in_strides, w_shape, w_strides, bias_strides, out_shape, out_strides,
+        padding_h, padding_w, groups, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
+}
+
+result<void> kernels::conv2d_chain(const float *input, float *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, gsl::span<const conv2d_chain_stage> stages, int32_t tile_h, kernel_context &context) noexcept
+{
+    CHECK_WITH_ERR(!stages.empty() && tile_h > 0, std::errc::invalid_argument);
+
+    // shapes[s] is the input of stage s, shapes.back() the output of the chain
+    const auto n_stages = stages.size();
+    std::vector<runtime_shape_t> shapes { in_shape };
+    std::vector<runtime_shape_t> w_strides;
+    for (auto &stage : stages)
+    {
+        auto &in = shapes.back();
+        CHECK_WITH_ERR(stage.w_shape.size() == 4 && stage.groups > 0 && stage.stride_h > 0 && stage.dilation_h > 0, std::errc::invalid_argument);
+        CHECK_WITH_ERR(stage.weights ? in[1] == stage.w_shape[1] * stage.groups : in[1] == stage.w_shape[0], std::errc::invalid_argument);
+        auto out_h = detail::get_windowed_output_size(in[2], (int32_t)stage.w_shape[2], stage.stride_h, stage.dilation_h, stage.padding_h);
+        auto out_w = detail::get_windowed_output_size(in[3], (int32_t)stage.w_shape[3], stage.stride_w, stage.dilation_w, stage.padding_w);
+        shapes.push_back({ in[0], stage.w_shape[0], out_h, out_w });
+        w_strides.push_back(get_default_strides(stage.w_shape));
+    }
+
+    // rows[band * (n_stages + 1) + s] are the rows of tensor s a band depends on
+    const auto out_h = shapes.back()[2];
+    const auto bands = (out_h + tile_h - 1) / tile_h;
+    std::vector<row_range> rows(bands * (n_stages + 1));
+    std::vector<size_t> max_rows(n_stages + 1);
+    for (size_t band = 0; band < bands; band++)
+    {
+        auto band_rows = rows.data() + band * (n_stages + 1);
+        band_rows[n_stages] = { band * tile_h, std::min(out_h, (band + 1) * tile_h) };
+        for (size_t s = n_stages; s-- > 0;)
+        {
+            band_rows[s] = input_rows(stages[s], shapes[s][2], band_rows[s + 1]);
+            max_rows[s] = std::max(max_rows[s], band_rows[s].end - band_rows[s].begin);
+        }
+    }
+
+    // Every thread keeps the intermediates of its current band in its own part of the workspace
+    std::vector<size_t> scratch_offsets(n_stages + 1);
+    size_t scratch_size = 0;
+    for (size_t s = 1; s < n_stages; s++)
+    {
+        scratch_offsets[s] = scratch_size;
+        scratch_size += shapes[s][0] * shapes[s][1] * max_rows[s] * shapes[s][3];
+    }
+
+    const size_t threads = std::max<size_t>(1, std::min<size_t>(context.num_threads, bands));
+    try_var(workspace, context.workspace<float>(scratch_size * threads));
+    std::vector<std::error_condition> errors(threads);
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (size_t t = 0; t < threads; t++)
+    {
+        // Stages run on their own context: the workspace is taken, and only a single band may use every thread
+        kernel_context stage_context;
+        stage_context.num_threads = threads > 1 ? 1 : context.num_threads;
+
+        auto scratch = workspace + t * scratch_size;
+        for (size_t band = bands * t / threads; band < bands * (t + 1) / threads && !errors[t]; band++)
+        {
+            auto band_rows = rows.data() + band * (n_stages + 1);
+            for (size_t s = 0; s < n_stages; s++)
+            {
+                auto &in_rows = band_rows[s], &out_rows = band_rows[s + 1];
+                const float *src;
+                float *dest;
+                runtime_shape_t src_strides, dest_strides;
+                if (s == 0)
+                {
+                    src = input + in_rows.begin * in_strides[2];
+                    src_strides = in_strides;
+                }
+                else
+                {
+                    src = scratch + scratch_offsets[s];
+                    src_strides = get_default_strides({ shapes[s][0], shapes[s][1], in_rows.end - in_rows.begin, shapes[s][3] });
+                }
+
+                if (s + 1 == n_stages)
+                {
+                    dest = output + out_rows.begin * out_strides[2];
+                    dest_strides = out_strides;
+                }
+                else
+                {
+                    dest = scratch + scratch_offsets[s + 1];
+                    dest_strides = get_default_strides({ shapes[s + 1][0], shapes[s + 1][1], out_rows.end - out_rows.begin, shapes[s + 1][3] });
+                }
+
+                auto r = run_stage(stages[s], src, dest, shapes[s], src_strides, w_strides[s], dest_strides, in_rows, out_rows, stage_context);
+                if (r.is_err())
+                {
+                    errors[t] = r.unwrap_err();
+                    break;
+                }
+            }
+        }
+    }
+
+    for (auto &e : errors)
+    {
+        if (e)
+            return err(e);
+    }
+
+    return ok();
+}
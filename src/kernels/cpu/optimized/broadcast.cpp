@@ -0,0 +1,54 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "copy_rows.h"
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+template <class T>
+result<void> broadcast_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, kernel_context &context) noexcept
+{
+    // Broadcast axes read the input with a zero stride, so a broadcast inner axis becomes a fill
+    const auto dims_ext = out_shape.size() - in_shape.size();
+    runtime_shape_t src_strides(out_shape.size(), 0);
+    for (size_t i = 0; i < in_shape.size(); i++)
+    {
+        if (in_shape[i] != 1)
+            src_strides[i + dims_ext] = in_strides[i];
+    }
+
+    copy_rows(input, output, out_shape, src_strides, out_strides, context);
+    return ok();
+}
+}
+
+#define BROADCAST_IMPL(size, type) \
+    case size:                     \
+        return broadcast_impl(reinterpret_cast<const type *>(input), reinterpret_cast<type *>(output), in_shape, in_strides, out_shape, out_strides, context)
+
+result<void> optimized::broadcast(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, kernel_context &context) noexcept
+{
+    TYPE_IMPL_SELECT(type, BROADCAST_IMPL);
+}
@@ -0,0 +1,117 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+#if defined(X86_64_SIMD_ON)
+#include <immintrin.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+#if defined(X86_64_SIMD_ON)
+// 8 values below 0x10000 to 8 uint16
+void store_u16x8(uint16_t *output, __m256i values) noexcept
+{
+    auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(values, values), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm256_castsi256_si128(packed));
+}
+
+// half::round_to_half on 8 lanes, F16C rounds denormals and NaN payloads differently
+__m256i round_to_half(__m256 value) noexcept
+{
+    const auto f32infy = _mm256_set1_epi32(255 << 23);
+    const auto f16max = _mm256_set1_epi32((127 + 16) << 23);
+    const auto denorm_magic = _mm256_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const auto one = _mm256_set1_epi32(1);
+
+    auto u = _mm256_castps_si256(value);
+    auto sign = _mm256_and_si256(u, _mm256_set1_epi32((int32_t)0x80000000u));
+    u = _mm256_xor_si256(u, sign);
+
+    // operands stay below 0x80000000, so signed compares are fine
+    auto inf_nan = _mm256_cmpgt_epi32(u, _mm256_sub_epi32(f16max, one));
+    auto special = _mm256_blendv_epi8(_mm256_set1_epi32(0x7c00), _mm256_set1_epi32(0x7e00), _mm256_cmpgt_epi32(u, f32infy));
+
+    auto is_denorm = _mm256_cmpgt_epi32(_mm256_set1_epi32(113 << 23), u);
+    auto denorm = _mm256_sub_epi32(_mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(u), _mm256_castsi256_ps(denorm_magic))), denorm_magic);
+
+    auto mant_odd = _mm256_and_si256(_mm256_srli_epi32(u, 13), one);
+    auto normal = _mm256_add_epi32(_mm256_add_epi32(u, _mm256_set1_epi32((int32_t)0xc8000fffu)), mant_odd);
+    normal = _mm256_srli_epi32(normal, 13);
+
+    auto result = _mm256_blendv_epi8(normal, denorm, is_denorm);
+    result = _mm256_blendv_epi8(result, special, inf_nan);
+    return _mm256_or_si256(result, _mm256_srli_epi32(sign, 16));
+}
+
+// bfloat16::round_to_bfloat16 on 8 lanes
+__m256i round_to_bfloat16(__m256 value) noexcept
+{
+    auto u = _mm256_castps_si256(value);
+    auto lsb = _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1));
+    auto rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(u, _mm256_set1_epi32(0x7fff)), lsb), 16);
+    auto is_nan = _mm256_castps_si256(_mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+    return _mm256_blendv_epi8(rounded, _mm256_set1_epi32(0x7fc0), is_nan);
+}
+#endif
+
+void narrow(const float *CXX_RESTRICT input, half *CXX_RESTRICT output, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    for (; i + 8 <= count; i += 8)
+        store_u16x8(&output[i].raw(), round_to_half(_mm256_loadu_ps(input + i)));
+#endif
+    for (; i < count; i++)
+        output[i] = half::round_to_half(input[i]);
+}
+
+void narrow(const float *CXX_RESTRICT input, bfloat16 *CXX_RESTRICT output, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    for (; i + 8 <= count; i += 8)
+        store_u16x8(&output[i].raw(), round_to_bfloat16(_mm256_loadu_ps(input + i)));
+#endif
+    for (; i < count; i++)
+        output[i] = bfloat16::round_to_bfloat16(input[i]);
+}
+}
+
+result<void> optimized::convert(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
+    const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
+    NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const auto count = compute_size(in_shape);
+    if (in_type == dt_float32 && out_type == dt_float16)
+        narrow(reinterpret_cast<const float *>(input), reinterpret_cast<half *>(output), count);
+    else if (in_type == dt_float32 && out_type == dt_bfloat16)
+        narrow(reinterpret_cast<const float *>(input), reinterpret_cast<bfloat16 *>(output), count);
+    else if (in_type == dt_float16 && out_type == dt_float32)
+        widen_to_float(reinterpret_cast<const half *>(input), reinterpret_cast<float *>(output), count);
+    else if (in_type == dt_bfloat16 && out_type == dt_float32)
+        widen_to_float(reinterpret_cast<const bfloat16 *>(input), reinterpret_cast<float *>(output), count);
+    else
+        return err(std::errc::not_supported);
+    return ok();
+}
@@ -15,7 +15,9 @@
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/kernel_utils.h>
 #include <nncase/runtime/runtime_op_utility.h>
+#include <algorithm>
 #include <utility>
+#include <vector>
 #ifdef NNCASE_HALIDE
 #include <hkg/export/HalideBuffer.h>
 #include <hkg/export/halide_conv2d.h>
@@ -529,7 +531,12 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
     const auto filter_w = w_shape[3];
 
 #ifdef NNCASE_HALIDE
-    if (groups == 1 && runtime::is_contiguous(in_shape, in_strides))
+    // Halide buffers are dense, so neither tensor may be a strided view
+    const runtime_shape_t out_shape { in_shape[0], w_shape[0],
+        detail::get_windowed_output_size(in_shape[2], (int32_t)filter_h, stride_h, dilation_h, padding_h),
+        detail::get_windowed_output_size(in_shape[3], (int32_t)filter_w, stride_w, dilation_w, padding_w) };
+    const bool dense = runtime::is_contiguous(in_shape, in_strides) && runtime::is_contiguous(out_shape, out_strides);
+    if (groups == 1 && dense)
     {
         // clang-format off
         HALIDE_CONV2D_NXM_S1_S2(1, 1)
@@ -539,7 +546,7 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
         // clang-format on
     }
 
-    if ((size_t)groups == in_shape[1] && (size_t)groups == w_shape[0] && runtime::is_contiguous(in_shape, in_strides))
+    if ((size_t)groups == in_shape[1] && (size_t)groups == w_shape[0] && dense)
     {
         // clang-format off
         HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(1, 1)
@@ -584,4 +591,158 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
     }
 #endif
     return err(std::errc::not_supported);
-}
\ No newline at end of file
+}
+result<void> optimized::conv2d_nhwc(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    NNCASE_UNUSED const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    NNCASE_UNUSED kernels::kernel_context &context) noexcept
+{
+    const auto in_h = (int32_t)in_shape[2], in_w = (int32_t)in_shape[3];
+    const auto out_channels = w_shape[0], g_ic = w_shape[1], g_oc = out_channels / groups;
+    const auto filter_h = (int32_t)w_shape[2], filter_w = (int32_t)w_shape[3];
+    const auto out_h = (int32_t)kernels::detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h);
+    const auto out_w = (int32_t)kernels::detail::get_windowed_output_size(in_shape[3], filter_w, stride_w, dilation_w, padding_w);
+    const bool depthwise = g_ic == 1 && g_oc == 1;
+
+    // Every output pixel accumulates its out_channels in place, reading one dense input pixel per filter tap
+    const auto rows = (int32_t)in_shape[0] * out_h;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int32_t row = 0; row < rows; row++)
+    {
+        const auto batch = (size_t)(row / out_h);
+        const auto oy = row % out_h;
+        const auto in_y_origin = oy * stride_h - padding_h.before;
+        const auto ky_start = std::max(0, (-in_y_origin + dilation_h - 1) / dilation_h);
+        const auto ky_end = std::min(filter_h, (in_h - in_y_origin + dilation_h - 1) / dilation_h);
+        const auto in_batch = input + batch * in_strides[0];
+
+        for (int32_t ox = 0; ox < out_w; ox++)
+        {
+            const auto in_x_origin = ox * stride_w - padding_w.before;
+            const auto kx_start = std::max(0, (-in_x_origin + dilation_w - 1) / dilation_w);
+            const auto kx_end = std::min(filter_w, (in_w - in_x_origin + dilation_w - 1) / dilation_w);
+            auto out = output + batch * out_strides[0] + oy * out_strides[2] + ox * out_strides[3];
+            for (size_t oc = 0; oc < out_channels; oc++)
+                out[oc] = bias[oc];
+
+            for (int32_t ky = ky_start; ky < ky_end; ky++)
+            {
+                const auto in_row = in_batch + (in_y_origin + ky * dilation_h) * in_strides[2];
+                for (int32_t kx = kx_start; kx < kx_end; kx++)
+                {
+                    const auto in = in_row + (in_x_origin + kx * dilation_w) * in_strides[3];
+                    const auto w = weights + ky * w_strides[2] + kx * w_strides[3];
+                    if (depthwise)
+                    {
+                        for (size_t c = 0; c < out_channels; c++)
+                            out[c] += in[c] * w[c];
+                    }
+                    else
+                    {
+                        for (size_t g = 0; g < (size_t)groups; g++)
+                        {
+                            auto out_g = out + g * g_oc;
+                            for (size_t ic = 0; ic < g_ic; ic++)
+                            {
+                                const auto value = in[g * g_ic + ic];
+                                const auto w_row = w + ic * w_strides[1] + g * g_oc;
+                                for (size_t oc = 0; oc < g_oc; oc++)
+                                    out_g[oc] += value * w_row[oc];
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (size_t oc = 0; oc < out_channels; oc++)
+                out[oc] = kernels::detail::apply_activation(out[oc], fused_activation);
+        }
+    }
+
+    return ok();
+}
+
+result<void> optimized::conv2d_transpose(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    kernels::kernel_context &context) noexcept
+{
+    const auto in_h = (int32_t)in_shape[2], in_w = (int32_t)in_shape[3];
+    const auto out_channels = w_shape[0], g_ic = w_shape[1], g_oc = out_channels / groups;
+    const auto filter_h = (int32_t)w_shape[2], filter_w = (int32_t)w_shape[3];
+    const auto out_h = out_shape[2], out_w = out_shape[3];
+
+    // Sub-pixel decomposition: output columns are split by phase ox % stride_w, so every filter column adds a dense input row
+    // to a dense run of one phase and no multiply is spent on the zeros a strided conv2d lowering would insert
+    struct column_tap
+    {
+        size_t phase;
+        ptrdiff_t shift;
+        int32_t begin;
+        int32_t end;
+    };
+
+    const auto phase_w = (out_w + stride_w - 1) / stride_w;
+    std::vector<column_tap> taps(filter_w);
+    for (int32_t kx = 0; kx < filter_w; kx++)
+    {
+        // ox = ix * stride_w + origin = (ix + shift) * stride_w + phase
+        const auto origin = kx * dilation_w - padding_w.before;
+        const auto phase = ((origin % stride_w) + stride_w) % stride_w;
+        const auto shift = (origin - phase) / stride_w;
+        const auto phase_size = (int32_t)((out_w + stride_w - 1 - phase) / stride_w);
+        taps[kx] = { (size_t)phase, shift, std::max(0, -shift), std::min(in_w, phase_size - shift) };
+    }
+
+    const auto rows = in_shape[0] * out_channels * out_h;
+    const auto threads = (int32_t)std::max<size_t>(1, std::min<size_t>(context.num_threads, rows));
+    try_var(workspace, context.workspace<float>(phase_w * stride_w * threads));
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (int32_t t = 0; t < threads; t++)
+    {
+        auto acc = workspace + t * phase_w * stride_w;
+        for (size_t row = rows * t / threads; row < rows * (t + 1) / threads; row++)
+        {
+            const auto oy = (int32_t)(row % out_h);
+            const auto oc = row / out_h % out_channels;
+            const auto batch = row / out_h / out_channels;
+            const auto in_group = input + batch * in_strides[0] + oc / g_oc * g_ic * in_strides[1];
+            std::fill_n(acc, phase_w * stride_w, bias[oc * bias_strides[0]]);
+
+            for (int32_t ky = 0; ky < filter_h; ky++)
+            {
+                // only the filter rows of this output row's phase contribute
+                const auto in_y = oy + padding_h.before - ky * dilation_h;
+                if (in_y < 0 || in_y % stride_h || in_y / stride_h >= in_h)
+                    continue;
+
+                for (size_t ic = 0; ic < g_ic; ic++)
+                {
+                    const auto in_row = in_group + ic * in_strides[1] + (in_y / stride_h) * in_strides[2];
+                    const auto w_row = weights + oc * w_strides[0] + ic * w_strides[1] + ky * w_strides[2];
+                    for (int32_t kx = 0; kx < filter_w; kx++)
+                    {
+                        const auto &tap = taps[kx];
+                        const auto w = w_row[kx * w_strides[3]];
+                        auto out = acc + tap.phase * phase_w + tap.shift;
+                        for (int32_t ix = tap.begin; ix < tap.end; ix++)
+                            out[ix] += w * in_row[ix];
+                    }
+                }
+            }
+
+            auto out_row = output + batch * out_strides[0] + oc * out_strides[1] + oy * out_strides[2];
+            for (size_t ox = 0; ox < out_w; ox++)
+                out_row[ox * out_strides[3]] = kernels::detail::apply_activation(acc[ox % stride_w * phase_w + ox / stride_w], fused_activation);
+        }
+    }
+
+    return ok();
+}
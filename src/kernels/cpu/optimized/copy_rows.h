@@ -0,0 +1,122 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <nncase/kernels/cpu/optimized/runtime_types.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+BEGIN_NS_NNCASE_KERNELS_CPU_OPT
+
+// Below this many bytes per thread, starting the threads costs more than the copy
+constexpr size_t copy_bytes_per_thread = 64 * 1024;
+
+inline int32_t copy_threads(size_t bytes, kernel_context &context) noexcept
+{
+    return (int32_t)std::clamp<size_t>(bytes / copy_bytes_per_thread, 1, std::max<size_t>(context.num_threads, 1));
+}
+
+// Drops size 1 axes and merges neighbouring axes every strides walks as one, so rows get as long as possible
+inline void fold_axes(runtime_shape_t &shape, std::initializer_list<runtime_shape_t *> strides) noexcept
+{
+    for (size_t i = shape.size(); i-- > 0;)
+    {
+        if (shape.size() > 1 && shape[i] == 1)
+        {
+            shape.erase(shape.begin() + i);
+            for (auto s : strides)
+                s->erase(s->begin() + i);
+        }
+    }
+
+    for (size_t i = shape.size() - 1; i > 0; i--)
+    {
+        bool mergeable = true;
+        for (auto s : strides)
+            mergeable &= (*s)[i - 1] == (*s)[i] * shape[i];
+        if (mergeable)
+        {
+            shape[i - 1] *= shape[i];
+            shape.erase(shape.begin() + i);
+            for (auto s : strides)
+            {
+                (*s)[i - 1] = (*s)[i];
+                s->erase(s->begin() + i);
+            }
+        }
+    }
+}
+
+// Offset of an outer row, the index over every axis but the last
+inline size_t row_offset(const runtime_shape_t &shape, const runtime_shape_t &strides, size_t row) noexcept
+{
+    size_t offset = 0;
+    for (size_t i = shape.size() - 1; i-- > 0;)
+    {
+        offset += row % shape[i] * strides[i];
+        row /= shape[i];
+    }
+    return offset;
+}
+
+// Copies a row of width elements, a zero source step fills it with one element
+template <class T>
+void copy_row(const T *src, T *dest, size_t width, size_t src_step, size_t dest_step) noexcept
+{
+    if (src_step == 1 && dest_step == 1)
+    {
+        std::memcpy(dest, src, width * sizeof(T));
+    }
+    else if (src_step == 0 && dest_step == 1)
+    {
+        std::fill_n(dest, width, *src);
+    }
+    else
+    {
+        for (size_t i = 0; i < width; i++)
+            dest[i * dest_step] = src[i * src_step];
+    }
+}
+
+// Strided copy of shape from src to dest, row by row over the folded axes
+template <class T>
+void copy_rows(const T *src, T *dest, runtime_shape_t shape, runtime_shape_t src_strides, runtime_shape_t dest_strides, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    if (shape.empty())
+    {
+        shape = { 1 };
+        src_strides = dest_strides = { 1 };
+    }
+
+    const auto size = runtime::compute_size(shape);
+    if (!size)
+        return;
+
+    fold_axes(shape, { &src_strides, &dest_strides });
+    const auto width = shape.back();
+    const auto rows = (int32_t)(size / width);
+#ifdef NNCASE_OPENMP
+    const auto threads = copy_threads(size * sizeof(T), context);
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (int32_t row = 0; row < rows; row++)
+    {
+        copy_row(src + row_offset(shape, src_strides, row), dest + row_offset(shape, dest_strides, row), width,
+            src_strides.back(), dest_strides.back());
+    }
+}
+
+END_NS_NNCASE_KERNELS_CPU_OPT
@@ -16,6 +16,10 @@
 #include <nncase/kernels/kernel_utils.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
+#if defined(X86_64_SIMD_ON)
+#include <immintrin.h>
+#endif
+
 using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::kernels;
@@ -52,10 +56,19 @@ result<void> dequantize(const TQint *CXX_RESTRICT input, float *CXX_RESTRICT out
 #if __riscv
     riscv_dequantize(input, output, count, scale, bias);
 #else
-    for (size_t i = 0; i < count; i++)
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    const auto vscale = _mm256_set1_ps(scale), vbias = _mm256_set1_ps(bias);
+    for (; i + 8 <= count; i += 8)
     {
-        output[i] = input[i] * scale + bias;
+        auto raw = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(input + i));
+        auto widened = std::is_signed_v<TQint> ? _mm256_cvtepi8_epi32(raw) : _mm256_cvtepu8_epi32(raw);
+        // no fmadd, the reference multiplies and adds with two roundings
+        _mm256_storeu_ps(output + i, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(widened), vscale), vbias));
     }
+#endif
+    for (; i < count; i++)
+        output[i] = (float)input[i] * scale + bias;
 #endif
     return ok();
 }
@@ -0,0 +1,120 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "recurrent.h"
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+template result<void> optimized::gru<float>(const float *input, const float *w, const float *r, const float *b, float *initial_h,
+    float *output, float *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode,
+    bool linear_before_reset, kernel_context &context) noexcept;
+
+template <typename T>
+result<void> optimized::gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h,
+    const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset, kernel_context &context) noexcept
+{
+    const size_t seq_length = input_shape[0];
+    const size_t batch_size = input_shape[1];
+    const size_t input_size = input_shape[2];
+    const size_t num_directions = w_shape[0];
+    const size_t hidden_size = w_shape[1] / 3;
+    const size_t gate_size = 3 * hidden_size;
+    const size_t state_size = batch_size * hidden_size;
+
+    // workspace: x_gates [seq, batch, 3 * hidden], h_gates [batch, 3 * hidden], zr [batch, 2 * hidden], h_t, rh [batch, hidden]
+    const size_t x_gates_size = seq_length * batch_size * gate_size;
+    const size_t h_gates_size = batch_size * gate_size;
+    const size_t zr_size = batch_size * 2 * hidden_size;
+    try_var(workspace, context.workspace<T>(x_gates_size + h_gates_size + zr_size + 2 * state_size));
+    auto x_gates = workspace;
+    auto h_gates = x_gates + x_gates_size;
+    auto zr = h_gates + h_gates_size;
+    auto h_t = zr + zr_size;
+    auto rh = h_t + state_size;
+
+    for (size_t d = 0; d < num_directions; d++)
+    {
+        auto w_d = w + d * gate_size * input_size;
+        auto r_d = r + d * gate_size * hidden_size;
+        auto wb_d = b + d * 2 * gate_size;
+        auto rb_d = wb_d + gate_size;
+        const bool reverse = mode == lstm_direction::kReverse || d == 1;
+
+        // x_gates = X * W^T + Wb for all the time steps
+        gemm_nt(input, w_d, wb_d, x_gates, seq_length * batch_size, gate_size, input_size, gate_size, context);
+        std::copy_n(initial_h + d * state_size, state_size, h_t);
+
+        for (size_t step = 0; step < seq_length; step++)
+        {
+            const size_t t = reverse ? seq_length - 1 - step : step;
+            auto x_t = x_gates + t * batch_size * gate_size;
+
+            // z, r (and h when linear_before_reset) recurrent parts: H * R^T + Rb
+            const size_t rec_gates = linear_before_reset ? gate_size : 2 * hidden_size;
+            gemm_nt(h_t, r_d, rb_d, h_gates, batch_size, rec_gates, hidden_size, gate_size, context);
+            for (size_t bs = 0; bs < batch_size; bs++)
+                add_sigmoid(x_t + bs * gate_size, h_gates + bs * gate_size, zr + bs * 2 * hidden_size, 2 * hidden_size);
+
+            if (!linear_before_reset)
+            {
+                // h gate: (r . H) * Rh^T + Rbh
+                for (size_t bs = 0; bs < batch_size; bs++)
+                {
+                    auto r_t = zr + bs * 2 * hidden_size + hidden_size;
+                    for (size_t k = 0; k < hidden_size; k++)
+                        rh[bs * hidden_size + k] = r_t[k] * h_t[bs * hidden_size + k];
+                }
+
+                gemm_nt(rh, r_d + 2 * hidden_size * hidden_size, rb_d + 2 * hidden_size, h_gates + 2 * hidden_size,
+                    batch_size, hidden_size, hidden_size, gate_size, context);
+            }
+            else
+            {
+                // h gate: r . (H * Rh^T + Rbh)
+                for (size_t bs = 0; bs < batch_size; bs++)
+                {
+                    auto r_t = zr + bs * 2 * hidden_size + hidden_size;
+                    auto h_gate = h_gates + bs * gate_size + 2 * hidden_size;
+                    for (size_t k = 0; k < hidden_size; k++)
+                        h_gate[k] *= r_t[k];
+                }
+            }
+
+            auto out_t = output + (t * num_directions + d) * state_size;
+            for (size_t bs = 0; bs < batch_size; bs++)
+            {
+                // reuse rh for the candidate state
+                auto h_hat = rh + bs * hidden_size;
+                add_tanh(x_t + bs * gate_size + 2 * hidden_size, h_gates + bs * gate_size + 2 * hidden_size, h_hat, hidden_size);
+
+                auto z_t = zr + bs * 2 * hidden_size;
+                auto h_row = h_t + bs * hidden_size;
+                for (size_t k = 0; k < hidden_size; k++)
+                    h_row[k] = (1 - z_t[k]) * h_hat[k] + z_t[k] * h_row[k];
+                std::copy_n(h_row, hidden_size, out_t + bs * hidden_size);
+            }
+        }
+
+        std::copy_n(h_t, state_size, output_h + d * state_size);
+    }
+
+    return ok();
+}
@@ -0,0 +1,159 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "recurrent.h"
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+template result<void> optimized::lstm<float>(const float *input, const float *w, const float *r, const float *b, const float *initial_h, const float *initial_c,
+    float *output, float *output_h, float *output_c, const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape,
+    const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens, lstm_direction direction, lstm_framework framework,
+    kernel_context &context) noexcept;
+
+namespace
+{
+#if defined(X86_64_SIMD_ON)
+// c = f * c + i * g, h = o * tanh(c)
+void update_state(const float *i, const float *f, const float *o, const float *g, float *c, float *h, size_t n) noexcept
+{
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8)
+    {
+        auto c_t = _mm256_fmadd_ps(_mm256_loadu_ps(f + k), _mm256_loadu_ps(c + k), _mm256_mul_ps(_mm256_loadu_ps(i + k), _mm256_loadu_ps(g + k)));
+        _mm256_storeu_ps(c + k, c_t);
+        _mm256_storeu_ps(h + k, _mm256_mul_ps(_mm256_loadu_ps(o + k), tanh256_ps(c_t)));
+    }
+    for (; k < n; k++)
+    {
+        c[k] = f[k] * c[k] + i[k] * g[k];
+        h[k] = o[k] * std::tanh(c[k]);
+    }
+}
+#else
+void update_state(const float *i, const float *f, const float *o, const float *g, float *c, float *h, size_t n) noexcept
+{
+    for (size_t k = 0; k < n; k++)
+    {
+        c[k] = f[k] * c[k] + i[k] * g[k];
+        h[k] = o[k] * std::tanh(c[k]);
+    }
+}
+#endif
+}
+
+template <typename T>
+result<void> optimized::lstm(const T *input, const T *w, const T *r, const T *b, const T *initial_h, const T *initial_c,
+    T *output, T *output_h, T *output_c, const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape,
+    const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens, lstm_direction direction, lstm_framework framework,
+    kernel_context &context) noexcept
+{
+    const size_t seq_length = input_shape[0];
+    const size_t batch_size = input_shape[1];
+    const size_t input_size = input_shape[2];
+    const size_t num_directions = w_shape[0];
+    const size_t gate_size = w_shape[1];
+    const size_t hidden_size = gate_size / 4;
+    const size_t state_batch = initial_h_shape[1];
+    const size_t state_size = batch_size * hidden_size;
+    if (state_batch != batch_size && state_batch != 1)
+        return err(std::errc::invalid_argument);
+    if (!kernels::detail::sequence_lens_valid(sequence_lens, seq_length, batch_size))
+        return err(std::errc::invalid_argument);
+
+    // onnx: b = [Wb, Rb] and gates [i, o, f, c], caffe: b = Wb and gates [i, f, o, c]
+    const bool has_rb = compute_size(b_shape) == num_directions * 2 * gate_size;
+    const size_t b_stride = has_rb ? 2 * gate_size : gate_size;
+    const size_t o_gate = (framework == kCaffe ? 2 : 1) * hidden_size;
+    const size_t f_gate = (framework == kCaffe ? 1 : 2) * hidden_size;
+    const size_t c_gate = 3 * hidden_size;
+
+    // workspace: x_gates [seq, batch, 4 * hidden], h_gates, gates [batch, 4 * hidden], h_t, c_t [batch, hidden], bias [4 * hidden]
+    const size_t x_gates_size = seq_length * batch_size * gate_size;
+    const size_t gates_size = batch_size * gate_size;
+    try_var(workspace, context.workspace<T>(x_gates_size + 2 * gates_size + 2 * state_size + gate_size));
+    auto x_gates = workspace;
+    auto h_gates = x_gates + x_gates_size;
+    auto gates = h_gates + gates_size;
+    auto h_t = gates + gates_size;
+    auto c_t = h_t + state_size;
+    auto bias = c_t + state_size;
+
+    for (size_t d = 0; d < num_directions; d++)
+    {
+        auto w_d = w + d * gate_size * input_size;
+        auto r_d = r + d * gate_size * hidden_size;
+        auto b_d = b + d * b_stride;
+        const bool reverse = direction == kReverse || d == 1;
+
+        // x_gates = X * W^T + Wb + Rb for all the time steps
+        for (size_t g = 0; g < gate_size; g++)
+            bias[g] = b_d[g] + (has_rb ? b_d[gate_size + g] : 0);
+        gemm_nt(input, w_d, bias, x_gates, seq_length * batch_size, gate_size, input_size, gate_size, context);
+
+        // caffe resets the states at the beginning of a sequence (cont = 0)
+        if (framework == kCaffe)
+        {
+            std::fill_n(h_t, state_size, T(0));
+            std::fill_n(c_t, state_size, T(0));
+        }
+        else
+        {
+            for (size_t bs = 0; bs < batch_size; bs++)
+            {
+                auto src = (d * state_batch + (state_batch == 1 ? 0 : bs)) * hidden_size;
+                std::copy_n(initial_h + src, hidden_size, h_t + bs * hidden_size);
+                std::copy_n(initial_c + src, hidden_size, c_t + bs * hidden_size);
+            }
+        }
+
+        for (size_t step = 0; step < seq_length; step++)
+        {
+            const size_t t = reverse ? seq_length - 1 - step : step;
+            auto x_t = x_gates + t * batch_size * gate_size;
+
+            // gates = x_gates[t] + H * R^T, i, o and f (i, f and o for caffe) are the first 3 * hidden.
+            // Batches already past their length get gates too, but their states are left alone
+            gemm_nt(h_t, r_d, nullptr, h_gates, batch_size, gate_size, hidden_size, gate_size, context);
+            auto out_t = output + (t * num_directions + d) * state_size;
+            for (size_t bs = 0; bs < batch_size; bs++)
+            {
+                if (!kernels::detail::in_sequence(sequence_lens, bs, t))
+                {
+                    std::fill_n(out_t + bs * hidden_size, hidden_size, T(0));
+                    continue;
+                }
+
+                auto x_row = x_t + bs * gate_size;
+                auto h_row = h_gates + bs * gate_size;
+                auto g_row = gates + bs * gate_size;
+                add_sigmoid(x_row, h_row, g_row, c_gate);
+                add_tanh(x_row + c_gate, h_row + c_gate, g_row + c_gate, hidden_size);
+                update_state(g_row, g_row + f_gate, g_row + o_gate, g_row + c_gate, c_t + bs * hidden_size, h_t + bs * hidden_size, hidden_size);
+                std::copy_n(h_t + bs * hidden_size, hidden_size, out_t + bs * hidden_size);
+            }
+        }
+
+        std::copy_n(h_t, state_size, output_h + d * state_size);
+        std::copy_n(c_t, state_size, output_c + d * state_size);
+    }
+
+    return ok();
+}
@@ -0,0 +1,496 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/nnil.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/dbg.h>
+#include <nncase/runtime/nnil.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Elements processed per instruction dispatch
+constexpr size_t block_size = 64;
+constexpr size_t max_stack_depth = 64;
+constexpr size_t parallel_threshold = 16 * 1024;
+
+// The evaluation stack is resolved at compile time: every stack slot becomes a
+// register holding one block of values, and each instruction knows its slots.
+struct plan_op
+{
+    nnil_opcode_t opcode;
+    uint8_t dest;
+    uint8_t src;
+    uint8_t src2;
+    bool imm_b;
+    bool imm_c;
+    float imm;
+    float imm2;
+};
+
+struct plan
+{
+    std::vector<plan_op> ops;
+    size_t registers = 0;
+    int32_t result = -1;
+};
+
+// args is the number of arguments body may load
+result<void> compile(gsl::span<const gsl::byte> body, size_t args, plan &p) noexcept
+{
+    try
+    {
+        span_reader sr(body);
+        nnil_reader reader(sr);
+        size_t depth = 0;
+        auto push = [&]() -> result<uint8_t> {
+            CHECK_WITH_ERR(depth < max_stack_depth, nncase_errc::nnil_illegal_instruction);
+            p.registers = std::max(p.registers, depth + 1);
+            return ok((uint8_t)depth++);
+        };
+        auto last_is_ldc = [&](size_t n) {
+            if (p.ops.size() < n)
+                return false;
+            for (size_t i = p.ops.size() - n; i < p.ops.size(); i++)
+            {
+                auto &op = p.ops[i];
+                if (op.opcode != nnil_ldc_r4 || op.imm_b)
+                    return false;
+            }
+            return true;
+        };
+
+        while (reader.avail())
+        {
+            auto op = reader.next();
+            plan_op pop {};
+            pop.opcode = op.opcode;
+            switch (op.opcode)
+            {
+            case nnil_nop:
+                continue;
+            case nnil_pop:
+                CHECK_WITH_ERR(depth >= 1, nncase_errc::nnil_illegal_instruction);
+                depth--;
+                continue;
+            case nnil_dup:
+                CHECK_WITH_ERR(depth >= 1, nncase_errc::nnil_illegal_instruction);
+                pop.src = (uint8_t)(depth - 1);
+                try_set(pop.dest, push());
+                break;
+            case nnil_lda_0:
+            case nnil_lda:
+                pop.opcode = nnil_lda;
+                pop.src = op.opcode == nnil_lda ? op.lda.index : 0;
+                CHECK_WITH_ERR(pop.src < args, nncase_errc::nnil_illegal_instruction);
+                try_set(pop.dest, push());
+                break;
+            case nnil_ldc_r4_0:
+            case nnil_ldc_r4_1:
+            case nnil_ldc_r4:
+                pop.opcode = nnil_ldc_r4;
+                pop.imm = op.opcode == nnil_ldc_r4_0 ? 0.f : op.opcode == nnil_ldc_r4_1 ? 1.f
+                                                                                        : op.ldc_r4.r4;
+                try_set(pop.dest, push());
+                break;
+            case nnil_abs:
+            case nnil_acos:
+            case nnil_asin:
+            case nnil_ceil:
+            case nnil_cos:
+            case nnil_exp:
+            case nnil_floor:
+            case nnil_erf:
+            case nnil_log:
+            case nnil_logical_not:
+            case nnil_neg:
+            case nnil_round:
+            case nnil_rsqrt:
+            case nnil_sign:
+            case nnil_sin:
+            case nnil_sqrt:
+            case nnil_square:
+            case nnil_tanh:
+                CHECK_WITH_ERR(depth >= 1, nncase_errc::nnil_illegal_instruction);
+                pop.dest = pop.src = (uint8_t)(depth - 1);
+                break;
+            case nnil_add:
+            case nnil_sub:
+            case nnil_mul:
+            case nnil_div:
+            case nnil_min:
+            case nnil_max:
+            case nnil_pow:
+                CHECK_WITH_ERR(depth >= 2, nncase_errc::nnil_illegal_instruction);
+                // Fold a constant right operand into the instruction
+                if (last_is_ldc(1) && p.ops.back().dest == depth - 1)
+                {
+                    pop.imm_b = true;
+                    pop.imm = p.ops.back().imm;
+                    p.ops.pop_back();
+                }
+                else
+                {
+                    pop.src2 = (uint8_t)(depth - 1);
+                }
+                depth--;
+                pop.dest = pop.src = (uint8_t)(depth - 1);
+                break;
+            case nnil_clamp:
+                CHECK_WITH_ERR(depth >= 3, nncase_errc::nnil_illegal_instruction);
+                if (last_is_ldc(2) && p.ops.back().dest == depth - 1 && p.ops[p.ops.size() - 2].dest == depth - 2)
+                {
+                    pop.imm_c = true;
+                    pop.imm2 = p.ops.back().imm;
+                    p.ops.pop_back();
+                    pop.imm = p.ops.back().imm;
+                    p.ops.pop_back();
+                }
+                else
+                {
+                    pop.src2 = (uint8_t)(depth - 2);
+                }
+                depth -= 2;
+                pop.dest = pop.src = (uint8_t)(depth - 1);
+                break;
+            case nnil_ret:
+                CHECK_WITH_ERR(depth >= 1, nncase_errc::nnil_illegal_instruction);
+                p.result = (int32_t)(depth - 1);
+                return ok();
+            default:
+                return err(nncase_errc::nnil_illegal_instruction);
+            }
+
+            p.ops.emplace_back(pop);
+        }
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    return ok();
+}
+
+template <class F>
+void unary_loop(float *a, size_t n, F &&f) noexcept
+{
+    for (size_t i = 0; i < n; i++)
+        a[i] = f(a[i]);
+}
+
+template <class F>
+void binary_loop(const plan_op &op, float *regs, size_t n, F &&f) noexcept
+{
+    auto a = regs + op.dest * block_size;
+    if (op.imm_b)
+    {
+        const auto b = op.imm;
+        for (size_t i = 0; i < n; i++)
+            a[i] = f(a[i], b);
+    }
+    else
+    {
+        auto b = regs + op.src2 * block_size;
+        for (size_t i = 0; i < n; i++)
+            a[i] = f(a[i], b[i]);
+    }
+}
+
+// Scalar math is kept identical to reference::nnil_unary_method, so results are bit exact.
+// load_arg(index, dest) fills dest with n elements of argument index, returns the result register.
+template <class TLoadArg>
+const float *run_block(const plan &p, TLoadArg &&load_arg, size_t n, float *regs) noexcept
+{
+    for (auto &op : p.ops)
+    {
+        auto dest = regs + op.dest * block_size;
+        switch (op.opcode)
+        {
+        case nnil_dup:
+            std::copy_n(regs + op.src * block_size, n, dest);
+            break;
+        case nnil_lda:
+            load_arg(op.src, dest);
+            break;
+        case nnil_ldc_r4:
+            std::fill_n(dest, n, op.imm);
+            break;
+        case nnil_abs:
+            unary_loop(dest, n, [](float v) { return fabsf(v); });
+            break;
+        case nnil_acos:
+            unary_loop(dest, n, [](float v) { return acosf(v); });
+            break;
+        case nnil_asin:
+            unary_loop(dest, n, [](float v) { return (float)asin(v); });
+            break;
+        case nnil_ceil:
+            unary_loop(dest, n, [](float v) { return ceilf(v); });
+            break;
+        case nnil_cos:
+            unary_loop(dest, n, [](float v) { return cosf(v); });
+            break;
+        case nnil_exp:
+            unary_loop(dest, n, [](float v) { return expf(v); });
+            break;
+        case nnil_floor:
+            unary_loop(dest, n, [](float v) { return floorf(v); });
+            break;
+        case nnil_erf:
+            unary_loop(dest, n, [](float v) { return erff(v); });
+            break;
+        case nnil_log:
+            unary_loop(dest, n, [](float v) { return logf(v); });
+            break;
+        case nnil_logical_not:
+            unary_loop(dest, n, [](float v) { return (float)!v; });
+            break;
+        case nnil_neg:
+            unary_loop(dest, n, [](float v) { return -v; });
+            break;
+        case nnil_round:
+            unary_loop(dest, n, [](float v) { return roundf(v); });
+            break;
+        case nnil_rsqrt:
+            unary_loop(dest, n, [](float v) { return 1.f / sqrtf(v); });
+            break;
+        case nnil_sign:
+            unary_loop(dest, n, [](float v) { return (float)((0 < v) - (v < 0)); });
+            break;
+        case nnil_sin:
+            unary_loop(dest, n, [](float v) { return sinf(v); });
+            break;
+        case nnil_sqrt:
+            unary_loop(dest, n, [](float v) { return sqrtf(v); });
+            break;
+        case nnil_square:
+            unary_loop(dest, n, [](float v) { return v * v; });
+            break;
+        case nnil_tanh:
+            unary_loop(dest, n, [](float v) { return tanhf(v); });
+            break;
+        case nnil_add:
+            binary_loop(op, regs, n, [](float a, float b) { return a + b; });
+            break;
+        case nnil_sub:
+            binary_loop(op, regs, n, [](float a, float b) { return a - b; });
+            break;
+        case nnil_mul:
+            binary_loop(op, regs, n, [](float a, float b) { return a * b; });
+            break;
+        case nnil_div:
+            binary_loop(op, regs, n, [](float a, float b) { return a / b; });
+            break;
+        case nnil_min:
+            binary_loop(op, regs, n, [](float a, float b) { return std::min(a, b); });
+            break;
+        case nnil_max:
+            binary_loop(op, regs, n, [](float a, float b) { return std::max(a, b); });
+            break;
+        case nnil_pow:
+            binary_loop(op, regs, n, [](float a, float b) { return (float)std::pow(a, b); });
+            break;
+        case nnil_clamp:
+            if (op.imm_c)
+            {
+                const auto low = op.imm, high = op.imm2;
+                for (size_t i = 0; i < n; i++)
+                    dest[i] = clamp(dest[i], low, high);
+            }
+            else
+            {
+                auto low = regs + op.src2 * block_size;
+                auto high = low + block_size;
+                for (size_t i = 0; i < n; i++)
+                    dest[i] = clamp(dest[i], low[i], high[i]);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return regs + p.result * block_size;
+}
+
+// Merges adjacent dimensions that every tensor walks contiguously, strides[t] are the
+// broadcast strides of tensor t over shape (0 on broadcast dimensions)
+void fold_dims(runtime_shape_t &shape, std::vector<runtime_shape_t> &strides) noexcept
+{
+    runtime_shape_t new_shape;
+    std::vector<runtime_shape_t> new_strides(strides.size());
+    for (size_t d = shape.size(); d-- > 0;)
+    {
+        if (shape[d] == 1)
+            continue;
+
+        bool merge = !new_shape.empty();
+        for (size_t t = 0; t < strides.size() && merge; t++)
+            merge = strides[t][d] == new_strides[t].back() * new_shape.back();
+
+        if (merge)
+        {
+            new_shape.back() *= shape[d];
+        }
+        else
+        {
+            new_shape.push_back(shape[d]);
+            for (size_t t = 0; t < strides.size(); t++)
+                new_strides[t].push_back(strides[t][d]);
+        }
+    }
+
+    if (new_shape.empty())
+    {
+        new_shape.push_back(1);
+        for (auto &s : new_strides)
+            s.push_back(0);
+    }
+
+    std::reverse(new_shape.begin(), new_shape.end());
+    for (auto &s : new_strides)
+        std::reverse(s.begin(), s.end());
+    shape = std::move(new_shape);
+    strides = std::move(new_strides);
+}
+}
+
+result<void> optimized::nnil_unary_method(const float *input, float *output, size_t count, gsl::span<const gsl::byte> body, kernel_context &context) noexcept
+{
+    plan p;
+    try_(compile(body, 1, p));
+    if (p.result < 0 || !count)
+        return ok();
+
+    const size_t blocks = (count + block_size - 1) / block_size;
+    const size_t threads = count >= parallel_threshold ? std::max<size_t>(1, std::min<size_t>(context.num_threads, blocks)) : 1;
+    const size_t regs_size = p.registers * block_size;
+    try_var(workspace, context.workspace<float>(regs_size * threads));
+
+    // Each thread runs a contiguous range of blocks on its own registers
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (size_t t = 0; t < threads; t++)
+    {
+        auto regs = workspace + t * regs_size;
+        for (size_t b = blocks * t / threads; b < blocks * (t + 1) / threads; b++)
+        {
+            auto offset = b * block_size;
+            auto n = std::min(block_size, count - offset);
+            auto result = run_block(
+                p, [&](NNCASE_UNUSED uint8_t arg, float *dest) { std::copy_n(input + offset, n, dest); }, n, regs);
+            std::copy_n(result, n, output + offset);
+        }
+    }
+
+    return ok();
+}
+
+result<void> optimized::nnil_elementwise(gsl::span<const float *const> inputs, gsl::span<const runtime_shape_t> in_shapes, gsl::span<const runtime_shape_t> in_strides,
+    float *output, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, gsl::span<const gsl::byte> body, kernel_context &context) noexcept
+{
+    CHECK_WITH_ERR(in_shapes.size() == inputs.size() && in_strides.size() == inputs.size(), std::errc::invalid_argument);
+    plan p;
+    try_(compile(body, inputs.size(), p));
+    const auto count = compute_size(out_shape);
+    if (p.result < 0 || !count)
+        return ok();
+
+    // Broadcast strides of every input over out_shape, the output goes last
+    const auto rank = out_shape.size();
+    auto shape = out_shape;
+    std::vector<runtime_shape_t> strides(inputs.size() + 1, runtime_shape_t(rank, 0));
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        auto &in_shape = in_shapes[i];
+        CHECK_WITH_ERR(in_shape.size() <= rank && in_strides[i].size() == in_shape.size(), std::errc::invalid_argument);
+        const auto ext = rank - in_shape.size();
+        for (size_t d = 0; d < in_shape.size(); d++)
+        {
+            CHECK_WITH_ERR(in_shape[d] == out_shape[d + ext] || in_shape[d] == 1, nncase_errc::shape_mismatch);
+            if (in_shape[d] != 1)
+                strides[i][d + ext] = in_strides[i][d];
+        }
+    }
+    std::copy(out_strides.begin(), out_strides.end(), strides.back().begin());
+    fold_dims(shape, strides);
+
+    // Work items are blocks of the innermost dimension
+    const auto inner = shape.back();
+    const auto row_blocks = (inner + block_size - 1) / block_size;
+    const auto rows = count / inner;
+    const auto items = rows * row_blocks;
+    const size_t threads = count >= parallel_threshold ? std::max<size_t>(1, std::min<size_t>(context.num_threads, items)) : 1;
+    const size_t regs_size = p.registers * block_size;
+    try_var(workspace, context.workspace<float>(regs_size * threads));
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (size_t t = 0; t < threads; t++)
+    {
+        auto regs = workspace + t * regs_size;
+        runtime_shape_t offsets(strides.size());
+        for (size_t item = items * t / threads; item < items * (t + 1) / threads; item++)
+        {
+            const auto row = item / row_blocks;
+            const auto begin = item % row_blocks * block_size;
+            const auto n = std::min(block_size, inner - begin);
+
+            // Offsets of the first element of this block in every tensor
+            std::fill(offsets.begin(), offsets.end(), 0);
+            for (size_t d = shape.size() - 1, r = row; d-- > 0;)
+            {
+                const auto i = r % shape[d];
+                r /= shape[d];
+                for (size_t k = 0; k < strides.size(); k++)
+                    offsets[k] += i * strides[k][d];
+            }
+            for (size_t k = 0; k < strides.size(); k++)
+                offsets[k] += begin * strides[k].back();
+
+            auto result = run_block(
+                p, [&](uint8_t arg, float *dest) {
+                    auto src = inputs[arg] + offsets[arg];
+                    const auto stride = strides[arg].back();
+                    if (stride == 0)
+                        std::fill_n(dest, n, *src);
+                    else if (stride == 1)
+                        std::copy_n(src, n, dest);
+                    else
+                        for (size_t i = 0; i < n; i++)
+                            dest[i] = src[i * stride];
+                },
+                n, regs);
+
+            auto dest = output + offsets.back();
+            const auto out_stride = strides.back().back();
+            if (out_stride == 1)
+                std::copy_n(result, n, dest);
+            else
+                for (size_t i = 0; i < n; i++)
+                    dest[i * out_stride] = result[i];
+        }
+    }
+
+    return ok();
+}
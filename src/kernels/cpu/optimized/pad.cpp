@@ -0,0 +1,148 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "copy_rows.h"
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Input index every output index of an axis reads, -1 for constant padding
+std::vector<ptrdiff_t> pad_axis(size_t in_size, size_t out_size, const padding &pad, pad_mode_t mode)
+{
+    const auto in = (ptrdiff_t)in_size;
+    std::vector<ptrdiff_t> index(out_size);
+    for (size_t o = 0; o < out_size; o++)
+    {
+        auto i = (ptrdiff_t)o - pad.before;
+        if (i < 0)
+        {
+            if (mode == pad_reflect)
+                i = -i;
+            else if (mode == pad_symmetric)
+                i = -i - 1;
+            else
+                i = mode == pad_edge ? 0 : -1;
+        }
+        else if (i >= in)
+        {
+            if (mode == pad_reflect)
+                i = 2 * in - 2 - i;
+            else if (mode == pad_symmetric)
+                i = 2 * in - 1 - i;
+            else
+                i = mode == pad_edge ? in - 1 : -1;
+        }
+
+        index[o] = i;
+    }
+    return index;
+}
+
+template <class T>
+result<void> pad_impl(const T *input, T *output, runtime_shape_t in_shape, runtime_shape_t in_strides, runtime_shape_t out_strides,
+    runtime_paddings_t paddings, pad_mode_t mode, T pad_value, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    // Unpadded neighbouring axes are merged so the last axis holds the longest rows
+    for (size_t i = in_shape.size() - 1; i > 0; i--)
+    {
+        auto unpadded = [&](size_t axis) { return paddings[axis].before == 0 && paddings[axis].after == 0; };
+        if (unpadded(i - 1) && unpadded(i) && in_strides[i - 1] == in_strides[i] * in_shape[i] && out_strides[i - 1] == out_strides[i] * in_shape[i])
+        {
+            in_shape[i - 1] *= in_shape[i];
+            in_strides[i - 1] = in_strides[i];
+            out_strides[i - 1] = out_strides[i];
+            in_shape.erase(in_shape.begin() + i);
+            in_strides.erase(in_strides.begin() + i);
+            out_strides.erase(out_strides.begin() + i);
+            paddings.erase(paddings.begin() + i);
+        }
+    }
+
+    const auto dims = in_shape.size();
+    runtime_shape_t out_shape(dims);
+    std::vector<std::vector<ptrdiff_t>> index(dims);
+    for (size_t i = 0; i < dims; i++)
+    {
+        out_shape[i] = (size_t)((ptrdiff_t)in_shape[i] + paddings[i].sum());
+        index[i] = pad_axis(in_shape[i], out_shape[i], paddings[i], mode);
+    }
+
+    const auto out_w = out_shape.back();
+    const auto in_step = in_strides.back(), out_step = out_strides.back();
+    const auto &x_index = index.back();
+    // columns read straight from the input row
+    const auto x_begin = (size_t)std::clamp<ptrdiff_t>(paddings.back().before, 0, out_w);
+    const auto x_end = (size_t)std::clamp<ptrdiff_t>(paddings.back().before + (ptrdiff_t)in_shape.back(), x_begin, out_w);
+
+    const auto rows = (int32_t)(compute_size(out_shape) / std::max<size_t>(out_w, 1));
+#ifdef NNCASE_OPENMP
+    const auto threads = copy_threads(compute_size(out_shape) * sizeof(T), context);
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (int32_t row = 0; row < rows; row++)
+    {
+        // map the outer index of the output row to the input row it reads, if any
+        ptrdiff_t in_offset = 0;
+        size_t out_offset = 0, rest = row;
+        bool pad_row = false;
+        for (size_t i = dims - 1; i-- > 0;)
+        {
+            const auto o = rest % out_shape[i];
+            rest /= out_shape[i];
+            out_offset += o * out_strides[i];
+            pad_row |= index[i][o] < 0;
+            in_offset += index[i][o] * (ptrdiff_t)in_strides[i];
+        }
+
+        auto out = output + out_offset;
+        if (pad_row)
+        {
+            copy_row(&pad_value, out, out_w, 0, out_step);
+            continue;
+        }
+
+        auto in = input + in_offset;
+        for (size_t x = 0; x < x_begin; x++)
+            out[x * out_step] = x_index[x] < 0 ? pad_value : in[x_index[x] * in_step];
+        if (x_end > x_begin)
+            copy_row(in + x_index[x_begin] * in_step, out + x_begin * out_step, x_end - x_begin, in_step, out_step);
+        for (size_t x = x_end; x < out_w; x++)
+            out[x * out_step] = x_index[x] < 0 ? pad_value : in[x_index[x] * in_step];
+    }
+    return ok();
+}
+}
+
+#define PAD_IMPL(size, type) \
+    case size:               \
+        return pad_impl(reinterpret_cast<const type *>(input), reinterpret_cast<type *>(output), in_shape, in_strides, out_strides, paddings, mode, pad_value.as<type>(), context)
+
+result<void> optimized::pad(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode,
+    const scalar &pad_value, kernel_context &context) noexcept
+{
+    // interior padding is left to the reference kernel
+    if (in_shape.empty() || std::any_of(paddings.begin(), paddings.end(), [](const padding &p) { return p.interior != 0; }))
+        return err(std::errc::not_supported);
+    TYPE_IMPL_SELECT(type, PAD_IMPL);
+}
@@ -16,6 +16,10 @@
 #include <nncase/kernels/kernel_utils.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
+#if defined(X86_64_SIMD_ON)
+#include <immintrin.h>
+#endif
+
 using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::kernels;
@@ -55,17 +59,63 @@ void riscv_quantize(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, si
 }
 #endif
 
+template <class TQ>
+TQ quantize_one(float value, float scale, float bias) noexcept
+{
+    // same steps as reference::quantize, lrintf of a value beyond int32 wraps the same way
+    auto qvalue = (int32_t)lrintf(value * scale + bias);
+    return (TQ)kernels::detail::clamp(qvalue, (int32_t)std::numeric_limits<TQ>::lowest(), (int32_t)std::numeric_limits<TQ>::max());
+}
+
+#if defined(X86_64_SIMD_ON)
+// Quantizes 32 values, false if one of them is beyond int32 or NaN and needs the scalar path
+template <class TQ>
+bool avx2_quantize_32(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, __m256 scale, __m256 bias) noexcept
+{
+    const auto abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const auto int32_limit = _mm256_set1_ps(2147483648.f);
+    __m256 values[4];
+    __m256 out_of_range = _mm256_setzero_ps();
+    for (size_t j = 0; j < 4; j++)
+    {
+        // a separate multiply and add, rounded twice like the reference
+        values[j] = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(input + j * 8), scale), bias);
+        out_of_range = _mm256_or_ps(out_of_range, _mm256_cmp_ps(_mm256_and_ps(values[j], abs_mask), int32_limit, _CMP_NLT_UQ));
+    }
+    if (_mm256_movemask_ps(out_of_range))
+        return false;
+
+    // rounds to nearest even as lrintf does, then saturates through int16 to the 8 bit range
+    auto lo = _mm256_packs_epi32(_mm256_cvtps_epi32(values[0]), _mm256_cvtps_epi32(values[1]));
+    auto hi = _mm256_packs_epi32(_mm256_cvtps_epi32(values[2]), _mm256_cvtps_epi32(values[3]));
+    auto packed = std::is_signed_v<TQ> ? _mm256_packs_epi16(lo, hi) : _mm256_packus_epi16(lo, hi);
+    // packs work within 128 bit lanes, put the 4 byte groups back in order
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output), packed);
+    return true;
+}
+#endif
+
 template <class TQ>
 result<void> quantize(const float *CXX_RESTRICT input, TQ *CXX_RESTRICT output, size_t count, float scale, float bias)
 {
 #if __riscv
     riscv_quantize(input, output, count, scale, bias);
 #else
-    for (size_t i = 0; i < count; i++)
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    const auto vscale = _mm256_set1_ps(scale), vbias = _mm256_set1_ps(bias);
+    for (; i + 32 <= count; i += 32)
     {
-        auto qvalue = (int32_t)std::nearbyintf(input[i] * scale + bias);
-        output[i] = (TQ)kernels::detail::clamp(qvalue, (int32_t)std::numeric_limits<TQ>::lowest(), (int32_t)std::numeric_limits<TQ>::max());
+        if (!avx2_quantize_32(input + i, output + i, vscale, vbias))
+        {
+            for (size_t j = i; j < i + 32; j++)
+                output[j] = quantize_one<TQ>(input[j], scale, bias);
+        }
     }
+#endif
+    for (; i < count; i++)
+        output[i] = quantize_one<TQ>(input[i], scale, bias);
 #endif
     return ok();
 }
@@ -0,0 +1,168 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cmath>
+#include <nncase/kernels/cpu/optimized/runtime_types.h>
+#include <nncase/kernels/kernel_context.h>
+
+#if defined(X86_64_SIMD_ON)
+#include "x86_64/avx_mathfun.h"
+#endif
+
+// GEMM and gate activation helpers shared by the GRU and LSTM kernels
+
+BEGIN_NS_NNCASE_KERNELS_CPU_OPT
+
+// Smaller GEMMs are not worth waking up the thread pool
+constexpr size_t gemm_parallel_threshold = 32 * 1024;
+
+#if defined(X86_64_SIMD_ON)
+// out[j] = dot(a, b[j]) for 4 consecutive rows of b
+inline void dot4(const float *a, const float *b, size_t ldb, size_t k, float *out) noexcept
+{
+    auto b0 = b, b1 = b + ldb, b2 = b + 2 * ldb, b3 = b + 3 * ldb;
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= k; i += 8)
+    {
+        auto va = _mm256_loadu_ps(a + i);
+        s0 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b0 + i), s0);
+        s1 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b1 + i), s1);
+        s2 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b2 + i), s2);
+        s3 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b3 + i), s3);
+    }
+
+    out[0] = _mm256_reduce_add_ps(s0);
+    out[1] = _mm256_reduce_add_ps(s1);
+    out[2] = _mm256_reduce_add_ps(s2);
+    out[3] = _mm256_reduce_add_ps(s3);
+    for (; i < k; i++)
+    {
+        out[0] += a[i] * b0[i];
+        out[1] += a[i] * b1[i];
+        out[2] += a[i] * b2[i];
+        out[3] += a[i] * b3[i];
+    }
+}
+
+inline float dot(const float *a, const float *b, size_t k) noexcept
+{
+    __m256 s = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= k; i += 8)
+        s = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s);
+    auto sum = _mm256_reduce_add_ps(s);
+    for (; i < k; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+// out = sigmoid(a + b)
+inline void add_sigmoid(const float *a, const float *b, float *out, size_t n) noexcept
+{
+    size_t i = 0;
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8)
+    {
+        auto x = _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        auto e = exp256_ps(_mm256_sub_ps(zero, x));
+        _mm256_storeu_ps(out + i, _mm256_div_ps(one, _mm256_add_ps(one, e)));
+    }
+    for (; i < n; i++)
+        out[i] = 1.f / (1.f + std::exp(-(a[i] + b[i])));
+}
+
+// out = tanh(a + b)
+inline void add_tanh(const float *a, const float *b, float *out, size_t n) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, tanh256_ps(_mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i))));
+    for (; i < n; i++)
+        out[i] = std::tanh(a[i] + b[i]);
+}
+#else
+inline void dot4(const float *a, const float *b, size_t ldb, size_t k, float *out) noexcept
+{
+    auto b0 = b, b1 = b + ldb, b2 = b + 2 * ldb, b3 = b + 3 * ldb;
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (size_t i = 0; i < k; i++)
+    {
+        auto va = a[i];
+        s0 += va * b0[i];
+        s1 += va * b1[i];
+        s2 += va * b2[i];
+        s3 += va * b3[i];
+    }
+
+    out[0] = s0;
+    out[1] = s1;
+    out[2] = s2;
+    out[3] = s3;
+}
+
+inline float dot(const float *a, const float *b, size_t k) noexcept
+{
+    float sum = 0;
+    for (size_t i = 0; i < k; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+inline void add_sigmoid(const float *a, const float *b, float *out, size_t n) noexcept
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = 1.f / (1.f + std::exp(-(a[i] + b[i])));
+}
+
+inline void add_tanh(const float *a, const float *b, float *out, size_t n) noexcept
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = std::tanh(a[i] + b[i]);
+}
+#endif
+
+// c[i, j] = dot(a[i], b[j]) + bias[j], a: [m, k], b: [n, k], c: [m, ldc], bias may be null
+inline void gemm_nt(const float *a, const float *b, const float *bias, float *c, size_t m, size_t n, size_t k, size_t ldc,
+    NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const size_t n_blocks = n / 4;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for collapse(2) num_threads(context.num_threads) if (m * n * k >= gemm_parallel_threshold)
+#endif
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t nb = 0; nb < n_blocks; nb++)
+        {
+            auto j = nb * 4;
+            auto out = c + i * ldc + j;
+            dot4(a + i * k, b + j * k, k, k, out);
+            if (bias)
+            {
+                for (size_t q = 0; q < 4; q++)
+                    out[q] += bias[j + q];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = n_blocks * 4; j < n; j++)
+            c[i * ldc + j] = dot(a + i * k, b + j * k, k) + (bias ? bias[j] : 0.f);
+    }
+}
+
+END_NS_NNCASE_KERNELS_CPU_OPT
@@ -0,0 +1,105 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#ifdef NNCASE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+template <bool Mean, class TBinaryOp>
+result<void> reduce_window2d_nhwc_impl(const float *input, float init_value, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w,
+    value_range<float> fused_activation, TBinaryOp &&binary_op, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const auto channels = in_shape[1];
+    const auto in_h = (int32_t)in_shape[2], in_w = (int32_t)in_shape[3];
+    const auto out_h = (int32_t)kernels::detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h);
+    const auto out_w = (int32_t)kernels::detail::get_windowed_output_size(in_shape[3], filter_w, stride_w, dilation_w, padding_w);
+
+    const auto rows = (int32_t)in_shape[0] * out_h;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int32_t row = 0; row < rows; row++)
+    {
+        const auto batch = (size_t)(row / out_h);
+        const auto oy = row % out_h;
+        const auto in_y_origin = oy * stride_h - padding_h.before;
+        const auto ky_start = std::max(0, (-in_y_origin + dilation_h - 1) / dilation_h);
+        const auto ky_end = std::min(filter_h, (in_h - in_y_origin + dilation_h - 1) / dilation_h);
+        const auto in_batch = input + batch * in_strides[0];
+
+        for (int32_t ox = 0; ox < out_w; ox++)
+        {
+            const auto in_x_origin = ox * stride_w - padding_w.before;
+            const auto kx_start = std::max(0, (-in_x_origin + dilation_w - 1) / dilation_w);
+            const auto kx_end = std::min(filter_w, (in_w - in_x_origin + dilation_w - 1) / dilation_w);
+            auto out = output + batch * out_strides[0] + oy * out_strides[2] + ox * out_strides[3];
+            for (size_t c = 0; c < channels; c++)
+                out[c] = init_value;
+
+            for (int32_t ky = ky_start; ky < ky_end; ky++)
+            {
+                const auto in_row = in_batch + (in_y_origin + ky * dilation_h) * in_strides[2];
+                for (int32_t kx = kx_start; kx < kx_end; kx++)
+                {
+                    const auto in = in_row + (in_x_origin + kx * dilation_w) * in_strides[3];
+                    for (size_t c = 0; c < channels; c++)
+                        out[c] = binary_op(out[c], in[c]);
+                }
+            }
+
+            // mean only counts the taps inside the input, like the reference kernel
+            const auto count = (float)((ky_end - ky_start) * (kx_end - kx_start));
+            for (size_t c = 0; c < channels; c++)
+                out[c] = kernels::detail::apply_activation(Mean ? out[c] / count : out[c], fused_activation);
+        }
+    }
+
+    return ok();
+}
+}
+
+#define REDUCE_WINDOW2D_NHWC_IMPL(op, mean, reducer) \
+    case op:                                         \
+        return reduce_window2d_nhwc_impl<mean>(input, init_value, output, in_shape, in_strides, out_strides, padding_h, padding_w, filter_h, filter_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation, reducer, context)
+
+result<void> optimized::reduce_window2d_nhwc(reduce_op_t op, const float *input, float init_value, float *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    kernel_context &context) noexcept
+{
+    auto plus = [](float a, float b) { return a + b; };
+    auto min = [](float a, float b) { return std::min(a, b); };
+    auto max = [](float a, float b) { return std::max(a, b); };
+    switch (op)
+    {
+        REDUCE_WINDOW2D_NHWC_IMPL(reduce_mean, true, plus);
+        REDUCE_WINDOW2D_NHWC_IMPL(reduce_min, false, min);
+        REDUCE_WINDOW2D_NHWC_IMPL(reduce_max, false, max);
+        REDUCE_WINDOW2D_NHWC_IMPL(reduce_sum, false, plus);
+    default:
+        return err(std::errc::not_supported);
+    }
+}
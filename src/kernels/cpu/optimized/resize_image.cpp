@@ -12,8 +12,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstring>
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <vector>
+
+#if defined(X86_64_SIMD_ON)
+#include <immintrin.h>
+#endif
 
 using namespace nncase;
 using namespace nncase::runtime;
@@ -23,56 +31,180 @@ using namespace nncase::kernels::cpu::optimized;
 
 namespace
 {
+// uint8 bilinear weights are fixed point with 1 << resize_coef_bits as 1.0, which keeps
+// a vertical blend of two horizontal blends of 8 bit pixels within int32
+constexpr int32_t resize_coef_bits = 11;
+constexpr int32_t resize_coef_one = 1 << resize_coef_bits;
+
+// Source taps and weights of every output row or column, shared by all channels
+struct bilinear_axis
+{
+    bilinear_axis(size_t out_size, size_t in_size, float scale, bool half_pixel_centers)
+        : i0(out_size), i1(out_size), frac(out_size), frac_q(out_size)
+    {
+        for (size_t o = 0; o < out_size; o++)
+        {
+            float in;
+            kernels::detail::set_resize_bilinear(o, scale, half_pixel_centers, in_size, in, i0[o], i1[o]);
+            frac[o] = in - i0[o];
+            // taps clamped at the border read one pixel twice, so any weight gives the same result
+            frac_q[o] = i0[o] == i1[o] ? 0 : (int32_t)std::lround(frac[o] * resize_coef_one);
+        }
+    }
+
+    std::vector<int32_t> i0;
+    std::vector<int32_t> i1;
+    std::vector<float> frac;
+    std::vector<int32_t> frac_q;
+};
+
+std::vector<size_t> nearest_axis(size_t out_size, size_t in_size, float scale, bool align_corners, bool half_pixel_centers)
+{
+    std::vector<size_t> index(out_size);
+    for (size_t o = 0; o < out_size; o++)
+        index[o] = kernels::detail::get_nearest_neighbor(o, in_size, scale, align_corners, half_pixel_centers);
+    return index;
+}
+
+// Number of row bands each plane is split into, so a few large planes still keep every thread busy
+size_t resize_bands(size_t planes, int32_t out_h, kernel_context &context) noexcept
+{
+    return std::clamp<size_t>((context.num_threads + planes - 1) / planes, 1, out_h);
+}
 
 template <class T>
-result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
-    NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, NNCASE_UNUSED bool half_pixel_centers, NNCASE_UNUSED kernel_context &context) noexcept
+struct bilinear_acc
+{
+    using type = float;
+};
+
+template <>
+struct bilinear_acc<uint8_t>
+{
+    using type = int32_t;
+};
+
+template <class T>
+void horizontal_pass(const T *in_row, float *out, const bilinear_axis &x, size_t out_w) noexcept
+{
+    for (size_t ox = 0; ox < out_w; ox++)
+    {
+        const auto v0 = (float)in_row[x.i0[ox]];
+        out[ox] = v0 + x.frac[ox] * ((float)in_row[x.i1[ox]] - v0);
+    }
+}
+
+void horizontal_pass(const uint8_t *in_row, int32_t *out, const bilinear_axis &x, size_t out_w) noexcept
+{
+    for (size_t ox = 0; ox < out_w; ox++)
+        out[ox] = in_row[x.i0[ox]] * (resize_coef_one - x.frac_q[ox]) + in_row[x.i1[ox]] * x.frac_q[ox];
+}
+
+template <class T>
+void vertical_pass(const float *h0, const float *h1, T *out, float fy, NNCASE_UNUSED int32_t fy_q, size_t out_w) noexcept
 {
-    auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
-    auto height_scale = scales.first;
-    auto width_scale = scales.second;
     const float rounding_offset = std::numeric_limits<T>::is_integer ? .5f : .0f;
-    runtime_shape_t in_index(4), out_index(4);
+    for (size_t ox = 0; ox < out_w; ox++)
+        out[ox] = T(h0[ox] + fy * (h1[ox] - h0[ox]) + rounding_offset);
+}
 
-    const auto in_img_size = in_shape[2] * in_shape[3];
-    const auto out_img_size = out_w * out_h;
+void vertical_pass(const float *h0, const float *h1, float *out, float fy, NNCASE_UNUSED int32_t fy_q, size_t out_w) noexcept
+{
+    size_t ox = 0;
+#if defined(X86_64_SIMD_ON)
+    const auto vfy = _mm256_set1_ps(fy);
+    for (; ox + 8 <= out_w; ox += 8)
+    {
+        const auto v0 = _mm256_loadu_ps(h0 + ox);
+        _mm256_storeu_ps(out + ox, _mm256_fmadd_ps(vfy, _mm256_sub_ps(_mm256_loadu_ps(h1 + ox), v0), v0));
+    }
+#endif
+    for (; ox < out_w; ox++)
+        out[ox] = h0[ox] + fy * (h1[ox] - h0[ox]);
+}
 
-    for (size_t batch = 0; batch < in_shape[0]; batch++)
+void vertical_pass(const int32_t *h0, const int32_t *h1, uint8_t *out, NNCASE_UNUSED float fy, int32_t fy_q, size_t out_w) noexcept
+{
+    constexpr int32_t shift = resize_coef_bits * 2;
+    constexpr int32_t half = 1 << (shift - 1);
+    size_t ox = 0;
+#if defined(X86_64_SIMD_ON)
+    const auto w0 = _mm256_set1_epi32(resize_coef_one - fy_q), w1 = _mm256_set1_epi32(fy_q), vhalf = _mm256_set1_epi32(half);
+    for (; ox + 8 <= out_w; ox += 8)
     {
-        auto in_batch = input + (size_t)batch * in_shape[1] * in_img_size;
-        auto *begin_output_ptr = output + batch * in_shape[1] * out_w * out_h;
-#ifdef NNCASE_OPENMP
-#pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
+        auto sum = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h0 + ox)), w0),
+            _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h1 + ox)), w1));
+        sum = _mm256_srli_epi32(_mm256_add_epi32(sum, vhalf), shift);
+        const auto words = _mm_packus_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + ox), _mm_packus_epi16(words, words));
+    }
 #endif
-        for (size_t oc = 0; oc < in_shape[1]; oc++)
+    for (; ox < out_w; ox++)
+        out[ox] = (uint8_t)((h0[ox] * (resize_coef_one - fy_q) + h1[ox] * fy_q + half) >> shift);
+}
+
+// Bilinear rows [oy_begin, oy_end) of one NCHW plane, rows holds two horizontally blended source rows
+template <class T>
+void resize_bilinear_rows(const T *input, T *output, size_t in_w, size_t out_w, const bilinear_axis &y, const bilinear_axis &x,
+    size_t oy_begin, size_t oy_end, typename bilinear_acc<T>::type *rows) noexcept
+{
+    // Blended source rows are kept across output rows, upscaling reuses them on most rows
+    auto h0 = rows, h1 = rows + out_w;
+    int32_t row0 = -1, row1 = -1;
+    for (size_t oy = oy_begin; oy < oy_end; oy++)
+    {
+        const auto y0 = y.i0[oy], y1 = y.i1[oy];
+        if (y0 != row0)
         {
-            auto in_c = in_batch + (size_t)oc * in_img_size;
-            auto *output_ptr = begin_output_ptr + oc * out_img_size;
-            for (int oy = 0; oy < out_h; oy++)
+            if (y0 == row1)
             {
-                float in_y;
-                int32_t in_y0, in_y1;
-                kernels::detail::set_resize_bilinear(oy, height_scale, half_pixel_centers, in_shape[2], in_y, in_y0, in_y1);
+                std::swap(h0, h1);
+                std::swap(row0, row1);
+            }
+            else
+            {
+                horizontal_pass(input + y0 * in_w, h0, x, out_w);
+                row0 = y0;
+            }
+        }
 
-                for (int ox = 0; ox < out_w; ox++)
-                {
-                    float in_x;
-                    int32_t in_x0, in_x1;
-                    kernels::detail::set_resize_bilinear(ox, width_scale, half_pixel_centers, in_shape[3], in_x, in_x0, in_x1);
+        if (y1 != y0 && y1 != row1)
+        {
+            horizontal_pass(input + y1 * in_w, h1, x, out_w);
+            row1 = y1;
+        }
 
-                    auto v0 = in_c[in_y0 * in_shape[3] + in_x0];
-                    auto v1 = in_c[in_y1 * in_shape[3] + in_x0];
-                    auto v2 = in_c[in_y0 * in_shape[3] + in_x1];
-                    auto v3 = in_c[in_y1 * in_shape[3] + in_x1];
+        vertical_pass(h0, y1 == y0 ? h0 : h1, output + oy * out_w, y.frac[oy], y.frac_q[oy], out_w);
+    }
+}
 
-                    auto a0 = (1 - (in_y - in_y0)) * (1 - (in_x - in_x0));
-                    auto a1 = (in_y - in_y0) * (1 - (in_x - in_x0));
-                    auto a2 = (1 - (in_y - in_y0)) * (in_x - in_x0);
-                    auto a3 = (in_y - in_y0) * (in_x - in_x0);
+template <class T>
+result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
+    NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers, kernel_context &context) noexcept
+{
+    using acc_t = typename bilinear_acc<T>::type;
+    auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
+    const bilinear_axis y_axis(out_h, in_shape[2], scales.first, half_pixel_centers);
+    const bilinear_axis x_axis(out_w, in_shape[3], scales.second, half_pixel_centers);
 
-                    *output_ptr++ = T(v0 * a0 + v1 * a1 + v2 * a2 + v3 * a3 + rounding_offset);
-                }
-            }
+    const auto in_img_size = in_shape[2] * in_shape[3];
+    const auto out_img_size = (size_t)out_h * out_w;
+    const auto planes = in_shape[0] * in_shape[1];
+    const auto bands = resize_bands(planes, out_h, context);
+    const auto units = planes * bands;
+    const auto threads = (int32_t)std::max<size_t>(1, std::min<size_t>(context.num_threads, units));
+    try_var(rows, context.workspace<acc_t>(2 * out_w * threads));
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (int32_t t = 0; t < threads; t++)
+    {
+        for (size_t unit = units * t / threads; unit < units * (t + 1) / threads; unit++)
+        {
+            const auto plane = unit / bands, band = unit % bands;
+            resize_bilinear_rows(input + plane * in_img_size, output + plane * out_img_size, in_shape[3], out_w, y_axis, x_axis,
+                out_h * band / bands, out_h * (band + 1) / bands, rows + t * 2 * out_w);
         }
     }
     return ok();
@@ -80,37 +212,40 @@ result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape
 
 template <class T>
 result<void> resize_nearest_neighbor_impl(const T *input, T *output, const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
-    NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers, NNCASE_UNUSED kernel_context &context) noexcept
+    NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers, kernel_context &context) noexcept
 {
     auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
-    auto height_scale = scales.first;
-    auto width_scale = scales.second;
+    const auto y_index = nearest_axis(out_h, in_shape[2], scales.first, align_corners, half_pixel_centers);
+    const auto x_index = nearest_axis(out_w, in_shape[3], scales.second, align_corners, half_pixel_centers);
 
     const auto in_image_size = in_shape[2] * in_shape[3];
-    const auto out_image_size = out_h * out_w;
-    for (size_t batch = 0; batch < in_shape[0]; batch++)
-    {
-        auto *begin_input_ptr = input + batch * in_shape[1] * in_image_size;
-        auto *begin_output_ptr = output + batch * in_shape[1] * out_image_size;
+    const auto out_image_size = (size_t)out_h * out_w;
+    const auto planes = in_shape[0] * in_shape[1];
+    const auto bands = resize_bands(planes, out_h, context);
+    const auto units = (int32_t)(planes * bands);
 #ifdef NNCASE_OPENMP
-#pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
+#pragma omp parallel for num_threads(context.num_threads)
 #endif
-        for (size_t oc = 0; oc < in_shape[1]; oc++)
-        {
-            auto *input_ptr = begin_input_ptr + oc * in_image_size;
-            auto *output_ptr = begin_output_ptr + oc * out_image_size;
+    for (int32_t unit = 0; unit < units; unit++)
+    {
+        const auto plane = (size_t)unit / bands, band = (size_t)unit % bands;
+        auto *input_ptr = input + plane * in_image_size;
+        auto *output_ptr = output + plane * out_image_size;
 
-            for (int oy = 0; oy < out_h; oy++)
+        const auto oy_begin = out_h * band / bands, oy_end = out_h * (band + 1) / bands;
+        for (size_t oy = oy_begin; oy < oy_end; oy++)
+        {
+            auto *out_row = output_ptr + oy * out_w;
+            // upscaled rows repeat the previous one
+            if (oy != oy_begin && y_index[oy] == y_index[oy - 1])
             {
-                auto in_y = kernels::detail::get_nearest_neighbor(oy, in_shape[2], height_scale, align_corners, half_pixel_centers);
-                auto *in_row = input_ptr + in_y * in_shape[3];
-
-                for (int ox = 0; ox < out_w; ox++)
-                {
-                    auto in_x = kernels::detail::get_nearest_neighbor(ox, in_shape[3], width_scale, align_corners, half_pixel_centers);
-                    *output_ptr++ = in_row[in_x];
-                }
+                std::memcpy(out_row, out_row - out_w, out_w * sizeof(T));
+                continue;
             }
+
+            auto *in_row = input_ptr + y_index[oy] * in_shape[3];
+            for (int32_t ox = 0; ox < out_w; ox++)
+                out_row[ox] = in_row[x_index[ox]];
         }
     }
     return ok();
@@ -118,7 +253,7 @@ result<void> resize_nearest_neighbor_impl(const T *input, T *output, const runti
 
 inline result<void> gnne_resize_nearest_neighbor(const bfloat16 *input, bfloat16 *output,
     const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
-    NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, NNCASE_UNUSED bool align_corners, NNCASE_UNUSED bool half_pixel_centers, NNCASE_UNUSED kernel_context &context)
+    NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, NNCASE_UNUSED bool align_corners, NNCASE_UNUSED bool half_pixel_centers, kernel_context &context)
 {
     if (align_corners || half_pixel_centers)
     {
@@ -135,7 +270,7 @@ inline result<void> gnne_resize_nearest_neighbor(const bfloat16 *input, bfloat16
         auto *begin_input_ptr = input + batch * in_shape[1] * in_image_size;
         auto *begin_output_ptr = output + batch * in_shape[1] * out_image_size;
 #ifdef NNCASE_OPENMP
-#pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
+#pragma omp parallel for num_threads(context.num_threads)
 #endif
         for (size_t oc = 0; oc < in_shape[1]; oc++)
         {
@@ -162,7 +297,7 @@ inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output
     NNCASE_UNUSED const runtime_shape_t &out_strides,
     int32_t out_h, int32_t out_w, bool align_corners,
     NNCASE_UNUSED bool half_pixel_centers,
-    NNCASE_UNUSED kernel_context &context)
+    kernel_context &context)
 {
     if (half_pixel_centers)
     {
@@ -184,7 +319,7 @@ inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output
         auto in_batch = input + (size_t)batch * in_shape[1] * in_img_size;
         auto *begin_output_ptr = output + batch * in_shape[1] * out_w * out_h;
 #ifdef NNCASE_OPENMP
-#pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
+#pragma omp parallel for num_threads(context.num_threads)
 #endif
         for (size_t oc = 0; oc < in_shape[1]; oc++)
         {
@@ -221,6 +356,91 @@ inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output
     return ok();
 }
 
+template <class T>
+void bilinear_pixel(const T *v0, const T *v1, const T *v2, const T *v3, T *out, size_t channels, const bilinear_axis &y, size_t oy,
+    const bilinear_axis &x, size_t ox) noexcept
+{
+    const float rounding_offset = std::numeric_limits<T>::is_integer ? .5f : .0f;
+    const auto fy = y.frac[oy], fx = x.frac[ox];
+    const auto a0 = (1 - fy) * (1 - fx);
+    const auto a1 = fy * (1 - fx);
+    const auto a2 = (1 - fy) * fx;
+    const auto a3 = fy * fx;
+    for (size_t c = 0; c < channels; c++)
+        out[c] = T(v0[c] * a0 + v1[c] * a1 + v2[c] * a2 + v3[c] * a3 + rounding_offset);
+}
+
+void bilinear_pixel(const uint8_t *v0, const uint8_t *v1, const uint8_t *v2, const uint8_t *v3, uint8_t *out, size_t channels,
+    const bilinear_axis &y, size_t oy, const bilinear_axis &x, size_t ox) noexcept
+{
+    constexpr int32_t shift = resize_coef_bits * 2;
+    const auto wy1 = y.frac_q[oy], wy0 = resize_coef_one - wy1;
+    const auto wx1 = x.frac_q[ox], wx0 = resize_coef_one - wx1;
+    for (size_t c = 0; c < channels; c++)
+    {
+        const auto h0 = v0[c] * wx0 + v2[c] * wx1;
+        const auto h1 = v1[c] * wx0 + v3[c] * wx1;
+        out[c] = (uint8_t)((h0 * wy0 + h1 * wy1 + (1 << (shift - 1))) >> shift);
+    }
+}
+
+template <class T>
+result<void> resize_bilinear_nhwc_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers, kernel_context &context) noexcept
+{
+    auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
+    const bilinear_axis y_axis(out_h, in_shape[2], scales.first, half_pixel_centers);
+    const bilinear_axis x_axis(out_w, in_shape[3], scales.second, half_pixel_centers);
+    const auto channels = in_shape[1];
+
+    // Interpolation weights are shared by all channels of a pixel, which are dense
+    const auto rows = (int32_t)in_shape[0] * out_h;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int32_t row = 0; row < rows; row++)
+    {
+        const auto batch = (size_t)(row / out_h);
+        const auto oy = (size_t)(row % out_h);
+        const auto in_row0 = input + batch * in_strides[0] + y_axis.i0[oy] * in_strides[2];
+        const auto in_row1 = input + batch * in_strides[0] + y_axis.i1[oy] * in_strides[2];
+        auto out = output + batch * out_strides[0] + oy * out_strides[2];
+
+        for (int32_t ox = 0; ox < out_w; ox++)
+        {
+            const auto x0 = x_axis.i0[ox] * in_strides[3], x1 = x_axis.i1[ox] * in_strides[3];
+            bilinear_pixel(in_row0 + x0, in_row1 + x0, in_row0 + x1, in_row1 + x1, out + ox * out_strides[3], channels, y_axis, oy, x_axis, ox);
+        }
+    }
+    return ok();
+}
+
+template <class T>
+result<void> resize_nearest_neighbor_nhwc_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers, kernel_context &context) noexcept
+{
+    auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
+    const auto y_index = nearest_axis(out_h, in_shape[2], scales.first, align_corners, half_pixel_centers);
+    const auto x_index = nearest_axis(out_w, in_shape[3], scales.second, align_corners, half_pixel_centers);
+    const auto channels = in_shape[1];
+
+    const auto rows = (int32_t)in_shape[0] * out_h;
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int32_t row = 0; row < rows; row++)
+    {
+        const auto batch = (size_t)(row / out_h);
+        const auto oy = (size_t)(row % out_h);
+        const auto in_row = input + batch * in_strides[0] + y_index[oy] * in_strides[2];
+        auto out = output + batch * out_strides[0] + oy * out_strides[2];
+
+        for (int32_t ox = 0; ox < out_w; ox++)
+            std::memcpy(out + ox * out_strides[3], in_row + x_index[ox] * in_strides[3], channels * sizeof(T));
+    }
+    return ok();
+}
+
 }
 
 #define FP_OR_Q_IMPL(type, KERNEL)            \
@@ -264,4 +484,45 @@ result<void> optimized::resize_nearest_neighbor(datatype_t type, const gsl::byte
     kernel_context &context) noexcept
 {
     FP_OR_Q_IMPL(type, RESIZE_NEAREST_NEIGHBOR_IMPL);
-}
\ No newline at end of file
+}
+// bfloat16 keeps the NCHW-only behaviour of the kernels above, so it is left to the reference kernels
+#define NHWC_IMPL(type, KERNEL)               \
+    switch (type)                             \
+    {                                         \
+    case dt_float32:                          \
+        return KERNEL(float);                 \
+    case dt_int8:                             \
+    case dt_uint8:                            \
+        return KERNEL(uint8_t);               \
+    case dt_int16:                            \
+    case dt_uint16:                           \
+        return KERNEL(uint16_t);              \
+    case dt_int32:                            \
+    case dt_uint32:                           \
+        return KERNEL(uint32_t);              \
+    case dt_int64:                            \
+    case dt_uint64:                           \
+        return KERNEL(uint64_t);              \
+    default:                                  \
+        return err(std::errc::not_supported); \
+    }
+
+#define RESIZE_BILINEAR_NHWC_IMPL(type) \
+    resize_bilinear_nhwc_impl(reinterpret_cast<const type *>(input), reinterpret_cast<type *>(output), in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context);
+
+#define RESIZE_NEAREST_NEIGHBOR_NHWC_IMPL(type) \
+    resize_nearest_neighbor_nhwc_impl(reinterpret_cast<const type *>(input), reinterpret_cast<type *>(output), in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context);
+
+result<void> optimized::resize_bilinear_nhwc(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
+    kernel_context &context) noexcept
+{
+    NHWC_IMPL(type, RESIZE_BILINEAR_NHWC_IMPL);
+}
+
+result<void> optimized::resize_nearest_neighbor_nhwc(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
+    const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers,
+    kernel_context &context) noexcept
+{
+    NHWC_IMPL(type, RESIZE_NEAREST_NEIGHBOR_NHWC_IMPL);
+}
@@ -0,0 +1,337 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+#if defined(X86_64_SIMD_ON)
+#include <immintrin.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Below this many scores the per anchor and per class loops stay on one thread
+constexpr size_t nms_parallel_scores = 64 * 1024;
+
+struct box_corners
+{
+    float ymin;
+    float xmin;
+    float ymax;
+    float xmax;
+};
+
+struct box_info
+{
+    int index;
+    float score;
+};
+
+float box_area(const box_corners &box) noexcept
+{
+    return (box.ymax - box.ymin) * (box.xmax - box.xmin);
+}
+
+// Same expression as the reference, so the threshold test rounds the same way
+float compute_iou(const box_corners &box_i, const box_corners &box_j) noexcept
+{
+    const float area_i = box_area(box_i);
+    const float area_j = box_area(box_j);
+    if (area_i <= 0 || area_j <= 0)
+        return 0.f;
+    const float intersection_y_min = std::max<float>(box_i.ymin, box_j.ymin);
+    const float intersection_x_min = std::max<float>(box_i.xmin, box_j.xmin);
+    const float intersection_y_max = std::min<float>(box_i.ymax, box_j.ymax);
+    const float intersection_x_max = std::min<float>(box_i.xmax, box_j.xmax);
+    const float intersection_area = std::max<float>(intersection_y_max - intersection_y_min, 0.0) * std::max<float>(intersection_x_max - intersection_x_min, 0.0);
+    return intersection_area / (area_i + area_j - intersection_area);
+}
+
+// Kept boxes in columns, so a candidate is tested against 8 of them at once
+class kept_boxes
+{
+public:
+    void clear() noexcept
+    {
+        for (auto v : { &ymin_, &xmin_, &ymax_, &xmax_, &area_ })
+            v->clear();
+        boxes_.clear();
+    }
+
+    void push_back(const box_corners &box)
+    {
+        ymin_.push_back(box.ymin);
+        xmin_.push_back(box.xmin);
+        ymax_.push_back(box.ymax);
+        xmax_.push_back(box.xmax);
+        area_.push_back(box_area(box));
+        boxes_.push_back(box);
+    }
+
+    // True if a kept box overlaps box by more than iou_threshold, stops at the first one
+    bool suppresses(const box_corners &box, float iou_threshold) const noexcept
+    {
+        const auto count = boxes_.size();
+        const auto area = box_area(box);
+        // a zero area box has zero IoU with everything
+        if (area <= 0)
+            return count && 0.f > iou_threshold;
+
+        size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+        // a NaN area makes every IoU NaN, leave that to the scalar loop
+        const auto simd_count = area > 0 ? count : 0;
+        const auto zero = _mm256_setzero_ps();
+        const auto ymin = _mm256_set1_ps(box.ymin), xmin = _mm256_set1_ps(box.xmin);
+        const auto ymax = _mm256_set1_ps(box.ymax), xmax = _mm256_set1_ps(box.xmax);
+        const bool zero_suppresses = 0.f > iou_threshold;
+        for (; i + 8 <= simd_count; i += 8)
+        {
+            // max_ps/min_ps pick their second operand on ties and NaN, like std::max/min of the reference
+            auto dy = _mm256_sub_ps(_mm256_min_ps(ymax, _mm256_loadu_ps(ymax_.data() + i)), _mm256_max_ps(ymin, _mm256_loadu_ps(ymin_.data() + i)));
+            auto dx = _mm256_sub_ps(_mm256_min_ps(xmax, _mm256_loadu_ps(xmax_.data() + i)), _mm256_max_ps(xmin, _mm256_loadu_ps(xmin_.data() + i)));
+            auto intersection = _mm256_mul_ps(_mm256_max_ps(zero, dy), _mm256_max_ps(zero, dx));
+            auto kept_area = _mm256_loadu_ps(area_.data() + i);
+
+            // lanes whose IoU is exactly zero: an empty kept box, or positive areas without overlap
+            auto iou_zero = _mm256_or_ps(_mm256_cmp_ps(kept_area, zero, _CMP_LE_OQ),
+                _mm256_and_ps(_mm256_cmp_ps(kept_area, zero, _CMP_GT_OQ), _mm256_cmp_ps(intersection, zero, _CMP_EQ_OQ)));
+            auto zero_mask = _mm256_movemask_ps(iou_zero);
+            if (zero_suppresses && zero_mask)
+                return true;
+
+            // the overlapping few take the exact scalar division
+            for (auto rest = ~zero_mask & 0xff; rest; rest &= rest - 1)
+            {
+                if (compute_iou(boxes_[i + __builtin_ctz(rest)], box) > iou_threshold)
+                    return true;
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            if (compute_iou(boxes_[i], box) > iou_threshold)
+                return true;
+        }
+        return false;
+    }
+
+    size_t size() const noexcept { return boxes_.size(); }
+
+private:
+    std::vector<float> ymin_, xmin_, ymax_, xmax_, area_;
+    std::vector<box_corners> boxes_;
+};
+
+// Greedy NMS of one score column. Candidates at or above score_threshold come out of a heap by
+// descending score, then ascending index, the order of the reference stable sort, so only the
+// visited ones get ordered. A candidate is kept unless an already kept box suppresses it; the
+// reference suppression scan ends up with the same set.
+void nms_single_class(const float *scores, size_t score_step, int num_boxes, const std::vector<box_corners> &boxes, float score_threshold,
+    float iou_threshold, int max_detections, std::vector<std::pair<float, int>> &candidates, kept_boxes &kept, std::vector<int> &selected)
+{
+    candidates.clear();
+    for (int i = 0; i < num_boxes; i++)
+    {
+        auto score = scores[i * score_step];
+        if (score >= score_threshold)
+            candidates.emplace_back(score, i);
+    }
+
+    auto worse = [](const std::pair<float, int> &a, const std::pair<float, int> &b) {
+        return a.first < b.first || (a.first == b.first && a.second > b.second);
+    };
+    std::make_heap(candidates.begin(), candidates.end(), worse);
+
+    const auto output_size = (size_t)std::min((int)candidates.size(), max_detections);
+    selected.clear();
+    kept.clear();
+    for (auto end = candidates.end(); selected.size() < output_size && end != candidates.begin(); --end)
+    {
+        std::pop_heap(candidates.begin(), end, worse);
+        auto &box = boxes[(end - 1)->second];
+        if (!kept.suppresses(box, iou_threshold))
+        {
+            selected.push_back((end - 1)->second);
+            kept.push_back(box);
+        }
+    }
+}
+}
+
+template result<void> optimized::tflite_detection_postprocess<float>(const float *boxes, const float *scores, const float *anchors, float *output_locations, float *output_classes, float *output_scores, float *output_num_detections,
+    const runtime_shape_t &boxes_shape, const runtime_shape_t &scores_shape, const runtime_shape_t &anchors_shape,
+    const int32_t max_detections, const int32_t max_classes_per_detection, const int32_t detections_per_class,
+    const bool use_regular_non_max_suppression, const float nms_score_threshold, const float nms_iou_threshold,
+    const int32_t num_classes, const float y_scale, const float x_scale, const float h_scale, const float w_scale) noexcept;
+
+template <typename T>
+result<void> optimized::tflite_detection_postprocess(const T *boxes, const T *scores, const T *anchors, T *output_locations, T *output_classes, T *output_scores, T *output_num_detections,
+    const runtime_shape_t &boxes_shape, const runtime_shape_t &scores_shape, const runtime_shape_t &anchors_shape,
+    const int32_t max_detections, const int32_t max_classes_per_detection, const int32_t detections_per_class,
+    const bool use_regular_non_max_suppression, const float nms_score_threshold, const float nms_iou_threshold,
+    const int32_t num_classes, const float y_scale, const float x_scale, const float h_scale, const float w_scale) noexcept
+{
+    const auto num_boxes = (int)anchors_shape[0];
+    const auto num_classes_with_background = (int)scores_shape[2];
+    const auto num_detections_per_class = std::min(detections_per_class, max_detections);
+    const int label_offset = num_classes_with_background - num_classes;
+#ifdef NNCASE_OPENMP
+    const bool parallel = (size_t)num_boxes * num_classes_with_background >= nms_parallel_scores;
+#endif
+
+    // DecodeCenterSizeBoxes, the same double precision steps as the reference
+    std::vector<box_corners> decoded_boxes(boxes_shape[1]);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+    for (int index = 0; index < num_boxes; index++)
+    {
+        const auto box_encoding_index = index * boxes_shape[2];
+        auto box = boxes + box_encoding_index;
+        auto anchor = anchors + box_encoding_index;
+        auto y_center = static_cast<float>(static_cast<double>(box[0]) / static_cast<double>(y_scale) * static_cast<double>(anchor[2]) + static_cast<double>(anchor[0]));
+        auto x_center = static_cast<float>(static_cast<double>(box[1]) / static_cast<double>(x_scale) * static_cast<double>(anchor[3]) + static_cast<double>(anchor[1]));
+        auto half_h = static_cast<float>(0.5 * (std::exp(static_cast<double>(box[2]) / static_cast<double>(h_scale))) * static_cast<double>(anchor[2]));
+        auto half_w = static_cast<float>(0.5 * (std::exp(static_cast<double>(box[3]) / static_cast<double>(w_scale))) * static_cast<double>(anchor[3]));
+        decoded_boxes[index] = { y_center - half_h, x_center - half_w, y_center + half_h, x_center + half_w };
+    }
+
+    auto locations = reinterpret_cast<box_corners *>(output_locations);
+    if (use_regular_non_max_suppression)
+    {
+        // NMS every class on its own, then merge the classes in order as the reference does
+        const auto classes = std::max(num_classes - 1, 0);
+        std::vector<std::vector<int>> class_selected(classes);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel if (parallel)
+#endif
+        {
+            std::vector<std::pair<float, int>> candidates;
+            kept_boxes kept;
+#ifdef NNCASE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int col = 0; col < classes; col++)
+            {
+                nms_single_class(scores + col + label_offset, num_classes_with_background, num_boxes, decoded_boxes, nms_score_threshold,
+                    nms_iou_threshold, max_detections, candidates, kept, class_selected[col]);
+            }
+        }
+
+        int sorted_indices_size = 0;
+        std::vector<box_info> box_info_after_regular_nms(max_detections + std::max(num_detections_per_class, max_detections));
+        for (int col = 0; col < classes; col++)
+        {
+            auto &selected = class_selected[col];
+            if (selected.empty())
+                continue;
+
+            for (size_t i = 0; i < selected.size(); ++i)
+            {
+                box_info_after_regular_nms[sorted_indices_size + i].score = scores[selected[i] * num_classes_with_background + col + label_offset];
+                box_info_after_regular_nms[sorted_indices_size + i].index = selected[i] * num_classes_with_background + col + label_offset;
+            }
+
+            std::inplace_merge(box_info_after_regular_nms.begin(), box_info_after_regular_nms.begin() + sorted_indices_size,
+                box_info_after_regular_nms.begin() + sorted_indices_size + selected.size(),
+                [](const box_info &a, const box_info &b) { return a.score >= b.score; });
+            sorted_indices_size = std::min(sorted_indices_size + static_cast<int>(selected.size()), max_detections);
+        }
+
+        for (int output_box_index = 0; output_box_index < max_detections; output_box_index++)
+        {
+            if (output_box_index < sorted_indices_size)
+            {
+                auto &info = box_info_after_regular_nms[output_box_index];
+                const int anchor_index = info.index / num_classes_with_background;
+                locations[output_box_index] = decoded_boxes[anchor_index];
+                output_classes[output_box_index] = info.index - anchor_index * num_classes_with_background - label_offset;
+                output_scores[output_box_index] = info.score;
+            }
+            else
+            {
+                locations[output_box_index] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                output_classes[output_box_index] = 0.0f;
+                output_scores[output_box_index] = 0.0f;
+            }
+        }
+        output_num_detections[0] = sorted_indices_size;
+    }
+    else
+    {
+        // Fast NMS: the best classes of every anchor, then one NMS over the anchors' top scores
+        const int num_categories_per_anchor = std::min(max_classes_per_detection, num_classes);
+        std::vector<float> max_scores(num_boxes);
+        std::vector<int> sorted_class_indices((size_t)num_boxes * num_categories_per_anchor);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+        for (int row = 0; row < num_boxes; row++)
+        {
+            const T *box_scores = scores + row * num_classes_with_background + label_offset;
+            int *class_indices = sorted_class_indices.data() + (size_t)row * num_categories_per_anchor;
+            if (num_categories_per_anchor == 1)
+            {
+                int max_index = 0;
+                for (int i = 1; i < num_classes; ++i)
+                {
+                    if (box_scores[i] > box_scores[max_index])
+                        max_index = i;
+                }
+                class_indices[0] = max_index;
+            }
+            else
+            {
+                std::vector<int> all_classes(num_classes);
+                std::iota(all_classes.begin(), all_classes.end(), 0);
+                std::partial_sort(all_classes.begin(), all_classes.begin() + num_categories_per_anchor, all_classes.end(),
+                    [&box_scores](const int i, const int j) { return box_scores[i] > box_scores[j]; });
+                std::copy_n(all_classes.begin(), num_categories_per_anchor, class_indices);
+            }
+            max_scores[row] = box_scores[class_indices[0]];
+        }
+
+        std::vector<std::pair<float, int>> candidates;
+        kept_boxes kept;
+        std::vector<int> selected;
+        nms_single_class(max_scores.data(), 1, num_boxes, decoded_boxes, nms_score_threshold, nms_iou_threshold, max_detections,
+            candidates, kept, selected);
+
+        int output_box_index = 0;
+        for (auto selected_index : selected)
+        {
+            const T *box_scores = scores + selected_index * num_classes_with_background + label_offset;
+            const int *class_indices = sorted_class_indices.data() + (size_t)selected_index * num_categories_per_anchor;
+            for (int col = 0; col < num_categories_per_anchor; ++col)
+            {
+                int box_offset = max_classes_per_detection * output_box_index + col;
+                locations[box_offset] = decoded_boxes[selected_index];
+                output_classes[box_offset] = class_indices[col];
+                output_scores[box_offset] = box_scores[class_indices[col]];
+            }
+            output_box_index++;
+        }
+        output_num_detections[0] = output_box_index;
+    }
+
+    return ok();
+}
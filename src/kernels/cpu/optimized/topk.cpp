@@ -0,0 +1,126 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Below this many input elements the rows are not worth spreading over threads
+constexpr size_t topk_parallel_elements = 16 * 1024;
+
+// Keeps the k best pairs of a row in a heap whose top is the worst kept one. A pair only gets in
+// when its value beats the top, the same rule as the priority queue of reference::topk, so ties
+// keep the same elements.
+template <class T, class Compare>
+void heap_topk(std::vector<std::pair<T, size_t>> &heap, const T *row, size_t row_step, size_t count, size_t k, Compare comp)
+{
+    heap.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        auto value = row[i * row_step];
+        if (heap.size() < k)
+        {
+            heap.emplace_back(value, i);
+            std::push_heap(heap.begin(), heap.end(), comp);
+        }
+        else if (comp(std::pair<T, size_t>(value, 0), std::pair<T, size_t>(heap.front().first, 0)))
+        {
+            std::pop_heap(heap.begin(), heap.end(), comp);
+            heap.back() = { value, i };
+            std::push_heap(heap.begin(), heap.end(), comp);
+        }
+    }
+
+    // best first, pairs of equal value by descending (largest) or ascending index as the queue pops them
+    std::sort_heap(heap.begin(), heap.end(), comp);
+}
+}
+
+template result<void> optimized::topk<float>(const float *input, float *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &output_values_strides,
+    const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept;
+
+template <typename T>
+result<void> optimized::topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &output_values_strides,
+    const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept
+{
+    const auto axis_size = in_shape[axis];
+    if (k <= 0 || (size_t)k > axis_size)
+        return err(std::errc::invalid_argument);
+
+    // outputs are laid out like reference::topk: k entries inner_size apart from the row start
+    size_t outer_size = 1, inner_size = 1;
+    for (size_t i = 0; i < (size_t)axis; i++)
+        outer_size *= in_shape[i];
+    for (size_t i = axis + 1; i < in_shape.size(); i++)
+        inner_size *= in_shape[i];
+
+    auto row_shape = in_shape;
+    row_shape[axis] = 1;
+    const auto rows = (int32_t)(outer_size * inner_size);
+    const auto row_step = in_strides[axis];
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel if (outer_size * inner_size * axis_size >= topk_parallel_elements)
+#endif
+    {
+        std::vector<std::pair<T, size_t>> pairs;
+        pairs.reserve(sorted ? (size_t)k : axis_size);
+#ifdef NNCASE_OPENMP
+#pragma omp for
+#endif
+        for (int32_t row = 0; row < rows; row++)
+        {
+            runtime_shape_t index(row_shape.size());
+            for (size_t i = row_shape.size(), rest = (size_t)row; i-- > 0; rest /= row_shape[i])
+                index[i] = rest % row_shape[i];
+            auto in_row = input + offset(in_strides, index);
+            auto out_begin = offset(output_values_strides, index);
+
+            if (sorted)
+            {
+                if (largest)
+                    heap_topk(pairs, in_row, row_step, axis_size, (size_t)k, std::greater<std::pair<T, size_t>>());
+                else
+                    heap_topk(pairs, in_row, row_step, axis_size, (size_t)k, std::less<std::pair<T, size_t>>());
+            }
+            else
+            {
+                pairs.clear();
+                for (size_t i = 0; i < axis_size; i++)
+                    pairs.emplace_back(in_row[i * row_step], i);
+                kernels::detail::quick_select(pairs, 0, (int64_t)axis_size - 1, k, largest);
+            }
+
+            for (size_t i = 0; i < (size_t)k; i++)
+            {
+                auto out = out_begin + i * inner_size;
+                output_values[out] = pairs[i].first;
+                output_indices[out] = (int64_t)pairs[i].second;
+            }
+        }
+    }
+
+    return ok();
+}
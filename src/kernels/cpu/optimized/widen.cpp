@@ -0,0 +1,191 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+#if defined(X86_64_SIMD_ON)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef NNCASE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Rows of B widened at once are capped so the float block stays in L2
+constexpr size_t block_floats = 32 * 1024;
+// Output columns one task accumulates
+constexpr size_t n_tile = 256;
+
+#if defined(X86_64_SIMD_ON)
+// F16C isn't part of the AVX2 baseline the rest of the kernels are built for
+bool has_f16c() noexcept
+{
+#ifdef _MSC_VER
+    static const bool supported = [] {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 29)) != 0;
+    }();
+#else
+    static const bool supported = __builtin_cpu_supports("f16c");
+#endif
+    return supported;
+}
+#endif
+
+// out[i] += a * b[i]
+void axpy(float *out, float a, const float *b, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    auto va = _mm256_set1_ps(a);
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(b + i), _mm256_loadu_ps(out + i)));
+#endif
+    for (; i < count; i++)
+        out[i] += a * b[i];
+}
+
+template <class TB>
+result<void> matmul_widened(const float *input_a, const TB *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    // Same layout assumptions as reference::matmul: dense rows, batches stepped by strides[0]
+    const auto M = in_a_shape[in_a_shape.size() - 2];
+    const auto K = in_a_shape.back();
+    const auto N = in_b_shape.back();
+
+    size_t batch_a = 1, batch_b = 1, batch_out = 1;
+    for (size_t i = 0; i < in_a_shape.size() - 2; i++)
+        batch_a *= in_a_shape[i];
+    for (size_t i = 0; i < in_b_shape.size() - 2; i++)
+        batch_b *= in_b_shape[i];
+    for (size_t i = 0; i < out_shape.size() - 2; i++)
+        batch_out *= out_shape[i];
+    const auto step_a = batch_a == 1 ? 0 : in_a_strides[0];
+    const auto step_b = batch_b == 1 ? 0 : in_b_strides[0];
+    const auto step_out = batch_out == 1 ? 0 : out_strides[0];
+
+    const auto kc = std::clamp<size_t>(block_floats / std::max<size_t>(N, 1), 1, std::max<size_t>(K, 1));
+    try_var(block, context.workspace<float>(kc * N));
+
+    const auto n_tiles = (N + n_tile - 1) / n_tile;
+    const auto tasks = (int32_t)(M * n_tiles);
+    for (size_t b = 0; b < std::max(batch_a, batch_b); b++)
+    {
+        auto pa = input_a + b * step_a;
+        auto pb = input_b + b * step_b;
+        auto pout = output + b * step_out;
+
+        for (size_t m = 0; m < M; m++)
+            std::copy_n(bias, N, pout + m * N);
+
+        for (size_t k0 = 0; k0 < K; k0 += kc)
+        {
+            const auto kn = std::min(kc, K - k0);
+            widen_to_float(pb + k0 * N, block, kn * N);
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+            for (int32_t task = 0; task < tasks; task++)
+            {
+                const auto m = (size_t)task / n_tiles;
+                const auto n0 = (size_t)task % n_tiles * n_tile;
+                const auto nn = std::min(n_tile, N - n0);
+                auto out_row = pout + m * N + n0;
+                auto a_row = pa + m * K + k0;
+                for (size_t k = 0; k < kn; k++)
+                    axpy(out_row, a_row[k], block + k * N + n0, nn);
+            }
+        }
+
+        for (size_t i = 0; i < M * N; i++)
+            pout[i] = kernels::detail::apply_activation(pout[i], fused_activation);
+    }
+
+    return ok();
+}
+}
+
+void optimized::widen_to_float(const half *input, float *output, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    // F16C sets the quiet bit of signaling NaNs, half::operator float keeps the payload as is
+    const auto exp_mask = _mm256_set1_epi32(0x7c00);
+    const auto vector_count = has_f16c() ? count : 0;
+    for (; i + 8 <= vector_count; i += 8)
+    {
+        auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+        auto value = _mm256_castps_si256(_mm256_cvtph_ps(raw));
+        auto bits = _mm256_cvtepu16_epi32(raw);
+        auto inf_nan = _mm256_cmpeq_epi32(_mm256_and_si256(bits, exp_mask), exp_mask);
+        auto exact = _mm256_or_si256(_mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7fff)), 13), _mm256_set1_epi32(0x70000000)),
+            _mm256_slli_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x8000)), 16));
+        _mm256_storeu_ps(output + i, _mm256_castsi256_ps(_mm256_blendv_epi8(value, exact, inf_nan)));
+    }
+#endif
+    for (; i < count; i++)
+        output[i] = input[i];
+}
+
+void optimized::widen_to_float(const bfloat16 *input, float *output, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(X86_64_SIMD_ON)
+    // bfloat16 is the high half of a float
+    for (; i + 8 <= count; i += 8)
+    {
+        auto raw = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i)));
+        _mm256_storeu_ps(output + i, _mm256_castsi256_ps(_mm256_slli_epi32(raw, 16)));
+    }
+#endif
+    for (; i < count; i++)
+        output[i] = input[i];
+}
+
+result<void> optimized::matmul(const float *input_a, const half *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    return matmul_widened(input_a, input_b, bias, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+        out_shape, out_strides, fused_activation, context);
+}
+
+result<void> optimized::matmul(const float *input_a, const bfloat16 *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    return matmul_widened(input_a, input_b, bias, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+        out_shape, out_strides, fused_activation, context);
+}
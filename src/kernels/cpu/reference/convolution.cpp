@@ -91,3 +91,72 @@ result<void> reference::conv2d(const float *input, const float *weights, const f
 
     return ok();
 }
+
+result<void> reference::conv2d_transpose(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const auto filter_h = (int32_t)w_shape[2];
+    const auto filter_w = (int32_t)w_shape[3];
+    const auto in_h = (int32_t)in_shape[2];
+    const auto in_w = (int32_t)in_shape[3];
+    const auto g_ic = w_shape[1];
+    const auto g_oc = w_shape[0] / groups;
+
+    runtime_shape_t in_index(4);
+    runtime_shape_t w_index(4);
+    runtime_shape_t bias_index(1);
+    runtime_shape_t out_index(4);
+    for (size_t batch = 0; batch < out_shape[0]; batch++)
+    {
+        in_index[0] = out_index[0] = batch;
+        for (size_t og = 0; og < (size_t)groups; og++)
+        {
+            for (size_t oc = 0; oc < g_oc; oc++)
+            {
+                out_index[1] = w_index[0] = bias_index[0] = og * g_oc + oc;
+                for (size_t oy = 0; oy < out_shape[2]; oy++)
+                {
+                    out_index[2] = oy;
+                    for (size_t ox = 0; ox < out_shape[3]; ox++)
+                    {
+                        out_index[3] = ox;
+                        float value = bias[offset(bias_strides, bias_index)];
+
+                        // gather every input pixel that scatters into (oy, ox)
+                        for (size_t ic = 0; ic < g_ic; ic++)
+                        {
+                            in_index[1] = og * g_ic + ic;
+                            w_index[1] = ic;
+                            for (int32_t ky = 0; ky < filter_h; ky++)
+                            {
+                                const int32_t in_y = (int32_t)oy + padding_h.before - ky * dilation_h;
+                                if (in_y < 0 || in_y % stride_h || in_y / stride_h >= in_h)
+                                    continue;
+
+                                w_index[2] = ky;
+                                in_index[2] = in_y / stride_h;
+                                for (int32_t kx = 0; kx < filter_w; kx++)
+                                {
+                                    const int32_t in_x = (int32_t)ox + padding_w.before - kx * dilation_w;
+                                    if (in_x < 0 || in_x % stride_w || in_x / stride_w >= in_w)
+                                        continue;
+
+                                    w_index[3] = kx;
+                                    in_index[3] = in_x / stride_w;
+                                    value += input[offset(in_strides, in_index)] * weights[offset(w_strides, w_index)];
+                                }
+                            }
+                        }
+
+                        output[offset(out_strides, out_index)] = kernels::detail::apply_activation(value, fused_activation);
+                    }
+                }
+            }
+        }
+    }
+
+    return ok();
+}
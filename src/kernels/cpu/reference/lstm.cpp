@@ -0,0 +1,153 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+template result<void> reference::lstm<float>(const float *input, const float *w, const float *r, const float *b, const float *initial_h, const float *initial_c,
+    float *output, float *output_h, float *output_c, const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape,
+    const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens, lstm_direction direction, lstm_framework framework) noexcept;
+
+namespace
+{
+template <class T>
+T dot(const T *a, const T *b, size_t size) noexcept
+{
+    T sum = 0;
+    for (size_t i = 0; i < size; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+template <class T>
+T sigmoid_scalar(T x) noexcept
+{
+    return 1 / (1 + std::exp(-x));
+}
+}
+
+template <typename T>
+result<void> reference::lstm(const T *input, const T *w, const T *r, const T *b, const T *initial_h, const T *initial_c,
+    T *output, T *output_h, T *output_c, const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape,
+    const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens, lstm_direction direction, lstm_framework framework) noexcept
+{
+    const size_t seq_length = input_shape[0];
+    const size_t batch_size = input_shape[1];
+    const size_t input_size = input_shape[2];
+    const size_t num_directions = w_shape[0];
+    const size_t gate_size = w_shape[1];
+    const size_t hidden_size = gate_size / 4;
+    const size_t state_batch = initial_h_shape[1];
+    if (state_batch != batch_size && state_batch != 1)
+        return err(std::errc::invalid_argument);
+    if (!kernels::detail::sequence_lens_valid(sequence_lens, seq_length, batch_size))
+        return err(std::errc::invalid_argument);
+
+    // onnx: b = [Wb, Rb] and gates [i, o, f, c], caffe: b = Wb and gates [i, f, o, c]
+    const bool has_rb = compute_size(b_shape) == num_directions * 2 * gate_size;
+    const size_t b_stride = has_rb ? 2 * gate_size : gate_size;
+    const size_t o_gate = (framework == kCaffe ? 2 : 1) * hidden_size;
+    const size_t f_gate = (framework == kCaffe ? 1 : 2) * hidden_size;
+    const size_t c_gate = 3 * hidden_size;
+
+    std::vector<T> x_gates(seq_length * batch_size * gate_size);
+    std::vector<T> gates(batch_size * gate_size);
+    std::vector<T> h_t(batch_size * hidden_size);
+    std::vector<T> c_t(batch_size * hidden_size);
+
+    for (size_t d = 0; d < num_directions; d++)
+    {
+        auto w_d = w + d * gate_size * input_size;
+        auto r_d = r + d * gate_size * hidden_size;
+        auto b_d = b + d * b_stride;
+        const bool reverse = direction == kReverse || d == 1;
+
+        // x_gates = X * W^T + Wb + Rb, done once for all the time steps
+        for (size_t row = 0; row < seq_length * batch_size; row++)
+        {
+            auto x_row = input + row * input_size;
+            auto out_row = x_gates.data() + row * gate_size;
+            for (size_t g = 0; g < gate_size; g++)
+                out_row[g] = dot(x_row, w_d + g * input_size, input_size) + b_d[g] + (has_rb ? b_d[gate_size + g] : 0);
+        }
+
+        for (size_t bs = 0; bs < batch_size; bs++)
+        {
+            auto src = (d * state_batch + (state_batch == 1 ? 0 : bs)) * hidden_size;
+            std::copy_n(initial_h + src, hidden_size, h_t.data() + bs * hidden_size);
+            std::copy_n(initial_c + src, hidden_size, c_t.data() + bs * hidden_size);
+        }
+
+        for (size_t step = 0; step < seq_length; step++)
+        {
+            const size_t t = reverse ? seq_length - 1 - step : step;
+
+            // caffe resets the states at the beginning of a sequence (cont = 0)
+            if (framework == kCaffe && step == 0)
+            {
+                std::fill(h_t.begin(), h_t.end(), T(0));
+                std::fill(c_t.begin(), c_t.end(), T(0));
+            }
+
+            // gates = x_gates[t] + H * R^T
+            for (size_t bs = 0; bs < batch_size; bs++)
+            {
+                if (!kernels::detail::in_sequence(sequence_lens, bs, t))
+                    continue;
+                auto h_row = h_t.data() + bs * hidden_size;
+                auto x_row = x_gates.data() + (t * batch_size + bs) * gate_size;
+                auto g_row = gates.data() + bs * gate_size;
+                for (size_t g = 0; g < gate_size; g++)
+                    g_row[g] = x_row[g] + dot(h_row, r_d + g * hidden_size, hidden_size);
+            }
+
+            auto out_t = output + (t * num_directions + d) * batch_size * hidden_size;
+            for (size_t bs = 0; bs < batch_size; bs++)
+            {
+                if (!kernels::detail::in_sequence(sequence_lens, bs, t))
+                {
+                    std::fill_n(out_t + bs * hidden_size, hidden_size, T(0));
+                    continue;
+                }
+
+                auto g_row = gates.data() + bs * gate_size;
+                auto h_row = h_t.data() + bs * hidden_size;
+                auto c_row = c_t.data() + bs * hidden_size;
+                for (size_t k = 0; k < hidden_size; k++)
+                {
+                    auto i = sigmoid_scalar(g_row[k]);
+                    auto o = sigmoid_scalar(g_row[o_gate + k]);
+                    auto f = sigmoid_scalar(g_row[f_gate + k]);
+                    auto c = std::tanh(g_row[c_gate + k]);
+                    c_row[k] = f * c_row[k] + i * c;
+                    h_row[k] = o * std::tanh(c_row[k]);
+                }
+                std::copy_n(h_row, hidden_size, out_t + bs * hidden_size);
+            }
+        }
+
+        std::copy_n(h_t.data(), h_t.size(), output_h + d * h_t.size());
+        std::copy_n(c_t.data(), c_t.size(), output_c + d * c_t.size());
+    }
+
+    return ok();
+}
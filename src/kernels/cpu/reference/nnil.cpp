@@ -14,6 +14,7 @@
  */
 #include <nncase/kernels/cpu/reference/nnil.h>
 #include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/dbg.h>
 #include <nncase/runtime/nnil.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
@@ -23,166 +24,200 @@ using namespace nncase::kernels;
 using namespace nncase::kernels::cpu;
 using namespace nncase::kernels::cpu::reference;
 
-result<void> reference::nnil_unary_method(const float *input, float *output, size_t count, gsl::span<const gsl::byte> body, NNCASE_UNUSED kernel_context &context) noexcept
+namespace
 {
-    for (size_t i = 0; i < count; i++)
-    {
-        nnil_evalstack stack;
-        span_reader sr(body);
-        nnil_reader reader(sr);
-        bool ret = false;
+// Runs body for one element, load_arg(index) reads the element of argument index
+template <class TLoadArg>
+result<float> run_program(gsl::span<const gsl::byte> body, TLoadArg &&load_arg) noexcept
+{
+    nnil_evalstack stack;
+    span_reader sr(body);
+    nnil_reader reader(sr);
 
-        while (reader.avail() && !ret)
+    while (reader.avail())
+    {
+        auto op = reader.next();
+        switch (op.opcode)
+        {
+        case nnil_nop:
+            break;
+        case nnil_dup:
+            stack.dup();
+            break;
+        case nnil_pop:
+            stack.pop();
+            break;
+        case nnil_lda_0:
         {
-            auto op = reader.next();
-            switch (op.opcode)
-            {
-            case nnil_nop:
-                break;
-            case nnil_dup:
-                stack.dup();
-                break;
-            case nnil_pop:
-                stack.pop();
-                break;
-            case nnil_lda_0:
-                stack.push(input[i]);
-                break;
-            case nnil_ldc_r4_0:
-                stack.push(0.f);
-                break;
-            case nnil_ldc_r4_1:
-                stack.push(1.f);
-                break;
-            case nnil_ldc_r4:
-                stack.push(op.ldc_r4.r4);
-                break;
-            case nnil_abs:
-                stack.push(fabsf(stack.pop()));
-                break;
-            case nnil_acos:
-                stack.push(acosf(stack.pop()));
-                break;
-            case nnil_asin:
-                stack.push(asin(stack.pop()));
-                break;
-            case nnil_ceil:
-                stack.push(ceilf(stack.pop()));
-                break;
-            case nnil_cos:
-                stack.push(cosf(stack.pop()));
-                break;
-            case nnil_exp:
-                stack.push(expf(stack.pop()));
-                break;
-            case nnil_floor:
-                stack.push(floorf(stack.pop()));
-                break;
-            case nnil_erf:
-                stack.push(erff(stack.pop()));
-                break;
-            case nnil_log:
-                stack.push(logf(stack.pop()));
-                break;
-            case nnil_logical_not:
-                stack.push(!(stack.pop()));
-                break;
-            case nnil_neg:
-                stack.push(-stack.pop());
-                break;
-            case nnil_round:
-                stack.push(roundf(stack.pop()));
-                break;
-            case nnil_rsqrt:
-                stack.push(1.f / sqrtf(stack.pop()));
-                break;
-            case nnil_sign:
-            {
-                auto val = stack.pop();
-                stack.push((0 < val) - (val < 0));
-                break;
-            }
-            case nnil_sin:
-                stack.push(sinf(stack.pop()));
-                break;
-            case nnil_sqrt:
-                stack.push(sqrtf(stack.pop()));
-                break;
-            case nnil_square:
-            {
-                auto v = stack.pop();
-                stack.push(v * v);
-                break;
-            }
-            case nnil_tanh:
-                stack.push(tanhf(stack.pop()));
-                break;
-            case nnil_add:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(a + b);
-                break;
-            }
-            case nnil_sub:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(a - b);
-                break;
-            }
-            case nnil_mul:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(a * b);
-                break;
-            }
-            case nnil_div:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(a / b);
-                break;
-            }
-            case nnil_min:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(std::min(a, b));
-                break;
-            }
-            case nnil_max:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(std::max(a, b));
-                break;
-            }
-            case nnil_pow:
-            {
-                auto b = stack.pop();
-                auto a = stack.pop();
-                stack.push(std::pow(a, b));
-                break;
-            }
-            case nnil_clamp:
-            {
-                auto high = stack.pop();
-                auto low = stack.pop();
-                auto v = stack.pop();
-                stack.push(clamp(v, low, high));
-                break;
-            }
-            case nnil_ret:
-                output[i] = stack.pop();
-                ret = true;
-                break;
-            default:
-                return err(nncase_errc::nnil_illegal_instruction);
-            }
+            try_var(value, load_arg(0));
+            stack.push(value);
+            break;
         }
+        case nnil_lda:
+        {
+            try_var(value, load_arg(op.lda.index));
+            stack.push(value);
+            break;
+        }
+        case nnil_ldc_r4_0:
+            stack.push(0.f);
+            break;
+        case nnil_ldc_r4_1:
+            stack.push(1.f);
+            break;
+        case nnil_ldc_r4:
+            stack.push(op.ldc_r4.r4);
+            break;
+        case nnil_abs:
+            stack.push(fabsf(stack.pop()));
+            break;
+        case nnil_acos:
+            stack.push(acosf(stack.pop()));
+            break;
+        case nnil_asin:
+            stack.push(asin(stack.pop()));
+            break;
+        case nnil_ceil:
+            stack.push(ceilf(stack.pop()));
+            break;
+        case nnil_cos:
+            stack.push(cosf(stack.pop()));
+            break;
+        case nnil_exp:
+            stack.push(expf(stack.pop()));
+            break;
+        case nnil_floor:
+            stack.push(floorf(stack.pop()));
+            break;
+        case nnil_erf:
+            stack.push(erff(stack.pop()));
+            break;
+        case nnil_log:
+            stack.push(logf(stack.pop()));
+            break;
+        case nnil_logical_not:
+            stack.push(!(stack.pop()));
+            break;
+        case nnil_neg:
+            stack.push(-stack.pop());
+            break;
+        case nnil_round:
+            stack.push(roundf(stack.pop()));
+            break;
+        case nnil_rsqrt:
+            stack.push(1.f / sqrtf(stack.pop()));
+            break;
+        case nnil_sign:
+        {
+            auto val = stack.pop();
+            stack.push((0 < val) - (val < 0));
+            break;
+        }
+        case nnil_sin:
+            stack.push(sinf(stack.pop()));
+            break;
+        case nnil_sqrt:
+            stack.push(sqrtf(stack.pop()));
+            break;
+        case nnil_square:
+        {
+            auto v = stack.pop();
+            stack.push(v * v);
+            break;
+        }
+        case nnil_tanh:
+            stack.push(tanhf(stack.pop()));
+            break;
+        case nnil_add:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(a + b);
+            break;
+        }
+        case nnil_sub:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(a - b);
+            break;
+        }
+        case nnil_mul:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(a * b);
+            break;
+        }
+        case nnil_div:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(a / b);
+            break;
+        }
+        case nnil_min:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(std::min(a, b));
+            break;
+        }
+        case nnil_max:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(std::max(a, b));
+            break;
+        }
+        case nnil_pow:
+        {
+            auto b = stack.pop();
+            auto a = stack.pop();
+            stack.push(std::pow(a, b));
+            break;
+        }
+        case nnil_clamp:
+        {
+            auto high = stack.pop();
+            auto low = stack.pop();
+            auto v = stack.pop();
+            stack.push(clamp(v, low, high));
+            break;
+        }
+        case nnil_ret:
+            return ok(stack.pop());
+        default:
+            return err(nncase_errc::nnil_illegal_instruction);
+        }
+    }
+
+    return err(nncase_errc::nnil_illegal_instruction);
+}
+}
+
+result<void> reference::nnil_unary_method(const float *input, float *output, size_t count, gsl::span<const gsl::byte> body, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        try_set(output[i], run_program(body, [&](size_t arg) -> result<float> {
+            CHECK_WITH_ERR(arg == 0, nncase_errc::nnil_illegal_instruction);
+            return ok(input[i]);
+        }));
     }
 
     return ok();
 }
+
+result<void> reference::nnil_elementwise(gsl::span<const float *const> inputs, gsl::span<const runtime_shape_t> in_shapes, gsl::span<const runtime_shape_t> in_strides,
+    float *output, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, gsl::span<const gsl::byte> body, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    return apply(out_shape, [&](const runtime_shape_t &index) -> result<void> {
+        try_set(output[offset(out_strides, index)], run_program(body, [&](size_t arg) -> result<float> {
+            CHECK_WITH_ERR(arg < inputs.size(), nncase_errc::nnil_illegal_instruction);
+            const auto in_index = kernels::detail::get_reduced_offset(index, in_shapes[arg]);
+            return ok(inputs[arg][offset(in_strides[arg], in_index)]);
+        }));
+        return ok();
+    });
+}
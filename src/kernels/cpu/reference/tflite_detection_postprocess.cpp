@@ -276,10 +276,13 @@ result<void> reference::tflite_detection_postprocess(const T *boxes, const T *sc
                 }
                 else
                 {
-                    std::iota(class_indices, class_indices + num_classes, 0);
+                    // sort in a row of its own, class_indices only has room for the first num_categories_per_anchor
+                    std::vector<int> all_classes(num_classes);
+                    std::iota(all_classes.begin(), all_classes.end(), 0);
                     std::partial_sort(
-                        class_indices, class_indices + num_categories_per_anchor, class_indices + num_classes,
+                        all_classes.begin(), all_classes.begin() + num_categories_per_anchor, all_classes.end(),
                         [&box_scores](const int i, const int j) { return box_scores[i] > box_scores[j]; });
+                    std::copy_n(all_classes.begin(), num_categories_per_anchor, class_indices);
                 }
                 // end DecreasingPartialArgSort
 
@@ -24,66 +24,6 @@ using namespace nncase::kernels;
 using namespace nncase::kernels::cpu;
 using namespace nncase::kernels::cpu::reference;
 
-namespace
-{
-template <typename T>
-int64_t quick_partition(std::vector<std::pair<T, size_t>> &nums, int64_t lo, int64_t hi, bool largest)
-{
-    int64_t i = lo;
-    int64_t j = hi + 1;
-    T pivot = nums[lo].first;
-
-    while (true)
-    {
-        if (largest)
-        {
-            while (++i < hi && nums[i].first > pivot)
-                ;
-            while (--j > lo && nums[j].first < pivot)
-                ;
-        }
-        else
-        {
-            while (++i < hi && nums[i].first < pivot)
-                ;
-            while (--j > lo && nums[j].first > pivot)
-                ;
-        }
-
-        if (i >= j)
-        {
-            break;
-        }
-
-        std::swap(nums[i].first, nums[j].first);
-        std::swap(nums[i].second, nums[j].second);
-    }
-
-    std::swap(nums[lo].first, nums[j].first);
-    std::swap(nums[lo].second, nums[j].second);
-
-    return j;
-}
-
-template <typename T>
-void quick_select(std::vector<std::pair<T, size_t>> &nums, int64_t lo, int64_t hi, int64_t k, bool largest)
-{
-    if (lo >= hi)
-    {
-        return;
-    }
-
-    int64_t idx = quick_partition(nums, lo, hi, largest);
-    if (idx == k)
-    {
-        return;
-    }
-
-    return idx > k ? quick_select(nums, lo, idx - 1, k, largest) : quick_select(nums, idx + 1, hi, k, largest);
-}
-
-}
-
 template result<void> reference::topk<float>(const float *input, float *output_values, int64_t *output_indices,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     const runtime_shape_t &output_values_shape, const runtime_shape_t &output_values_strides,
@@ -182,7 +122,7 @@ result<void> reference::topk(const T *input, T *output_values, int64_t *output_i
         else
         {
             // not sort with topk
-            quick_select(e.second, 0, static_cast<int64_t>(in_shape[axis] - 1), k, largest);
+            kernels::detail::quick_select(e.second, 0, static_cast<int64_t>(in_shape[axis] - 1), k, largest);
 
             // sort with idx
             // std::sort(e.second.begin(), e.second.begin() + k, [](std::pair<T, size_t> &a, std::pair<T, size_t> &b) { return a.second < b.second; });
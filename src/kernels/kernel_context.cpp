@@ -42,3 +42,9 @@ kernel_context &kernels::default_kernel_context()
     static default_kernel_context_holder holder;
     return holder.ctx;
 }
+
+kernel_workspace &kernels::default_kernel_workspace() noexcept
+{
+    static thread_local kernel_workspace workspace;
+    return workspace;
+}
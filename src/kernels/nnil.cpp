@@ -12,7 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <nncase/kernels/cpu/reference/nnil.h>
+#include <nncase/kernels/cpu/optimized/nnil.h>
 #include <nncase/kernels/kernel_context.h>
 #include <nncase/kernels/nnil.h>
 
@@ -22,5 +22,11 @@ using namespace nncase::kernels;
 
 result<void> kernels::nnil_unary_method(const float *input, float *output, size_t count, gsl::span<const gsl::byte> body, kernel_context &context) noexcept
 {
-    return cpu::reference::nnil_unary_method(input, output, count, body, context);
+    return cpu::optimized::nnil_unary_method(input, output, count, body, context);
+}
+
+result<void> kernels::nnil_elementwise(gsl::span<const float *const> inputs, gsl::span<const runtime_shape_t> in_shapes, gsl::span<const runtime_shape_t> in_strides,
+    float *output, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, gsl::span<const gsl::byte> body, kernel_context &context) noexcept
+{
+    return cpu::optimized::nnil_elementwise(inputs, in_shapes, in_strides, output, out_shape, out_strides, body, context);
 }
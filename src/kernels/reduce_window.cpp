@@ -12,8 +12,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/reduce_window.h>
 #include <nncase/kernels/kernel_context.h>
+#include <nncase/kernels/kernel_utils.h>
 #include <nncase/kernels/reduce_window.h>
 
 using namespace nncase;
@@ -25,6 +27,15 @@ result<void> kernels::reduce_window2d(reduce_op_t op, const float *input, float
     int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
     kernel_context &context) noexcept
 {
+    const runtime_shape_t out_shape { in_shape[0], in_shape[1],
+        kernels::detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h),
+        kernels::detail::get_windowed_output_size(in_shape[3], filter_w, stride_w, dilation_w, padding_w) };
+    if (kernels::detail::is_channel_last(in_shape, in_strides) && kernels::detail::is_channel_last(out_shape, out_strides))
+    {
+        return cpu::optimized::reduce_window2d_nhwc(op, input, init_value, output, in_shape, in_strides, out_strides, padding_h,
+            padding_w, filter_h, filter_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
+    }
+
     return cpu::reference::reduce_window2d(op, input, init_value, output, in_shape, in_strides, out_strides, padding_h,
         padding_w, filter_h, filter_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation, context);
 }
@@ -14,6 +14,7 @@
  */
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
 #include <nncase/kernels/tensor_compute.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
@@ -31,26 +32,22 @@ result<void> kernels::batch_to_space(datatype_t type, const gsl::byte *input, gs
 result<void> kernels::broadcast(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, kernel_context &context) noexcept
 {
-    return cpu::reference::broadcast(type, input, output, in_shape, in_strides, out_shape, out_strides, context);
+    return cpu::optimized::broadcast(type, input, output, in_shape, in_strides, out_shape, out_strides, context);
 }
 
 result<void> kernels::concat(datatype_t type, gsl::span<const gsl::byte *const> inputs, gsl::byte *output, const runtime_shape_t &out_shape,
     gsl::span<const runtime_shape_t> in_strides, const runtime_shape_t &out_strides, size_t axis, const runtime_shape_t &concat_dims,
     kernel_context &context) noexcept
 {
-    if (in_strides[0].size() <= 4)
-    {
-        return cpu::optimized::concat(type, inputs, output, out_shape, in_strides, out_strides, axis, concat_dims, context);
-    }
-    else
-    {
-        return cpu::reference::concat(type, inputs, output, out_shape, in_strides, out_strides, axis, concat_dims, context);
-    }
+    return cpu::optimized::concat(type, inputs, output, out_shape, in_strides, out_strides, axis, concat_dims, context);
 }
 
 result<void> kernels::convert(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, kernel_context &context) noexcept
 {
+    if (is_contiguous(in_shape, in_strides) && is_contiguous(in_shape, out_strides)
+        && cpu::optimized::convert(in_type, out_type, input, output, in_shape, in_strides, out_strides, context).is_ok())
+        return ok();
     return cpu::reference::convert(in_type, out_type, input, output, in_shape, in_strides, out_strides, context);
 }
 
@@ -158,6 +155,24 @@ result<void> kernels::matmul(const T *input_a, const T *input_b, const T *bias,
         out_shape, out_strides, fused_activation);
 }
 
+result<void> kernels::matmul(const float *input_a, const half *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    return cpu::optimized::matmul(input_a, input_b, bias, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+        out_shape, out_strides, fused_activation, context);
+}
+
+result<void> kernels::matmul(const float *input_a, const bfloat16 *input_b, const float *bias, float *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    return cpu::optimized::matmul(input_a, input_b, bias, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides,
+        out_shape, out_strides, fused_activation, context);
+}
+
 result<void> kernels::onehot(datatype_t type, const int32_t *indices, gsl::byte *output, const runtime_shape_t &indices_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &out_strides, gsl::byte *depth, gsl::byte *off_value, gsl::byte *on_value, size_t axis, onehot_mode_t mode, kernel_context &context) noexcept
 {
@@ -175,6 +190,8 @@ result<void> kernels::pad(datatype_t type, const gsl::byte *input, gsl::byte *ou
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_paddings_t &paddings, pad_mode_t mode,
     const scalar &pad_value, kernel_context &context) noexcept
 {
+    if (cpu::optimized::pad(type, input, output, in_shape, in_strides, out_strides, paddings, mode, pad_value, context).is_ok())
+        return ok();
     return cpu::reference::pad(type, input, output, in_shape, in_strides, out_strides, paddings, mode, pad_value, context);
 }
 
@@ -283,15 +300,20 @@ result<void> kernels::reduce_prod(const T *input, T *output, const runtime_shape
     return cpu::reference::reduce_prod(input, output, in_shape, in_strides, out_strides, axes, keep_dims);
 }
 
-#define DISPATCH_RESIZE(resize_fun)                                                                                                                          \
-    runtime_shape_t out_shape { in_shape[0], in_shape[1], static_cast<size_t>(out_h), static_cast<size_t>(out_w) };                                          \
-    if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, out_strides))                                                                        \
-    {                                                                                                                                                        \
-        return cpu::optimized::resize_fun(type, input, output, in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context); \
-    }                                                                                                                                                        \
-    else                                                                                                                                                     \
-    {                                                                                                                                                        \
-        return cpu::reference::resize_fun(type, input, output, in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context); \
+#define DISPATCH_RESIZE(resize_fun)                                                                                                                                     \
+    runtime_shape_t out_shape { in_shape[0], in_shape[1], static_cast<size_t>(out_h), static_cast<size_t>(out_w) };                                                     \
+    if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, out_strides))                                                                                   \
+    {                                                                                                                                                                   \
+        return cpu::optimized::resize_fun(type, input, output, in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context);            \
+    }                                                                                                                                                                   \
+    else if (kernels::detail::is_channel_last(in_shape, in_strides) && kernels::detail::is_channel_last(out_shape, out_strides)                                         \
+        && cpu::optimized::resize_fun##_nhwc(type, input, output, in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context).is_ok()) \
+    {                                                                                                                                                                   \
+        return ok();                                                                                                                                                    \
+    }                                                                                                                                                                   \
+    else                                                                                                                                                                \
+    {                                                                                                                                                                   \
+        return cpu::reference::resize_fun(type, input, output, in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context);            \
     }
 
 result<void> kernels::resize_bilinear(datatype_t type, const gsl::byte *input, gsl::byte *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides,
@@ -319,7 +341,7 @@ result<void> kernels::slice(datatype_t type, const gsl::byte *input, gsl::byte *
             break;
         }
     }
-    if (in_strides.size() <= 4 && !neg_strides)
+    if (!neg_strides)
     {
         return cpu::optimized::slice(type, input, output, in_shape, in_strides, out_strides, begins, ends, strides, context);
     }
@@ -465,6 +487,8 @@ result<void> kernels::topk(const T *input, T *output_values, int64_t *output_ind
     const runtime_shape_t &output_indices_shape, const runtime_shape_t &output_indices_strides,
     const int64_t k, const int32_t axis, const bool largest, const bool sorted) noexcept
 {
+    if (cpu::optimized::topk(input, output_values, output_indices, in_shape, in_strides, output_values_strides, k, axis, largest, sorted).is_ok())
+        return ok();
     return cpu::reference::topk(input, output_values, output_indices, in_shape, in_strides, output_values_shape, output_values_strides,
         output_indices_shape, output_indices_strides, k, axis, largest, sorted);
 }
@@ -477,12 +501,25 @@ result<void> kernels::trilu(const T *input, T *output, const runtime_shape_t &in
     return cpu::reference::trilu(input, output, in_shape, upper, k);
 }
 
-template result<void> kernels::gru<float>(const float *input, const float *w, const float *r, const float *b, float *initial_h, float *output, float *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset) noexcept;
+template result<void> kernels::gru<float>(const float *input, const float *w, const float *r, const float *b, float *initial_h, float *output, float *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset, kernel_context &context) noexcept;
+
+template <typename T>
+result<void> kernels::gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset, kernel_context &context) noexcept
+{
+    return cpu::optimized::gru(input, w, r, b, initial_h, output, output_h, input_shape, w_shape, mode, linear_before_reset, context);
+}
+
+template result<void> kernels::lstm<float>(const float *input, const float *w, const float *r, const float *b, const float *initial_h, const float *initial_c, float *output, float *output_h, float *output_c,
+    const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape, const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens,
+    lstm_direction direction, lstm_framework framework, kernel_context &context) noexcept;
 
 template <typename T>
-result<void> kernels::gru(const T *input, const T *w, const T *r, const T *b, T *initial_h, T *output, T *output_h, const runtime_shape_t &input_shape, const runtime_shape_t &w_shape, int mode, bool linear_before_reset) noexcept
+result<void> kernels::lstm(const T *input, const T *w, const T *r, const T *b, const T *initial_h, const T *initial_c, T *output, T *output_h, T *output_c,
+    const runtime_shape_t &input_shape, const runtime_shape_t &initial_h_shape, const runtime_shape_t &w_shape, const runtime_shape_t &b_shape, const runtime_shape_t &sequence_lens,
+    lstm_direction direction, lstm_framework framework, kernel_context &context) noexcept
 {
-    return cpu::reference::gru(input, w, r, b, initial_h, output, output_h, input_shape, w_shape, mode, linear_before_reset);
+    return cpu::optimized::lstm(input, w, r, b, initial_h, initial_c, output, output_h, output_c, input_shape, initial_h_shape, w_shape, b_shape, sequence_lens,
+        direction, framework, context);
 }
 
 template result<void> kernels::tflite_detection_postprocess<float>(const float *boxes, const float *scores, const float *anchors, float *output_locations, float *output_classes, float *output_scores, float *output_num_detections,
@@ -498,7 +535,7 @@ result<void> kernels::tflite_detection_postprocess(const T *boxes, const T *scor
     const bool use_regular_non_max_suppression, const float nms_score_threshold, const float nms_iou_threshold,
     const int32_t num_classes, const float y_scale, const float x_scale, const float h_scale, const float w_scale) noexcept
 {
-    return cpu::reference::tflite_detection_postprocess(boxes, scores, anchors, output_locations, output_classes, output_scores, output_num_detections,
+    return cpu::optimized::tflite_detection_postprocess(boxes, scores, anchors, output_locations, output_classes, output_scores, output_num_detections,
         boxes_shape, scores_shape, anchors_shape,
         max_detections, max_classes_per_detection, detections_per_class,
         use_regular_non_max_suppression, nms_score_threshold, nms_iou_threshold,
@@ -25,11 +25,14 @@
 #include <nncase/kernels/neutral/neutral_kernels.h>
 #include <nncase/runtime/datatypes.h>
 #include <nncase/runtime/debug.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
 #include <nncase/transforms/neutral/add_quant_motion.h>
+#include <nncase/transforms/neutral/fold_constant.h>
 #include <nncase/transforms/neutral/optimize_allocation.h>
 #include <nncase/transforms/neutral/optimize_benchmark.h>
 #include <nncase/transforms/neutral/post_process_transform.h>
 #include <nncase/transforms/neutral/pre_process_setting.h>
+#include <nncase/transforms/neutral/weights_storage.h>
 #include <nncase/transforms/pass.h>
 #include <variant>
 #include <xtensor/xarray.hpp>
@@ -156,6 +159,7 @@ public:
     void import_tflite(std::span<const uint8_t> model, const import_options &options) override
     {
         BEGIN_IMPORT()
+        check_static_dims("TFLite");
         importer::import_tflite(graph_, model, imp_options, real_inlayout_, real_outlayout_);
         END_IMPORT()
     }
@@ -163,13 +167,24 @@ public:
     void import_onnx(std::span<const uint8_t> model, const import_options &options) override
     {
         BEGIN_IMPORT()
+        auto bindings = dim_bindings();
+        imp_options.dim_values = bindings.front();
         importer::import_onnx(graph_, model, imp_options, real_inlayout_, real_outlayout_);
+        for (size_t i = 1; i < bindings.size(); i++)
+        {
+            auto &variant = *variants_.emplace_back(std::make_unique<ir::graph>());
+            variant.name(variant_name(bindings[i]));
+            imp_options.dim_values = bindings[i];
+            std::string inlayout, outlayout;
+            importer::import_onnx(variant, model, imp_options, inlayout, outlayout);
+        }
         END_IMPORT()
     }
 
     void import_caffe(std::span<const uint8_t> model, std::span<const uint8_t> prototxt) override
     {
         std::cout << "1. Import graph..." << std::endl;
+        check_static_dims("Caffe");
         importer::import_caffe(graph_, model, prototxt, real_inlayout_, real_outlayout_);
         END_IMPORT()
     }
@@ -198,6 +213,11 @@ public:
 
     void compile() override
     {
+        if (!variants_.empty() && use_ptq_)
+            throw std::runtime_error("Symbolic input dimensions are not supported with PTQ");
+        if (!variants_.empty() && !compile_options_.input_shape.empty())
+            throw std::runtime_error("Symbolic input dimensions can't be used with input_shape");
+
         if (use_ptq_)
         {
             if (compile_options_.input_type == "default")
@@ -376,6 +396,9 @@ public:
 
         if (compile_options_.benchmark_only)
             optimize_benchmark(graph_);
+
+        for (auto &variant : variants_)
+            compile_variant(*variant);
     }
 
     ir::graph &graph(uint32_t stage) override
@@ -408,6 +431,11 @@ public:
         using namespace nncase::codegen;
 
         scheduler sch(*target_, graph_, graph_.outputs());
+        std::vector<ir::graph *> variants;
+        for (auto &variant : variants_)
+            variants.emplace_back(variant.get());
+        sch.entry_variants(std::move(variants));
+        sch.config_placement(parse_memory_placement(compile_options_.memory_placement));
         if (compile_options_.dump_ir)
         {
             auto dump_path = compile_options_.dump_dir / "codegen";
@@ -418,12 +446,90 @@ public:
         auto schr = sch.schedule();
         model_builder builder(*target_, schr);
         builder.config_dump(compile_options_.dump_dir, compile_options_.dump_asm);
+        builder.config_compression(parse_section_compression(compile_options_.section_compression));
         auto result = builder.build(output);
 
         dump_summary(graph_, builder, result);
     }
 
 private:
+    void check_static_dims(std::string_view format)
+    {
+        if (!compile_options_.dim_values.empty())
+            throw std::runtime_error("Symbolic input dimensions are only supported for ONNX models, not " + std::string(format));
+    }
+
+    // Every combination of the symbolic dimension values, the first one is compiled as the main graph
+    std::vector<std::unordered_map<std::string, size_t>> dim_bindings() const
+    {
+        std::vector<std::unordered_map<std::string, size_t>> bindings(1);
+        for (auto &[name, values] : compile_options_.dim_values)
+        {
+            if (values.empty())
+                throw std::runtime_error("No values for symbolic dimension " + name);
+
+            std::vector<std::unordered_map<std::string, size_t>> expanded;
+            for (auto &binding : bindings)
+            {
+                for (auto value : values)
+                {
+                    auto &new_binding = expanded.emplace_back(binding);
+                    new_binding[name] = value;
+                }
+            }
+            bindings = std::move(expanded);
+        }
+
+        return bindings;
+    }
+
+    std::string variant_name(const std::unordered_map<std::string, size_t> &binding) const
+    {
+        std::string name = graph_.name();
+        for (auto &[dim, values] : compile_options_.dim_values)
+            name += "_" + dim + std::to_string(binding.at(dim));
+        return name;
+    }
+
+    // The float pipeline of compile() for a main graph imported at other input shapes
+    void compile_variant(ir::graph &graph)
+    {
+        std::cout << "Compile " << graph.name() << "..." << std::endl;
+        if (compile_options_.preprocess)
+        {
+            pre_process(graph, compile_options_);
+            post_process(graph, compile_options_);
+        }
+
+        optimize_target_independent(graph);
+        optimize_target_dependent(graph, false);
+        graph.set_module_type(to_module_type("stackvm"));
+        optimize_target_dependent_after_quant(graph);
+        optimize_merge_module_regions(graph);
+        if (compile_options_.benchmark_only)
+            optimize_benchmark(graph);
+    }
+
+    static uint32_t parse_section_compression(std::string_view name)
+    {
+        if (name == "none")
+            return 0;
+        else if (name == "lz4")
+            return runtime::SECTION_COMPRESSED_LZ4;
+        else if (name == "zstd")
+            return runtime::SECTION_COMPRESSED_ZSTD;
+        throw std::runtime_error("Unsupported section compression: " + std::string(name));
+    }
+
+    static schedule::memory_placement parse_memory_placement(std::string_view name)
+    {
+        if (name == "best")
+            return schedule::memory_placement::best;
+        else if (name == "first_fit")
+            return schedule::memory_placement::first_fit;
+        throw std::runtime_error("Unsupported memory placement: " + std::string(name));
+    }
+
     void set_target(std::string_view type)
     {
         target_ = plugin_loader::create_target(type);
@@ -515,6 +621,24 @@ private:
     void optimize_target_dependent_after_quant(ir::graph &graph)
     {
         run_passes("target_dep_after_quant", graph, [&](const module_type_t &module_type, ir::transforms::pass_manager &pmgr) { target_->register_target_dependent_after_quantization_passes(module_type, pmgr); });
+
+        auto w_storage_type = parse_datatype_str(compile_options_.w_storage_type);
+        if (w_storage_type != dt_float32)
+        {
+            if (w_storage_type != dt_float16 && w_storage_type != dt_bfloat16)
+                throw std::runtime_error("Unsupported weights storage type: " + compile_options_.w_storage_type);
+
+            using namespace ir::transforms;
+            run_passes("weights_storage", graph, [&](const module_type_t &module_type, ir::transforms::pass_manager &pmgr) {
+                if (module_type == runtime::stackvm::stackvm_module_type)
+                {
+                    transform_pass pass("weights_storage");
+                    pass.emplace<convert_weights_storage_transform>(w_storage_type);
+                    pass.emplace<fold_constant_transform>();
+                    pmgr.add_pass(std::move(pass));
+                }
+            });
+        }
     }
 
     void add_quantize_annotation(ir::graph &graph)
@@ -779,11 +903,25 @@ private:
         i = 0;
         for (auto &out : graph.outputs())
             std::cout << i++ << "\t" << out->name() << "\t" << datatype_names(out->input().type()) << ir::to_string(out->input().shape()) << std::endl;
+        if (!variants_.empty())
+        {
+            std::cout << "VARIANTS" << std::endl;
+            i = 0;
+            dump_variant(i++, graph);
+            for (auto &variant : variants_)
+                dump_variant(i++, *variant);
+        }
+
         std::cout << "\nMEMORY USAGES" << std::endl;
         size_t total_usage = 0;
         total_usage += dump_memory_usage(mod_builder, mem_input, ".input");
         total_usage += dump_memory_usage(mod_builder, mem_output, ".output");
         total_usage += dump_memory_usage(mod_builder, mem_data, ".data");
+        // on-chip memory of the target, e.g. the K210 KPU RAM, not part of the total
+        if (mod_builder.max_usage(mem_private_base))
+            dump_memory_usage(mod_builder, mem_private_base, ".private");
+        if (auto saved = mod_builder.deduplicated_bytes(mem_rdata))
+            std::cout << ".rdata\t" << format_size(saved) << " deduplicated" << std::endl;
         std::cout << "MODEL"
                   << "\t" << format_size(build_result.model_size) << std::endl;
         total_usage += build_result.model_size;
@@ -805,10 +943,20 @@ private:
         file << "input: " << format_size(mod_builder.max_usage(mem_input)) << std::endl;
         file << "output: " << format_size(mod_builder.max_usage(mem_output)) << std::endl;
         file << "data: " << format_size(mod_builder.max_usage(mem_data)) << std::endl;
+        if (mod_builder.max_usage(mem_private_base))
+            file << "private: " << format_size(mod_builder.max_usage(mem_private_base)) << std::endl;
         file << "MODEL: " << format_size(build_result.model_size) << std::endl;
         file << "TOTAL: " << format_size(total_usage) << std::endl;
     }
 
+    void dump_variant(size_t index, ir::graph &graph)
+    {
+        std::cout << index << "\t" << graph.name();
+        for (auto &in : graph.inputs())
+            std::cout << "\t" << ir::to_string(in->output().shape());
+        std::cout << std::endl;
+    }
+
     size_t dump_memory_usage(codegen::model_builder &mod_builder, memory_location_t location, std::string_view name)
     {
         auto usage = mod_builder.max_usage(location);
@@ -818,6 +966,7 @@ private:
 
 private:
     ir::graph graph_;
+    std::vector<std::unique_ptr<ir::graph>> variants_;
     compile_options compile_options_;
     std::string input_layout_;
     std::variant<ptq_dataset_options, ptq_tensor_options> ptq_options_;
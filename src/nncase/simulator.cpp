@@ -78,37 +78,45 @@ private:
         size_t i = 0;
         for (auto it = dataset.begin<T>(); it != dataset.end<T>(); ++it)
         {
-            {
-                auto input_tensor = interp_.input_tensor(0).unwrap();
-                auto input_map = std::move(hrt::map(input_tensor, hrt::map_write).unwrap());
-                auto input_buffer = input_map.buffer();
-                auto &tensor = it->tensor;
-                std::memcpy(input_buffer.data(), tensor.data(), input_buffer.size_bytes());
-            }
+            // The input views the sample and keeps it alive until the request is done, so the
+            // dataset can move on while it is in flight and only the pipeline's upload copies it
+            auto sample = std::make_shared<xt::xarray<T>>(std::move(it->tensor));
+            auto input_tensor = hrt::create(interp_.input_desc(0).datatype, interp_.input_shape(0),
+                                    { reinterpret_cast<gsl::byte *>(sample->data()), sample->size() * sizeof(T) },
+                                    [sample](gsl::byte *) {})
+                                    .unwrap_or_throw();
 
-            auto r = interp_.run();
-            if (r.is_ok())
-            {
-                std::filesystem::path out_filename(options_.output_path / it->filenames[0].filename());
-                out_filename.replace_extension(".bin");
+            std::vector<runtime_tensor> output_tensors(interp_.outputs_size());
+            for (size_t o = 0; o < output_tensors.size(); o++)
+                output_tensors[o] = hrt::create(interp_.output_desc(o).datatype, interp_.output_shape(o)).unwrap_or_throw();
 
-                std::ofstream of(out_filename, std::ios::binary | std::ios::out);
-                for (size_t i = 0; i < interp_.outputs_size(); i++)
-                {
-                    auto output_tensor = interp_.output_tensor(i).unwrap();
-                    auto output_map = std::move(hrt::map(output_tensor, hrt::map_read).unwrap());
-                    auto output_buffer = output_map.buffer();
-                    of.write(reinterpret_cast<const char *>(output_buffer.data()), output_buffer.size());
-                }
-            }
-            else
-            {
-                std::cerr << "Eval " << it->filenames[0].filename() << " failed: " << r.unwrap_err().message() << std::endl;
-            }
+            auto filename = it->filenames[0].filename();
+            interp_.run_async({ input_tensor }, output_tensors, [this, output_tensors, filename](result<void> r) mutable {
+                       if (r.is_ok())
+                       {
+                           std::filesystem::path out_filename(options_.output_path / filename);
+                           out_filename.replace_extension(".bin");
+
+                           std::ofstream of(out_filename, std::ios::binary | std::ios::out);
+                           for (auto &output_tensor : output_tensors)
+                           {
+                               auto output_map = std::move(hrt::map(output_tensor, hrt::map_read).unwrap());
+                               auto output_buffer = output_map.buffer();
+                               of.write(reinterpret_cast<const char *>(output_buffer.data()), output_buffer.size());
+                           }
+                       }
+                       else
+                       {
+                           std::cerr << "Eval " << filename << " failed: " << r.unwrap_err().message() << std::endl;
+                       }
+                   })
+                .unwrap_or_throw();
 
             if (options_.progress)
                 options_.progress(i, dataset.total_size());
         }
+
+        interp_.wait_async_idle();
     }
 
 private:
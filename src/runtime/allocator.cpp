@@ -12,15 +12,157 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <new>
 #include <nncase/runtime/allocator.h>
 
 using namespace nncase;
 using namespace nncase::runtime;
 
-allocation_state::~allocation_state()
+namespace
 {
+std::atomic<host_allocator *> default_allocator_ { nullptr };
+
+host_allocator &heap_allocator() noexcept
+{
+    // never destroyed, tensors with static storage may be released after it
+    static auto allocator = new heap_host_allocator;
+    return *allocator;
+}
+
+gsl::byte *heap_allocate(size_t bytes) noexcept
+{
+    return reinterpret_cast<gsl::byte *>(::operator new(bytes, std::align_val_t(host_buffer_alignment), std::nothrow));
+}
+
+void heap_free(gsl::byte *buffer) noexcept
+{
+    ::operator delete(buffer, std::align_val_t(host_buffer_alignment));
+}
 }
 
 host_allocator::~host_allocator()
 {
 }
+
+gsl::byte *heap_host_allocator::allocate(size_t bytes) noexcept
+{
+    return heap_allocate(bytes);
+}
+
+void heap_host_allocator::free(gsl::byte *buffer, NNCASE_UNUSED size_t bytes) noexcept
+{
+    heap_free(buffer);
+}
+
+pooled_host_allocator::pooled_host_allocator(size_t max_bytes_held) noexcept
+    : max_bytes_held_(max_bytes_held), stats_ {}
+{
+}
+
+pooled_host_allocator::~pooled_host_allocator()
+{
+    trim();
+}
+
+size_t pooled_host_allocator::size_class(size_t bytes) noexcept
+{
+    if (bytes <= host_buffer_alignment)
+        return host_buffer_alignment;
+
+    // a quarter of the largest power of two below bytes
+    size_t step = host_buffer_alignment / 4;
+    while (step * 8 < bytes)
+        step *= 2;
+    return (bytes + step - 1) / step * step;
+}
+
+gsl::byte *pooled_host_allocator::allocate(size_t bytes) noexcept
+{
+    auto size = size_class(bytes);
+    lock();
+    auto it = free_lists_.find(size);
+    if (it != free_lists_.end() && !it->second.empty())
+    {
+        auto buffer = it->second.back();
+        it->second.pop_back();
+        stats_.hits++;
+        stats_.bytes_held -= size;
+        unlock();
+        return buffer;
+    }
+
+    stats_.misses++;
+    unlock();
+    return heap_allocate(size);
+}
+
+void pooled_host_allocator::free(gsl::byte *buffer, size_t bytes) noexcept
+{
+    if (!buffer)
+        return;
+
+    auto size = size_class(bytes);
+    lock();
+    if (stats_.bytes_held + size <= max_bytes_held_)
+    {
+        try
+        {
+            free_lists_[size].push_back(buffer);
+            stats_.bytes_held += size;
+            unlock();
+            return;
+        }
+        catch (...)
+        {
+        }
+    }
+
+    unlock();
+    heap_free(buffer);
+}
+
+host_allocator_stats pooled_host_allocator::stats() const noexcept
+{
+    lock();
+    auto stats = stats_;
+    unlock();
+    return stats;
+}
+
+void pooled_host_allocator::trim() noexcept
+{
+    lock();
+    auto free_lists = std::move(free_lists_);
+    free_lists_.clear();
+    stats_.bytes_held = 0;
+    unlock();
+
+    for (auto &list : free_lists)
+    {
+        for (auto buffer : list.second)
+            heap_free(buffer);
+    }
+}
+
+// Held only for a few pointer moves, a spin lock also builds for bare metal targets without std::mutex
+void pooled_host_allocator::lock() const noexcept
+{
+    while (lock_.test_and_set(std::memory_order_acquire))
+        ;
+}
+
+void pooled_host_allocator::unlock() const noexcept
+{
+    lock_.clear(std::memory_order_release);
+}
+
+host_allocator &nncase::runtime::default_host_allocator() noexcept
+{
+    auto allocator = default_allocator_.load(std::memory_order_acquire);
+    return allocator ? *allocator : heap_allocator();
+}
+
+void nncase::runtime::default_host_allocator(host_allocator *allocator) noexcept
+{
+    default_allocator_.store(allocator, std::memory_order_release);
+}
@@ -48,6 +48,8 @@ public:
             return "Shape mismatch";
         case nncase_errc::invalid_memory_location:
             return "Invalid memory location";
+        case nncase_errc::invalid_model_section:
+            return "Invalid model section";
         case nncase_errc::stackvm_illegal_instruction:
             return "StackVM illegal instruction";
         case nncase_errc::stackvm_illegal_target:
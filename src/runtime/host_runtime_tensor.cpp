@@ -25,10 +25,26 @@ using namespace nncase::runtime::detail;
 namespace
 {
 runtime_tensor_type host_runtime_tensor_type_ { "host" };
+
+result<void> allocate_block(host_memory_block &block) noexcept
+{
+    if (block.pool == hrt::pool_cpu_only)
+    {
+        auto allocator = block.allocator;
+        auto size = block.size_bytes;
+        auto buffer = allocator->allocate(size);
+        CHECK_WITH_ERR(buffer, std::errc::not_enough_memory);
+        block.deleter = [allocator, size](gsl::byte *buffer) { allocator->free(buffer, size); };
+        block.virtual_address = (uintptr_t)buffer;
+        return ok();
+    }
+
+    return physical_memory_block::allocate(block);
+}
 }
 
 host_memory_block::host_memory_block(host_memory_block &&other) noexcept
-    : pool(other.pool), virtual_address(other.virtual_address), size_bytes(other.size_bytes), deleter(std::move(other.deleter)), cache_status(other.cache_status), physical_block(std::move(other.physical_block))
+    : pool(other.pool), virtual_address(other.virtual_address), size_bytes(other.size_bytes), deleter(std::move(other.deleter)), allocator(other.allocator), cache_status(other.cache_status), physical_block(std::move(other.physical_block))
 {
     other.deleter = {};
 }
@@ -40,6 +56,7 @@ host_memory_block &host_memory_block::operator=(host_memory_block &&other) noexc
     virtual_address = other.virtual_address;
     size_bytes = other.size_bytes;
     deleter = std::move(other.deleter);
+    allocator = other.allocator;
     cache_status = other.cache_status;
     physical_block = std::move(other.physical_block);
     other.deleter = {};
@@ -222,29 +239,28 @@ runtime_tensor_type &hrt::tensor_type() noexcept
 
 result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, runtime_shape_t strides, memory_pool_t pool, uintptr_t physical_address) noexcept
 {
+    if (pool == pool_cpu_only || !physical_address)
+        return create(datatype, std::move(shape), std::move(strides), default_host_allocator(), pool);
+
     host_memory_block block {};
     block.pool = pool;
     block.size_bytes = compute_size(shape, strides) * get_bytes(datatype);
+    block.physical_block.physical_address = physical_address;
+    try_(physical_memory_block::acknowledge(block));
 
-    if (pool == pool_cpu_only)
-    {
-        std::unique_ptr<gsl::byte[]> buffer(new (std::nothrow) gsl::byte[block.size_bytes]);
-        CHECK_WITH_ERR(buffer, std::errc::not_enough_memory);
-        block.deleter = std::default_delete<gsl::byte[]>();
-        block.virtual_address = (uintptr_t)buffer.release();
-    }
-    else
-    {
-        if (physical_address)
-        {
-            block.physical_block.physical_address = physical_address;
-            try_(physical_memory_block::acknowledge(block));
-        }
-        else
-        {
-            try_(physical_memory_block::allocate(block));
-        }
-    }
+    std::shared_ptr<runtime_tensor_impl> impl(new (std::nothrow) host_runtime_tensor_impl(datatype,
+        std::move(shape), std::move(strides), std::move(block)));
+    CHECK_WITH_ERR(impl, std::errc::not_enough_memory);
+    return ok(runtime_tensor(std::move(impl)));
+}
+
+result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, runtime_shape_t strides, host_allocator &allocator, memory_pool_t pool) noexcept
+{
+    host_memory_block block {};
+    block.pool = pool;
+    block.size_bytes = compute_size(shape, strides) * get_bytes(datatype);
+    block.allocator = &allocator;
+    try_(allocate_block(block));
 
     std::shared_ptr<runtime_tensor_impl> impl(new (std::nothrow) host_runtime_tensor_impl(datatype,
         std::move(shape), std::move(strides), std::move(block)));
@@ -260,16 +276,14 @@ result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, r
     host_memory_block block {};
     block.pool = pool;
     block.size_bytes = size;
+    block.allocator = &default_host_allocator();
 
     if (pool == pool_cpu_only)
     {
         if (copy)
         {
-            std::unique_ptr<gsl::byte[]> buffer(new (std::nothrow) gsl::byte[block.size_bytes]);
-            CHECK_WITH_ERR(buffer, std::errc::not_enough_memory);
-            try_(kernels::copy(datatype, data.data(), buffer.get(), shape, strides, strides));
-            block.deleter = std::default_delete<gsl::byte[]>();
-            block.virtual_address = (uintptr_t)buffer.release();
+            try_(allocate_block(block));
+            try_(kernels::copy(datatype, data.data(), block.virtual_buffer().data(), shape, strides, strides));
         }
         else
         {
@@ -287,7 +301,7 @@ result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, r
         }
         else
         {
-            try_(physical_memory_block::allocate(block));
+            try_(allocate_block(block));
         }
 
         if (copy)
@@ -336,6 +350,11 @@ result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, m
     return create(datatype, shape, get_default_strides(shape), pool, physical_address);
 }
 
+result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, host_allocator &allocator, memory_pool_t pool) noexcept
+{
+    return create(datatype, shape, get_default_strides(shape), allocator, pool);
+}
+
 result<runtime_tensor> hrt::create(datatype_t datatype, runtime_shape_t shape, gsl::span<gsl::byte> data, bool copy, memory_pool_t pool, uintptr_t physical_address) noexcept
 {
     return create(datatype, shape, get_default_strides(shape), data, copy, pool, physical_address);
@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <nncase/runtime/dbg.h>
@@ -19,12 +20,25 @@
 #include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_loader.h>
 #include <nncase/runtime/span_reader.h>
+#ifdef NNCASE_ASYNC_RUNTIME
+#include "interpreter_pipeline.h"
+#else
+BEGIN_NS_NNCASE_RUNTIME
+class interpreter_pipeline
+{
+};
+END_NS_NNCASE_RUNTIME
+#endif
 
 using namespace nncase;
 using namespace nncase::runtime;
 
 interpreter::interpreter() noexcept
-    : entry_function_(nullptr)
+    : entry_function_(nullptr), allocator_(nullptr), scratch_(nullptr)
+{
+}
+
+interpreter::~interpreter()
 {
 }
 
@@ -38,6 +52,24 @@ result<void> interpreter::load_model(gsl::span<const gsl::byte> buffer) noexcept
     if (header->version != MODEL_VERSION)
         return err(nncase_errc::invalid_model_version);
 
+    std::vector<uint32_t> variant_ids;
+    if (header->flags & MODEL_HAS_ENTRY_VARIANTS)
+    {
+        CHECK_WITH_ERR(reader.avail() >= sizeof(uint32_t), std::errc::invalid_argument);
+        auto count = reader.read<uint32_t>();
+        CHECK_WITH_ERR(count <= reader.avail() / sizeof(uint32_t), std::errc::invalid_argument);
+        try
+        {
+            variant_ids.resize(count);
+        }
+        catch (...)
+        {
+            return err(std::errc::not_enough_memory);
+        }
+        for (auto &id : variant_ids)
+            id = reader.read<uint32_t>();
+    }
+
     // 2. Load modules
     try
     {
@@ -57,7 +89,17 @@ result<void> interpreter::load_model(gsl::span<const gsl::byte> buffer) noexcept
 
         try_(rt_module->initialize(payload, *this));
         if (i == header->entry_module)
+        {
             try_set(entry_function_, rt_module->find_function_by_id(header->entry_function));
+            for (auto id : variant_ids)
+            {
+                try_var(variant, rt_module->find_function_by_id(id));
+                CHECK_WITH_ERR(variant->inputs_size() == entry_function_->inputs_size()
+                        && variant->outputs_size() == entry_function_->outputs_size(),
+                    std::errc::invalid_argument);
+                entry_variants_.emplace_back(variant);
+            }
+        }
         modules_[i] = std::move(rt_module);
     }
 
@@ -114,11 +156,79 @@ result<void> interpreter::output_tensor(size_t index, runtime_tensor tensor) noe
     return entry_function_->output_tensor(index, tensor);
 }
 
+bool interpreter::output_required(size_t index) const noexcept
+{
+    return entry_function_->output_required(index);
+}
+
+result<void> interpreter::output_required(size_t index, bool required) noexcept
+{
+    return entry_function_->output_required(index, required);
+}
+
+result<void> interpreter::reshape_inputs(gsl::span<const runtime_shape_t> shapes) noexcept
+{
+    CHECK_WITH_ERR(shapes.size() == inputs_size(), std::errc::invalid_argument);
+    auto matches = [&](runtime_function *function) {
+        for (size_t i = 0; i < shapes.size(); i++)
+        {
+            if (function->input_shape(i) != shapes[i])
+                return false;
+        }
+        return true;
+    };
+
+    if (matches(entry_function_))
+        return ok();
+
+    auto it = std::find_if(entry_variants_.begin(), entry_variants_.end(), matches);
+    CHECK_WITH_ERR(it != entry_variants_.end(), nncase_errc::shape_mismatch);
+    for (size_t i = 0; i < outputs_size(); i++)
+        try_((*it)->output_required(i, entry_function_->output_required(i)));
+
+    // The pipeline's tensors have the old shapes
+    wait_async_idle();
+    pipeline_.reset();
+    entry_function_ = *it;
+    return ok();
+}
+
 result<void> interpreter::run() noexcept
 {
     return entry_function_->invoke();
 }
 
+result<void> interpreter::run_async(NNCASE_UNUSED std::vector<runtime_tensor> inputs, NNCASE_UNUSED std::vector<runtime_tensor> outputs, NNCASE_UNUSED run_async_callback_t callback) noexcept
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    CHECK_WITH_ERR(entry_function_, std::errc::invalid_argument);
+    if (!pipeline_)
+    {
+        std::unique_ptr<interpreter_pipeline> pipeline(new (std::nothrow) interpreter_pipeline(*this));
+        CHECK_WITH_ERR(pipeline, std::errc::not_enough_memory);
+        try_(pipeline->initialize());
+        pipeline_ = std::move(pipeline);
+    }
+
+    return pipeline_->submit(std::move(inputs), std::move(outputs), std::move(callback));
+#else
+    return err(std::errc::not_supported);
+#endif
+}
+
+void interpreter::wait_async_idle() noexcept
+{
+#ifdef NNCASE_ASYNC_RUNTIME
+    if (pipeline_)
+        pipeline_->wait_idle();
+#endif
+}
+
+size_t interpreter::modules_size() const noexcept
+{
+    return modules_.size();
+}
+
 result<runtime_module *> interpreter::find_module_by_id(size_t index) noexcept
 {
     CHECK_WITH_ERR(index < modules_.size(), std::errc::result_out_of_range);
@@ -129,3 +239,23 @@ options_dict &interpreter::options() noexcept
 {
     return options_;
 }
+
+host_allocator &interpreter::allocator() const noexcept
+{
+    return allocator_ ? *allocator_ : default_host_allocator();
+}
+
+void interpreter::allocator(host_allocator &allocator) noexcept
+{
+    allocator_ = &allocator;
+}
+
+scratch_arena *interpreter::scratch() const noexcept
+{
+    return scratch_;
+}
+
+void interpreter::scratch(scratch_arena &arena) noexcept
+{
+    scratch_ = &arena;
+}
@@ -0,0 +1,221 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "interpreter_pipeline.h"
+#include <nncase/runtime/dbg.h>
+#include <nncase/runtime/error.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+interpreter_pipeline::interpreter_pipeline(interpreter &interp) noexcept
+    : interp_(interp)
+{
+}
+
+interpreter_pipeline::~interpreter_pipeline()
+{
+    wait_idle();
+
+    upload_queue_.close();
+    free_input_slots_.close();
+    compute_queue_.close();
+    free_output_slots_.close();
+    readback_queue_.close();
+
+    if (upload_thread_.joinable())
+        upload_thread_.join();
+    if (compute_thread_.joinable())
+        compute_thread_.join();
+    if (readback_thread_.joinable())
+        readback_thread_.join();
+}
+
+result<void> interpreter_pipeline::initialize() noexcept
+{
+    try
+    {
+        for (size_t slot = 0; slot < SLOTS; slot++)
+        {
+            auto &inputs = input_slots_[slot];
+            inputs.resize(interp_.inputs_size());
+            for (size_t i = 0; i < inputs.size(); i++)
+                try_set(inputs[i], hrt::create(interp_.input_desc(i).datatype, interp_.input_shape(i), interp_.allocator(), hrt::pool_shared));
+
+            auto &outputs = output_slots_[slot];
+            outputs.resize(interp_.outputs_size());
+            for (size_t i = 0; i < outputs.size(); i++)
+                try_set(outputs[i], hrt::create(interp_.output_desc(i).datatype, interp_.output_shape(i), interp_.allocator(), hrt::pool_shared));
+
+            free_input_slots_.push(slot);
+            free_output_slots_.push(slot);
+        }
+
+        upload_thread_ = std::thread([this] { upload_loop(); });
+        compute_thread_ = std::thread([this] { compute_loop(); });
+        readback_thread_ = std::thread([this] { readback_loop(); });
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    return ok();
+}
+
+result<void> interpreter_pipeline::submit(std::vector<runtime_tensor> inputs, std::vector<runtime_tensor> outputs, run_async_callback_t callback) noexcept
+{
+    CHECK_WITH_ERR(inputs.size() == interp_.inputs_size(), std::errc::invalid_argument);
+    CHECK_WITH_ERR(outputs.size() == interp_.outputs_size(), std::errc::invalid_argument);
+
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        CHECK_WITH_ERR(!inputs[i].empty(), std::errc::invalid_argument);
+        CHECK_WITH_ERR(inputs[i].datatype() == interp_.input_desc(i).datatype, nncase_errc::datatype_mismatch);
+        CHECK_WITH_ERR(inputs[i].shape() == interp_.input_shape(i), nncase_errc::shape_mismatch);
+    }
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        // outputs that are not required are left untouched, so they may be empty
+        if (!interp_.output_required(i))
+            continue;
+        CHECK_WITH_ERR(!outputs[i].empty(), std::errc::invalid_argument);
+        CHECK_WITH_ERR(outputs[i].datatype() == interp_.output_desc(i).datatype, nncase_errc::datatype_mismatch);
+        CHECK_WITH_ERR(outputs[i].shape() == interp_.output_shape(i), nncase_errc::shape_mismatch);
+    }
+
+    bool counted = false;
+    try
+    {
+        request req;
+        req.inputs = std::move(inputs);
+        req.outputs = std::move(outputs);
+        req.callback = std::move(callback);
+        req.outputs_required.resize(req.outputs.size());
+        for (size_t i = 0; i < req.outputs.size(); i++)
+            req.outputs_required[i] = interp_.output_required(i);
+
+        // Counted before it is queued, so readback can't finish it first
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_++;
+        }
+        counted = true;
+
+        upload_queue_.push(std::move(req));
+    }
+    catch (...)
+    {
+        // The request never made it into the queue, nothing will finish it
+        if (counted)
+        {
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                pending_--;
+            }
+            pending_cond_.notify_all();
+        }
+
+        return err(std::errc::not_enough_memory);
+    }
+
+    return ok();
+}
+
+void interpreter_pipeline::wait_idle() noexcept
+{
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    pending_cond_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void interpreter_pipeline::upload_loop() noexcept
+{
+    request req;
+    while (upload_queue_.pop(req))
+    {
+        if (!free_input_slots_.pop(req.input_slot))
+            break;
+        req.status = upload(req);
+        compute_queue_.push(std::move(req));
+    }
+}
+
+void interpreter_pipeline::compute_loop() noexcept
+{
+    request req;
+    while (compute_queue_.pop(req))
+    {
+        if (!free_output_slots_.pop(req.output_slot))
+            break;
+        if (req.status.is_ok())
+            req.status = compute(req);
+        free_input_slots_.push(req.input_slot);
+        readback_queue_.push(std::move(req));
+    }
+}
+
+void interpreter_pipeline::readback_loop() noexcept
+{
+    request req;
+    while (readback_queue_.pop(req))
+    {
+        if (req.status.is_ok())
+            req.status = readback(req);
+        free_output_slots_.push(req.output_slot);
+
+        if (req.callback)
+            req.callback(std::move(req.status));
+
+        // Drop the caller's tensors before reporting idle
+        req = request();
+
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_--;
+        }
+        pending_cond_.notify_all();
+    }
+}
+
+result<void> interpreter_pipeline::upload(request &req) noexcept
+{
+    auto &slot = input_slots_[req.input_slot];
+    for (size_t i = 0; i < slot.size(); i++)
+        try_(req.inputs[i].copy_to(slot[i]));
+    return ok();
+}
+
+result<void> interpreter_pipeline::compute(request &req) noexcept
+{
+    auto &inputs = input_slots_[req.input_slot];
+    auto &outputs = output_slots_[req.output_slot];
+    for (size_t i = 0; i < inputs.size(); i++)
+        try_(interp_.input_tensor(i, inputs[i]));
+    for (size_t i = 0; i < outputs.size(); i++)
+        try_(interp_.output_tensor(i, outputs[i]));
+    return interp_.run();
+}
+
+result<void> interpreter_pipeline::readback(request &req) noexcept
+{
+    auto &slot = output_slots_[req.output_slot];
+    for (size_t i = 0; i < slot.size(); i++)
+    {
+        if (req.outputs_required[i])
+            try_(slot[i].copy_to(req.outputs[i]));
+    }
+    return ok();
+}
@@ -0,0 +1,120 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <nncase/runtime/interpreter.h>
+#include <thread>
+
+BEGIN_NS_NNCASE_RUNTIME
+
+// Three-stage (upload -> compute -> readback) pipeline behind interpreter::run_async.
+// Inputs and outputs are double buffered, so the upload of request N+1 and the
+// readback of request N-1 overlap with the compute of request N.
+class interpreter_pipeline
+{
+    static constexpr size_t SLOTS = 2;
+
+    template <class T>
+    class blocking_queue
+    {
+    public:
+        void push(T value)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                items_.emplace_back(std::move(value));
+            }
+            cond_.notify_one();
+        }
+
+        bool pop(T &value)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this] { return closed_ || !items_.empty(); });
+            if (items_.empty())
+                return false;
+            value = std::move(items_.front());
+            items_.pop_front();
+            return true;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+            }
+            cond_.notify_all();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::deque<T> items_;
+        bool closed_ = false;
+    };
+
+    struct request
+    {
+        std::vector<runtime_tensor> inputs;
+        std::vector<runtime_tensor> outputs;
+        // output_required when the request was submitted
+        std::vector<bool> outputs_required;
+        run_async_callback_t callback;
+        size_t input_slot;
+        size_t output_slot;
+        result<void> status = ok();
+    };
+
+public:
+    interpreter_pipeline(interpreter &interp) noexcept;
+    interpreter_pipeline(const interpreter_pipeline &) = delete;
+    ~interpreter_pipeline();
+    interpreter_pipeline &operator=(const interpreter_pipeline &) = delete;
+
+    result<void> initialize() noexcept;
+    result<void> submit(std::vector<runtime_tensor> inputs, std::vector<runtime_tensor> outputs, run_async_callback_t callback) noexcept;
+    void wait_idle() noexcept;
+
+private:
+    void upload_loop() noexcept;
+    void compute_loop() noexcept;
+    void readback_loop() noexcept;
+
+    result<void> upload(request &req) noexcept;
+    result<void> compute(request &req) noexcept;
+    result<void> readback(request &req) noexcept;
+
+private:
+    interpreter &interp_;
+    std::vector<runtime_tensor> input_slots_[SLOTS];
+    std::vector<runtime_tensor> output_slots_[SLOTS];
+    blocking_queue<size_t> free_input_slots_;
+    blocking_queue<size_t> free_output_slots_;
+    blocking_queue<request> upload_queue_;
+    blocking_queue<request> compute_queue_;
+    blocking_queue<request> readback_queue_;
+    std::thread upload_thread_;
+    std::thread compute_thread_;
+    std::thread readback_thread_;
+
+    std::mutex pending_mutex_;
+    std::condition_variable pending_cond_;
+    size_t pending_ = 0;
+};
+
+END_NS_NNCASE_RUNTIME
@@ -15,6 +15,7 @@
 #include "section.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/error.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_function.h>
 #include <nncase/runtime/span_reader.h>
 
@@ -196,7 +197,7 @@ result<void> runtime_function::input_tensor(size_t index, runtime_tensor tensor)
                 try_var(device_tensor, allocate_input_tensor(index));
             if (!tensor.can_copy_to_without_staging(device_tensor))
             {
-                try_set(info.staging_tensor, host_runtime_tensor::create(info.range.datatype, info.shape));
+                try_set(info.staging_tensor, host_runtime_tensor::create(info.range.datatype, info.shape, module().interp().allocator()));
             }
             else
             {
@@ -235,7 +236,7 @@ result<void> runtime_function::output_tensor(size_t index, runtime_tensor tensor
                 try_var(device_tensor, allocate_output_tensor(index));
             if (!device_tensor.can_copy_to_without_staging(tensor))
             {
-                try_set(info.staging_tensor, host_runtime_tensor::create(info.range.datatype, info.shape));
+                try_set(info.staging_tensor, host_runtime_tensor::create(info.range.datatype, info.shape, module().interp().allocator()));
             }
             else
             {
@@ -256,6 +257,19 @@ result<void> runtime_function::output_tensor(size_t index, runtime_tensor tensor
     return ok();
 }
 
+bool runtime_function::output_required(size_t index) const noexcept
+{
+    assert(index < output_tensors_.size());
+    return output_tensors_[index].required;
+}
+
+result<void> runtime_function::output_required(size_t index, bool required) noexcept
+{
+    CHECK_WITH_ERR(index < output_tensors_.size(), std::errc::result_out_of_range);
+    output_tensors_[index].required = required;
+    return ok();
+}
+
 result<void> runtime_function::invoke() noexcept
 {
     // 1. Ensure bindings
@@ -294,6 +308,9 @@ result<void> runtime_function::invoke() noexcept
     // 4. Copy outputs
     for (auto &out : output_tensors_)
     {
+        if (!out.required)
+            continue;
+
         if (out.staging_tensor.empty())
         {
             if (!out.device_tensor.empty())
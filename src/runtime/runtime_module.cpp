@@ -15,6 +15,8 @@
 #include "section.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/error.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_module.h>
 #include <nncase/runtime/span_reader.h>
 
@@ -26,11 +28,16 @@ namespace
 class runtime_module_init_context_impl : public runtime_module_init_context
 {
 public:
-    runtime_module_init_context_impl(const module_header &header, interpreter &interp, gsl::span<const gsl::byte> sections) noexcept
-        : header_(header), interp_(interp), sections_(sections)
+    runtime_module_init_context_impl(const module_header &header, interpreter &interp, gsl::span<const gsl::byte> sections, std::vector<runtime_tensor> &section_buffers) noexcept
+        : header_(header), interp_(interp), sections_(sections), section_buffers_(section_buffers), decompress_failed_(false)
     {
     }
 
+    bool decompress_failed() const noexcept
+    {
+        return decompress_failed_;
+    }
+
     interpreter &interp() noexcept override
     {
         return interp_;
@@ -48,13 +55,58 @@ public:
 
     gsl::span<const gsl::byte> section(const char *name) noexcept override
     {
-        return find_section(name, sections_);
+        auto header = find_section_header(name, sections_);
+        if (!header)
+            return {};
+        if (header->flags & SECTION_MERGED_INTO_RDATA)
+            return section(".rdata").subspan(header->body_start, header->body_size);
+        if (!(header->flags & SECTION_COMPRESSION_MASK))
+            return section_body(*header);
+
+        // compressed sections are decompressed the first time they are asked for
+        for (auto &[decompressed_header, body] : decompressed_)
+        {
+            if (decompressed_header == header)
+                return body;
+        }
+
+        auto body = decompress(*header);
+        if (body.is_ok())
+            return body.unwrap();
+        decompress_failed_ = true;
+        return {};
+    }
+
+private:
+    // A body that fails to decompress is still handed out at its full size, so modules can finish
+    // initializing before initialize() reports the error
+    result<gsl::span<const gsl::byte>> decompress(const section_header &header) noexcept
+    {
+        try_var(buffer, hrt::create(dt_uint8, { header.uncompressed_size }, interp_.allocator(), hrt::pool_cpu_only));
+        try_var(map, hrt::map(buffer, hrt::map_write));
+        gsl::span<const gsl::byte> body = map.buffer();
+        try
+        {
+            section_buffers_.emplace_back(std::move(buffer));
+            decompressed_.emplace_back(&header, body);
+        }
+        catch (...)
+        {
+            return err(std::errc::not_enough_memory);
+        }
+
+        if (decompress_section(header, map.buffer()).is_err())
+            decompress_failed_ = true;
+        return ok(body);
     }
 
 private:
     const module_header &header_;
     interpreter &interp_;
     gsl::span<const gsl::byte> sections_;
+    std::vector<runtime_tensor> &section_buffers_;
+    std::vector<std::pair<const section_header *, gsl::span<const gsl::byte>>> decompressed_;
+    bool decompress_failed_;
 };
 
 gsl::span<const gsl::byte> read_functions(span_reader &sr, size_t functions) noexcept
@@ -128,7 +180,9 @@ result<void> runtime_module::initialize(gsl::span<const gsl::byte> payload, inte
         reader.read(desc);
 
     span_reader func_reader(read_functions(reader, header_.functions));
-    runtime_module_init_context_impl init_context(header_, interp, read_sections(reader, header_.sections));
+    auto sections = read_sections(reader, header_.sections);
+    try_(validate_sections(sections));
+    runtime_module_init_context_impl init_context(header_, interp, sections, section_buffers_);
     try_(initialize_before_functions(init_context));
 
     for (size_t i = 0; i < header_.functions; i++)
@@ -140,7 +194,9 @@ result<void> runtime_module::initialize(gsl::span<const gsl::byte> payload, inte
         functions_[i] = std::move(func);
     }
 
-    return initialize_after_functions(init_context);
+    try_(initialize_after_functions(init_context));
+    CHECK_WITH_ERR(!init_context.decompress_failed(), nncase_errc::invalid_model_section);
+    return ok();
 }
 
 result<runtime_function *> runtime_module::find_function_by_id(size_t index) noexcept
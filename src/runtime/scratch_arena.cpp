@@ -0,0 +1,64 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/scratch_arena.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+scratch_arena::scratch_arena() noexcept
+    : scratch_arena(default_host_allocator())
+{
+}
+
+scratch_arena::scratch_arena(host_allocator &allocator) noexcept
+    : allocator_(&allocator), capacity_(0)
+{
+    kernel_context_.num_threads = kernels::default_kernel_context().num_threads;
+    kernel_context_.memory = &workspace_;
+}
+
+void scratch_arena::reserve(size_t bytes) noexcept
+{
+    if (bytes > capacity_)
+    {
+        capacity_ = bytes;
+        // Interpreters only hold the buffer while they run, so the smaller one is freed now
+        data_ = {};
+    }
+}
+
+size_t scratch_arena::capacity() const noexcept
+{
+    return capacity_;
+}
+
+result<runtime_tensor> scratch_arena::acquire() noexcept
+{
+    if (data_.empty() && capacity_)
+        try_set(data_, hrt::create(dt_uint8, { capacity_ }, *allocator_, hrt::pool_shared));
+    return ok(data_);
+}
+
+kernels::kernel_context &scratch_arena::kernel_context() noexcept
+{
+    return kernel_context_;
+}
+
+void scratch_arena::trim() noexcept
+{
+    data_ = {};
+    workspace_.release();
+}
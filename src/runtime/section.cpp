@@ -13,40 +13,103 @@
  * limitations under the License.
  */
 #include "section.h"
+#include <nncase/runtime/dbg.h>
+#include <nncase/runtime/error.h>
 #include <nncase/runtime/span_reader.h>
+#ifdef NNCASE_LZ4
+#include <lz4.h>
+#endif
+#ifdef NNCASE_ZSTD
+#include <zstd.h>
+#endif
 
 using namespace nncase;
 using namespace nncase::runtime;
 
-gsl::span<const gsl::byte> runtime::find_section(const char *name, gsl::span<const gsl::byte> sections) noexcept
+const section_header *runtime::find_section_header(const char *name, gsl::span<const gsl::byte> sections) noexcept
 {
     span_reader reader(sections);
     while (!reader.empty())
     {
         auto header = reader.get_ref<section_header>();
         if (!strncmp(header->name, name, MAX_SECTION_NAME_LENGTH))
-        {
-            gsl::span<const gsl::byte> result;
-            if (header->flags & SECTION_MERGED_INTO_RDATA)
-            {
-                auto rdata_span = find_section(".rdata", sections);
-                result = rdata_span.subspan(header->body_start, header->body_size);
-            }
-            else
-            {
-                result = reader.read_avail().subspan(header->body_start, header->body_size);
-            }
+            return header;
+        if (!(header->flags & SECTION_MERGED_INTO_RDATA))
+            reader.skip((size_t)header->body_start + header->body_size);
+    }
+
+    return nullptr;
+}
+
+gsl::span<const gsl::byte> runtime::section_body(const section_header &header) noexcept
+{
+    return { reinterpret_cast<const gsl::byte *>(&header + 1) + header.body_start, header.body_size };
+}
+
+result<void> runtime::validate_sections(gsl::span<const gsl::byte> sections) noexcept
+{
+    span_reader reader(sections);
+    while (!reader.empty())
+    {
+        auto header = reader.get_ref<section_header>();
+        if (header->flags & SECTION_MERGED_INTO_RDATA)
+            continue;
 
-            return result;
+        auto compression = header->flags & SECTION_COMPRESSION_MASK;
+        if (compression == SECTION_COMPRESSED_LZ4)
+        {
+#ifdef NNCASE_LZ4
+            CHECK_WITH_ERR(header->uncompressed_size <= LZ4_MAX_INPUT_SIZE, nncase_errc::invalid_model_section);
+#else
+            return err(nncase_errc::invalid_model_section);
+#endif
+        }
+        else if (compression == SECTION_COMPRESSED_ZSTD)
+        {
+#ifdef NNCASE_ZSTD
+            auto body = section_body(*header);
+            CHECK_WITH_ERR(ZSTD_getFrameContentSize(body.data(), body.size()) == header->uncompressed_size, nncase_errc::invalid_model_section);
+#else
+            return err(nncase_errc::invalid_model_section);
+#endif
         }
         else
         {
-            if (!(header->flags & SECTION_MERGED_INTO_RDATA))
-                reader.skip((size_t)header->body_start + header->body_size);
+            CHECK_WITH_ERR(!compression, nncase_errc::invalid_model_section);
         }
+
+        reader.skip((size_t)header->body_start + header->body_size);
     }
 
-    return {};
+    return ok();
+}
+
+result<void> runtime::decompress_section(const section_header &header, gsl::span<gsl::byte> dest) noexcept
+{
+    CHECK_WITH_ERR(dest.size() == header.uncompressed_size, std::errc::invalid_argument);
+    switch (header.flags & SECTION_COMPRESSION_MASK)
+    {
+#ifdef NNCASE_LZ4
+    case SECTION_COMPRESSED_LZ4:
+    {
+        auto body = section_body(header);
+        auto size = LZ4_decompress_safe(reinterpret_cast<const char *>(body.data()), reinterpret_cast<char *>(dest.data()), (int)body.size(), (int)dest.size());
+        CHECK_WITH_ERR(size == (int)dest.size(), nncase_errc::invalid_model_section);
+        return ok();
+    }
+#endif
+#ifdef NNCASE_ZSTD
+    case SECTION_COMPRESSED_ZSTD:
+    {
+        auto body = section_body(header);
+        auto size = ZSTD_decompress(dest.data(), dest.size(), body.data(), body.size());
+        CHECK_WITH_ERR(!ZSTD_isError(size) && size == dest.size(), nncase_errc::invalid_model_section);
+        return ok();
+    }
+#endif
+    default:
+        return err(nncase_errc::invalid_model_section);
+    }
 }
 
 gsl::span<const gsl::byte> runtime::read_sections(span_reader &sr, size_t sections) noexcept
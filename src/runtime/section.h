@@ -19,7 +19,13 @@
 
 BEGIN_NS_NNCASE_RUNTIME
 
-gsl::span<const gsl::byte> find_section(const char *name, gsl::span<const gsl::byte> sections) noexcept;
 gsl::span<const gsl::byte> read_sections(span_reader &sr, size_t sections) noexcept;
 
+const section_header *find_section_header(const char *name, gsl::span<const gsl::byte> sections) noexcept;
+// The stored body, still compressed if the header says so
+gsl::span<const gsl::byte> section_body(const section_header &header) noexcept;
+// Fails on compressions this runtime is built without and on sizes a decompressor cannot produce
+result<void> validate_sections(gsl::span<const gsl::byte> sections) noexcept;
+result<void> decompress_section(const section_header &header, gsl::span<gsl::byte> dest) noexcept;
+
 END_NS_NNCASE_RUNTIME
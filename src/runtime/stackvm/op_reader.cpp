@@ -71,6 +71,13 @@ result<void> op_visitor::next() noexcept
 #endif
             return visit(op_reader<tensor_conv2d_op_t>()(reader_));
         }
+        case tensor_function_t::CONV2D_TRANSPOSE:
+        {
+#if defined ENABLE_OP_PROFILE
+            op_profile st("tensor_conv2d_transpose");
+#endif
+            return visit(op_reader<tensor_conv2d_transpose_op_t>()(reader_));
+        }
         case tensor_function_t::COPY:
         {
 #if defined ENABLE_OP_PROFILE
@@ -309,6 +316,27 @@ result<void> op_visitor::next() noexcept
 #endif
             return visit(op_reader<tensor_gather_elements_op_t>()(reader_));
         }
+        case tensor_function_t::LSTM:
+        {
+#if defined ENABLE_OP_PROFILE
+            op_profile st("tensor_lstm");
+#endif
+            return visit(op_reader<tensor_lstm_op_t>()(reader_));
+        }
+        case tensor_function_t::CONV2D_CHAIN:
+        {
+#if defined ENABLE_OP_PROFILE
+            op_profile st("tensor_conv2d_chain");
+#endif
+            return visit(op_reader<tensor_conv2d_chain_op_t>()(reader_));
+        }
+        case tensor_function_t::FUSED_ELEMENTWISE:
+        {
+#if defined ENABLE_OP_PROFILE
+            op_profile st("tensor_fused_elementwise");
+#endif
+            return visit(op_reader<tensor_fused_elementwise_op_t>()(reader_));
+        }
         default:
             break;
         }
@@ -335,6 +363,8 @@ result<void> op_visitor::next() noexcept
             return visit(op_reader<throw_op_t>()(reader_));
         case opcode_t::BREAK:
             return visit(op_reader<break_op_t>()(reader_));
+        case opcode_t::BR_UNUSED:
+            return visit(op_reader<br_unused_op_t>()(reader_));
         case opcode_t::LDC_I4:
             return visit(op_reader<ldc_i4_op_t>()(reader_));
         case opcode_t::LDNULL:
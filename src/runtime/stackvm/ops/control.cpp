@@ -76,3 +76,23 @@ result<void> stackvm_runtime_function::visit(NNCASE_UNUSED const break_op_t &op)
 {
     return err(std::errc::not_supported);
 }
+
+result<void> stackvm_runtime_function::visit(const br_unused_op_t &op) noexcept
+{
+    // masks are pushed from outputs 0-31 on, so the last one pops first
+    bool used = false;
+    for (size_t i = op.masks; i-- > 0;)
+    {
+        try_var(value, stack_.pop());
+        auto mask = value.as_u4();
+        for (size_t bit = 0; mask && !used; bit++, mask >>= 1)
+        {
+            auto index = i * 32 + bit;
+            used = (mask & 1) && index < outputs_size() && output_required(index);
+        }
+    }
+
+    if (!used)
+        return pc_relative(op.target);
+    return ok();
+}
@@ -36,7 +36,23 @@ result<void> stackvm_runtime_function::visit(const tensor_conv2d_op_t &op) noexc
 
     if (op.datatype != dt_float32)
         return err(nncase_errc::datatype_mismatch);
-    return kernels::conv2d(reinterpret_cast<const float *>(input), reinterpret_cast<const float *>(weights),
-        reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
-        padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+
+#define CONV2D_IMPL(w_type)                                                                                                                          \
+    return kernels::conv2d(reinterpret_cast<const float *>(input), reinterpret_cast<const w_type *>(weights),                                     \
+        reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides, \
+        padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context())
+
+    switch (op.w_datatype)
+    {
+    case dt_float32:
+        CONV2D_IMPL(float);
+    case dt_float16:
+        CONV2D_IMPL(half);
+    case dt_bfloat16:
+        CONV2D_IMPL(bfloat16);
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
+
+#undef CONV2D_IMPL
 }
@@ -0,0 +1,68 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <nncase/kernels/convolution.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_conv2d_chain_op_t &op) noexcept
+{
+    if (op.datatype != dt_float32)
+        return err(nncase_errc::datatype_mismatch);
+
+    // Stage i uses shape registers rstage_src + 2i (weights shape) and rstage_src + 2i + 1
+    // (groups, strides, dilations, reduce op), and paddings register rpad_src + i (padding_h, padding_w)
+    std::vector<kernels::conv2d_chain_stage> stages(op.stages);
+    for (size_t i = op.stages; i-- > 0;)
+    {
+        auto &stage = stages[i];
+        try_var(clamp_high, stack_.pop());
+        try_var(clamp_low, stack_.pop());
+        try_var(init_value, stack_.pop());
+        try_var(bias, pop_addr());
+        try_var(weights, pop_addr());
+        try_var(w_shape, module().shape_reg(op.rstage_src + i * 2));
+        try_var(params, module().shape_reg(op.rstage_src + i * 2 + 1));
+        try_var(paddings, module().paddings_reg(op.rpad_src + i));
+        if (params.size() != 6 || paddings.size() != 2)
+            return err(std::errc::invalid_argument);
+
+        auto args = as_runtime_axis(params);
+        stage.weights = reinterpret_cast<const float *>(weights);
+        stage.bias = reinterpret_cast<const float *>(bias);
+        stage.w_shape = w_shape;
+        stage.padding_h = paddings[0];
+        stage.padding_w = paddings[1];
+        stage.groups = args[0];
+        stage.stride_h = args[1];
+        stage.stride_w = args[2];
+        stage.dilation_h = args[3];
+        stage.dilation_w = args[4];
+        stage.reduce_op = (reduce_op_t)args[5];
+        stage.init_value = init_value.as_r4();
+        stage.fused_activation = { clamp_low.as_r4(), clamp_high.as_r4() };
+    }
+
+    try_var(output, pop_addr());
+    try_var(input, pop_addr());
+    try_var(in_shape, module().shape_reg(op.rshape_src));
+    try_var(in_strides, module().shape_reg(op.rstride_src));
+    try_var(out_strides, module().shape_reg(op.rstride_dest));
+
+    return kernels::conv2d_chain(reinterpret_cast<const float *>(input), reinterpret_cast<float *>(output), in_shape, in_strides, out_strides,
+        stages, op.tile_h, module().kernel_context());
+}
@@ -0,0 +1,43 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <nncase/kernels/nnil.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_fused_elementwise_op_t &op) noexcept
+{
+    if (op.datatype != dt_float32)
+        return err(nncase_errc::datatype_mismatch);
+
+    // Input i uses shape registers rshape_src + 2i (shape) and rshape_src + 2i + 1 (strides)
+    std::vector<const float *> inputs(op.inputs);
+    std::vector<runtime_shape_t> in_shapes(op.inputs), in_strides(op.inputs);
+    try_var(output, pop_addr());
+    for (size_t i = op.inputs; i-- > 0;)
+    {
+        try_var(input, pop_addr());
+        try_set(in_shapes[i], module().shape_reg(op.rshape_src + i * 2));
+        try_set(in_strides[i], module().shape_reg(op.rshape_src + i * 2 + 1));
+        inputs[i] = reinterpret_cast<const float *>(input);
+    }
+
+    try_var(out_shape, module().shape_reg(op.rshape_dest));
+    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    return kernels::nnil_elementwise(inputs, in_shapes, in_strides, reinterpret_cast<float *>(output), out_shape, out_strides,
+        op.body, module().kernel_context());
+}
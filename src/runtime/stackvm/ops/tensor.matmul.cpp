@@ -33,7 +33,21 @@ result<void> stackvm_runtime_function::visit(const tensor_matmul_op_t &op) noexc
     try_var(out_shape, module().shape_reg(op.rshape_dest));
     try_var(out_stride, module().shape_reg(op.rstride_dest));
 
-    return kernels::matmul(reinterpret_cast<const float *>(input_a), reinterpret_cast<const float *>(input_b),
-        reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape_a, in_stride_a,
-        in_shape_b, in_stride_b, out_shape, out_stride, { op.fused_clamp_low, op.fused_clamp_high });
+    switch (op.w_datatype)
+    {
+    case dt_float32:
+        return kernels::matmul(reinterpret_cast<const float *>(input_a), reinterpret_cast<const float *>(input_b),
+            reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape_a, in_stride_a,
+            in_shape_b, in_stride_b, out_shape, out_stride, { op.fused_clamp_low, op.fused_clamp_high });
+    case dt_float16:
+        return kernels::matmul(reinterpret_cast<const float *>(input_a), reinterpret_cast<const half *>(input_b),
+            reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape_a, in_stride_a,
+            in_shape_b, in_stride_b, out_shape, out_stride, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+    case dt_bfloat16:
+        return kernels::matmul(reinterpret_cast<const float *>(input_a), reinterpret_cast<const bfloat16 *>(input_b),
+            reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape_a, in_stride_a,
+            in_shape_b, in_stride_b, out_shape, out_stride, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
 }
@@ -15,6 +15,7 @@
 #include "runtime_function.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
 using namespace nncase;
@@ -34,12 +35,12 @@ result<void> stackvm_runtime_function::initialize_core(runtime_function_init_con
 
 result<runtime_tensor> stackvm_runtime_function::allocate_input_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(input_desc(index).datatype, input_shape(index));
+    return host_runtime_tensor::create(input_desc(index).datatype, input_shape(index), module().interp().allocator());
 }
 
 result<runtime_tensor> stackvm_runtime_function::allocate_output_tensor(size_t index) noexcept
 {
-    return host_runtime_tensor::create(output_desc(index).datatype, output_shape(index));
+    return host_runtime_tensor::create(output_desc(index).datatype, output_shape(index), module().interp().allocator());
 }
 
 result<void> stackvm_runtime_function::validate_input_tensor(NNCASE_UNUSED size_t index, runtime_tensor tensor) noexcept
@@ -59,7 +60,12 @@ result<void> stackvm_runtime_function::validate_output_tensor(NNCASE_UNUSED size
 result<void> stackvm_runtime_function::invoke_core() noexcept
 {
     call_depth_ = 0;
-    return visit(text_);
+    // A shared scratch arena is only held while running, calls within the module find it bound
+    try_var(bound, module().acquire_scratch());
+    auto result = visit(text_);
+    if (bound)
+        module().release_scratch();
+    return result;
 }
 
 uintptr_t stackvm_runtime_function::pc() const noexcept
@@ -69,7 +75,8 @@ uintptr_t stackvm_runtime_function::pc() const noexcept
 
 result<void> stackvm_runtime_function::pc(uintptr_t value) noexcept
 {
-    if (value >= text_.size_bytes())
+    // the end of text is a valid target, it finishes the function
+    if (value > text_.size_bytes())
         return err(nncase_errc::stackvm_illegal_target);
     reader_ = span_reader(text_.subspan(value));
     return ok();
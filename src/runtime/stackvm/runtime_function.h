@@ -46,6 +46,7 @@ protected:
     result<void> visit(const ecall_op_t &op) noexcept override;
     result<void> visit(const throw_op_t &op) noexcept override;
     result<void> visit(const break_op_t &op) noexcept override;
+    result<void> visit(const br_unused_op_t &op) noexcept override;
 
     result<void> visit(const ldc_i4_op_t &op) noexcept override;
     result<void> visit(const ldnull_op_t &op) noexcept override;
@@ -144,7 +145,10 @@ protected:
     result<void> visit(const tensor_compare_op_t &op) noexcept override;
     result<void> visit(const tensor_compress_op_t &op) noexcept override;
     result<void> visit(const tensor_conv2d_op_t &op) noexcept override;
+    result<void> visit(const tensor_conv2d_chain_op_t &op) noexcept override;
+    result<void> visit(const tensor_conv2d_transpose_op_t &op) noexcept override;
     result<void> visit(const tensor_convert_op_t &op) noexcept override;
+    result<void> visit(const tensor_fused_elementwise_op_t &op) noexcept override;
     result<void> visit(const tensor_copy_op_t &op) noexcept override;
     result<void> visit(const tensor_cumsum_op_t &op) noexcept override;
     result<void> visit(const tensor_dequantize_op_t &op) noexcept override;
@@ -154,6 +158,7 @@ protected:
     result<void> visit(const tensor_gather_nd_op_t &op) noexcept override;
     result<void> visit(const tensor_gru_op_t &op) noexcept override;
     result<void> visit(const tensor_lut1d_op_t &op) noexcept override;
+    result<void> visit(const tensor_lstm_op_t &op) noexcept override;
     result<void> visit(const tensor_matmul_op_t &op) noexcept override;
     result<void> visit(const tensor_onehot_op_t &op) noexcept override;
     result<void> visit(const tensor_pad_op_t &op) noexcept override;
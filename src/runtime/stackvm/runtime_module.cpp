@@ -16,6 +16,7 @@
 #include "runtime_function.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
 using namespace nncase;
@@ -47,15 +48,29 @@ result<void> stackvm_runtime_module::initialize_before_functions(runtime_module_
 {
     assert(context.is_section_pinned());
     auto data_pool = mempool(mem_data);
-    if (data_pool.size)
-    {
-        try_set(data_, hrt::create(dt_uint8, { data_pool.size }, hrt::pool_shared));
-    }
+    if (auto arena = interp().scratch())
+        arena->reserve(data_pool.size);
+    else if (data_pool.size)
+        try_set(data_, hrt::create(dt_uint8, { data_pool.size }, interp().allocator(), hrt::pool_shared));
 
     rdata_ = context.section(".rdata");
     return ok();
 }
 
+result<bool> stackvm_runtime_module::acquire_scratch() noexcept
+{
+    auto arena = interp().scratch();
+    if (!arena || !data_.empty() || !mempool(mem_data).size)
+        return ok(false);
+    try_set(data_, arena->acquire());
+    return ok(true);
+}
+
+void stackvm_runtime_module::release_scratch() noexcept
+{
+    data_ = {};
+}
+
 result<uintptr_t> stackvm_runtime_module::reg(size_t id) const noexcept
 {
     CHECK_WITH_ERR(id < regs_.size(), std::errc::result_out_of_range);
@@ -115,6 +130,8 @@ result<void> stackvm_runtime_module::paddings_reg(size_t id, runtime_paddings_t
 
 kernels::kernel_context &stackvm_runtime_module::kernel_context() noexcept
 {
+    if (auto arena = interp().scratch())
+        return arena->kernel_context();
     return kernels::default_kernel_context();
 }
 
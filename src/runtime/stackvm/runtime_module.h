@@ -31,6 +31,10 @@ public:
 
     const runtime_tensor &data_tensor() const noexcept;
 
+    // Binds the interpreter's scratch arena as mem_data for a run, true if this call bound it
+    result<bool> acquire_scratch() noexcept;
+    void release_scratch() noexcept;
+
     result<uintptr_t> reg(size_t id) const noexcept;
     result<void> reg(size_t id, uintptr_t value) noexcept;
 
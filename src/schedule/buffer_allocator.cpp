@@ -12,10 +12,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/visitor.h>
 #include <nncase/schedule/buffer_allocator.h>
 #include <nncase/schedule/freelist.h>
 #include <stdexcept>
+#include <string_view>
 
 using namespace nncase;
 using namespace nncase::schedule;
@@ -29,6 +35,16 @@ constexpr size_t align(size_t size, size_t alignment = 8)
         return size - remainder + alignment;
     return size;
 }
+
+const ir::constant *owner_constant(const physical_buffer &buffer) noexcept
+{
+    return ir::node_cast<ir::constant>(buffer.owner().owner().owner());
+}
+
+size_t hash_bytes(std::span<const std::byte> data) noexcept
+{
+    return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char *>(data.data()), data.size()));
+}
 }
 
 size_t buffer_allocator::get_size_in_bytes(const logical_buffer &buffer)
@@ -68,6 +84,37 @@ void linear_buffer_allocator::finish()
 {
 }
 
+void constant_buffer_allocator::mark(const physical_buffer &buffer)
+{
+    auto con = owner_constant(buffer);
+    if (!con)
+    {
+        linear_buffer_allocator::mark(buffer);
+        return;
+    }
+
+    auto data = con->data();
+    auto hash = hash_bytes(data);
+    auto range = constants_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        auto &alloc = it->second;
+        auto other = owner_constant(*alloc.buffer)->data();
+        if (alloc.start % buffer.alignment() == 0 && other.size() == data.size()
+            && std::memcmp(other.data(), data.data(), data.size()) == 0)
+        {
+            auto shared = alloc;
+            shared.buffer = &buffer;
+            allocations_.emplace(&buffer, shared);
+            deduplicated_bytes_ += shared.size;
+            return;
+        }
+    }
+
+    linear_buffer_allocator::mark(buffer);
+    constants_.emplace(hash, allocations_.at(&buffer));
+}
+
 first_fit_allocator::first_fit_allocator(std::optional<size_t> fixed_size)
     : list_(fixed_size)
 {
@@ -109,3 +156,45 @@ void first_fit_allocator::finish()
 {
     max_usage_ = list_.max_usage();
 }
+
+lifetime_aware_allocator::lifetime_aware_allocator(std::optional<size_t> fixed_size)
+    : fixed_size_(fixed_size)
+{
+    max_usage_ = 0;
+}
+
+void lifetime_aware_allocator::base_offset([[maybe_unused]] size_t value)
+{
+    throw std::runtime_error("Lifetime aware allocator doesn't support base offset");
+}
+
+void lifetime_aware_allocator::mark(const physical_buffer &buffer)
+{
+    buffers_.emplace_back(make_alloc(buffer));
+}
+
+void lifetime_aware_allocator::finish()
+{
+    std::vector<planned_buffer> first_fit, by_size;
+    first_fit.reserve(buffers_.size());
+    for (auto &alloc : buffers_)
+    {
+        auto &lifetime = alloc.buffer->lifetime();
+        first_fit.emplace_back(planned_buffer { alloc.size, lifetime.birth, lifetime.end() });
+    }
+    by_size = first_fit;
+
+    auto first_fit_usage = plan_first_fit(first_fit);
+    auto by_size_usage = placement_ == memory_placement::best ? plan_greedy_by_size(by_size) : std::numeric_limits<size_t>::max();
+    auto &best = by_size_usage < first_fit_usage ? by_size : first_fit;
+    max_usage_ = std::min(by_size_usage, first_fit_usage);
+    if (fixed_size_ && max_usage_ > *fixed_size_)
+        throw std::runtime_error("Allocator has ran out of memory");
+
+    for (size_t i = 0; i < buffers_.size(); i++)
+    {
+        auto alloc = buffers_[i];
+        alloc.start = best[i].start;
+        allocations_.emplace(alloc.buffer, alloc);
+    }
+}
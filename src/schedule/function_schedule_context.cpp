@@ -121,7 +121,7 @@ function_schedule_context::function_schedule_context(ir::graph &graph, module_sc
 
 void function_schedule_context::create_allocators()
 {
-    mod_sched_.model_sched().target().register_allocators(module_type(), allocators_, allocator_holder_);
+    mod_sched_.model_sched().register_allocators(module_type(), allocators_, allocator_holder_);
 
     // Input & output don't actually allocate inside the module, they are passed from the caller
     // They just need relative offset, so don't inherit previous allocators
@@ -230,6 +230,7 @@ void function_schedule_context::analyze_buffer_alias()
     pmgr.add_pass<alias_bitcast_buffer_pass>();
     pmgr.add_pass<alias_concat_buffer_pass>();
     pmgr.add_pass<alias_bitcast_buffer_pass>();
+    pmgr.add_pass<alias_inplace_buffer_pass>();
     pmgr.run();
 }
 
@@ -0,0 +1,97 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <limits>
+#include <nncase/schedule/memory_planner.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::schedule;
+
+namespace
+{
+// Start of the gap chosen for buffer among the already placed buffers that live at the same time
+size_t place(const planned_buffer &buffer, std::span<const planned_buffer *const> placed, bool best_fit)
+{
+    std::vector<const planned_buffer *> overlapped;
+    for (auto p : placed)
+    {
+        if (p->overlaps(buffer))
+            overlapped.emplace_back(p);
+    }
+    std::sort(overlapped.begin(), overlapped.end(), [](auto lhs, auto rhs) { return lhs->start < rhs->start; });
+
+    size_t offset = 0, best_start = 0, best_gap = std::numeric_limits<size_t>::max();
+    for (auto p : overlapped)
+    {
+        if (p->start >= offset)
+        {
+            auto gap = p->start - offset;
+            if (gap >= buffer.size && gap < best_gap)
+            {
+                best_start = offset;
+                best_gap = gap;
+                if (!best_fit)
+                    return best_start;
+            }
+        }
+        offset = std::max(offset, p->start + p->size);
+    }
+
+    return best_gap == std::numeric_limits<size_t>::max() ? offset : best_start;
+}
+
+size_t plan(std::vector<planned_buffer *> orders, bool best_fit)
+{
+    size_t peak = 0;
+    std::vector<const planned_buffer *> placed;
+    placed.reserve(orders.size());
+    for (auto b : orders)
+    {
+        b->start = place(*b, placed, best_fit);
+        peak = std::max(peak, b->start + b->size);
+        placed.emplace_back(b);
+    }
+
+    return peak;
+}
+
+std::vector<planned_buffer *> make_orders(std::span<planned_buffer> buffers)
+{
+    std::vector<planned_buffer *> orders;
+    orders.reserve(buffers.size());
+    for (auto &b : buffers)
+        orders.emplace_back(&b);
+    return orders;
+}
+}
+
+size_t schedule::plan_first_fit(std::span<planned_buffer> buffers)
+{
+    auto orders = make_orders(buffers);
+    std::stable_sort(orders.begin(), orders.end(), [](auto lhs, auto rhs) { return lhs->birth < rhs->birth; });
+    return plan(std::move(orders), false);
+}
+
+size_t schedule::plan_greedy_by_size(std::span<planned_buffer> buffers)
+{
+    auto orders = make_orders(buffers);
+    std::stable_sort(orders.begin(), orders.end(), [](auto lhs, auto rhs) {
+        if (lhs->size != rhs->size)
+            return lhs->size > rhs->size;
+        return lhs->end - lhs->birth > rhs->end - rhs->birth;
+    });
+    return plan(std::move(orders), true);
+}
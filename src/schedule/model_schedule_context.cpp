@@ -31,27 +31,53 @@ void model_schedule_context::config_dump(std::filesystem::path dump_dir)
     dump_dir_ = std::move(dump_dir);
 }
 
-void model_schedule_context::schedule(ir::graph &entry_function)
+void model_schedule_context::register_allocators(const module_type_t &type, allocator_map_t &allocators, std::vector<std::shared_ptr<buffer_allocator>> &allocator_holders)
 {
+    target_.register_allocators(type, allocators, allocator_holders);
+    for (auto &allocator : allocator_holders)
+    {
+        if (auto lifetime_aware = dynamic_cast<lifetime_aware_allocator *>(allocator.get()))
+            lifetime_aware->placement(placement_);
+    }
+}
+
+void model_schedule_context::schedule(ir::graph &entry_function, std::span<ir::graph *const> entry_variants)
+{
+    entry_function_ = &entry_function;
+    if (!entry_variants.empty())
+    {
+        entry_variants_.emplace_back(&entry_function);
+        entry_variants_.insert(entry_variants_.end(), entry_variants.begin(), entry_variants.end());
+    }
+
     // 1. Calculate modules count
-    auto reachable_graphs = entry_function.reachable_graphs();
     size_t modules_count;
     {
         std::unordered_set<module_type_t> modules;
-        for (auto subgraph : reachable_graphs)
+        for (auto subgraph : entry_function.reachable_graphs())
             modules.emplace(subgraph->module_type());
+        for (auto variant : entry_variants)
+        {
+            if (variant->module_type() != entry_function.module_type())
+                throw std::invalid_argument("Entry variant " + variant->name() + " is not in the entry module");
+            for (auto subgraph : variant->reachable_graphs())
+                modules.emplace(subgraph->module_type());
+        }
         modules_count = modules.size();
     }
 
     result_.modules.resize(modules_count);
-    entry_function_ = &entry_function;
 
-    // 2. Visit entry function
+    // 2. Visit entry functions
+    // Variants run one at a time, so they are visited one after another on the same timeline
+    // and their buffers can overlap in mem_data
     std::list<logical_buffer> dummy_buffers;
     std::unordered_map<const ir::output_connector *, logical_buffer *> dummy_buffer_map;
     lifetime_recorder dummy_lifetime(dummy_buffers, dummy_buffer_map);
     caller_context dummy_ctx { dummy_lifetime };
     visit_function(entry_function, dummy_ctx);
+    for (auto variant : entry_variants)
+        visit_function(*variant, dummy_ctx);
 
     // 3. Collect schedule results
     end_schedule();
@@ -79,4 +105,6 @@ void model_schedule_context::end_schedule()
     for (auto &module_p : module_contexts_)
         module_p.second.end_schedule();
     result_.entry_function = entry_module_->module_result().functions_map.at(entry_function_);
+    for (auto variant : entry_variants_)
+        result_.entry_variants.emplace_back(entry_module_->module_result().functions_map.at(variant));
 }
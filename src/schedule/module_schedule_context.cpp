@@ -25,7 +25,7 @@ module_schedule_context::module_schedule_context(module_schedule_result &result,
     : result_(result), model_sched_(model_sched), type_(type)
 {
     result_.type = type;
-    model_sched.target().register_allocators(type_, allocators_, allocator_holder_);
+    model_sched.register_allocators(type_, allocators_, allocator_holder_);
 }
 
 buffer_allocator &module_schedule_context::shared_allocator(const module_type_t &type)
@@ -47,7 +47,11 @@ void module_schedule_context::end_schedule()
 
         if (allocator.first != mem_input
             && allocator.first != mem_output)
+        {
             module_result().max_usages.emplace(allocator.first, allocator.second->max_usage());
+            if (allocator.second->deduplicated_bytes())
+                module_result().deduplicated_bytes.emplace(allocator.first, allocator.second->deduplicated_bytes());
+        }
     }
 
     result_.functions.resize(functions_.size());
@@ -30,7 +30,8 @@ model_schedule_result scheduler::schedule(bool skip_buffer_alias)
     model_schedule_result result {};
     model_schedule_context context(result, target_, skip_buffer_alias);
     context.config_dump(dump_dir_);
-    context.schedule(main_graph_);
+    context.config_placement(placement_);
+    context.schedule(main_graph_, entry_variants_);
     return result;
 }
 
@@ -38,3 +39,13 @@ void scheduler::config_dump(std::filesystem::path dump_dir)
 {
     dump_dir_ = std::move(dump_dir);
 }
+
+void scheduler::config_placement(memory_placement placement)
+{
+    placement_ = placement;
+}
+
+void scheduler::entry_variants(std::vector<ir::graph *> graphs)
+{
+    entry_variants_ = std::move(graphs);
+}
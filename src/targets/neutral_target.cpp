@@ -70,7 +70,7 @@ void neutral_target::register_allocators(const module_type_t &type, allocator_ma
     {
         allocators.emplace(mem_input, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
         allocators.emplace(mem_output, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
-        allocators.emplace(mem_rdata, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
+        allocators.emplace(mem_rdata, allocator_holders.emplace_back(std::make_shared<constant_buffer_allocator>()).get());
         allocators.emplace(mem_data, allocator_holders.emplace_back(std::make_shared<first_fit_allocator>()).get());
     }
     else
@@ -0,0 +1,201 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_chain.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/fuse_conv2d_chain.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+// Halo rows recomputed by neighbouring bands may cost at most this much extra work per intermediate
+constexpr float max_recompute_ratio = 1.25f;
+
+bool is_fusable_input(input_connector &input)
+{
+    return input.type() == dt_float32 && input.shape().size() == 4;
+}
+
+conv2d_chain::stage to_stage(conv2d &conv)
+{
+    return { true, conv.weights().shape(), conv.groups(), conv.padding_h(), conv.padding_w(), conv.stride_h(), conv.stride_w(),
+        conv.dilation_h(), conv.dilation_w(), reduce_sum, 0.f, conv.fused_activation() };
+}
+
+conv2d_chain::stage to_stage(reduce_window2d &rw)
+{
+    auto channels = rw.input().shape()[1];
+    return { false, shape_t { channels, 1, (size_t)rw.filter_h(), (size_t)rw.filter_w() }, (int32_t)channels, rw.padding_h(), rw.padding_w(),
+        rw.stride_h(), rw.stride_w(), rw.dilation_h(), rw.dilation_w(), rw.reduce_op(), rw.init_value(), rw.fused_activation() };
+}
+
+// Returns the largest band height whose intermediates fit in cache_size, or 0 when fusing doesn't pay off
+int32_t choose_tile_h(const shape_t &input_shape, const std::vector<conv2d_chain::stage> &stages, size_t cache_size)
+{
+    auto shapes = conv2d_chain::stage_shapes(input_shape, stages);
+    auto out_h = shapes.back()[2];
+    for (size_t tile_h = out_h; tile_h > 0; tile_h--)
+    {
+        // rows of the output of stage s computed for one band
+        size_t rows = tile_h, scratch = 0;
+        bool recompute_ok = true;
+        auto bands = (out_h + tile_h - 1) / tile_h;
+        for (size_t s = stages.size() - 1; s > 0; s--)
+        {
+            auto &stage = stages[s];
+            auto filter = (size_t)((stage.weights_shape[2] - 1) * stage.dilation_h + 1);
+            auto &shape = shapes[s - 1];
+            rows = std::min(shape[2], (rows - 1) * stage.stride_h + filter);
+            scratch += shape[0] * shape[1] * rows * shape[3] * sizeof(float);
+            recompute_ok &= (float)(bands * rows) <= shape[2] * max_recompute_ratio;
+        }
+
+        if (scratch <= cache_size)
+            return recompute_ok ? (int32_t)tile_h : 0;
+    }
+
+    return 0;
+}
+}
+
+bool fuse_conv2d_chain_transform::on_try_match(node &node, transform_context &context)
+{
+    conv2d *first_conv = nullptr;
+    conv2d_chain *first_chain = nullptr;
+    conv2d *second_conv = nullptr;
+    reduce_window2d *second_rw = nullptr;
+
+    input_connector *second_input;
+    if ((second_conv = node_cast<conv2d>(node)))
+    {
+        second_input = &second_conv->input();
+    }
+    else if ((second_rw = node_cast<reduce_window2d>(node)))
+    {
+        second_input = &second_rw->input();
+    }
+    else
+    {
+        return false;
+    }
+
+    if (!is_fusable_input(*second_input))
+        return false;
+
+    // Another consumer of the intermediate would keep the first producer alive, and the chain would compute it again
+    if (second_input->connection()->connections().size() != 1)
+        return false;
+
+    std::vector<conv2d_chain::stage> stages;
+    auto &first = second_input->connection()->owner();
+    if ((first_conv = node_cast<conv2d>(first)) && is_fusable_input(first_conv->input()))
+        stages.emplace_back(to_stage(*first_conv));
+    else if ((first_chain = node_cast<conv2d_chain>(first)) && first_chain->stages().size() < max_stages_)
+        stages = first_chain->stages();
+    else
+        return false;
+
+    auto &first_input = first_conv ? first_conv->input() : first_chain->input();
+    if (second_conv)
+    {
+        stages.emplace_back(to_stage(*second_conv));
+    }
+    else
+    {
+        // ceil_mode and strict_inside_input give a shape the reduce_window2d kernel doesn't produce
+        stages.emplace_back(to_stage(*second_rw));
+        if (conv2d_chain::stage_shapes(second_input->shape(), { stages.back() }).back() != second_rw->output().shape())
+            return false;
+    }
+
+    // Only worth it when the intermediate spills out of cache
+    if (xt::compute_size(second_input->shape()) * sizeof(float) <= cache_size_
+        || !choose_tile_h(first_input.shape(), stages, cache_size_))
+        return false;
+
+    context.inputs.emplace_back(&first_input);
+    if (first_conv)
+    {
+        context.inputs.emplace_back(&first_conv->weights());
+        context.inputs.emplace_back(&first_conv->bias());
+    }
+    else
+    {
+        for (size_t i = 0; i < first_chain->stages().size(); i++)
+        {
+            if (first_chain->stages()[i].is_conv2d)
+            {
+                context.inputs.emplace_back(&first_chain->weights(i));
+                context.inputs.emplace_back(&first_chain->bias(i));
+            }
+        }
+    }
+
+    if (second_conv)
+    {
+        context.inputs.emplace_back(&second_conv->weights());
+        context.inputs.emplace_back(&second_conv->bias());
+        context.outputs.emplace_back(&second_conv->output());
+    }
+    else
+    {
+        context.outputs.emplace_back(&second_rw->output());
+    }
+
+    context.matched_nodes.emplace_back(&first);
+    context.matched_nodes.emplace_back(&node);
+    return true;
+}
+
+void fuse_conv2d_chain_transform::process(transform_context &context)
+{
+    auto &first = *context.matched_nodes[0];
+    auto &second = *context.matched_nodes[1];
+
+    std::vector<conv2d_chain::stage> stages;
+    if (auto first_conv = node_cast<conv2d>(first))
+        stages.emplace_back(to_stage(*first_conv));
+    else
+        stages = node_cast<conv2d_chain>(first)->stages();
+
+    if (auto second_conv = node_cast<conv2d>(second))
+        stages.emplace_back(to_stage(*second_conv));
+    else
+        stages.emplace_back(to_stage(*node_cast<reduce_window2d>(second)));
+
+    auto &input_shape = context.inputs[0]->shape();
+    auto tile_h = choose_tile_h(input_shape, stages, cache_size_);
+    auto chain = context.graph.emplace<conv2d_chain>(input_shape, stages, tile_h);
+    chain->name(first.name() + "_" + second.name());
+
+    // inputs are the chain input followed by the weights and bias of every conv2d stage, in order
+    chain->input().connect(*context.inputs[0]->connection());
+    for (size_t i = 0, in_id = 1; i < stages.size(); i++)
+    {
+        if (stages[i].is_conv2d)
+        {
+            chain->weights(i).connect(*context.inputs[in_id++]->connection());
+            chain->bias(i).connect(*context.inputs[in_id++]->connection());
+        }
+    }
+
+    auto inputs = context.outputs[0]->connections();
+    for (auto &in : dup(inputs))
+        in->connect(chain->output());
+}
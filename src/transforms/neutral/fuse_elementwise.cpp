@@ -0,0 +1,252 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/clamp.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/fused_elementwise.h>
+#include <nncase/ir/ops/fused_unary.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/fuse_elementwise.h>
+#include <optional>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+// Evaluation stack entries of the nnil kernels
+constexpr size_t max_stack_depth = 64;
+
+// A node as a subgraph whose ldx(i) loads its input i
+struct elementwise_desc
+{
+    std::vector<input_connector *> inputs;
+    std::vector<fused_unary_op> subgraph;
+};
+
+struct fused_desc
+{
+    std::vector<output_connector *> inputs;
+    std::vector<fused_unary_op> subgraph;
+};
+
+bool is_fusable_unary(unary_op_t op)
+{
+    // nnil rounds half away from zero and has no integer ops
+    return op != unary_round && op != unary_bitwise_not && op != unary_logical_not;
+}
+
+bool is_fusable_binary(binary_op_t op)
+{
+    switch (op)
+    {
+    case binary_add:
+    case binary_sub:
+    case binary_mul:
+    case binary_div:
+    case binary_min:
+    case binary_max:
+    case binary_pow:
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::optional<elementwise_desc> describe(node &node)
+{
+    for (auto in : node.inputs())
+    {
+        if (in->type() != dt_float32)
+            return std::nullopt;
+    }
+
+    if (node.outputs().size() != 1 || node.output_at(0).type() != dt_float32)
+        return std::nullopt;
+
+    elementwise_desc desc;
+    for (auto in : node.inputs())
+        desc.inputs.emplace_back(in);
+
+    if (auto b = node_cast<binary>(node))
+    {
+        if (!is_fusable_binary(b->binary_op()))
+            return std::nullopt;
+        desc.subgraph = { fused_unary_op::make_ldx(0), fused_unary_op::make_ldx(1), fused_unary_op::make_binary(b->binary_op(), { 0 }, { 1 }) };
+        if (b->fused_activation() != value_range<float>::full())
+        {
+            desc.subgraph.emplace_back(fused_unary_op::make_constant(b->fused_activation().min));
+            desc.subgraph.emplace_back(fused_unary_op::make_constant(b->fused_activation().max));
+            desc.subgraph.emplace_back(fused_unary_op::make_clamp({ 2 }, { 3 }, { 4 }));
+        }
+    }
+    else if (auto u = node_cast<unary>(node))
+    {
+        if (!is_fusable_unary(u->unary_op()))
+            return std::nullopt;
+        desc.subgraph = { fused_unary_op::make_ldx(0), fused_unary_op::make_unary(u->unary_op(), { 0 }) };
+    }
+    else if (node_cast<clamp>(node))
+    {
+        desc.subgraph = { fused_unary_op::make_ldx(0), fused_unary_op::make_ldx(1), fused_unary_op::make_ldx(2), fused_unary_op::make_clamp({ 0 }, { 1 }, { 2 }) };
+    }
+    else if (auto fu = node_cast<fused_unary>(node))
+    {
+        desc.subgraph = fu->subgraph();
+    }
+    else if (auto fe = node_cast<fused_elementwise>(node))
+    {
+        desc.subgraph = fe->subgraph();
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    return desc;
+}
+
+fused_unary_arg shift(fused_unary_arg arg, size_t offset)
+{
+    return { arg.op_id + offset };
+}
+
+// Appends subgraph to dest, ldx ops are replaced by load(input)
+template <class TLoad>
+size_t append(std::vector<fused_unary_op> &dest, const std::vector<fused_unary_op> &subgraph, TLoad &&load)
+{
+    const auto offset = dest.size();
+    for (auto op : subgraph)
+    {
+        switch (op.opcode)
+        {
+        case fu_constant:
+            break;
+        case fu_ldx:
+            op = load(op.ldx.input);
+            break;
+        case fu_identity:
+            op.identity.input = shift(op.identity.input, offset);
+            break;
+        case fu_unary:
+            op.unary.input = shift(op.unary.input, offset);
+            break;
+        case fu_binary:
+            op.binary.input_a = shift(op.binary.input_a, offset);
+            op.binary.input_b = shift(op.binary.input_b, offset);
+            break;
+        case fu_clamp:
+            op.clamp.input = shift(op.clamp.input, offset);
+            op.clamp.low = shift(op.clamp.low, offset);
+            op.clamp.high = shift(op.clamp.high, offset);
+            break;
+        default:
+            throw std::invalid_argument("Invalid fused unary op");
+        }
+
+        dest.emplace_back(op);
+    }
+
+    return dest.size() - 1;
+}
+
+// Inlines producer into consumer, inputs connected to the same output are loaded once, scalar constants are inlined
+fused_desc fuse(node &producer, node &consumer)
+{
+    auto p = describe(producer).value();
+    auto c = describe(consumer).value();
+
+    fused_desc fused;
+    auto load = [&](input_connector *in) {
+        auto &conn = *in->connection();
+        if (auto con = node_cast<constant>(conn.owner()); con && xt::compute_size(conn.shape()) == 1)
+            return fused_unary_op::make_constant(*reinterpret_cast<const float *>(con->data().data()));
+
+        auto index = (size_t)(std::find(fused.inputs.begin(), fused.inputs.end(), &conn) - fused.inputs.begin());
+        if (index == fused.inputs.size())
+            fused.inputs.emplace_back(&conn);
+        return fused_unary_op::make_ldx(index);
+    };
+
+    auto p_root = append(fused.subgraph, p.subgraph, [&](size_t input) { return load(p.inputs.at(input)); });
+    append(fused.subgraph, c.subgraph, [&](size_t input) {
+        auto in = c.inputs.at(input);
+        return in->connection() == &producer.output_at(0) ? fused_unary_op::make_identity({ p_root }) : load(in);
+    });
+    return fused;
+}
+}
+
+bool fuse_elementwise_transform::on_try_match(node &node, transform_context &context)
+{
+    if (!describe(node))
+        return false;
+
+    auto &output = node.output_at(0);
+    for (auto in : node.inputs())
+    {
+        auto &producer = in->connection()->owner();
+        if (!describe(producer) || producer.output_at(0).shape() != output.shape())
+            continue;
+
+        // The producer must only feed this node
+        auto &p_output = producer.output_at(0);
+        if (std::any_of(p_output.connections().begin(), p_output.connections().end(), [&](input_connector *conn) { return &conn->owner() != &node; }))
+            continue;
+
+        auto fused = fuse(producer, node);
+        auto [instructions, depth] = fused_elementwise::program_size(fused.subgraph);
+        if (fused.inputs.size() > max_inputs_ || instructions > max_instructions_ || depth >= max_stack_depth)
+            continue;
+
+        for (auto n : { &producer, &node })
+        {
+            for (auto n_in : n->inputs())
+            {
+                if (n_in->connection() != &p_output)
+                    context.inputs.emplace_back(n_in);
+            }
+        }
+
+        context.outputs.emplace_back(&output);
+        context.matched_nodes.emplace_back(&producer);
+        context.matched_nodes.emplace_back(&node);
+        return true;
+    }
+
+    return false;
+}
+
+void fuse_elementwise_transform::process(transform_context &context)
+{
+    auto &producer = *context.matched_nodes[0];
+    auto &consumer = *context.matched_nodes[1];
+    auto fused = fuse(producer, consumer);
+
+    std::vector<shape_t> input_shapes;
+    for (auto in : fused.inputs)
+        input_shapes.emplace_back(in->shape());
+
+    auto fe = context.graph.emplace<fused_elementwise>(std::move(fused.subgraph), input_shapes, context.outputs[0]->shape());
+    fe->name(producer.name() + "_" + consumer.name());
+    for (size_t i = 0; i < fused.inputs.size(); i++)
+        fe->input_at(i).connect(*fused.inputs[i]);
+
+    auto inputs = context.outputs[0]->connections();
+    for (auto &in : dup(inputs))
+        in->connect(fe->output());
+}
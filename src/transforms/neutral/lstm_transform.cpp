@@ -89,6 +89,10 @@ bool lstm_transform::on_try_match(node &node, transform_context &context)
     constant *w, *r, *b, *init_h, *init_c;
     if (auto old_lstm = node_cast<lstm>(node))
     {
+        // the unrolled graph runs every batch over the whole sequence
+        if (!old_lstm->sequence_lens().empty())
+            return false;
+
         if ((w = try_get_direct_parent<constant>(*old_lstm, 1))
             && (r = try_get_direct_parent<constant>(*old_lstm, 2))
             && (b = try_get_direct_parent<constant>(*old_lstm, 3)))
@@ -0,0 +1,259 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/clamp.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_nhwc.h>
+#include <nncase/ir/ops/pad.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/ops/reduce_window2d_nhwc.h>
+#include <nncase/ir/ops/resize_image.h>
+#include <nncase/ir/ops/resize_image_nhwc.h>
+#include <nncase/ir/ops/sigmoid.h>
+#include <nncase/ir/ops/transpose.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/nhwc_layout.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+// How many ops below a general conv2d we look for the transpose that would cancel
+constexpr size_t max_lookahead = 8;
+
+const axis_t nhwc_to_nchw_perm { 0, 3, 1, 2 };
+const axis_t nchw_to_nhwc_perm { 0, 2, 3, 1 };
+
+transpose *try_get_nhwc_to_nchw(input_connector &input)
+{
+    auto tp = node_cast<transpose>(input.connection()->owner());
+    return tp && tp->perm() == nhwc_to_nchw_perm ? tp : nullptr;
+}
+
+// Ops a transpose {0, 3, 1, 2} can be moved through, either by the transpose motions or by switching to NHWC
+bool is_layout_agnostic(node &node)
+{
+    switch (node.runtime_opcode())
+    {
+    case op_binary:
+    case op_clamp:
+    case op_concat:
+    case op_conv2d:
+    case op_pad:
+    case op_reduce_window2d:
+    case op_resize_image:
+    case op_sigmoid:
+    case op_unary:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Whether every path from output reaches a transpose back to NHWC through layout agnostic ops,
+// i.e. the transpose moved below a node will cancel instead of landing in the middle of the graph
+bool reaches_nhwc_exit(output_connector &output, size_t depth)
+{
+    if (output.connections().empty())
+        return false;
+
+    for (auto in : output.connections())
+    {
+        auto &owner = in->owner();
+        if (auto tp = node_cast<transpose>(owner); tp && tp->perm() == nchw_to_nhwc_perm)
+            continue;
+        if (!depth || !is_layout_agnostic(owner))
+            return false;
+        for (auto out : owner.outputs())
+        {
+            if (!reaches_nhwc_exit(*out, depth - 1))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// The NHWC kernel always wins for depthwise and pointwise convs, other convs only switch when it removes transposes
+bool prefers_nhwc(conv2d &conv)
+{
+    return conv.is_depthwise() || (conv.filter_h() == 1 && conv.filter_w() == 1) || reaches_nhwc_exit(conv.output(), max_lookahead);
+}
+
+void reconnect_through_transpose(transform_context &context, transpose &old_tp, output_connector &nhwc_output)
+{
+    auto inputs = context.outputs[0]->connections();
+    auto tp = context.graph.emplace<transpose>(nhwc_output.type(), nhwc_output.shape(), old_tp.perm());
+    tp->name(old_tp.name());
+    tp->input().connect(nhwc_output);
+
+    for (auto &in : dup(inputs))
+        in->connect(tp->output());
+}
+}
+
+bool transpose_conv2d_nhwc_motion_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto conv = node_cast<conv2d>(node))
+    {
+        auto tp = try_get_nhwc_to_nchw(conv->input());
+        if (tp && prefers_nhwc(*conv))
+        {
+            context.inputs.emplace_back(&tp->input());
+            context.inputs.emplace_back(&conv->weights());
+            context.inputs.emplace_back(&conv->bias());
+            context.outputs.emplace_back(&conv->output());
+
+            context.matched_nodes.emplace_back(tp);
+            context.matched_nodes.emplace_back(conv);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void transpose_conv2d_nhwc_motion_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &weights = *context.inputs[1]->connection();
+    auto &bias = *context.inputs[2]->connection();
+    auto &old_tp = static_cast<transpose &>(*context.matched_nodes[0]);
+    auto &old_conv = static_cast<conv2d &>(*context.matched_nodes[1]);
+
+    // OIHW -> HWIO, folded away for constant weights
+    auto w_tp = context.graph.emplace<transpose>(weights.type(), weights.shape(), axis_t { 2, 3, 1, 0 });
+    w_tp->name(old_conv.name() + "_hwio");
+    w_tp->input().connect(weights);
+
+    auto conv = context.graph.emplace<conv2d_nhwc>(output.shape(), w_tp->output().shape(), old_conv.groups(), old_conv.padding_h(), old_conv.padding_w(),
+        old_conv.stride_h(), old_conv.stride_w(), old_conv.dilation_h(), old_conv.dilation_w(), old_conv.fused_activation());
+    conv->name(old_conv.name());
+    conv->input().connect(output);
+    conv->weights().connect(w_tp->output());
+    conv->bias().connect(bias);
+
+    reconnect_through_transpose(context, old_tp, conv->output());
+}
+
+bool transpose_reduce_window2d_nhwc_motion_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto rw = node_cast<reduce_window2d>(node))
+    {
+        // ceil_mode and strict_inside_input give a shape the reduce_window2d kernel doesn't produce
+        auto &in_shape = rw->input().shape();
+        auto &out_shape = rw->output().shape();
+        auto tp = try_get_nhwc_to_nchw(rw->input());
+        if (tp
+            && out_shape[2] == get_windowed_output_size((int32_t)in_shape[2] + rw->padding_h().sum(), rw->filter_h(), rw->stride_h(), rw->dilation_h(), false)
+            && out_shape[3] == get_windowed_output_size((int32_t)in_shape[3] + rw->padding_w().sum(), rw->filter_w(), rw->stride_w(), rw->dilation_w(), false))
+        {
+            context.inputs.emplace_back(&tp->input());
+            context.outputs.emplace_back(&rw->output());
+
+            context.matched_nodes.emplace_back(tp);
+            context.matched_nodes.emplace_back(rw);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void transpose_reduce_window2d_nhwc_motion_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &old_tp = static_cast<transpose &>(*context.matched_nodes[0]);
+    auto &old_rw = static_cast<reduce_window2d &>(*context.matched_nodes[1]);
+
+    auto rw = context.graph.emplace<reduce_window2d_nhwc>(old_rw.reduce_op(), output.shape(), old_rw.init_value(), old_rw.filter_h(), old_rw.filter_w(),
+        old_rw.padding_h(), old_rw.padding_w(), old_rw.stride_h(), old_rw.stride_w(), old_rw.dilation_h(), old_rw.dilation_w(), old_rw.fused_activation());
+    rw->name(old_rw.name());
+    rw->input().connect(output);
+
+    reconnect_through_transpose(context, old_tp, rw->output());
+}
+
+bool transpose_resize_image_nhwc_motion_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto r = node_cast<resize_image>(node))
+    {
+        if (auto tp = try_get_nhwc_to_nchw(r->input()))
+        {
+            context.inputs.emplace_back(&tp->input());
+            context.outputs.emplace_back(&r->output());
+
+            context.matched_nodes.emplace_back(tp);
+            context.matched_nodes.emplace_back(r);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void transpose_resize_image_nhwc_motion_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &old_tp = static_cast<transpose &>(*context.matched_nodes[0]);
+    auto &old_r = static_cast<resize_image &>(*context.matched_nodes[1]);
+
+    auto r = context.graph.emplace<resize_image_nhwc>(output.type(), old_r.mode(), output.shape(), old_r.new_size(), old_r.align_corners(), old_r.half_pixel_centers());
+    r->name(old_r.name());
+    r->input().connect(output);
+
+    reconnect_through_transpose(context, old_tp, r->output());
+}
+
+// Unlike transpose_pad_motion, which lifts a transpose above pad, this one pushes it down
+bool transpose_pad_nhwc_motion_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto p = node_cast<pad>(node))
+    {
+        if (auto tp = try_get_nhwc_to_nchw(p->input()))
+        {
+            context.inputs.emplace_back(&tp->input());
+            context.outputs.emplace_back(&p->output());
+
+            context.matched_nodes.emplace_back(tp);
+            context.matched_nodes.emplace_back(p);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void transpose_pad_nhwc_motion_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &old_tp = static_cast<transpose &>(*context.matched_nodes[0]);
+    auto &old_p = static_cast<pad &>(*context.matched_nodes[1]);
+
+    xt::svector<padding> paddings(old_p.paddings().size(), padding::zero());
+    for (size_t i = 0; i < paddings.size(); i++)
+        paddings[old_tp.perm()[i]] = old_p.paddings()[i];
+
+    auto p = context.graph.emplace<pad>(output.type(), output.shape(), std::move(paddings), old_p.pad_mode(), old_p.pad_value());
+    p->name(old_p.name());
+    p->input().connect(output);
+
+    reconnect_through_transpose(context, old_tp, p->output());
+}
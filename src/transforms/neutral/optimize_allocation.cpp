@@ -18,14 +18,32 @@
 #include <nncase/ir/ops/copy.h>
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/visitor.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
 #include <nncase/schedule/scheduler.h>
 #include <nncase/transforms/neutral/optimize_allocation.h>
+#include <unordered_set>
 
 using namespace nncase;
 using namespace nncase::ir;
 using namespace nncase::ir::transforms;
 using namespace nncase::schedule;
 
+namespace
+{
+// Inputs of node that may share the output buffer: the stackvm kernels of these ops read every element
+// before writing the element at the same offset, so they are safe in place
+std::vector<input_connector *> inplace_candidates(node &node)
+{
+    auto &opcode = node.runtime_opcode();
+    if (opcode == op_binary || opcode == op_fused_elementwise)
+        return { node.inputs().begin(), node.inputs().end() };
+    else if (opcode == op_unary || opcode == op_sigmoid || opcode == op_convert || opcode == op_quantize
+        || opcode == op_dequantize || opcode == op_table_lookup1d)
+        return { &node.input_at(0) };
+    return {};
+}
+}
+
 void make_concat_no_action_pass::run_core(graph &graph, [[maybe_unused]] nncase::target &target, [[maybe_unused]] const run_pass_options &options)
 {
     auto alias_visitor = make_relay_ir_visitor([&](node &node) {
@@ -443,3 +461,44 @@ void alias_slice_buffer_pass::run_core(graph &graph, [[maybe_unused]] nncase::ta
     });
     alias_visitor.visit(graph);
 }
+
+void alias_inplace_buffer_pass::run_core(graph &graph, [[maybe_unused]] nncase::target &target, const run_pass_options &options)
+{
+    auto &context = *options.schedule_context;
+    if (context.module_type() != runtime::stackvm::stackvm_module_type)
+        return;
+
+    // Buffers aliased by this pass, their parents die where they are born
+    std::unordered_set<logical_buffer *> inplace_buffers;
+    auto alias_visitor = make_relay_ir_visitor([&](node &node) {
+        if (!(node.attributes() & node_attr_action) || node.outputs().size() != 1)
+            return;
+
+        auto &output = node.output_at(0);
+        auto &out_buf = *context.logical_buffer_map().at(&output);
+        if (out_buf.memory_location() != mem_data || out_buf.parent() || out_buf.strides_parent()
+            || (output.attributes() & cnctr_attr_no_buffer_fusion))
+            return;
+
+        for (auto in : inplace_candidates(node))
+        {
+            auto &input = *in->connection();
+            auto &in_buf = *context.logical_buffer_map().at(&input);
+            if (in_buf.memory_location() != mem_data || in_buf.strides_parent()
+                || (in_buf.parent() && !inplace_buffers.contains(&in_buf))
+                || (input.attributes() & cnctr_attr_no_buffer_fusion)
+                || input.shape() != output.shape() || ir::get_bytes(input.type()) != ir::get_bytes(output.type()))
+                continue;
+
+            // The input must die here
+            auto conns = input.connections();
+            if (std::any_of(conns.begin(), conns.end(), [&](input_connector *conn) { return &conn->owner() != &node; }))
+                continue;
+
+            out_buf.parent() = { &in_buf, 0, output.shape() };
+            inplace_buffers.emplace(&out_buf);
+            break;
+        }
+    });
+    alias_visitor.visit(graph);
+}
@@ -0,0 +1,92 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_nhwc.h>
+#include <nncase/ir/ops/convert.h>
+#include <nncase/ir/ops/matmul.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/weights_storage.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+// weights input of the nodes whose kernels accept half and bfloat16 weights
+input_connector *get_weights(node &node)
+{
+    if (auto conv = node_cast<conv2d>(node))
+        return &conv->weights();
+    if (auto nhwc_conv = node_cast<conv2d_nhwc>(node))
+        return &nhwc_conv->weights();
+    if (auto mm = node_cast<matmul>(node))
+        return &mm->input_b();
+    return nullptr;
+}
+}
+
+bool convert_weights_storage_transform::on_try_match(node &node, transform_context &context)
+{
+    auto weights = get_weights(node);
+    if (weights && weights->type() == dt_float32 && node.input_at(0).type() == dt_float32 && node_cast<constant>(weights->connection()->owner()))
+    {
+        for (auto in : node.inputs())
+            context.inputs.emplace_back(in);
+        context.outputs.emplace_back(&node.output_at(0));
+        context.matched_nodes.emplace_back(&node);
+        return true;
+    }
+
+    return false;
+}
+
+void convert_weights_storage_transform::process(transform_context &context)
+{
+    auto &old = *context.matched_nodes[0];
+    auto &weights = *context.inputs[1]->connection();
+
+    // folded into a constant of storage_type_ by fold_constant
+    auto cvt = context.graph.emplace<convert>(weights.type(), weights.shape(), storage_type_);
+    cvt->name(weights.owner().name() + "_storage");
+    cvt->input().connect(weights);
+
+    ir::node *new_node;
+    if (auto conv = node_cast<conv2d>(old))
+    {
+        new_node = context.graph.emplace<conv2d>(conv->input().shape(), weights.shape(), conv->groups(), conv->padding_h(), conv->padding_w(),
+            conv->stride_h(), conv->stride_w(), conv->dilation_h(), conv->dilation_w(), conv->fused_activation(), storage_type_);
+    }
+    else if (auto nhwc_conv = node_cast<conv2d_nhwc>(old))
+    {
+        new_node = context.graph.emplace<conv2d_nhwc>(nhwc_conv->input().shape(), weights.shape(), nhwc_conv->groups(), nhwc_conv->padding_h(), nhwc_conv->padding_w(),
+            nhwc_conv->stride_h(), nhwc_conv->stride_w(), nhwc_conv->dilation_h(), nhwc_conv->dilation_w(), nhwc_conv->fused_activation(), storage_type_);
+    }
+    else
+    {
+        auto mm = node_cast<matmul>(old);
+        new_node = context.graph.emplace<matmul>(mm->input_a().shape(), weights.shape(), mm->fused_activation(), storage_type_);
+    }
+
+    new_node->name(old.name());
+    new_node->input_at(0).connect(*context.inputs[0]->connection());
+    new_node->input_at(1).connect(cvt->output());
+    new_node->input_at(2).connect(*context.inputs[2]->connection());
+
+    auto inputs = context.outputs[0]->connections();
+    for (auto &in : dup(inputs))
+        in->connect(new_node->output_at(0));
+}
@@ -16,9 +16,13 @@
 #include <nncase/plugin_loader.h>
 #include <nncase/transforms/neutral/add_quant_checkpoints.h>
 #include <nncase/transforms/neutral/fold_constant.h>
+#include <nncase/transforms/neutral/fold_transpose.h>
+#include <nncase/transforms/neutral/fuse_conv2d_chain.h>
+#include <nncase/transforms/neutral/fuse_elementwise.h>
 #include <nncase/transforms/neutral/fuse_unary.h>
 #include <nncase/transforms/neutral/fused_unary_to_lookup1d.h>
-#include <nncase/transforms/neutral/lstm_transform.h>
+#include <nncase/transforms/neutral/nhwc_layout.h>
+#include <nncase/transforms/neutral/transpose_motion.h>
 #include <nncase/transforms/pass.h>
 
 #if defined(_MSC_VER)
@@ -40,15 +44,9 @@ extern "C"
     }
 }
 
-void cpu_target::register_target_dependent_passes([[maybe_unused]] const module_type_t &type, ir::transforms::pass_manager &pass_mgr, [[maybe_unused]] bool use_ptq, [[maybe_unused]] bool split_w_to_act)
+void cpu_target::register_target_dependent_passes([[maybe_unused]] const module_type_t &type, [[maybe_unused]] ir::transforms::pass_manager &pass_mgr, [[maybe_unused]] bool use_ptq, [[maybe_unused]] bool split_w_to_act)
 {
-    // lstm_transform
-    {
-        transform_pass p("lstm_transform");
-        p.emplace<fold_constant_transform>();
-        p.emplace<lstm_transform>();
-        pass_mgr.add_pass(std::move(p));
-    }
+    // lstm is lowered to the native stackvm op, see kernels::lstm
 }
 
 void cpu_target::register_quantize_annotation_passes([[maybe_unused]] const module_type_t &type, ir::transforms::pass_manager &pass_mgr)
@@ -68,4 +66,36 @@ void cpu_target::register_quantize_annotation_passes([[maybe_unused]] const modu
         p.emplace<add_quant_checkpoints_transform>(std::in_place, ir::op_fused_unary, ir::op_bitcast, ir::op_dequantize, ir::op_binary, ir::op_output_node);
         pass_mgr.add_pass(std::move(p));
     }
-}
\ No newline at end of file
+}
+
+void cpu_target::register_target_dependent_after_quantization_passes([[maybe_unused]] const module_type_t &type, ir::transforms::pass_manager &pass_mgr)
+{
+    {
+        // Push the transposes TFLite models start with down through NHWC kernels until they cancel
+        transform_pass p("nhwc_layout");
+        p.emplace<transpose_conv2d_nhwc_motion_transform>();
+        p.emplace<transpose_reduce_window2d_nhwc_motion_transform>();
+        p.emplace<transpose_resize_image_nhwc_motion_transform>();
+        p.emplace<transpose_pad_nhwc_motion_transform>();
+        p.emplace<transpose_binary_motion_transform>();
+        p.emplace<transpose_constant_binary_motion_transform>();
+        p.emplace<transpose_concat_motion_transform>();
+        p.emplace<transpose_clamp_motion_transform>();
+        p.emplace<transpose_sigmoid_motion_transform>();
+        p.emplace<transpose_unary_motion_transform>();
+        p.emplace<fold_transpose_transform>();
+        p.emplace<fold_nop_transpose_transform>();
+        p.emplace<fold_constant_transform>();
+        pass_mgr.add_pass(std::move(p));
+    }
+    {
+        transform_pass p("fuse_elementwise");
+        p.emplace<fuse_elementwise_transform>();
+        pass_mgr.add_pass(std::move(p));
+    }
+    {
+        transform_pass p("fuse_conv2d_chain");
+        p.emplace<fuse_conv2d_chain_transform>();
+        pass_mgr.add_pass(std::move(p));
+    }
+}
@@ -82,7 +82,7 @@ def _make_module(direction, hidden_size, seq_length, batch_size, input_size, bia
             'sequence_lens',
             TensorProto.INT32,
             dims=sequence_lens_shape,
-            vals=np.full(sequence_lens_shape, seq_length).flatten().tolist()
+            vals=[seq_length if sequence_lens == 'full' else max(1, seq_length - 3 - i) for i in range(batch_size)]
         )
         nodes_inputs.append('sequence_lens')
         initializers.append(sequence_lens_tensor)
@@ -190,6 +190,8 @@ biases = [
 
 sequence_lenses = [
     None,
+    'full',
+    'ragged'
 ]
 
 initial_hs = [
@@ -0,0 +1,263 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstring>
+#include <functional>
+#include <nncase/runtime/model.h>
+#include <nncase/runtime/stackvm/opcode.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
+#include <string>
+#include <vector>
+
+// Hand assembles tiny single module stackvm kmodels, so runtime tests don't need the compiler
+
+namespace kmodel_util
+{
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+struct byte_writer
+{
+    std::vector<uint8_t> data;
+
+    template <class T>
+    void write(const T &value)
+    {
+        auto begin = reinterpret_cast<const uint8_t *>(&value);
+        data.insert(data.end(), begin, begin + sizeof(T));
+    }
+
+    void write(const std::vector<uint8_t> &bytes)
+    {
+        data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+
+    void align(size_t alignment)
+    {
+        while (data.size() % alignment)
+            data.push_back(0);
+    }
+};
+
+struct text_builder
+{
+    byte_writer writer;
+
+    void ldc_i4(int32_t value)
+    {
+        writer.write((uint8_t)opcode_t::LDC_I4);
+        writer.write(value);
+    }
+
+    void lea_buffer(memory_location_t location, uint32_t offset)
+    {
+        writer.write((uint8_t)opcode_t::LEA_BUFFER);
+        writer.write((uint8_t)location);
+        writer.write((uint8_t)0);
+        writer.write(offset);
+    }
+
+    void stshape(uint8_t rshape, const std::vector<int32_t> &shape)
+    {
+        for (auto dim : shape)
+            ldc_i4(dim);
+        writer.write((uint8_t)opcode_t::STSHAPE);
+        writer.write(rshape);
+        writer.write((uint8_t)shape.size());
+    }
+
+    // Pops dest and src addresses
+    void tensor_copy(datatype_t datatype, uint8_t rshape, uint8_t rstride_src, uint8_t rstride_dest)
+    {
+        writer.write((uint8_t)opcode_t::TENSOR);
+        writer.write((uint16_t)tensor_function_t::COPY);
+        writer.write(datatype);
+        writer.write(rshape);
+        writer.write(rstride_src);
+        writer.write(rstride_dest);
+    }
+
+    // Fails the run when it is executed
+    void throw_()
+    {
+        writer.write((uint8_t)opcode_t::THROW);
+    }
+
+    // Skips what body emits when none of the outputs in mask (outputs 0-31) is required
+    void br_unused(uint32_t mask, const std::function<void()> &body)
+    {
+        ldc_i4((int32_t)mask);
+        writer.write((uint8_t)opcode_t::BR_UNUSED);
+        writer.write((uint8_t)1);
+        auto target_pos = writer.data.size();
+        writer.write((int32_t)0);
+        auto begin = writer.data.size();
+        body();
+        auto target = (int32_t)(writer.data.size() - begin);
+        std::memcpy(writer.data.data() + target_pos, &target, sizeof(target));
+    }
+};
+
+struct section_def
+{
+    std::string name;
+    std::vector<uint8_t> body;
+    // Returns the stored body and adds its SECTION_COMPRESSED_* flag, the body is stored as is when empty
+    std::function<std::vector<uint8_t>(uint32_t &flags, const std::vector<uint8_t> &body)> compress;
+};
+
+struct function_def
+{
+    std::vector<std::pair<memory_range, std::vector<uint32_t>>> inputs;
+    std::vector<std::pair<memory_range, std::vector<uint32_t>>> outputs;
+    std::vector<uint8_t> text;
+};
+
+inline void write_io(byte_writer &writer, const std::vector<std::pair<memory_range, std::vector<uint32_t>>> &io)
+{
+    for (auto &[range, shape] : io)
+        writer.write(range);
+    for (auto &[range, shape] : io)
+    {
+        writer.write((uint32_t)shape.size());
+        for (auto dim : shape)
+            writer.write(dim);
+    }
+}
+
+// The functions' texts are concatenated into .text, which goes first in sections
+inline std::vector<uint8_t> build_kmodel(const std::vector<mempool_desc> &mempools, const std::vector<function_def> &functions, std::vector<section_def> sections = {})
+{
+    section_def text { ".text", {}, {} };
+    std::vector<std::pair<uint32_t, uint32_t>> entrypoints;
+    for (auto &func : functions)
+    {
+        entrypoints.emplace_back((uint32_t)text.body.size(), (uint32_t)func.text.size());
+        text.body.insert(text.body.end(), func.text.begin(), func.text.end());
+    }
+    sections.insert(sections.begin(), std::move(text));
+
+    byte_writer module;
+    module_header mod_header {};
+    module.write(mod_header);
+    for (auto &pool : mempools)
+        module.write(pool);
+
+    for (size_t i = 0; i < functions.size(); i++)
+    {
+        byte_writer func;
+        function_header func_header {};
+        func.write(func_header);
+        write_io(func, functions[i].inputs);
+        write_io(func, functions[i].outputs);
+        func.align(8);
+        func_header.header_size = sizeof(func_header);
+        func_header.size = (uint32_t)func.data.size();
+        func_header.inputs = (uint32_t)functions[i].inputs.size();
+        func_header.outputs = (uint32_t)functions[i].outputs.size();
+        func_header.entrypoint = entrypoints[i].first;
+        func_header.text_size = entrypoints[i].second;
+        std::memcpy(func.data.data(), &func_header, sizeof(func_header));
+        module.write(func.data);
+    }
+
+    for (auto &section : sections)
+    {
+        section_header header {};
+        std::strncpy(header.name, section.name.c_str(), MAX_SECTION_NAME_LENGTH - 1);
+        auto header_pos = module.data.size();
+        module.write(header);
+        auto body_pos = module.data.size();
+        module.align(8);
+        header.body_start = (uint32_t)(module.data.size() - body_pos);
+        auto body = section.body;
+        if (section.compress)
+        {
+            header.uncompressed_size = (uint32_t)body.size();
+            body = section.compress(header.flags, body);
+        }
+        header.body_size = (uint32_t)body.size();
+        module.write(body);
+        std::memcpy(module.data.data() + header_pos, &header, sizeof(header));
+    }
+    module.align(8);
+
+    std::memcpy(mod_header.type.data(), stackvm_module_type.data(), stackvm_module_type.size());
+    mod_header.version = stackvm_module_version;
+    mod_header.header_size = sizeof(mod_header);
+    mod_header.size = (uint32_t)module.data.size();
+    mod_header.mempools = (uint32_t)mempools.size();
+    mod_header.functions = (uint32_t)functions.size();
+    mod_header.sections = (uint32_t)sections.size();
+    std::memcpy(module.data.data(), &mod_header, sizeof(mod_header));
+
+    byte_writer model;
+    model_header header {};
+    header.identifier = MODEL_IDENTIFIER;
+    header.version = MODEL_VERSION;
+    header.header_size = sizeof(header);
+    header.alignment = 8;
+    header.modules = 1;
+    model.write(header);
+    model.write(module.data);
+    return model.data;
+}
+
+// Lists the functions the entry function can be swapped for by interpreter::reshape_inputs
+inline void add_entry_variants(std::vector<uint8_t> &model, const std::vector<uint32_t> &function_ids)
+{
+    model_header header;
+    std::memcpy(&header, model.data(), sizeof(header));
+    byte_writer variants;
+    variants.write((uint32_t)function_ids.size());
+    for (auto id : function_ids)
+        variants.write(id);
+    header.flags |= MODEL_HAS_ENTRY_VARIANTS;
+    header.header_size += (uint32_t)variants.data.size();
+    std::memcpy(model.data(), &header, sizeof(header));
+    model.insert(model.begin() + sizeof(header), variants.data.begin(), variants.data.end());
+}
+
+// Copies count floats from src to dest
+inline void copy_floats(text_builder &text, memory_location_t src, memory_location_t dest, int32_t count)
+{
+    text.lea_buffer(src, 0);
+    text.lea_buffer(dest, 0);
+    text.stshape(0, { count });
+    text.stshape(1, { 1 });
+    text.stshape(2, { 1 });
+    text.tensor_copy(dt_float32, 0, 1, 2);
+}
+
+// float32[count] input -> data -> float32[count] output
+inline std::vector<uint8_t> identity_model(int32_t count)
+{
+    text_builder text;
+    copy_floats(text, mem_input, mem_data, count);
+    copy_floats(text, mem_data, mem_output, count);
+
+    function_def func;
+    auto bytes = (uint32_t)count * 4;
+    func.inputs.push_back({ memory_range { mem_input, dt_float32, 0, 0, bytes }, { (uint32_t)count } });
+    func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, 0, bytes }, { (uint32_t)count } });
+    func.text = text.writer.data;
+
+    mempool_desc data {};
+    data.location = mem_data;
+    data.size = bytes;
+    return build_kmodel({ data }, { func });
+}
+}
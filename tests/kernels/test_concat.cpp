@@ -56,6 +56,23 @@ public:
 };
 
 // Test name:ConcatTestDims[Dims axis]
+INSTANTIATE_TEST_SUITE_P(
+    ConcatTestDims52,
+    ConcatTest,
+    testing::Combine(
+        testing::Values(
+            std::vector<runtime_shape_t> {
+                runtime_shape_t { 2, 3, 3, 4, 6 }, // input shape
+                runtime_shape_t { 2, 3, 1, 4, 6 },
+                runtime_shape_t { 2, 3, 5, 4, 6 } }),
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0, 0 },
+            runtime_shape_t { 3, 3, 3, 3, 3 }), // input strides bias
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0, 0 },
+            runtime_shape_t { 3, 3, 3, 3, 3 }), // output strides bias
+        testing::Values(2)));
+
 INSTANTIATE_TEST_SUITE_P(
     ConcatTestDims43,
     ConcatTest,
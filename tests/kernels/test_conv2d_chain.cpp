@@ -0,0 +1,211 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/cpu/reference/reduce_window.h>
+
+struct stage_desc
+{
+    runtime_shape_t w_shape; // empty for reduce_window2d
+    reduce_op_t reduce_op;
+    int32_t filter;
+    int32_t stride;
+    int32_t dilation;
+    padding pad;
+    value_range<float> act;
+};
+
+stage_desc conv(size_t oc, size_t ic, int32_t filter, int32_t stride, int32_t pad, int32_t groups = 1, int32_t dilation = 1)
+{
+    return { { oc, ic / groups, (size_t)filter, (size_t)filter }, reduce_sum, filter, stride, dilation, { pad, pad }, { 0.f, 6.f } };
+}
+
+stage_desc pool(reduce_op_t op, int32_t filter, int32_t stride, int32_t pad)
+{
+    return { {}, op, filter, stride, 1, { pad, pad }, value_range<float>::full() };
+}
+
+struct chain_case
+{
+    runtime_shape_t in_shape;
+    std::vector<stage_desc> stages;
+    int32_t tile_h;
+};
+
+std::vector<chain_case> chain_cases()
+{
+    return {
+        // conv -> relu6 -> conv
+        { { 1, 8, 37, 29 }, { conv(16, 8, 3, 1, 1), conv(8, 16, 3, 1, 1) }, 4 },
+        // conv -> maxpool
+        { { 1, 3, 64, 48 }, { conv(16, 3, 3, 2, 1), pool(reduce_max, 3, 2, 1) }, 3 },
+        // pointwise -> depthwise -> pointwise, batched
+        { { 2, 8, 33, 17 }, { conv(24, 8, 1, 1, 0), conv(24, 24, 3, 1, 1, 24), conv(8, 24, 1, 1, 0) }, 5 },
+        // dilated conv -> avgpool, single row bands
+        { { 1, 4, 20, 20 }, { conv(4, 4, 3, 1, 2, 1, 2), pool(reduce_mean, 2, 2, 0) }, 1 },
+        // one band
+        { { 1, 4, 16, 16 }, { conv(4, 4, 5, 1, 2), conv(4, 4, 3, 2, 1) }, 64 },
+    };
+}
+
+class Conv2DChainTest : public ::testing::TestWithParam<std::tuple<size_t, uint32_t>>
+{
+public:
+    void SetUp() override
+    {
+        auto &&[case_id, threads] = GetParam();
+        c = chain_cases()[case_id];
+        context.num_threads = threads;
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        input.resize(compute_size(c.in_shape));
+        for (auto &v : input)
+            v = dis(gen);
+
+        auto in_shape = c.in_shape;
+        for (auto &desc : c.stages)
+        {
+            conv2d_chain_stage stage {};
+            if (!desc.w_shape.empty())
+            {
+                weights.emplace_back(compute_size(desc.w_shape));
+                biases.emplace_back(desc.w_shape[0]);
+                for (auto &v : weights.back())
+                    v = dis(gen);
+                for (auto &v : biases.back())
+                    v = dis(gen);
+                stage.weights = weights.back().data();
+                stage.bias = biases.back().data();
+                stage.w_shape = desc.w_shape;
+                stage.groups = (int32_t)(in_shape[1] / desc.w_shape[1]);
+            }
+            else
+            {
+                stage.w_shape = { in_shape[1], 1, (size_t)desc.filter, (size_t)desc.filter };
+                stage.groups = (int32_t)in_shape[1];
+                stage.reduce_op = desc.reduce_op;
+                stage.init_value = desc.reduce_op == reduce_max ? std::numeric_limits<float>::lowest() : 0.f;
+            }
+
+            stage.padding_h = stage.padding_w = desc.pad;
+            stage.stride_h = stage.stride_w = desc.stride;
+            stage.dilation_h = stage.dilation_w = desc.dilation;
+            stage.fused_activation = desc.act;
+            stages.emplace_back(stage);
+
+            in_shape = { in_shape[0], stage.w_shape[0],
+                kernels::detail::get_windowed_output_size(in_shape[2], desc.filter, desc.stride, desc.dilation, desc.pad),
+                kernels::detail::get_windowed_output_size(in_shape[3], desc.filter, desc.stride, desc.dilation, desc.pad) };
+        }
+
+        out_shape = in_shape;
+    }
+
+    // Runs every stage over the whole tensor with the reference kernels
+    std::vector<float> run_reference()
+    {
+        auto in_shape = c.in_shape;
+        std::vector<float> in = input, out;
+        for (auto &stage : stages)
+        {
+            runtime_shape_t shape { in_shape[0], stage.w_shape[0],
+                kernels::detail::get_windowed_output_size(in_shape[2], (int32_t)stage.w_shape[2], stage.stride_h, stage.dilation_h, stage.padding_h),
+                kernels::detail::get_windowed_output_size(in_shape[3], (int32_t)stage.w_shape[3], stage.stride_w, stage.dilation_w, stage.padding_w) };
+            out.assign(compute_size(shape), 0.f);
+            if (stage.weights)
+            {
+                cpu::reference::conv2d(in.data(), stage.weights, stage.bias, out.data(), in_shape, get_default_strides(in_shape), stage.w_shape,
+                    get_default_strides(stage.w_shape), { 1 }, get_default_strides(shape), stage.padding_h, stage.padding_w, stage.groups,
+                    stage.stride_h, stage.stride_w, stage.dilation_h, stage.dilation_w, stage.fused_activation, context)
+                    .unwrap_or_throw();
+            }
+            else
+            {
+                cpu::reference::reduce_window2d(stage.reduce_op, in.data(), stage.init_value, out.data(), in_shape, get_default_strides(in_shape),
+                    get_default_strides(shape), stage.padding_h, stage.padding_w, (int32_t)stage.w_shape[2], (int32_t)stage.w_shape[3],
+                    stage.stride_h, stage.stride_w, stage.dilation_h, stage.dilation_w, stage.fused_activation, context)
+                    .unwrap_or_throw();
+            }
+
+            in.swap(out);
+            in_shape = shape;
+        }
+
+        return in;
+    }
+
+    chain_case c;
+    kernel_context context;
+    std::vector<float> input;
+    std::vector<std::vector<float>> weights, biases;
+    std::vector<conv2d_chain_stage> stages;
+    runtime_shape_t out_shape;
+};
+
+INSTANTIATE_TEST_SUITE_P(Conv2DChain, Conv2DChainTest,
+    testing::Combine(testing::Range<size_t>(0, 5), testing::Values(1u, 4u)));
+
+TEST_P(Conv2DChainTest, same_as_unfused)
+{
+    auto expected = run_reference();
+    std::vector<float> output(compute_size(out_shape), NAN);
+    ASSERT_TRUE(kernels::conv2d_chain(input.data(), output.data(), c.in_shape, get_default_strides(c.in_shape), get_default_strides(out_shape),
+        stages, c.tile_h, context)
+                    .is_ok());
+
+    ASSERT_EQ(expected.size(), output.size());
+    for (size_t i = 0; i < output.size(); i++)
+        ASSERT_NEAR(expected[i], output[i], 1e-4f * std::max(1.f, std::abs(expected[i]))) << "at " << i;
+}
+
+TEST(Conv2DChainTest, strided_views)
+{
+    // Input rows padded to 40 floats, output written into the left half of a wider tensor
+    const runtime_shape_t in_shape { 1, 2, 12, 32 }, in_strides { 2 * 12 * 40, 12 * 40, 40, 1 };
+    const runtime_shape_t out_shape { 1, 2, 12, 32 }, out_strides { 2 * 12 * 64, 12 * 64, 64, 1 };
+    std::vector<float> input(in_strides[0], 1.f), output(out_strides[0], -1.f);
+    std::vector<float> weights(2 * 2 * 3 * 3, 1.f), bias(2, 0.f);
+
+    conv2d_chain_stage stage {};
+    stage.weights = weights.data();
+    stage.bias = bias.data();
+    stage.w_shape = { 2, 2, 3, 3 };
+    stage.padding_h = stage.padding_w = { 1, 1 };
+    stage.groups = stage.stride_h = stage.stride_w = stage.dilation_h = stage.dilation_w = 1;
+    stage.fused_activation = value_range<float>::full();
+    std::vector<conv2d_chain_stage> stages { stage, stage };
+
+    ASSERT_TRUE(kernels::conv2d_chain(input.data(), output.data(), in_shape, in_strides, out_strides, stages, 5).is_ok());
+
+    // Interior pixels see 18 ones through the first conv, then 18 * 18 through the second
+    EXPECT_EQ(18.f * 18.f, output[offset(out_strides, { 0, 1, 6, 16 })]);
+    EXPECT_EQ(-1.f, output[offset(out_strides, { 0, 1, 6, 40 })]);
+}
+
+TEST(Conv2DChainTest, invalid_stages)
+{
+    float in = 0, out = 0;
+    const runtime_shape_t shape { 1, 1, 1, 1 }, strides { 1, 1, 1, 1 };
+    ASSERT_TRUE(kernels::conv2d_chain(&in, &out, shape, strides, strides, {}, 1).is_err());
+
+    conv2d_chain_stage stage {};
+    stage.w_shape = { 2, 1, 1, 1 };
+    stage.groups = stage.stride_h = stage.stride_w = stage.dilation_h = stage.dilation_w = 1;
+    std::vector<conv2d_chain_stage> stages { stage };
+    ASSERT_TRUE(kernels::conv2d_chain(&in, &out, shape, strides, strides, stages, 1).is_err());
+}
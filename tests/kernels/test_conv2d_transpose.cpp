@@ -0,0 +1,117 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+
+struct transpose_case
+{
+    runtime_shape_t in_shape;
+    size_t out_channels;
+    int32_t filter;
+    int32_t stride;
+    int32_t dilation;
+    padding pad;
+    int32_t output_padding;
+    int32_t groups;
+};
+
+std::vector<transpose_case> transpose_cases()
+{
+    return {
+        // 2x upsampling decoders
+        { { 1, 8, 13, 17 }, 16, 4, 2, 1, { 1, 1 }, 0, 1 },
+        { { 2, 16, 9, 11 }, 8, 3, 2, 1, { 1, 1 }, 1, 1 },
+        { { 1, 4, 10, 10 }, 4, 2, 2, 1, { 0, 0 }, 0, 1 },
+        // stride 1, dilated, grouped
+        { { 1, 6, 12, 9 }, 6, 3, 1, 2, { 2, 1 }, 0, 3 },
+        // filter smaller than stride leaves phases without taps
+        { { 1, 3, 7, 8 }, 5, 2, 3, 1, { 0, 1 }, 2, 1 },
+        // depthwise, negative padding
+        { { 1, 8, 15, 6 }, 8, 5, 2, 1, { -1, 2 }, 1, 8 },
+    };
+}
+
+class Conv2DTransposeTest : public ::testing::TestWithParam<std::tuple<size_t, uint32_t>>
+{
+public:
+    void SetUp() override
+    {
+        auto &&[case_id, threads] = GetParam();
+        c = transpose_cases()[case_id];
+        context.num_threads = threads;
+
+        w_shape = { c.out_channels, c.in_shape[1] / c.groups, (size_t)c.filter, (size_t)c.filter };
+        auto out_size = [&](size_t in) { return (in - 1) * c.stride - c.pad.sum() + c.dilation * (c.filter - 1) + 1 + c.output_padding; };
+        out_shape = { c.in_shape[0], c.out_channels, out_size(c.in_shape[2]), out_size(c.in_shape[3]) };
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        input.resize(compute_size(c.in_shape));
+        weights.resize(compute_size(w_shape));
+        bias.resize(c.out_channels);
+        for (auto *values : { &input, &weights, &bias })
+        {
+            for (auto &v : *values)
+                v = dis(gen);
+        }
+    }
+
+    transpose_case c;
+    kernel_context context;
+    runtime_shape_t w_shape, out_shape;
+    std::vector<float> input, weights, bias;
+};
+
+INSTANTIATE_TEST_SUITE_P(Conv2DTranspose, Conv2DTransposeTest,
+    testing::Combine(testing::Range<size_t>(0, 6), testing::Values(1u, 4u)));
+
+TEST_P(Conv2DTransposeTest, same_as_reference)
+{
+    const value_range<float> act { -1.f, 1.5f };
+    std::vector<float> expected(compute_size(out_shape), NAN), output(expected.size(), NAN);
+    ASSERT_TRUE(cpu::reference::conv2d_transpose(input.data(), weights.data(), bias.data(), expected.data(), c.in_shape, get_default_strides(c.in_shape),
+        w_shape, get_default_strides(w_shape), { 1 }, out_shape, get_default_strides(out_shape), c.pad, c.pad, c.groups, c.stride, c.stride,
+        c.dilation, c.dilation, act, context)
+                    .is_ok());
+    ASSERT_TRUE(kernels::conv2d_transpose(input.data(), weights.data(), bias.data(), output.data(), c.in_shape, get_default_strides(c.in_shape),
+        w_shape, get_default_strides(w_shape), { 1 }, out_shape, get_default_strides(out_shape), c.pad, c.pad, c.groups, c.stride, c.stride,
+        c.dilation, c.dilation, act, context)
+                    .is_ok());
+
+    for (size_t i = 0; i < output.size(); i++)
+        ASSERT_NEAR(expected[i], output[i], 1e-4f * std::max(1.f, std::abs(expected[i]))) << "at " << i;
+}
+
+TEST(Conv2DTransposeTest, scatter)
+{
+    // Each input pixel stamps the 2x2 filter scaled by itself at (2 * y, 2 * x)
+    const runtime_shape_t in_shape { 1, 1, 2, 2 }, w_shape { 1, 1, 2, 2 }, out_shape { 1, 1, 4, 4 };
+    const float input[] = { 1, 2, 3, 4 }, weights[] = { 1, 10, 100, 1000 }, bias[] = { 0.5f };
+    float output[16];
+    ASSERT_TRUE(kernels::conv2d_transpose(input, weights, bias, output, in_shape, get_default_strides(in_shape), w_shape, get_default_strides(w_shape),
+        { 1 }, out_shape, get_default_strides(out_shape), { 0, 0 }, { 0, 0 }, 1, 2, 2, 1, 1, value_range<float>::full())
+                    .is_ok());
+
+    const float expected[] = {
+        1.5f, 10.5f, 2.5f, 20.5f,
+        100.5f, 1000.5f, 200.5f, 2000.5f,
+        3.5f, 30.5f, 4.5f, 40.5f,
+        300.5f, 3000.5f, 400.5f, 4000.5f
+    };
+    for (size_t i = 0; i < 16; i++)
+        EXPECT_EQ(expected[i], output[i]) << "at " << i;
+}
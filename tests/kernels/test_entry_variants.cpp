@@ -0,0 +1,136 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kmodel_util.h"
+#include <gtest/gtest.h>
+#include <nncase/runtime/error.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace kmodel_util;
+
+namespace
+{
+// float32[1, count] input -> data -> output, for each count. The function at failing fails instead
+std::vector<uint8_t> variants_model(const std::vector<int32_t> &counts, size_t failing = SIZE_MAX)
+{
+    std::vector<function_def> functions;
+    std::vector<uint32_t> function_ids;
+    for (auto count : counts)
+    {
+        text_builder text;
+        if (functions.size() == failing)
+            text.throw_();
+        copy_floats(text, mem_input, mem_data, count);
+        copy_floats(text, mem_data, mem_output, count);
+
+        function_def func;
+        auto bytes = (uint32_t)count * 4;
+        func.inputs.push_back({ memory_range { mem_input, dt_float32, 0, 0, bytes }, { 1, (uint32_t)count } });
+        func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, 0, bytes }, { 1, (uint32_t)count } });
+        func.text = text.writer.data;
+        function_ids.emplace_back((uint32_t)functions.size());
+        functions.emplace_back(std::move(func));
+    }
+
+    mempool_desc data {};
+    data.location = mem_data;
+    data.size = (uint32_t)*std::max_element(counts.begin(), counts.end()) * 4;
+    auto model = build_kmodel({ data }, functions);
+    add_entry_variants(model, function_ids);
+    return model;
+}
+
+result<void> load(interpreter &interp, const std::vector<uint8_t> &model)
+{
+    return interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() });
+}
+}
+
+TEST(EntryVariantsTest, reshape_inputs_picks_variant)
+{
+    auto model = variants_model({ 64, 16, 256 });
+    interpreter interp;
+    load(interp, model).unwrap_or_throw();
+    EXPECT_EQ((runtime_shape_t { 1, 64 }), interp.input_shape(0));
+
+    for (size_t count : { 16, 256, 64 })
+    {
+        runtime_shape_t shape { 1, count };
+        interp.reshape_inputs({ &shape, 1 }).unwrap_or_throw();
+        EXPECT_EQ(shape, interp.input_shape(0));
+        EXPECT_EQ(shape, interp.output_shape(0));
+
+        auto input = interp.input_tensor(0).unwrap_or_throw();
+        {
+            auto map = std::move(hrt::map(input, hrt::map_write).unwrap_or_throw());
+            auto p = reinterpret_cast<float *>(map.buffer().data());
+            for (size_t i = 0; i < count; i++)
+                p[i] = (float)i;
+        }
+
+        interp.run().unwrap_or_throw();
+        auto output = interp.output_tensor(0).unwrap_or_throw();
+        auto map = std::move(hrt::map(output, hrt::map_read).unwrap_or_throw());
+        EXPECT_EQ((float)(count - 1), reinterpret_cast<const float *>(map.buffer().data())[count - 1]);
+    }
+
+    // no variant has this shape, the current one stays
+    runtime_shape_t shape { 1, 32 };
+    auto result = interp.reshape_inputs({ &shape, 1 });
+    ASSERT_TRUE(result.is_err());
+    EXPECT_EQ(nncase_errc::shape_mismatch, result.unwrap_err());
+    EXPECT_EQ((runtime_shape_t { 1, 64 }), interp.input_shape(0));
+}
+
+TEST(EntryVariantsTest, runs_only_the_selected_variant)
+{
+    // the entry function for 64 floats fails, so a run only succeeds when another variant replaced it
+    auto model = variants_model({ 64, 16, 256 }, 0);
+    interpreter interp;
+    load(interp, model).unwrap_or_throw();
+    EXPECT_TRUE(interp.run().is_err());
+
+    for (size_t count : { 16, 256 })
+    {
+        runtime_shape_t shape { 1, count };
+        interp.reshape_inputs({ &shape, 1 }).unwrap_or_throw();
+        EXPECT_TRUE(interp.run().is_ok()) << count;
+    }
+
+    runtime_shape_t shape { 1, 64 };
+    interp.reshape_inputs({ &shape, 1 }).unwrap_or_throw();
+    EXPECT_TRUE(interp.run().is_err());
+}
+
+TEST(EntryVariantsTest, rejects_truncated_variant_list)
+{
+    auto model = variants_model({ 64, 16 });
+    auto count = model.data() + sizeof(model_header);
+
+    // more ids than the whole model has bytes for
+    for (uint32_t bad_count : { (uint32_t)model.size(), 0x40000000u, 0xffffffffu })
+    {
+        std::memcpy(count, &bad_count, sizeof(bad_count));
+        interpreter interp;
+        EXPECT_TRUE(load(interp, model).is_err()) << bad_count;
+    }
+
+    // the list is cut off right after the flag
+    model.resize(sizeof(model_header) + 2);
+    interpreter interp;
+    EXPECT_TRUE(load(interp, model).is_err());
+}
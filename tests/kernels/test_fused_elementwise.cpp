@@ -0,0 +1,109 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <gtest/gtest.h>
+#include <nncase/codegen/nnil_builder.h>
+#include <nncase/ir/ops/fused_elementwise.h>
+#include <nncase/kernels/nnil.h>
+#include <sstream>
+
+using namespace nncase::ir;
+
+namespace
+{
+struct program_case
+{
+    const char *name;
+    std::vector<fused_unary_op> subgraph;
+    size_t instructions;
+    size_t depth;
+    std::function<float(float, float)> expected;
+};
+
+std::ostream &operator<<(std::ostream &os, const program_case &c)
+{
+    return os << c.name;
+}
+
+std::vector<fused_unary_op> repeated_square(size_t times)
+{
+    std::vector<fused_unary_op> subgraph { fused_unary_op::make_ldx(0) };
+    for (size_t i = 0; i < times; i++)
+        subgraph.emplace_back(fused_unary_op::make_binary(binary_mul, { i }, { i }));
+    return subgraph;
+}
+}
+
+class FusedElementwiseTest : public ::testing::TestWithParam<program_case>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(FusedElementwise, FusedElementwiseTest,
+    testing::Values(
+        // lda_0, dup, mul
+        program_case { "square", { fused_unary_op::make_ldx(0), fused_unary_op::make_binary(binary_mul, { 0 }, { 0 }) }, 3, 2,
+            [](float a, float) { return a * a; } },
+        // lda_0, dup, tanh, sub
+        program_case { "x_sub_tanh_x", { fused_unary_op::make_ldx(0), fused_unary_op::make_unary(unary_tanh, { 0 }), fused_unary_op::make_binary(binary_sub, { 0 }, { 1 }) }, 4, 2,
+            [](float a, float) { return a - std::tanh(a); } },
+        // x is below tanh(x) when sub needs it again, so it is loaded twice
+        program_case { "tanh_x_sub_x", { fused_unary_op::make_ldx(0), fused_unary_op::make_unary(unary_tanh, { 0 }), fused_unary_op::make_binary(binary_sub, { 1 }, { 0 }) }, 4, 2,
+            [](float a, float) { return std::tanh(a) - a; } },
+        // lda_0, lda 1, add, dup, mul, the identity a fused producer leaves behind emits nothing
+        program_case { "identity_square", { fused_unary_op::make_ldx(0), fused_unary_op::make_ldx(1), fused_unary_op::make_binary(binary_add, { 0 }, { 1 }), fused_unary_op::make_identity({ 2 }), fused_unary_op::make_binary(binary_mul, { 3 }, { 3 }) }, 5, 2,
+            [](float a, float b) { return (a + b) * (a + b); } },
+        // the tree has 2^5 loads, dup keeps the program linear
+        program_case { "pow_32", repeated_square(5), 11, 2,
+            [](float a, float) { return std::pow(a, 32.f); } },
+        // b - a is dup'ed for the low bound, but the high bound comes after the low one and recomputes it
+        program_case { "clamp_shared", { fused_unary_op::make_ldx(0), fused_unary_op::make_ldx(1), fused_unary_op::make_binary(binary_sub, { 1 }, { 0 }), fused_unary_op::make_constant(0.5f), fused_unary_op::make_binary(binary_mul, { 2 }, { 3 }), fused_unary_op::make_clamp({ 2 }, { 4 }, { 2 }) }, 10, 4,
+            [](float a, float b) { return std::min(std::max(b - a, (b - a) * 0.5f), b - a); } }));
+
+TEST_P(FusedElementwiseTest, program_matches_subgraph)
+{
+    auto &c = GetParam();
+    std::stringstream ss;
+    binary_writer bw(ss);
+    codegen::nnil_builder builder(bw);
+    fused_elementwise::compile_graph(c.subgraph, builder);
+    auto buf = ss.str();
+    std::vector<gsl::byte> body(reinterpret_cast<gsl::byte *>(buf.data()), reinterpret_cast<gsl::byte *>(buf.data() + buf.size()));
+
+    auto [instructions, depth] = fused_elementwise::program_size(c.subgraph);
+    EXPECT_EQ(c.instructions, instructions);
+    EXPECT_EQ(c.depth, depth);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-1.1f, 1.1f);
+    std::vector<float> a(67), b(a.size()), output(a.size());
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        a[i] = dis(gen);
+        b[i] = dis(gen);
+    }
+
+    const float *inputs[] = { a.data(), b.data() };
+    runtime_shape_t shape { a.size() };
+    runtime_shape_t shapes[] = { shape, shape }, strides[] = { { 1 }, { 1 } };
+    kernels::nnil_elementwise(inputs, shapes, strides, output.data(), shape, { 1 }, body).unwrap_or_throw();
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        auto expected = c.expected(a[i], b[i]);
+        ASSERT_NEAR(expected, output[i], 1e-5f * std::max(1.f, std::abs(expected))) << "at " << i;
+    }
+}
@@ -0,0 +1,135 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+namespace
+{
+struct gru_case
+{
+    size_t seq_length;
+    size_t batch_size;
+    size_t input_size;
+    size_t hidden_size;
+    lstm_direction direction;
+    bool linear_before_reset;
+};
+
+std::ostream &operator<<(std::ostream &os, const gru_case &c)
+{
+    return os << "seq " << c.seq_length << " batch " << c.batch_size << " input " << c.input_size << " hidden " << c.hidden_size
+              << " direction " << c.direction << " linear before reset " << c.linear_before_reset;
+}
+
+std::vector<float> random_values(size_t size, std::mt19937 &gen)
+{
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+    std::vector<float> values(size);
+    for (auto &v : values)
+        v = dis(gen);
+    return values;
+}
+
+void expect_near(const std::vector<float> &expected, const std::vector<float> &actual, const char *what)
+{
+    ASSERT_EQ(expected.size(), actual.size()) << what;
+    for (size_t i = 0; i < expected.size(); i++)
+        ASSERT_NEAR(expected[i], actual[i], 2e-5f) << what << " at " << i;
+}
+}
+
+class GruTest : public ::testing::TestWithParam<gru_case>
+{
+public:
+    void SetUp() override
+    {
+        c = GetParam();
+        const size_t directions = c.direction == kBidirectional ? 2 : 1;
+        const size_t hidden = c.hidden_size;
+        std::mt19937 gen(42);
+        x = random_values(c.seq_length * c.batch_size * c.input_size, gen);
+        w = random_values(directions * 3 * hidden * c.input_size, gen);
+        r = random_values(directions * 3 * hidden * hidden, gen);
+        b = random_values(directions * 6 * hidden, gen);
+        initial_h = random_values(directions * c.batch_size * hidden, gen);
+        input_shape = { c.seq_length, c.batch_size, c.input_size };
+        w_shape = { directions, 3 * hidden, c.input_size };
+
+        expected_y.resize(c.seq_length * directions * c.batch_size * hidden);
+        expected_y_h.resize(directions * c.batch_size * hidden);
+        auto h = initial_h;
+        cpu::reference::gru(x.data(), w.data(), r.data(), b.data(), h.data(), expected_y.data(), expected_y_h.data(),
+            input_shape, w_shape, c.direction, c.linear_before_reset)
+            .unwrap_or_throw();
+    }
+
+    gru_case c;
+    std::vector<float> x, w, r, b, initial_h;
+    std::vector<float> expected_y, expected_y_h;
+    runtime_shape_t input_shape, w_shape;
+};
+
+INSTANTIATE_TEST_SUITE_P(Gru, GruTest,
+    testing::Values(gru_case { 5, 3, 7, 6, kForward, false },
+        gru_case { 5, 3, 7, 6, kForward, true },
+        gru_case { 4, 2, 3, 5, kReverse, false },
+        gru_case { 4, 2, 3, 5, kReverse, true },
+        gru_case { 6, 2, 17, 13, kBidirectional, false },
+        gru_case { 6, 2, 17, 13, kBidirectional, true },
+        gru_case { 1, 1, 1, 1, kForward, false },
+        gru_case { 8, 4, 64, 64, kForward, false },
+        gru_case { 3, 8, 40, 96, kBidirectional, true }));
+
+TEST_P(GruTest, optimized_same_as_reference)
+{
+    for (uint32_t threads : { 1u, 4u })
+    {
+        kernel_context context;
+        context.num_threads = threads;
+        auto h = initial_h;
+        std::vector<float> y(expected_y.size()), y_h(expected_y_h.size());
+        kernels::gru(x.data(), w.data(), r.data(), b.data(), h.data(), y.data(), y_h.data(),
+            input_shape, w_shape, c.direction, c.linear_before_reset, context)
+            .unwrap_or_throw();
+        SCOPED_TRACE(threads);
+        expect_near(expected_y, y, "y");
+        expect_near(expected_y_h, y_h, "y_h");
+        // the initial state is an input, running must not change it
+        EXPECT_EQ(initial_h, h);
+    }
+}
+
+TEST_P(GruTest, workspace_released)
+{
+    kernel_workspace workspace;
+    kernel_context context { 1, &workspace };
+    for (int run = 0; run < 2; run++)
+    {
+        auto h = initial_h;
+        std::vector<float> y(expected_y.size()), y_h(expected_y_h.size());
+        kernels::gru(x.data(), w.data(), r.data(), b.data(), h.data(), y.data(), y_h.data(),
+            input_shape, w_shape, c.direction, c.linear_before_reset, context)
+            .unwrap_or_throw();
+        SCOPED_TRACE(run);
+        expect_near(expected_y, y, "y");
+        EXPECT_LT(0, workspace.size());
+
+        // the next run allocates it again
+        context.release_workspace();
+        EXPECT_EQ(0, workspace.size());
+    }
+}
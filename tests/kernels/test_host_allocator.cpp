@@ -0,0 +1,123 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/scratch_arena.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+
+namespace
+{
+gsl::byte *data(runtime_tensor &tensor)
+{
+    return hrt::map(tensor, hrt::map_read).unwrap_or_throw().buffer().data();
+}
+}
+
+TEST(HostAllocatorTest, size_classes)
+{
+    EXPECT_EQ(64, pooled_host_allocator::size_class(0));
+    EXPECT_EQ(64, pooled_host_allocator::size_class(64));
+    EXPECT_EQ(80, pooled_host_allocator::size_class(65));
+    EXPECT_EQ(128, pooled_host_allocator::size_class(128));
+    EXPECT_EQ(160, pooled_host_allocator::size_class(129));
+    EXPECT_EQ(1280, pooled_host_allocator::size_class(1025));
+    EXPECT_EQ(655360, pooled_host_allocator::size_class(602112));
+    for (size_t bytes = 1; bytes < 100000; bytes += 97)
+    {
+        auto size = pooled_host_allocator::size_class(bytes);
+        ASSERT_GE(size, bytes);
+        ASSERT_LE(size, std::max<size_t>(64, bytes + bytes / 4));
+    }
+}
+
+TEST(HostAllocatorTest, recycles_released_tensors)
+{
+    pooled_host_allocator allocator;
+    for (auto pool : { hrt::pool_cpu_only, hrt::pool_shared })
+    {
+        auto tensor = hrt::create(dt_float32, { 1, 3, 224, 224 }, allocator, pool).unwrap_or_throw();
+        auto address = data(tensor);
+        EXPECT_EQ(0, (uintptr_t)address % host_buffer_alignment);
+        tensor.reset();
+
+        auto stats = allocator.stats();
+        EXPECT_EQ(pooled_host_allocator::size_class(3 * 224 * 224 * 4), stats.bytes_held);
+
+        // same size class, so the buffer comes back
+        tensor = hrt::create(dt_uint8, { 1, 3, 224, 224, 4 }, allocator, pool).unwrap_or_throw();
+        EXPECT_EQ(address, data(tensor));
+        EXPECT_EQ(0, allocator.stats().bytes_held);
+    }
+
+    // the shared pool tensor reuses the buffer the cpu only one released
+    auto stats = allocator.stats();
+    EXPECT_EQ(3, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+}
+
+TEST(HostAllocatorTest, max_bytes_held)
+{
+    pooled_host_allocator allocator(1024);
+    auto small = hrt::create(dt_float32, { 200 }, allocator).unwrap_or_throw();
+    auto large = hrt::create(dt_float32, { 1000 }, allocator).unwrap_or_throw();
+    small.reset();
+    large.reset();
+    EXPECT_EQ(pooled_host_allocator::size_class(800), allocator.stats().bytes_held);
+
+    allocator.trim();
+    EXPECT_EQ(0, allocator.stats().bytes_held);
+    auto tensor = hrt::create(dt_float32, { 200 }, allocator).unwrap_or_throw();
+    EXPECT_EQ(3, allocator.stats().misses);
+}
+
+TEST(HostAllocatorTest, default_allocator)
+{
+    pooled_host_allocator allocator;
+    default_host_allocator(&allocator);
+    EXPECT_EQ(&allocator, &default_host_allocator());
+    hrt::create(dt_float32, { 16, 16 }).unwrap_or_throw();
+    hrt::create(dt_float32, { 16, 16 }, hrt::pool_cpu_only).unwrap_or_throw();
+
+    // physical addresses and caller owned data do not go through the allocator
+    std::vector<float> buffer(16);
+    hrt::create(dt_float32, { 16 }, { reinterpret_cast<gsl::byte *>(buffer.data()), 64 }, false).unwrap_or_throw();
+    default_host_allocator(nullptr);
+
+    auto stats = allocator.stats();
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_NE(&allocator, &default_host_allocator());
+}
+
+TEST(HostAllocatorTest, scratch_arena_keeps_largest_reservation)
+{
+    scratch_arena arena;
+    arena.reserve(4096);
+    arena.reserve(1024);
+    EXPECT_EQ(4096, arena.capacity());
+
+    // every run gets the same buffer until a larger model is loaded
+    auto first = arena.acquire().unwrap_or_throw();
+    auto second = arena.acquire().unwrap_or_throw();
+    EXPECT_EQ(4096, first.shape()[0]);
+    EXPECT_EQ(data(first), data(second));
+
+    arena.reserve(8192);
+    auto grown = arena.acquire().unwrap_or_throw();
+    EXPECT_EQ(8192, grown.shape()[0]);
+    EXPECT_NE(data(first), data(grown));
+}
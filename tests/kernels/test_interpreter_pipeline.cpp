@@ -0,0 +1,151 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kmodel_util.h"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
+#include <type_traits>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace kmodel_util;
+
+namespace
+{
+constexpr int32_t count = 4096;
+// More than the pipeline's input and output slots, so requests queue up behind each other
+constexpr size_t requests = 16;
+
+// The pipeline's worker threads hold on to the interpreter
+static_assert(!std::is_move_constructible_v<interpreter>);
+
+runtime_tensor filled(float offset)
+{
+    auto tensor = hrt::create(dt_float32, { count }).unwrap_or_throw();
+    auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+    auto p = reinterpret_cast<float *>(map.buffer().data());
+    for (int32_t i = 0; i < count; i++)
+        p[i] = offset + (float)i;
+    return tensor;
+}
+
+std::vector<float> values(runtime_tensor &tensor)
+{
+    auto map = std::move(hrt::map(tensor, hrt::map_read).unwrap_or_throw());
+    auto p = reinterpret_cast<const float *>(map.buffer().data());
+    return std::vector<float>(p, p + count);
+}
+
+class callback_log
+{
+public:
+    run_async_callback_t callback(size_t request)
+    {
+        return [this, request](result<void> status) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            EXPECT_TRUE(status.is_ok()) << request;
+            order_.emplace_back(request);
+        };
+    }
+
+    std::vector<size_t> order()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<size_t> order_;
+};
+}
+
+class InterpreterPipelineTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        model = identity_model(count);
+        interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+        for (size_t r = 0; r < requests; r++)
+        {
+            inputs.emplace_back(filled(r * 10000.f));
+            outputs.emplace_back(filled(-1.f));
+        }
+    }
+
+    std::vector<uint8_t> model;
+    interpreter interp;
+    std::vector<runtime_tensor> inputs, outputs;
+};
+
+TEST_F(InterpreterPipelineTest, same_as_run)
+{
+    callback_log log;
+    for (size_t r = 0; r < requests; r++)
+        interp.run_async({ inputs[r] }, { outputs[r] }, log.callback(r)).unwrap_or_throw();
+    interp.wait_async_idle();
+
+    // callbacks come in submission order, and all of them before wait_async_idle returns
+    std::vector<size_t> expected_order(requests);
+    for (size_t r = 0; r < requests; r++)
+        expected_order[r] = r;
+    EXPECT_EQ(expected_order, log.order());
+
+    for (size_t r = 0; r < requests; r++)
+    {
+        interp.input_tensor(0, inputs[r]).unwrap_or_throw();
+        auto expected = filled(-1.f);
+        interp.output_tensor(0, expected).unwrap_or_throw();
+        interp.run().unwrap_or_throw();
+        EXPECT_EQ(values(expected), values(outputs[r])) << r;
+    }
+}
+
+TEST_F(InterpreterPipelineTest, rejects_bad_requests)
+{
+    EXPECT_TRUE(interp.run_async({}, { outputs[0] }, {}).is_err());
+    EXPECT_TRUE(interp.run_async({ inputs[0] }, {}, {}).is_err());
+    EXPECT_TRUE(interp.run_async({ runtime_tensor() }, { outputs[0] }, {}).is_err());
+    auto wrong_shape = hrt::create(dt_float32, { count / 2 }).unwrap_or_throw();
+    EXPECT_TRUE(interp.run_async({ wrong_shape }, { outputs[0] }, {}).is_err());
+    auto wrong_type = hrt::create(dt_int32, { count }).unwrap_or_throw();
+    EXPECT_TRUE(interp.run_async({ inputs[0] }, { wrong_type }, {}).is_err());
+
+    // nothing was queued
+    interp.wait_async_idle();
+}
+
+TEST(InterpreterPipelineLifetimeTest, destroy_with_requests_in_flight)
+{
+    auto model = identity_model(count);
+    callback_log log;
+    std::vector<runtime_tensor> outputs;
+    {
+        interpreter interp;
+        interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+        for (size_t r = 0; r < requests; r++)
+        {
+            outputs.emplace_back(filled(-1.f));
+            interp.run_async({ filled(r * 10000.f) }, { outputs[r] }, log.callback(r)).unwrap_or_throw();
+        }
+    }
+
+    // the interpreter finishes every request before it goes away
+    EXPECT_EQ(requests, log.order().size());
+    for (size_t r = 0; r < requests; r++)
+        EXPECT_EQ(r * 10000.f + count - 1, values(outputs[r])[count - 1]) << r;
+}
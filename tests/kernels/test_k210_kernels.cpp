@@ -0,0 +1,136 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/k210/optimized/k210_kernels.h>
+
+using namespace nncase::runtime::k210;
+
+class K210KernelsTest : public ::testing::TestWithParam<std::tuple<runtime_shape_t, bool, int32_t>>
+{
+public:
+    void SetUp() override
+    {
+        std::tie(shape, is_depthwise, filter) = GetParam();
+        in_c = (int32_t)shape[0];
+        out_c = is_depthwise ? in_c : (int32_t)shape[1];
+        h = (int32_t)shape[2];
+        w = (int32_t)shape[3];
+    }
+
+    template <class T>
+    std::vector<T> random(size_t count, T low, T high)
+    {
+        std::vector<T> values(count);
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            std::uniform_real_distribution<T> dis(low, high);
+            for (auto &v : values)
+                v = dis(gen);
+        }
+        else
+        {
+            std::uniform_int_distribution<int64_t> dis(low, high);
+            for (auto &v : values)
+                v = (T)dis(gen);
+        }
+        return values;
+    }
+
+    runtime_shape_t shape;
+    bool is_depthwise;
+    int32_t filter, in_c, out_c, h, w;
+    std::mt19937 gen { 42 };
+};
+
+// { in channels, out channels, height, width }
+INSTANTIATE_TEST_SUITE_P(K210Kernels, K210KernelsTest,
+    testing::Combine(
+        testing::Values(runtime_shape_t { 3, 16, 32, 40 }, runtime_shape_t { 32, 24, 13, 9 }, runtime_shape_t { 5, 7, 1, 1 }),
+        testing::Bool(),
+        testing::Values(1, 3)));
+
+#define DISPATCH_CONV(kernel, ...)                                \
+    if (is_depthwise && filter == 1)                              \
+        kernel<true, 1>(__VA_ARGS__);                             \
+    else if (is_depthwise && filter == 3)                         \
+        kernel<true, 3>(__VA_ARGS__);                             \
+    else if (filter == 1)                                         \
+        kernel<false, 1>(__VA_ARGS__);                            \
+    else                                                          \
+        kernel<false, 3>(__VA_ARGS__)
+
+TEST_P(K210KernelsTest, kpu_conv2d_bit_exact)
+{
+    auto input = random<uint8_t>((size_t)in_c * h * w, 0, 255);
+    auto weights = random<uint8_t>((size_t)out_c * (is_depthwise ? 1 : in_c) * filter * filter, 0, 255);
+
+    std::vector<kpu_batchnorm_segment> bn(out_c);
+    for (auto &seg : bn)
+        seg = { (int32_t)random<int32_t>(1, 1, 1 << 12)[0], 20, (int32_t)random<int32_t>(1, -256, 256)[0] };
+
+    // ascending starts, the first segment catches everything below
+    kpu_activation_table_t act;
+    for (size_t i = 0; i < act.size(); i++)
+    {
+        auto params = random<int32_t>(3, -2000, 2000);
+        act[i] = { i == 0 ? -(int64_t(1) << 35) : (int64_t)i * 1000 - 8000, params[0] / 100, 8, params[1] / 16 + 128 };
+    }
+
+    const auto size = (size_t)out_c * h * w;
+    std::vector<int64_t> expected_ws(size), actual_ws(size);
+    std::vector<uint8_t> expected(size), actual(size);
+    DISPATCH_CONV(kernels::k210::kpu_conv2d, input.data(), expected_ws.data(), expected.data(), weights.data(), h, w, in_c, out_c, 37, -128, 2, -117, 3,
+        int64_t(123456), bn.data(), act);
+    DISPATCH_CONV(kernels::k210::optimized::kpu_conv2d, input.data(), actual_ws.data(), actual.data(), weights.data(), h, w, in_c, out_c, 37, -128, 2, -117, 3,
+        int64_t(123456), bn.data(), act);
+    EXPECT_EQ(expected_ws, actual_ws);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_P(K210KernelsTest, fake_kpu_conv2d_bit_exact)
+{
+    auto input = random<float>((size_t)in_c * h * w, -1.f, 1.f);
+    auto weights = random<float>((size_t)out_c * (is_depthwise ? 1 : in_c) * filter * filter, -1.f, 1.f);
+    auto bias = random<float>(out_c, -1.f, 1.f);
+
+    const auto size = (size_t)out_c * h * w;
+    std::vector<float> expected(size), actual(size);
+    const value_range<float> act { -0.5f, 2.f };
+    DISPATCH_CONV(kernels::k210::fake_kpu_conv2d, input.data(), expected.data(), weights.data(), bias.data(), h, w, in_c, out_c, act);
+    DISPATCH_CONV(kernels::k210::optimized::fake_kpu_conv2d, input.data(), actual.data(), weights.data(), bias.data(), h, w, in_c, out_c, act);
+    for (size_t i = 0; i < size; i++)
+        ASSERT_EQ(expected[i], actual[i]) << "at " << i;
+}
+
+TEST_P(K210KernelsTest, kpu_pool2d_bit_exact)
+{
+    auto input = random<uint8_t>((size_t)in_c * h * w, 0, 255);
+    auto input_f = random<float>(input.size(), -1.f, 1.f);
+    for (int32_t t = kpu_pool_bypass; t <= kpu_pool_max_2_s1; t++)
+    {
+        auto pool_type = (kpu_pool_type_t)t;
+        const auto out_size = (size_t)in_c * get_kpu_pool_output_size(h, pool_type) * get_kpu_pool_output_size(w, pool_type);
+        std::vector<uint8_t> expected(out_size), actual(out_size);
+        kernels::k210::kpu_pool2d(input.data(), expected.data(), h, w, in_c, pool_type);
+        kernels::k210::optimized::kpu_pool2d(input.data(), actual.data(), h, w, in_c, pool_type);
+        EXPECT_EQ(expected, actual) << "pool type " << t;
+
+        std::vector<float> expected_f(out_size), actual_f(out_size);
+        kernels::k210::kpu_pool2d(input_f.data(), expected_f.data(), h, w, in_c, pool_type);
+        kernels::k210::optimized::kpu_pool2d(input_f.data(), actual_f.data(), h, w, in_c, pool_type);
+        EXPECT_EQ(expected_f, actual_f) << "pool type " << t;
+    }
+}
@@ -0,0 +1,190 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kmodel_util.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <lz4hc.h>
+#include <nncase/runtime/error.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
+#include <zstd.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace kmodel_util;
+
+namespace
+{
+enum class compression
+{
+    none,
+    lz4,
+    zstd
+};
+
+// Output copies the first output_count floats of rdata
+constexpr int32_t rdata_count = 4096;
+constexpr int32_t output_count = 1024;
+constexpr size_t unused_size = 10000;
+
+std::function<std::vector<uint8_t>(uint32_t &, const std::vector<uint8_t> &)> compressor(compression method)
+{
+    switch (method)
+    {
+    case compression::lz4:
+        return [](uint32_t &flags, const std::vector<uint8_t> &body) {
+            std::vector<uint8_t> compressed(LZ4_compressBound((int)body.size()));
+            compressed.resize(LZ4_compress_HC(reinterpret_cast<const char *>(body.data()), reinterpret_cast<char *>(compressed.data()),
+                (int)body.size(), (int)compressed.size(), LZ4HC_CLEVEL_MAX));
+            flags |= SECTION_COMPRESSED_LZ4;
+            return compressed;
+        };
+    case compression::zstd:
+        return [](uint32_t &flags, const std::vector<uint8_t> &body) {
+            std::vector<uint8_t> compressed(ZSTD_compressBound(body.size()));
+            compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), body.data(), body.size(), 19));
+            flags |= SECTION_COMPRESSED_ZSTD;
+            return compressed;
+        };
+    default:
+        return {};
+    }
+}
+
+std::vector<float> rdata_values()
+{
+    std::vector<float> values(rdata_count);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = (float)(i % 17);
+    return values;
+}
+
+// .rdata and an .unused section no module asks for, both compressed with method
+std::vector<uint8_t> rdata_model(compression method)
+{
+    text_builder text;
+    copy_floats(text, mem_rdata, mem_output, output_count);
+
+    function_def func;
+    func.inputs.push_back({ memory_range { mem_input, dt_float32, 0, 0, 4 }, { 1 } });
+    func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, 0, output_count * 4 }, { output_count } });
+    func.text = text.writer.data;
+
+    auto values = rdata_values();
+    std::vector<uint8_t> rdata(reinterpret_cast<const uint8_t *>(values.data()), reinterpret_cast<const uint8_t *>(values.data() + values.size()));
+    return build_kmodel({}, { func },
+        { { ".rdata", rdata, compressor(method) },
+            { ".unused", std::vector<uint8_t>(unused_size, 7), compressor(method) } });
+}
+
+section_header &find_section(std::vector<uint8_t> &model, const char *name)
+{
+    auto it = std::search(model.begin(), model.end(), name, name + strlen(name) + 1);
+    EXPECT_NE(model.end(), it);
+    return *reinterpret_cast<section_header *>(&*it);
+}
+
+uint8_t *body(section_header &header)
+{
+    return reinterpret_cast<uint8_t *>(&header + 1) + header.body_start;
+}
+
+class recording_allocator : public heap_host_allocator
+{
+public:
+    gsl::byte *allocate(size_t bytes) noexcept override
+    {
+        sizes.emplace_back(bytes);
+        return heap_host_allocator::allocate(bytes);
+    }
+
+    size_t count(size_t bytes) const noexcept
+    {
+        return std::count(sizes.begin(), sizes.end(), bytes);
+    }
+
+    std::vector<size_t> sizes;
+};
+}
+
+TEST(KModelSectionsTest, loads_compressed_sections)
+{
+    auto expected = rdata_values();
+    size_t uncompressed_size = 0;
+    for (auto method : { compression::none, compression::lz4, compression::zstd })
+    {
+        auto model = rdata_model(method);
+        if (method == compression::none)
+            uncompressed_size = model.size();
+        else
+            EXPECT_LT(model.size(), uncompressed_size / 4);
+
+        interpreter interp;
+        ASSERT_TRUE(interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).is_ok());
+        ASSERT_TRUE(interp.run().is_ok());
+        auto output = interp.output_tensor(0).unwrap_or_throw();
+        auto map = std::move(hrt::map(output, hrt::map_read).unwrap_or_throw());
+        EXPECT_EQ(0, memcmp(map.buffer().data(), expected.data(), output_count * sizeof(float)));
+    }
+}
+
+TEST(KModelSectionsTest, decompresses_only_requested_sections)
+{
+    for (auto method : { compression::none, compression::lz4, compression::zstd })
+    {
+        auto model = rdata_model(method);
+        recording_allocator allocator;
+        interpreter interp;
+        interp.allocator(allocator);
+        ASSERT_TRUE(interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).is_ok());
+
+        // uncompressed sections are used in place
+        auto decompressed = method == compression::none ? 0 : 1;
+        EXPECT_EQ(decompressed, allocator.count(rdata_count * sizeof(float)));
+        EXPECT_EQ(0, allocator.count(unused_size));
+    }
+}
+
+TEST(KModelSectionsTest, rejects_corrupt_sections)
+{
+    for (auto method : { compression::lz4, compression::zstd })
+    {
+        auto model = rdata_model(method);
+        auto &header = find_section(model, ".rdata");
+        // keep the zstd frame header, so the corruption is only found while decompressing
+        std::fill(body(header) + header.body_size / 2, body(header) + header.body_size, 0xff);
+
+        interpreter interp;
+        auto result = interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() });
+        ASSERT_TRUE(result.is_err());
+        EXPECT_EQ(nncase_errc::invalid_model_section, result.unwrap_err());
+    }
+
+    // a body that decompresses to less than uncompressed_size
+    auto model = rdata_model(compression::lz4);
+    find_section(model, ".rdata").uncompressed_size += 4;
+    interpreter interp;
+    auto result = interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() });
+    ASSERT_TRUE(result.is_err());
+    EXPECT_EQ(nncase_errc::invalid_model_section, result.unwrap_err());
+
+    // both compression flags
+    model = rdata_model(compression::none);
+    find_section(model, ".rdata").flags |= SECTION_COMPRESSED_LZ4 | SECTION_COMPRESSED_ZSTD;
+    interpreter interp2;
+    result = interp2.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() });
+    ASSERT_TRUE(result.is_err());
+    EXPECT_EQ(nncase_errc::invalid_model_section, result.unwrap_err());
+}
@@ -0,0 +1,148 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+template <class T>
+T narrow(float v);
+
+template <>
+half narrow<half>(float v) { return half::round_to_half(v); }
+
+template <>
+bfloat16 narrow<bfloat16>(float v) { return bfloat16::round_to_bfloat16(v); }
+
+template <class T>
+class LowpWeightsTest : public ::testing::Test
+{
+public:
+    std::vector<float> random(size_t count)
+    {
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        std::vector<float> values(count);
+        for (auto &v : values)
+            v = dis(gen);
+        return values;
+    }
+
+    // Low precision copy of weights, and the float values it widens back to
+    std::pair<std::vector<T>, std::vector<float>> narrow_all(const std::vector<float> &weights)
+    {
+        std::vector<T> lowp(weights.size());
+        std::vector<float> widened(weights.size());
+        for (size_t i = 0; i < weights.size(); i++)
+        {
+            lowp[i] = narrow<T>(weights[i]);
+            widened[i] = lowp[i];
+        }
+        return { lowp, widened };
+    }
+
+    // Checks the error of the low precision result against the fp32 model with the format's precision
+    void check_accuracy(const char *op, const std::vector<float> &fp32, const std::vector<float> &lowp)
+    {
+        float max_abs = 0.f, max_ref = 0.f;
+        for (size_t i = 0; i < fp32.size(); i++)
+        {
+            max_abs = std::max(max_abs, std::abs(fp32[i] - lowp[i]));
+            max_ref = std::max(max_ref, std::abs(fp32[i]));
+        }
+
+        EXPECT_LT(max_abs / max_ref, (std::is_same_v<T, half> ? 1e-3f : 1e-2f))
+            << op << " " << (std::is_same_v<T, half> ? "float16" : "bfloat16") << " weights: max abs error " << max_abs;
+    }
+
+    std::mt19937 gen { 42 };
+    kernel_context context;
+};
+
+using LowpTypes = ::testing::Types<half, bfloat16>;
+TYPED_TEST_SUITE(LowpWeightsTest, LowpTypes);
+
+TYPED_TEST(LowpWeightsTest, conv2d)
+{
+    struct conv_case
+    {
+        runtime_shape_t in_shape;
+        runtime_shape_t w_shape;
+        int32_t groups;
+        int32_t stride;
+    };
+
+    // One widened block; many blocks with a partial last one; grouped and depthwise, split on whole groups
+    for (auto &c : { conv_case { { 1, 16, 20, 20 }, { 32, 16, 3, 3 }, 1, 1 }, conv_case { { 1, 256, 10, 10 }, { 75, 256, 3, 3 }, 1, 1 },
+             conv_case { { 2, 64, 12, 12 }, { 64, 16, 3, 3 }, 4, 1 }, conv_case { { 1, 48, 9, 9 }, { 48, 1, 3, 3 }, 48, 2 } })
+    {
+        auto &in_shape = c.in_shape, &w_shape = c.w_shape;
+        const padding pad { 1, 1 };
+        const auto out_h = kernels::detail::get_windowed_output_size(in_shape[2], 3, c.stride, 1, pad);
+        const auto out_w = kernels::detail::get_windowed_output_size(in_shape[3], 3, c.stride, 1, pad);
+        const runtime_shape_t out_shape { in_shape[0], w_shape[0], out_h, out_w };
+        auto input = this->random(compute_size(in_shape));
+        auto weights = this->random(compute_size(w_shape));
+        auto bias = this->random(w_shape[0]);
+        auto [lowp, widened] = this->narrow_all(weights);
+
+        std::vector<float> output(compute_size(out_shape)), expected(output.size()), fp32(output.size());
+        ASSERT_TRUE(kernels::conv2d(input.data(), lowp.data(), bias.data(), output.data(), in_shape, get_default_strides(in_shape), w_shape,
+            get_default_strides(w_shape), { 1 }, get_default_strides(out_shape), pad, pad, c.groups, c.stride, c.stride, 1, 1, value_range<float>::full(), this->context)
+                        .is_ok());
+        ASSERT_TRUE(cpu::reference::conv2d(input.data(), widened.data(), bias.data(), expected.data(), in_shape, get_default_strides(in_shape), w_shape,
+            get_default_strides(w_shape), { 1 }, get_default_strides(out_shape), pad, pad, c.groups, c.stride, c.stride, 1, 1, value_range<float>::full(), this->context)
+                        .is_ok());
+        ASSERT_TRUE(cpu::reference::conv2d(input.data(), weights.data(), bias.data(), fp32.data(), in_shape, get_default_strides(in_shape), w_shape,
+            get_default_strides(w_shape), { 1 }, get_default_strides(out_shape), pad, pad, c.groups, c.stride, c.stride, 1, 1, value_range<float>::full(), this->context)
+                        .is_ok());
+
+        for (size_t i = 0; i < output.size(); i++)
+            ASSERT_NEAR(expected[i], output[i], 1e-4f * std::max(1.f, std::abs(expected[i]))) << "at " << i << " of " << w_shape[0] << " channels";
+        this->check_accuracy("conv2d", fp32, output);
+    }
+}
+
+TYPED_TEST(LowpWeightsTest, matmul)
+{
+    // N spans several column tiles, the second shape splits K into several widened blocks
+    for (auto [M, K, N] : { std::tuple<size_t, size_t, size_t> { 3, 70, 300 }, { 1, 1000, 129 }, { 5, 300, 200 } })
+    {
+        const runtime_shape_t a_shape { M, K }, b_shape { K, N }, out_shape { M, N };
+        auto a = this->random(M * K);
+        auto b = this->random(K * N);
+        auto bias = this->random(N);
+        auto [lowp, widened] = this->narrow_all(b);
+
+        std::vector<float> output(M * N), expected(M * N), fp32(M * N);
+        const value_range<float> act { 0.f, std::numeric_limits<float>::infinity() };
+        ASSERT_TRUE(kernels::matmul(a.data(), lowp.data(), bias.data(), output.data(), a_shape, get_default_strides(a_shape), b_shape,
+            get_default_strides(b_shape), out_shape, get_default_strides(out_shape), act, this->context)
+                        .is_ok());
+        ASSERT_TRUE(cpu::reference::matmul(a.data(), widened.data(), bias.data(), expected.data(), a_shape, get_default_strides(a_shape), b_shape,
+            get_default_strides(b_shape), out_shape, get_default_strides(out_shape), act)
+                        .is_ok());
+        ASSERT_TRUE(cpu::reference::matmul(a.data(), b.data(), bias.data(), fp32.data(), a_shape, get_default_strides(a_shape), b_shape,
+            get_default_strides(b_shape), out_shape, get_default_strides(out_shape), value_range<float>::full())
+                        .is_ok());
+
+        for (size_t i = 0; i < output.size(); i++)
+            ASSERT_NEAR(expected[i], output[i], 1e-4f * std::max(1.f, std::abs(expected[i]))) << "at " << i;
+        for (auto &v : fp32)
+            v = kernels::detail::apply_activation(v, act);
+        this->check_accuracy("matmul", fp32, output);
+    }
+}
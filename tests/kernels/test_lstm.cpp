@@ -0,0 +1,235 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+namespace
+{
+struct lstm_case
+{
+    size_t seq_length;
+    size_t batch_size;
+    size_t input_size;
+    size_t hidden_size;
+    lstm_direction direction;
+    lstm_framework framework;
+    // 1 broadcasts the initial states over the batch
+    size_t state_batch;
+    // one length per batch, empty runs every batch over the whole sequence
+    runtime_shape_t sequence_lens;
+};
+
+std::ostream &operator<<(std::ostream &os, const lstm_case &c)
+{
+    os << "seq " << c.seq_length << " batch " << c.batch_size << " input " << c.input_size << " hidden " << c.hidden_size
+       << " direction " << c.direction << " framework " << c.framework << " state batch " << c.state_batch;
+    for (auto len : c.sequence_lens)
+        os << " len " << len;
+    return os;
+}
+
+float sigmoid(float x)
+{
+    return 1.f / (1.f + std::exp(-x));
+}
+
+// One gate at a time, straight from the ONNX LSTM definition. Caffe differs in its gate order
+// [i, f, o, c], a single bias and states that start from zero. A batch past its length keeps its states and outputs zeros
+void naive_lstm(const lstm_case &c, const std::vector<float> &x, const std::vector<float> &w, const std::vector<float> &r,
+    const std::vector<float> &b, const std::vector<float> &initial_h, const std::vector<float> &initial_c,
+    std::vector<float> &y, std::vector<float> &y_h, std::vector<float> &y_c)
+{
+    const size_t directions = c.direction == kBidirectional ? 2 : 1;
+    const size_t hidden = c.hidden_size, batch = c.batch_size;
+    const bool caffe = c.framework == kCaffe;
+    const size_t gate_i = 0, gate_o = caffe ? 2 : 1, gate_f = caffe ? 1 : 2, gate_c = 3;
+    const size_t bias_stride = caffe ? 4 * hidden : 8 * hidden;
+
+    y.assign(c.seq_length * directions * batch * hidden, 0.f);
+    y_h.assign(directions * batch * hidden, 0.f);
+    y_c.assign(directions * batch * hidden, 0.f);
+    for (size_t d = 0; d < directions; d++)
+    {
+        std::vector<float> h(batch * hidden), cell(batch * hidden);
+        for (size_t n = 0; n < batch; n++)
+        {
+            for (size_t k = 0; k < hidden; k++)
+            {
+                auto src = (d * c.state_batch + (c.state_batch == 1 ? 0 : n)) * hidden + k;
+                h[n * hidden + k] = caffe ? 0.f : initial_h[src];
+                cell[n * hidden + k] = caffe ? 0.f : initial_c[src];
+            }
+        }
+
+        const bool reverse = c.direction == kReverse || d == 1;
+        for (size_t step = 0; step < c.seq_length; step++)
+        {
+            const size_t t = reverse ? c.seq_length - 1 - step : step;
+            auto next_h = h, next_c = cell;
+            for (size_t n = 0; n < batch; n++)
+            {
+                if (!c.sequence_lens.empty() && t >= c.sequence_lens[n])
+                    continue;
+                for (size_t k = 0; k < hidden; k++)
+                {
+                    float gates[4];
+                    for (size_t g = 0; g < 4; g++)
+                    {
+                        const size_t row = d * 4 * hidden + g * hidden + k;
+                        float sum = b[d * bias_stride + g * hidden + k];
+                        if (!caffe)
+                            sum += b[d * bias_stride + 4 * hidden + g * hidden + k];
+                        for (size_t i = 0; i < c.input_size; i++)
+                            sum += x[(t * batch + n) * c.input_size + i] * w[row * c.input_size + i];
+                        for (size_t j = 0; j < hidden; j++)
+                            sum += h[n * hidden + j] * r[row * hidden + j];
+                        gates[g] = sum;
+                    }
+
+                    auto i_t = sigmoid(gates[gate_i]), o_t = sigmoid(gates[gate_o]), f_t = sigmoid(gates[gate_f]);
+                    auto c_t = f_t * cell[n * hidden + k] + i_t * std::tanh(gates[gate_c]);
+                    next_c[n * hidden + k] = c_t;
+                    next_h[n * hidden + k] = o_t * std::tanh(c_t);
+                }
+            }
+
+            h = next_h;
+            cell = next_c;
+            for (size_t n = 0; n < batch; n++)
+            {
+                if (!c.sequence_lens.empty() && t >= c.sequence_lens[n])
+                    continue;
+                for (size_t k = 0; k < hidden; k++)
+                    y[((t * directions + d) * batch + n) * hidden + k] = h[n * hidden + k];
+            }
+        }
+
+        std::copy(h.begin(), h.end(), y_h.begin() + d * batch * hidden);
+        std::copy(cell.begin(), cell.end(), y_c.begin() + d * batch * hidden);
+    }
+}
+
+std::vector<float> random_values(size_t size, std::mt19937 &gen)
+{
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+    std::vector<float> values(size);
+    for (auto &v : values)
+        v = dis(gen);
+    return values;
+}
+
+void expect_near(const std::vector<float> &expected, const std::vector<float> &actual, const char *what)
+{
+    ASSERT_EQ(expected.size(), actual.size()) << what;
+    for (size_t i = 0; i < expected.size(); i++)
+        ASSERT_NEAR(expected[i], actual[i], 2e-5f) << what << " at " << i;
+}
+}
+
+class LstmTest : public ::testing::TestWithParam<lstm_case>
+{
+public:
+    void SetUp() override
+    {
+        c = GetParam();
+        directions = c.direction == kBidirectional ? 2 : 1;
+        const size_t hidden = c.hidden_size;
+        std::mt19937 gen(42);
+        x = random_values(c.seq_length * c.batch_size * c.input_size, gen);
+        w = random_values(directions * 4 * hidden * c.input_size, gen);
+        r = random_values(directions * 4 * hidden * hidden, gen);
+        b = random_values(directions * (c.framework == kCaffe ? 4 : 8) * hidden, gen);
+        initial_h = random_values(directions * c.state_batch * hidden, gen);
+        initial_c = random_values(directions * c.state_batch * hidden, gen);
+        naive_lstm(c, x, w, r, b, initial_h, initial_c, expected_y, expected_y_h, expected_y_c);
+
+        input_shape = { c.seq_length, c.batch_size, c.input_size };
+        initial_h_shape = { directions, c.state_batch, hidden };
+        w_shape = { directions, 4 * hidden, c.input_size };
+        // caffe stores a single bias without the direction axis
+        b_shape = c.framework == kCaffe ? runtime_shape_t { 4 * hidden } : runtime_shape_t { directions, 8 * hidden };
+    }
+
+    lstm_case c;
+    size_t directions;
+    std::vector<float> x, w, r, b, initial_h, initial_c;
+    std::vector<float> expected_y, expected_y_h, expected_y_c;
+    runtime_shape_t input_shape, initial_h_shape, w_shape, b_shape;
+};
+
+INSTANTIATE_TEST_SUITE_P(Lstm, LstmTest,
+    testing::Values(lstm_case { 5, 3, 7, 6, kForward, kOnnx, 3 },
+        lstm_case { 4, 2, 3, 5, kReverse, kOnnx, 2 },
+        lstm_case { 6, 2, 17, 13, kBidirectional, kOnnx, 2 },
+        lstm_case { 3, 4, 5, 3, kBidirectional, kOnnx, 1 },
+        lstm_case { 5, 3, 4, 4, kForward, kCaffe, 1 },
+        lstm_case { 4, 2, 9, 11, kForward, kCaffe, 2 },
+        lstm_case { 1, 1, 1, 1, kForward, kOnnx, 1 },
+        lstm_case { 8, 4, 64, 64, kBidirectional, kOnnx, 4 },
+        lstm_case { 5, 3, 7, 6, kForward, kOnnx, 3, { 5, 2, 1 } },
+        lstm_case { 6, 4, 3, 5, kReverse, kOnnx, 1, { 1, 6, 3, 4 } },
+        lstm_case { 7, 3, 17, 13, kBidirectional, kOnnx, 3, { 4, 7, 2 } },
+        lstm_case { 5, 2, 4, 4, kForward, kCaffe, 1, { 3, 5 } }));
+
+TEST_P(LstmTest, reference_same_as_naive)
+{
+    std::vector<float> y(expected_y.size()), y_h(expected_y_h.size()), y_c(expected_y_c.size());
+    cpu::reference::lstm(x.data(), w.data(), r.data(), b.data(), initial_h.data(), initial_c.data(), y.data(), y_h.data(), y_c.data(),
+        input_shape, initial_h_shape, w_shape, b_shape, c.sequence_lens, c.direction, c.framework)
+        .unwrap_or_throw();
+    expect_near(expected_y, y, "y");
+    expect_near(expected_y_h, y_h, "y_h");
+    expect_near(expected_y_c, y_c, "y_c");
+}
+
+TEST_P(LstmTest, optimized_same_as_naive)
+{
+    for (uint32_t threads : { 1u, 4u })
+    {
+        kernel_context context;
+        context.num_threads = threads;
+        std::vector<float> y(expected_y.size()), y_h(expected_y_h.size()), y_c(expected_y_c.size());
+        kernels::lstm(x.data(), w.data(), r.data(), b.data(), initial_h.data(), initial_c.data(), y.data(), y_h.data(), y_c.data(),
+            input_shape, initial_h_shape, w_shape, b_shape, c.sequence_lens, c.direction, c.framework, context)
+            .unwrap_or_throw();
+        SCOPED_TRACE(threads);
+        expect_near(expected_y, y, "y");
+        expect_near(expected_y_h, y_h, "y_h");
+        expect_near(expected_y_c, y_c, "y_c");
+    }
+}
+
+TEST(LstmStateTest, rejects_mismatched_state_batch)
+{
+    std::vector<float> data(1024);
+    auto p = data.data();
+    EXPECT_TRUE(kernels::lstm(p, p, p, p, p, p, p, p, p, { 2, 3, 4 }, { 1, 2, 4 }, { 1, 16, 4 }, { 1, 32 }, {}, kForward, kOnnx).is_err());
+    EXPECT_TRUE(cpu::reference::lstm(p, p, p, p, p, p, p, p, p, { 2, 3, 4 }, { 1, 2, 4 }, { 1, 16, 4 }, { 1, 32 }, {}, kForward, kOnnx).is_err());
+}
+
+TEST(LstmStateTest, rejects_bad_sequence_lens)
+{
+    std::vector<float> data(1024);
+    auto p = data.data();
+    for (runtime_shape_t lens : { runtime_shape_t { 2 }, runtime_shape_t { 2, 0 }, runtime_shape_t { 3, 1 } })
+    {
+        SCOPED_TRACE(lens.size());
+        EXPECT_TRUE(kernels::lstm(p, p, p, p, p, p, p, p, p, { 2, 2, 4 }, { 1, 2, 4 }, { 1, 16, 4 }, { 1, 32 }, lens, kForward, kOnnx).is_err());
+        EXPECT_TRUE(cpu::reference::lstm(p, p, p, p, p, p, p, p, p, { 2, 2, 4 }, { 1, 2, 4 }, { 1, 16, 4 }, { 1, 32 }, lens, kForward, kOnnx).is_err());
+    }
+}
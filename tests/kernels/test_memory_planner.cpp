@@ -0,0 +1,350 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <map>
+#include <nncase/compiler.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/runtime/k210/runtime_op_utility.h>
+#include <nncase/runtime/model.h>
+#include <nncase/runtime/span_reader.h>
+#include <nncase/schedule/buffer_allocator.h>
+#include <nncase/schedule/memory_planner.h>
+#include <sstream>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::schedule;
+
+// Synthetic KPU RAM buffers: each layer consumes its inputs and produces one feature map.
+// The graphs below borrow the layer shapes of well known networks, but they are hand built
+// here, not measured from kmodels the k210 target compiled. They only check the planners,
+// k210_example_pools measures real models
+class kpu_model
+{
+public:
+    size_t input(size_t c, size_t h, size_t w)
+    {
+        return emplace(c, h, w);
+    }
+
+    size_t layer(std::initializer_list<size_t> inputs, size_t c, size_t h, size_t w)
+    {
+        for (auto in : inputs)
+            buffers[in].end = std::max(buffers[in].end, step + 1);
+        return emplace(c, h, w);
+    }
+
+    // Chain of 3x3 layers, the spatial size halves for every stride 2 entry
+    size_t chain(size_t in, std::initializer_list<std::pair<size_t, size_t>> channels_strides)
+    {
+        for (auto [c, stride] : channels_strides)
+        {
+            h_ /= stride;
+            w_ /= stride;
+            in = layer({ in }, c, h_, w_);
+        }
+        return in;
+    }
+
+    void resolution(size_t h, size_t w)
+    {
+        h_ = h;
+        w_ = w;
+    }
+
+    std::vector<planned_buffer> buffers;
+
+private:
+    size_t emplace(size_t c, size_t h, size_t w)
+    {
+        buffers.push_back({ nncase::runtime::k210::get_kpu_bytes(w, h, c), step, step + 1 });
+        step++;
+        return buffers.size() - 1;
+    }
+
+    size_t step = 0, h_ = 0, w_ = 0;
+};
+
+kpu_model mobilenet_v1_like()
+{
+    // alpha 0.5, 128x128, depthwise and pointwise layers
+    kpu_model m;
+    m.resolution(128, 128);
+    auto x = m.input(3, 128, 128);
+    m.chain(x, { { 16, 2 }, { 16, 1 }, { 32, 1 }, { 32, 2 }, { 64, 1 }, { 64, 1 }, { 64, 1 }, { 64, 2 }, { 128, 1 }, { 128, 1 }, { 128, 1 },
+                   { 128, 2 }, { 256, 1 }, { 256, 1 }, { 256, 1 }, { 256, 1 }, { 256, 1 }, { 256, 2 }, { 512, 1 }, { 512, 1 } });
+    return m;
+}
+
+kpu_model yolov2_tiny_like()
+{
+    kpu_model m;
+    m.resolution(240, 320);
+    auto x = m.input(3, 240, 320);
+    m.chain(x, { { 16, 1 }, { 32, 2 }, { 64, 2 }, { 128, 2 }, { 256, 2 }, { 512, 2 }, { 1024, 1 }, { 512, 1 }, { 125, 1 } });
+    return m;
+}
+
+kpu_model yolov3_tiny_like()
+{
+    // the stride 16 features wait for the upsampled stride 32 branch
+    kpu_model m;
+    m.resolution(256, 320);
+    auto x = m.input(3, 256, 320);
+    auto route = m.chain(x, { { 16, 1 }, { 32, 2 }, { 64, 2 }, { 128, 2 }, { 256, 2 } });
+    auto head = m.chain(route, { { 512, 2 }, { 1024, 1 }, { 256, 1 } });
+    m.layer({ head }, 255, 8, 10);
+    auto up = m.layer({ head }, 128, 8, 10);
+    up = m.layer({ up }, 128, 16, 20);
+    auto cat = m.layer({ up, route }, 384, 16, 20);
+    m.resolution(16, 20);
+    m.chain(cat, { { 256, 1 }, { 255, 1 } });
+    return m;
+}
+
+kpu_model unet_like()
+{
+    // every encoder level stays alive until its decoder level
+    kpu_model m;
+    m.resolution(128, 128);
+    auto x = m.input(3, 128, 128);
+    std::vector<size_t> skips;
+    size_t channels = 8;
+    for (size_t level = 0; level < 4; level++)
+    {
+        x = m.chain(x, { { channels, level ? 2 : 1 }, { channels, 1 } });
+        skips.emplace_back(x);
+        channels *= 2;
+    }
+
+    for (size_t level = 3; level-- > 0;)
+    {
+        channels /= 2;
+        size_t size = 128 >> level;
+        x = m.layer({ x }, channels, size, size);
+        x = m.layer({ x, skips[level] }, channels * 2, size, size);
+        m.resolution(size, size);
+        x = m.chain(x, { { channels, 1 } });
+    }
+    m.layer({ x }, 2, 128, 128);
+    return m;
+}
+
+bool is_valid_plan(const std::vector<planned_buffer> &buffers)
+{
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        for (size_t j = i + 1; j < buffers.size(); j++)
+        {
+            auto &a = buffers[i], &b = buffers[j];
+            if (a.overlaps(b) && a.start < b.start + b.size && b.start < a.start + a.size)
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST(MemoryPlannerTest, synthetic_kpu_ram_usage)
+{
+    const std::pair<const char *, kpu_model> models[] = {
+        { "mobilenet_v1", mobilenet_v1_like() },
+        { "yolov2_tiny", yolov2_tiny_like() },
+        { "yolov3_tiny", yolov3_tiny_like() },
+        { "unet", unet_like() },
+    };
+
+    size_t total_first_fit = 0, total_planned = 0;
+    for (auto &[name, model] : models)
+    {
+        auto first_fit = model.buffers, by_size = model.buffers;
+        auto first_fit_usage = plan_first_fit(first_fit);
+        auto by_size_usage = plan_greedy_by_size(by_size);
+        EXPECT_TRUE(is_valid_plan(first_fit)) << name;
+        EXPECT_TRUE(is_valid_plan(by_size)) << name;
+
+        // the allocator keeps the better of the two
+        auto planned = std::min(first_fit_usage, by_size_usage);
+        total_first_fit += first_fit_usage;
+        total_planned += planned;
+    }
+
+    EXPECT_LT(total_planned, total_first_fit);
+}
+
+std::string read_file(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+// Compiles a model for k210 with its post quantization dataset, returns the kmodel
+std::string compile_k210(const std::filesystem::path &model, const std::filesystem::path &dataset, const std::string &placement)
+{
+    compile_options options {};
+    options.target = "k210";
+    options.memory_placement = placement;
+    auto compiler = nncase::compiler::create(options);
+
+    auto content = read_file(model);
+    std::span<const uint8_t> buffer(reinterpret_cast<const uint8_t *>(content.data()), content.size());
+    import_options import {};
+    if (model.extension() == ".tflite")
+        compiler->import_tflite(buffer, import);
+    else
+        compiler->import_onnx(buffer, import);
+
+    ptq_dataset_options ptq;
+    ptq.dataset = dataset;
+    ptq.dataset_format = "image";
+    compiler->use_ptq(ptq);
+    compiler->compile();
+
+    std::stringstream kmodel;
+    compiler->gencode(kmodel);
+    return kmodel.str();
+}
+
+// Pool sizes of a kmodel by memory location, summed over its modules
+std::map<memory_location_t, size_t> read_mempools(const std::string &kmodel)
+{
+    span_reader reader(gsl::make_span(reinterpret_cast<const gsl::byte *>(kmodel.data()), kmodel.size()));
+    model_header header;
+    reader.read(header);
+    if (header.flags & MODEL_HAS_ENTRY_VARIANTS)
+        reader.skip(reader.read<uint32_t>() * sizeof(uint32_t));
+
+    std::map<memory_location_t, size_t> pools;
+    for (uint32_t i = 0; i < header.modules; i++)
+    {
+        span_reader module_reader(reader.read_span(reader.peek_with_offset<uint32_t>(offsetof(module_header, size))));
+        module_header module;
+        module_reader.read(module);
+        for (uint32_t j = 0; j < module.mempools; j++)
+        {
+            mempool_desc desc;
+            module_reader.read(desc);
+            pools[desc.location] += desc.size;
+        }
+    }
+    return pools;
+}
+
+TEST(MemoryPlannerTest, k210_example_pools)
+{
+    // The K210 examples, compiled by the k210 target plugin with first fit placement and with the planner
+    const std::filesystem::path examples = NNCASE_EXAMPLES_DIR;
+    const std::tuple<const char *, std::filesystem::path, std::filesystem::path> models[] = {
+        { "ulffd_landmark", examples / "facedetect_landmark/model/ulffd_landmark.tflite", examples / "facedetect_landmark/images" },
+        { "yolox_nano_224", examples / "yolox/model/yolox_nano_224.onnx", examples / "20classes_yolo/images" },
+    };
+
+    try
+    {
+        compile_options options {};
+        options.target = "k210";
+        nncase::compiler::create(options);
+    }
+    catch (std::exception &ex)
+    {
+        GTEST_SKIP() << "k210 target is not available: " << ex.what();
+    }
+
+    std::printf("%-16s %-10s %12s %12s %8s\n", "model", "pool", "first fit", "planned", "saved");
+    for (auto &[name, model, dataset] : models)
+    {
+        ASSERT_TRUE(std::filesystem::exists(model)) << model;
+        auto first_fit = read_mempools(compile_k210(model, dataset, "first_fit"));
+        auto planned = read_mempools(compile_k210(model, dataset, "best"));
+        ASSERT_EQ(first_fit.size(), planned.size()) << name;
+        for (auto [location, first_fit_size] : first_fit)
+        {
+            auto planned_size = planned.at(location);
+            std::printf("%-16s %-10d %12zu %12zu %7.1f%%\n", name, (int)location, first_fit_size, planned_size,
+                first_fit_size ? 100.0 * ((double)first_fit_size - (double)planned_size) / first_fit_size : 0.0);
+            // only the lifetime aware pools change, and never for the worse
+            EXPECT_LE(planned_size, first_fit_size) << name << " pool " << (int)location;
+        }
+    }
+}
+
+TEST(MemoryPlannerTest, first_fit_reuses_freed_gaps)
+{
+    // a dies before c is born, so c takes its place
+    std::vector<planned_buffer> buffers {
+        { 64, 0, 2 },
+        { 128, 1, 4 },
+        { 64, 2, 4 },
+    };
+    EXPECT_EQ(192, plan_first_fit(buffers));
+    EXPECT_EQ(0, buffers[2].start);
+}
+
+TEST(MemoryPlannerTest, greedy_by_size_avoids_fragmentation)
+{
+    // in birth order the hole a leaves below the long lived b is too small for the later buffers
+    std::vector<planned_buffer> buffers {
+        { 64, 0, 2 },
+        { 64, 1, 6 },
+        { 256, 3, 5 },
+        { 128, 2, 4 },
+    };
+    auto first_fit = buffers;
+    EXPECT_EQ(512, plan_first_fit(first_fit));
+    EXPECT_EQ(448, plan_greedy_by_size(buffers));
+    EXPECT_TRUE(is_valid_plan(buffers));
+}
+
+TEST(MemoryPlannerTest, identical_constants_share_rdata)
+{
+    ir::graph graph;
+    std::deque<logical_buffer> logical;
+    std::deque<physical_buffer> physical;
+    auto add_constant = [&](const std::vector<float> &data, size_t alignment) -> physical_buffer & {
+        auto con = graph.emplace<ir::constant>(dt_float32, ir::shape_t { data.size() }, data);
+        auto &buffer = physical.emplace_back(physical.size(), logical.emplace_back(logical.size(), con->output(), mem_rdata));
+        buffer.alignment(alignment);
+        return buffer;
+    };
+
+    const std::vector<float> ones(2, 1.f), zeros(16, 0.f);
+    auto &a = add_constant(ones, 8);
+    auto &b = add_constant(zeros, 8);
+    auto &c = add_constant(zeros, 8);
+    // b's offset does not meet the alignment, so the first 64 aligned copy gets its own place
+    auto &d = add_constant(zeros, 64);
+    auto &e = add_constant(zeros, 64);
+
+    constant_buffer_allocator allocator;
+    allocator.base_offset(0);
+    for (auto &buffer : physical)
+        allocator.mark(buffer);
+    allocator.finish();
+
+    auto &allocs = allocator.allocations();
+    EXPECT_EQ(0, allocs.at(&a).start);
+    EXPECT_EQ(8, allocs.at(&b).start);
+    EXPECT_EQ(8, allocs.at(&c).start);
+    EXPECT_EQ(128, allocs.at(&d).start);
+    EXPECT_EQ(128, allocs.at(&e).start);
+    EXPECT_EQ(192, allocator.max_usage());
+    EXPECT_EQ(128, allocator.deduplicated_bytes());
+}
@@ -0,0 +1,174 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/cpu/reference/reduce_window.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/reduce_window.h>
+#include <nncase/kernels/tensor_compute.h>
+
+// NHWC tensors are passed as NCHW shapes with permuted strides
+runtime_shape_t nhwc_strides(const runtime_shape_t &shape)
+{
+    return { shape[1] * shape[2] * shape[3], 1, shape[3] * shape[1], shape[1] };
+}
+
+// HWIO weights for a [out_channels, in_channels / groups, filter_h, filter_w] shape
+runtime_shape_t hwio_strides(const runtime_shape_t &w_shape)
+{
+    return { 1, w_shape[0], w_shape[3] * w_shape[1] * w_shape[0], w_shape[1] * w_shape[0] };
+}
+
+template <class T>
+std::vector<T> random_data(size_t size, float min, float max)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(min, max);
+    std::vector<T> data(size);
+    for (auto &v : data)
+        v = (T)dis(gen);
+    return data;
+}
+
+struct conv_case
+{
+    runtime_shape_t in_shape;
+    runtime_shape_t w_shape;
+    int32_t groups;
+    int32_t stride;
+    int32_t dilation;
+    padding pad;
+};
+
+class Conv2DNHWCTest : public ::testing::TestWithParam<std::tuple<conv_case, uint32_t>>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(NHWC, Conv2DNHWCTest,
+    testing::Combine(testing::Values(
+                         // depthwise
+                         conv_case { { 1, 16, 19, 23 }, { 16, 1, 3, 3 }, 16, 1, 1, { 1, 1 } },
+                         conv_case { { 2, 8, 20, 20 }, { 8, 1, 5, 5 }, 8, 2, 1, { 2, 1 } },
+                         // pointwise
+                         conv_case { { 1, 12, 9, 7 }, { 20, 12, 1, 1 }, 1, 1, 1, { 0, 0 } },
+                         // general, grouped and dilated
+                         conv_case { { 1, 6, 17, 13 }, { 10, 6, 3, 3 }, 1, 2, 1, { 1, 1 } },
+                         conv_case { { 1, 8, 15, 15 }, { 12, 2, 3, 3 }, 4, 1, 1, { 1, 1 } },
+                         conv_case { { 1, 4, 16, 16 }, { 4, 4, 3, 3 }, 1, 1, 2, { 2, 2 } }),
+        testing::Values(1u, 4u)));
+
+TEST_P(Conv2DNHWCTest, same_as_reference)
+{
+    auto &&[c, threads] = GetParam();
+    kernel_context context;
+    context.num_threads = threads;
+
+    const runtime_shape_t out_shape { c.in_shape[0], c.w_shape[0],
+        kernels::detail::get_windowed_output_size(c.in_shape[2], (int32_t)c.w_shape[2], c.stride, c.dilation, c.pad),
+        kernels::detail::get_windowed_output_size(c.in_shape[3], (int32_t)c.w_shape[3], c.stride, c.dilation, c.pad) };
+    const auto in_strides = nhwc_strides(c.in_shape), w_strides = hwio_strides(c.w_shape), out_strides = nhwc_strides(out_shape);
+    auto input = random_data<float>(compute_size(c.in_shape), -1.f, 1.f);
+    auto weights = random_data<float>(compute_size(c.w_shape), -1.f, 1.f);
+    auto bias = random_data<float>(c.w_shape[0], -1.f, 1.f);
+    std::vector<float> expected(compute_size(out_shape)), output(compute_size(out_shape), NAN);
+
+    const value_range<float> act { -1.f, 2.f };
+    cpu::reference::conv2d(input.data(), weights.data(), bias.data(), expected.data(), c.in_shape, in_strides, c.w_shape, w_strides, { 1 },
+        out_strides, c.pad, c.pad, c.groups, c.stride, c.stride, c.dilation, c.dilation, act, context)
+        .unwrap_or_throw();
+    ASSERT_TRUE(kernels::conv2d(input.data(), weights.data(), bias.data(), output.data(), c.in_shape, in_strides, c.w_shape, w_strides, { 1 },
+        out_strides, c.pad, c.pad, c.groups, c.stride, c.stride, c.dilation, c.dilation, act, context)
+                    .is_ok());
+
+    for (size_t i = 0; i < output.size(); i++)
+        ASSERT_NEAR(expected[i], output[i], 1e-5f * std::max(1.f, std::abs(expected[i]))) << "at " << i;
+}
+
+TEST(ReduceWindow2DNHWCTest, same_as_reference)
+{
+    const runtime_shape_t in_shape { 2, 24, 13, 11 };
+    const auto in_strides = nhwc_strides(in_shape);
+    auto input = random_data<float>(compute_size(in_shape), -1.f, 1.f);
+
+    for (auto op : { reduce_mean, reduce_max, reduce_min, reduce_sum })
+    {
+        for (int32_t filter : { 2, 3 })
+        {
+            const padding pad { 1, 1 };
+            const int32_t stride = 2;
+            const runtime_shape_t out_shape { in_shape[0], in_shape[1],
+                kernels::detail::get_windowed_output_size(in_shape[2], filter, stride, 1, pad),
+                kernels::detail::get_windowed_output_size(in_shape[3], filter, stride, 1, pad) };
+            const auto out_strides = nhwc_strides(out_shape);
+            const auto init = op == reduce_max ? std::numeric_limits<float>::lowest() : op == reduce_min ? std::numeric_limits<float>::max() : 0.f;
+            std::vector<float> expected(compute_size(out_shape)), output(compute_size(out_shape), NAN);
+
+            cpu::reference::reduce_window2d(op, input.data(), init, expected.data(), in_shape, in_strides, out_strides, pad, pad,
+                filter, filter, stride, stride, 1, 1, value_range<float>::full(), default_kernel_context())
+                .unwrap_or_throw();
+            ASSERT_TRUE(kernels::reduce_window2d(op, input.data(), init, output.data(), in_shape, in_strides, out_strides, pad, pad,
+                filter, filter, stride, stride, 1, 1, value_range<float>::full())
+                            .is_ok());
+
+            for (size_t i = 0; i < output.size(); i++)
+                ASSERT_NEAR(expected[i], output[i], 1e-6f) << "op " << op << " filter " << filter << " at " << i;
+        }
+    }
+}
+
+template <class T>
+void test_resize(datatype_t type, float min, float max)
+{
+    const runtime_shape_t in_shape { 1, 5, 7, 9 };
+    const auto in_strides = nhwc_strides(in_shape);
+    auto input = random_data<T>(compute_size(in_shape), min, max);
+
+    for (auto [out_h, out_w] : { std::pair { 13, 4 }, std::pair { 3, 18 } })
+    {
+        for (auto [align_corners, half_pixel_centers] : { std::pair { false, false }, std::pair { true, false }, std::pair { false, true } })
+        {
+            const runtime_shape_t out_shape { in_shape[0], in_shape[1], (size_t)out_h, (size_t)out_w };
+            const auto out_strides = nhwc_strides(out_shape);
+            std::vector<T> expected(compute_size(out_shape)), output(compute_size(out_shape));
+            auto in = reinterpret_cast<const gsl::byte *>(input.data());
+
+            cpu::reference::resize_bilinear(type, in, reinterpret_cast<gsl::byte *>(expected.data()), in_shape, in_strides, out_strides,
+                out_h, out_w, align_corners, half_pixel_centers, default_kernel_context())
+                .unwrap_or_throw();
+            ASSERT_TRUE(kernels::resize_bilinear(type, in, reinterpret_cast<gsl::byte *>(output.data()), in_shape, in_strides, out_strides,
+                out_h, out_w, align_corners, half_pixel_centers)
+                            .is_ok());
+            // uint8 is blended in fixed point, so it may round the other way
+            for (size_t i = 0; i < output.size(); i++)
+                ASSERT_NEAR((float)expected[i], (float)output[i], (std::is_integral_v<T> ? 1.f : 0.f)) << "at " << i;
+
+            cpu::reference::resize_nearest_neighbor(type, in, reinterpret_cast<gsl::byte *>(expected.data()), in_shape, in_strides, out_strides,
+                out_h, out_w, align_corners, half_pixel_centers, default_kernel_context())
+                .unwrap_or_throw();
+            ASSERT_TRUE(kernels::resize_nearest_neighbor(type, in, reinterpret_cast<gsl::byte *>(output.data()), in_shape, in_strides, out_strides,
+                out_h, out_w, align_corners, half_pixel_centers)
+                            .is_ok());
+            EXPECT_EQ(expected, output);
+        }
+    }
+}
+
+TEST(ResizeNHWCTest, same_as_reference)
+{
+    test_resize<float>(dt_float32, -1.f, 1.f);
+    test_resize<uint8_t>(dt_uint8, 0.f, 255.f);
+}
@@ -0,0 +1,196 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/nnil.h>
+#include <nncase/kernels/nnil.h>
+#include <nncase/runtime/nnil.h>
+
+class nnil_program
+{
+public:
+    nnil_program &op(nnil_opcode_t opcode)
+    {
+        body_.push_back((uint8_t)opcode);
+        return *this;
+    }
+
+    nnil_program &lda(uint8_t index)
+    {
+        op(nnil_lda);
+        body_.push_back(index);
+        return *this;
+    }
+
+    nnil_program &ldc(float value)
+    {
+        op(nnil_ldc_r4);
+        auto p = reinterpret_cast<const uint8_t *>(&value);
+        body_.insert(body_.end(), p, p + sizeof(value));
+        return *this;
+    }
+
+    gsl::span<const gsl::byte> body() const noexcept
+    {
+        return { reinterpret_cast<const gsl::byte *>(body_.data()), body_.size() };
+    }
+
+private:
+    std::vector<uint8_t> body_;
+};
+
+std::map<std::string, nnil_program> programs()
+{
+    std::map<std::string, nnil_program> p;
+    // x * clamp(x + 3, 0, 6) / 6
+    p["hswish"].op(nnil_lda_0).op(nnil_lda_0).ldc(3.f).op(nnil_add).op(nnil_ldc_r4_0).ldc(6.f).op(nnil_clamp).op(nnil_mul).ldc(6.f).op(nnil_div).op(nnil_ret);
+    // 0.5 * x * (1 + erf(x / sqrt(2)))
+    p["gelu"].op(nnil_lda_0).ldc(0.5f).op(nnil_mul).op(nnil_lda_0).ldc(1.41421356f).op(nnil_div).op(nnil_erf).op(nnil_ldc_r4_1).op(nnil_add).op(nnil_mul).op(nnil_ret);
+    // x * tanh(log(1 + exp(x)))
+    p["mish"].op(nnil_lda_0).op(nnil_lda_0).op(nnil_exp).op(nnil_ldc_r4_1).op(nnil_add).op(nnil_log).op(nnil_tanh).op(nnil_mul).op(nnil_ret);
+    // every other instruction, with non-constant operands
+    auto &all = p["all"];
+    all.op(nnil_lda_0).op(nnil_dup).op(nnil_abs).op(nnil_sqrt).op(nnil_rsqrt).op(nnil_add);
+    all.op(nnil_dup).op(nnil_sin).op(nnil_cos).op(nnil_acos).op(nnil_sub);
+    all.op(nnil_dup).op(nnil_tanh).op(nnil_asin).op(nnil_square).op(nnil_mul);
+    all.op(nnil_dup).op(nnil_ceil).op(nnil_floor).op(nnil_round).op(nnil_neg).op(nnil_sign).op(nnil_max);
+    all.op(nnil_lda_0).op(nnil_logical_not).op(nnil_min);
+    all.op(nnil_lda_0).op(nnil_abs).op(nnil_log).op(nnil_exp).op(nnil_pow);
+    all.op(nnil_lda_0).op(nnil_neg).op(nnil_lda_0).op(nnil_clamp).op(nnil_nop);
+    all.op(nnil_lda_0).op(nnil_pop).op(nnil_ldc_r4_1).op(nnil_add).op(nnil_ret);
+    return p;
+}
+
+class NnilTest : public ::testing::TestWithParam<std::string>
+{
+public:
+    void SetUp() override
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dis(-8.f, 8.f);
+        input.resize(100003);
+        for (auto &v : input)
+            v = dis(gen);
+        input[0] = 0.f;
+        input[1] = -0.f;
+        input[2] = 3.f;
+        output_ref.resize(input.size());
+        output_opt.resize(input.size());
+    }
+
+    std::vector<float> input, output_ref, output_opt;
+};
+
+INSTANTIATE_TEST_SUITE_P(Nnil, NnilTest, testing::Values("hswish", "gelu", "mish", "all"));
+
+TEST_P(NnilTest, bit_exact)
+{
+    auto program = programs().at(GetParam());
+    auto body = program.body();
+
+    ASSERT_TRUE(cpu::reference::nnil_unary_method(input.data(), output_ref.data(), input.size(), body, default_kernel_context()).is_ok());
+    ASSERT_TRUE(kernels::nnil_unary_method(input.data(), output_opt.data(), input.size(), body).is_ok());
+
+    // bit exact, NaNs included
+    for (size_t i = 0; i < input.size(); i++)
+        ASSERT_EQ(0, memcmp(&output_ref[i], &output_opt[i], sizeof(float))) << "at " << i << " of " << input[i] << ": " << output_ref[i] << " vs " << output_opt[i];
+}
+
+TEST(NnilTest, illegal_instruction)
+{
+    nnil_program underflow;
+    underflow.op(nnil_add).op(nnil_ret);
+    float in = 1.f, out = 0.f;
+    ASSERT_TRUE(kernels::nnil_unary_method(&in, &out, 1, underflow.body()).is_err());
+
+    nnil_program bitwise_not;
+    bitwise_not.op(nnil_lda_0).op(nnil_bitwise_not).op(nnil_ret);
+    ASSERT_TRUE(kernels::nnil_unary_method(&in, &out, 1, bitwise_not.body()).is_err());
+}
+
+struct elementwise_case
+{
+    runtime_shape_t out_shape;
+    std::vector<runtime_shape_t> in_shapes;
+    // pads the innermost dimension of the output, to test strided stores
+    size_t out_pad;
+};
+
+class NnilElementwiseTest : public ::testing::TestWithParam<std::tuple<elementwise_case, uint32_t>>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(NnilElementwise, NnilElementwiseTest,
+    testing::Combine(testing::Values(
+                         // residual add, per channel scale, scalar
+                         elementwise_case { { 1, 16, 33, 65 }, { { 1, 16, 33, 65 }, { 16, 1, 1 }, { 1 } }, 0 },
+                         // broadcast on both sides, strided output
+                         elementwise_case { { 2, 7, 5, 129 }, { { 2, 1, 5, 129 }, { 7, 1, 1 }, { 1, 1, 1, 129 } }, 3 },
+                         // innermost broadcast
+                         elementwise_case { { 3, 4, 50, 1 }, { { 3, 4, 50, 1 }, { 1, 4, 1, 1 }, { 50, 1 } }, 0 },
+                         // scalar output
+                         elementwise_case { { 1 }, { { 1 }, { 1 }, { 1 } }, 0 }),
+        testing::Values(1u, 4u)));
+
+TEST_P(NnilElementwiseTest, same_as_reference)
+{
+    auto &&[c, threads] = GetParam();
+    kernel_context context;
+    context.num_threads = threads;
+
+    // clamp((a + b) * c, 0, 6) - a
+    nnil_program program;
+    program.lda(0).op(nnil_lda_0).lda(1).op(nnil_add).lda(2).op(nnil_mul).op(nnil_ldc_r4_0).ldc(6.f).op(nnil_clamp).op(nnil_sub).op(nnil_neg).op(nnil_ret);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-4.f, 4.f);
+    std::vector<std::vector<float>> inputs;
+    std::vector<const float *> input_ptrs;
+    std::vector<runtime_shape_t> in_strides;
+    for (auto &shape : c.in_shapes)
+    {
+        inputs.emplace_back(compute_size(shape));
+        for (auto &v : inputs.back())
+            v = dis(gen);
+        input_ptrs.emplace_back(inputs.back().data());
+        in_strides.emplace_back(get_default_strides(shape));
+    }
+
+    auto padded_shape = c.out_shape;
+    padded_shape.back() += c.out_pad;
+    auto out_strides = get_default_strides(padded_shape);
+    std::vector<float> output_ref(compute_size(padded_shape), 0.f), output_opt(output_ref.size(), 0.f);
+
+    ASSERT_TRUE(cpu::reference::nnil_elementwise(input_ptrs, c.in_shapes, in_strides, output_ref.data(), c.out_shape, out_strides, program.body(), context).is_ok());
+    ASSERT_TRUE(kernels::nnil_elementwise(input_ptrs, c.in_shapes, in_strides, output_opt.data(), c.out_shape, out_strides, program.body(), context).is_ok());
+    ASSERT_EQ(0, memcmp(output_ref.data(), output_opt.data(), output_ref.size() * sizeof(float)));
+}
+
+TEST(NnilElementwiseTest, invalid_arguments)
+{
+    float a = 1.f, out = 0.f;
+    const float *inputs[] = { &a };
+    runtime_shape_t shapes[] = { { 1 } }, strides[] = { { 1 } };
+
+    nnil_program lda_out_of_range;
+    lda_out_of_range.lda(1).op(nnil_ret);
+    ASSERT_TRUE(kernels::nnil_elementwise(inputs, shapes, strides, &out, { 1 }, { 1 }, lda_out_of_range.body()).is_err());
+
+    nnil_program identity;
+    identity.lda(0).op(nnil_ret);
+    runtime_shape_t bad_shapes[] = { { 2 } };
+    ASSERT_TRUE(kernels::nnil_elementwise(inputs, bad_shapes, strides, &out, { 3 }, { 1 }, identity.body()).is_err());
+}
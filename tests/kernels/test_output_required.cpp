@@ -0,0 +1,156 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kmodel_util.h"
+#include <gtest/gtest.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace kmodel_util;
+
+namespace
+{
+constexpr int32_t count = 256;
+constexpr float untouched = -1.f;
+
+// output 0 = input through data, output 1 = input, each only computed when required
+std::vector<uint8_t> two_outputs_model()
+{
+    text_builder text;
+    text.br_unused(1, [&] {
+        copy_floats(text, mem_input, mem_data, count);
+        copy_floats(text, mem_data, mem_output, count);
+    });
+    text.br_unused(2, [&] {
+        text.lea_buffer(mem_input, 0);
+        text.lea_buffer(mem_output, count * 4);
+        text.stshape(0, { count });
+        text.stshape(1, { 1 });
+        text.stshape(2, { 1 });
+        text.tensor_copy(dt_float32, 0, 1, 2);
+    });
+
+    function_def func;
+    func.inputs.push_back({ memory_range { mem_input, dt_float32, 0, 0, count * 4 }, { count } });
+    func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, 0, count * 4 }, { count } });
+    func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, count * 4, count * 4 }, { count } });
+    func.text = text.writer.data;
+
+    mempool_desc data {};
+    data.location = mem_data;
+    data.size = count * 4;
+    return build_kmodel({ data }, { func });
+}
+
+runtime_tensor filled(float value)
+{
+    auto tensor = hrt::create(dt_float32, { count }).unwrap_or_throw();
+    auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+    auto p = reinterpret_cast<float *>(map.buffer().data());
+    for (int32_t i = 0; i < count; i++)
+        p[i] = value + (float)i;
+    return tensor;
+}
+
+float value_at(runtime_tensor &tensor, size_t index)
+{
+    auto map = std::move(hrt::map(tensor, hrt::map_read).unwrap_or_throw());
+    return reinterpret_cast<const float *>(map.buffer().data())[index];
+}
+}
+
+class OutputRequiredTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        model = two_outputs_model();
+        interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+        interp.input_tensor(0, filled(0.f)).unwrap_or_throw();
+    }
+
+    std::vector<uint8_t> model;
+    interpreter interp;
+};
+
+TEST_F(OutputRequiredTest, run_leaves_unrequired_outputs)
+{
+    for (size_t skipped : { 0, 1 })
+    {
+        auto outputs = std::vector { filled(untouched), filled(untouched) };
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            interp.output_tensor(i, outputs[i]).unwrap_or_throw();
+            interp.output_required(i, i != skipped).unwrap_or_throw();
+        }
+
+        interp.run().unwrap_or_throw();
+        EXPECT_EQ(untouched + count - 1, value_at(outputs[skipped], count - 1));
+        EXPECT_EQ(count - 1, value_at(outputs[1 - skipped], count - 1));
+    }
+
+    EXPECT_TRUE(interp.output_required(2, false).is_err());
+}
+
+TEST_F(OutputRequiredTest, run_async_leaves_unrequired_outputs)
+{
+    interp.output_required(0, false).unwrap_or_throw();
+    auto outputs = std::vector { filled(untouched), filled(untouched) };
+    bool done = false;
+    interp.run_async({ filled(0.f) }, outputs, [&](result<void> status) {
+              EXPECT_TRUE(status.is_ok());
+              done = true;
+          })
+        .unwrap_or_throw();
+
+    // an output that is not required needs no tensor
+    interp.run_async({ filled(0.f) }, { runtime_tensor(), filled(untouched) }, {}).unwrap_or_throw();
+    interp.wait_async_idle();
+
+    EXPECT_TRUE(done);
+    EXPECT_EQ(untouched + count - 1, value_at(outputs[0], count - 1));
+    EXPECT_EQ(count - 1, value_at(outputs[1], count - 1));
+}
+
+TEST(OutputRequiredBranchTest, br_unused_skips_body)
+{
+    // output 0 is the input, computing output 1 fails, so a run only succeeds when it is skipped
+    text_builder text;
+    copy_floats(text, mem_input, mem_output, count);
+    text.br_unused(2, [&] { text.throw_(); });
+
+    function_def func;
+    func.inputs.push_back({ memory_range { mem_input, dt_float32, 0, 0, count * 4 }, { count } });
+    func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, 0, count * 4 }, { count } });
+    func.outputs.push_back({ memory_range { mem_output, dt_float32, 0, count * 4, count * 4 }, { count } });
+    func.text = text.writer.data;
+    auto model = build_kmodel({}, { func });
+
+    interpreter interp;
+    interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+    interp.input_tensor(0, filled(0.f)).unwrap_or_throw();
+    EXPECT_TRUE(interp.run().is_err());
+
+    interp.output_required(1, false).unwrap_or_throw();
+    interp.run().unwrap_or_throw();
+    auto output = interp.output_tensor(0).unwrap_or_throw();
+    EXPECT_EQ(count - 1, value_at(output, count - 1));
+
+    // output 0 does not guard the branch
+    interp.output_required(1, true).unwrap_or_throw();
+    interp.output_required(0, false).unwrap_or_throw();
+    EXPECT_TRUE(interp.run().is_err());
+}
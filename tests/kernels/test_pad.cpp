@@ -0,0 +1,100 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/runtime_tensor.h>
+
+class PadTest : public ::testing::TestWithParam<
+                    std::tuple<
+                        runtime_shape_t, // input shape
+                        runtime_paddings_t, // paddings
+                        runtime_shape_t, // in strides bias
+                        pad_mode_t>>
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, paddings, in_strides_bias, mode] = GetParam();
+        input = create_input_tensor(in_shape, in_strides_bias);
+        runtime_shape_t out_shape(in_shape.size());
+        for (size_t i = 0; i < in_shape.size(); i++)
+            out_shape[i] = (size_t)((int32_t)in_shape[i] + paddings[i].sum());
+        output_ref = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+        output_opt = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 1));
+        this->paddings = paddings;
+        this->mode = mode;
+    }
+
+    runtime_tensor input, output_ref, output_opt;
+    runtime_paddings_t paddings;
+    pad_mode_t mode;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Pad,
+    PadTest,
+    testing::Combine(
+        testing::Values(runtime_shape_t { 2, 3, 5, 7 }),
+        testing::Values(
+            runtime_paddings_t { { 0, 0 }, { 0, 0 }, { 1, 2 }, { 3, 1 } },
+            runtime_paddings_t { { 1, 0 }, { 0, 2 }, { 0, 0 }, { 0, 0 } },
+            runtime_paddings_t { { 0, 0 }, { 2, 1 }, { 0, 0 }, { 2, 2 } },
+            runtime_paddings_t { { 0, 0 }, { 0, 0 }, { -1, 2 }, { 1, -2 } }),
+        testing::Values(runtime_shape_t { 0, 0, 0, 0 }, runtime_shape_t { 0, 1, 2, 3 }),
+        testing::Values(pad_constant, pad_reflect, pad_symmetric, pad_edge)));
+
+INSTANTIATE_TEST_SUITE_P(
+    PadDims5,
+    PadTest,
+    testing::Combine(
+        testing::Values(runtime_shape_t { 2, 3, 4, 5, 6 }),
+        testing::Values(
+            runtime_paddings_t { { 0, 0 }, { 1, 1 }, { 0, 0 }, { 0, 0 }, { 2, 1 } },
+            runtime_paddings_t { { 1, 1 }, { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } }),
+        testing::Values(runtime_shape_t { 0, 0, 0, 0, 0 }),
+        testing::Values(pad_constant, pad_reflect)));
+
+TEST_P(PadTest, same_as_reference)
+{
+    scalar pad_value(-1.5f);
+    auto in_map = hrt::map(input, hrt::map_read).unwrap_or_throw();
+    auto in = in_map.buffer().cbegin();
+    cpu::reference::pad(dt_float32, in, get_tensor_begin(output_ref), input.shape(), input.strides(), output_ref.strides(), paddings, mode, pad_value,
+        default_kernel_context())
+        .unwrap_or_throw();
+    ASSERT_TRUE(kernels::pad(dt_float32, in, get_tensor_begin(output_opt), input.shape(), input.strides(), output_opt.strides(), paddings, mode, pad_value)
+                    .is_ok());
+    EXPECT_TRUE(is_same_tensor(output_ref, output_opt));
+}
+
+TEST(BroadcastTest, same_as_reference)
+{
+    const runtime_shape_t out_shape { 2, 3, 4, 5, 6 };
+    for (auto in_shape : { runtime_shape_t { 3, 1, 1, 1 }, runtime_shape_t { 2, 1, 4, 1, 6 }, runtime_shape_t { 1 }, runtime_shape_t { 5, 1 } })
+    {
+        auto input = create_input_tensor(in_shape, runtime_shape_t(in_shape.size(), 0));
+        auto output_ref = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+        auto output_opt = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+        cpu::reference::broadcast(dt_float32, get_tensor_cbegin(input), get_tensor_begin(output_ref), in_shape, input.strides(), out_shape,
+            output_ref.strides(), default_kernel_context())
+            .unwrap_or_throw();
+        ASSERT_TRUE(kernels::broadcast(dt_float32, get_tensor_cbegin(input), get_tensor_begin(output_opt), in_shape, input.strides(), out_shape,
+            output_opt.strides())
+                        .is_ok());
+        EXPECT_TRUE(is_same_tensor(output_ref, output_opt));
+    }
+}
@@ -0,0 +1,148 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+namespace
+{
+// Values the vector paths have to round, saturate or pass through like the scalar code
+const float special_values[] = {
+    0.f, -0.f, 0.5f, -0.5f, 1.5f, 2.5f, -2.5f, 127.5f, 128.5f, 255.5f, -128.5f, 1e-40f, -1e-45f, 65504.f, 65520.f, 1e10f, -3e9f,
+    std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(),
+    -std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::signaling_NaN(), std::numeric_limits<float>::denorm_min(),
+    std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(), 5.96046448e-08f, 2.98023224e-08f, 6.10351562e-05f,
+};
+
+// Random bit patterns, so every exponent is hit, with the special values spread over them
+std::vector<float> random_floats(size_t count)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> dis;
+    std::vector<float> values(count);
+    for (auto &v : values)
+    {
+        auto bits = dis(gen);
+        std::memcpy(&v, &bits, sizeof(v));
+    }
+
+    for (size_t i = 0; i < std::size(special_values); i++)
+        values[i * 37 % count] = special_values[i];
+    return values;
+}
+
+template <class T>
+bool bitwise_equal(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return a.size() == b.size() && !std::memcmp(a.data(), b.data(), a.size() * sizeof(T));
+}
+
+template <class TI, class TO>
+void expect_convert_exact(const std::vector<TI> &input)
+{
+    const runtime_shape_t shape { input.size() };
+    const auto strides = get_default_strides(shape);
+    kernel_context context;
+    std::vector<TO> expected(input.size()), actual(input.size());
+    auto in = reinterpret_cast<const gsl::byte *>(input.data());
+    cpu::reference::convert(to_datatype<TI>(), to_datatype<TO>(), in, reinterpret_cast<gsl::byte *>(expected.data()), shape, strides, strides, context)
+        .unwrap_or_throw();
+    kernels::convert(to_datatype<TI>(), to_datatype<TO>(), in, reinterpret_cast<gsl::byte *>(actual.data()), shape, strides, strides, context)
+        .unwrap_or_throw();
+    EXPECT_TRUE(bitwise_equal(expected, actual));
+}
+}
+
+template <class TQ>
+class QuantizeTest : public ::testing::Test
+{
+};
+
+using QuantizeTypes = ::testing::Types<uint8_t, int8_t>;
+TYPED_TEST_SUITE(QuantizeTest, QuantizeTypes);
+
+TYPED_TEST(QuantizeTest, quantize_same_as_reference)
+{
+    // odd count leaves a scalar tail after the vector blocks
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-12.f, 12.f);
+    std::vector<float> input(4099);
+    for (auto &v : input)
+        v = dis(gen);
+    for (size_t i = 0; i < std::size(special_values); i++)
+        input[i * 101] = special_values[i];
+
+    const runtime_shape_t shape { 1, input.size() };
+    const auto strides = get_default_strides(shape);
+    kernel_context context;
+    for (auto [scale, bias] : { std::pair { 10.f, 0.f }, std::pair { 21.25f, 128.f }, std::pair { 1.f / 3.f, -0.5f } })
+    {
+        std::vector<TypeParam> expected(input.size()), actual(input.size());
+        auto in = reinterpret_cast<const gsl::byte *>(input.data());
+        cpu::reference::quantize(dt_float32, to_datatype<TypeParam>(), in, reinterpret_cast<gsl::byte *>(expected.data()), shape, strides, strides, scale, bias, context)
+            .unwrap_or_throw();
+        kernels::quantize(dt_float32, to_datatype<TypeParam>(), in, reinterpret_cast<gsl::byte *>(actual.data()), shape, strides, strides, scale, bias, context)
+            .unwrap_or_throw();
+        EXPECT_EQ(expected, actual) << "scale " << scale << " bias " << bias;
+    }
+}
+
+TYPED_TEST(QuantizeTest, dequantize_same_as_reference)
+{
+    std::vector<TypeParam> input(1027);
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = (TypeParam)(i * 7);
+
+    const runtime_shape_t shape { 1, input.size() };
+    const auto strides = get_default_strides(shape);
+    kernel_context context;
+    for (auto [scale, bias] : { std::pair { 0.1f, 0.f }, std::pair { 0.0078125f, -1.f }, std::pair { 1.f / 3.f, 0.7f } })
+    {
+        std::vector<float> expected(input.size()), actual(input.size());
+        auto in = reinterpret_cast<const gsl::byte *>(input.data());
+        cpu::reference::dequantize(to_datatype<TypeParam>(), dt_float32, in, reinterpret_cast<gsl::byte *>(expected.data()), shape, strides, strides, scale, bias, context)
+            .unwrap_or_throw();
+        kernels::dequantize(to_datatype<TypeParam>(), dt_float32, in, reinterpret_cast<gsl::byte *>(actual.data()), shape, strides, strides, scale, bias, context)
+            .unwrap_or_throw();
+        EXPECT_TRUE(bitwise_equal(expected, actual)) << "scale " << scale << " bias " << bias;
+    }
+}
+
+TEST(ConvertTest, float_to_half_same_as_reference)
+{
+    expect_convert_exact<float, half>(random_floats(1 << 20 | 5));
+}
+
+TEST(ConvertTest, float_to_bfloat16_same_as_reference)
+{
+    expect_convert_exact<float, bfloat16>(random_floats(1 << 20 | 5));
+}
+
+TEST(ConvertTest, half_and_bfloat16_to_float_same_as_reference)
+{
+    // every 16 bit pattern, NaN payloads included
+    std::vector<half> halves(1 << 16);
+    std::vector<bfloat16> bfloats(1 << 16);
+    for (size_t i = 0; i < halves.size(); i++)
+    {
+        halves[i] = half::from_raw((uint16_t)i);
+        bfloats[i] = bfloat16::from_raw((uint16_t)i);
+    }
+    expect_convert_exact<half, float>(halves);
+    expect_convert_exact<bfloat16, float>(bfloats);
+}
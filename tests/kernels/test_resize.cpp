@@ -0,0 +1,91 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+template <class T>
+class ResizeTest : public ::testing::TestWithParam<std::tuple<size_t, uint32_t>>
+{
+public:
+    void SetUp() override
+    {
+        auto &&[case_id, threads] = GetParam();
+        context.num_threads = threads;
+
+        // letterbox sized RGB, a batched feature map upsampled 2x, and a downscale
+        const std::tuple<runtime_shape_t, int32_t, int32_t> cases[] = {
+            { { 1, 3, 45, 80 }, 96, 160 },
+            { { 2, 8, 10, 13 }, 20, 26 },
+            { { 1, 4, 33, 29 }, 7, 11 },
+        };
+        std::tie(in_shape, out_h, out_w) = cases[case_id];
+        out_shape = { in_shape[0], in_shape[1], (size_t)out_h, (size_t)out_w };
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dis(0.f, 255.f);
+        input.resize(compute_size(in_shape));
+        for (auto &v : input)
+            v = T(dis(gen));
+    }
+
+    void test(datatype_t type, float tolerance)
+    {
+        auto in = reinterpret_cast<const gsl::byte *>(input.data());
+        for (auto [align_corners, half_pixel_centers] : { std::pair { false, false }, std::pair { true, false }, std::pair { false, true } })
+        {
+            std::vector<T> expected(compute_size(out_shape)), output(expected.size());
+            cpu::reference::resize_bilinear(type, in, reinterpret_cast<gsl::byte *>(expected.data()), in_shape, get_default_strides(in_shape),
+                get_default_strides(out_shape), out_h, out_w, align_corners, half_pixel_centers, context)
+                .unwrap_or_throw();
+            ASSERT_TRUE(kernels::resize_bilinear(type, in, reinterpret_cast<gsl::byte *>(output.data()), in_shape, get_default_strides(in_shape),
+                get_default_strides(out_shape), out_h, out_w, align_corners, half_pixel_centers, context)
+                            .is_ok());
+            for (size_t i = 0; i < output.size(); i++)
+                ASSERT_NEAR((float)expected[i], (float)output[i], tolerance) << "at " << i;
+
+            cpu::reference::resize_nearest_neighbor(type, in, reinterpret_cast<gsl::byte *>(expected.data()), in_shape, get_default_strides(in_shape),
+                get_default_strides(out_shape), out_h, out_w, align_corners, half_pixel_centers, context)
+                .unwrap_or_throw();
+            ASSERT_TRUE(kernels::resize_nearest_neighbor(type, in, reinterpret_cast<gsl::byte *>(output.data()), in_shape, get_default_strides(in_shape),
+                get_default_strides(out_shape), out_h, out_w, align_corners, half_pixel_centers, context)
+                            .is_ok());
+            EXPECT_EQ(expected, output);
+        }
+    }
+
+    kernel_context context;
+    runtime_shape_t in_shape, out_shape;
+    int32_t out_h, out_w;
+    std::vector<T> input;
+};
+
+using ResizeFloatTest = ResizeTest<float>;
+using ResizeUInt8Test = ResizeTest<uint8_t>;
+
+INSTANTIATE_TEST_SUITE_P(Resize, ResizeFloatTest, testing::Combine(testing::Range<size_t>(0, 3), testing::Values(1u, 4u)));
+INSTANTIATE_TEST_SUITE_P(Resize, ResizeUInt8Test, testing::Combine(testing::Range<size_t>(0, 3), testing::Values(1u, 4u)));
+
+TEST_P(ResizeFloatTest, same_as_reference)
+{
+    test(dt_float32, 1e-3f);
+}
+
+TEST_P(ResizeUInt8Test, same_as_reference)
+{
+    // fixed point weights may round the other way
+    test(dt_uint8, 1.f);
+}
@@ -0,0 +1,149 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kmodel_util.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
+#include <nncase/runtime/scratch_arena.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace kmodel_util;
+
+namespace
+{
+// Goes to the heap and counts the bytes still allocated
+class counting_allocator : public host_allocator
+{
+public:
+    gsl::byte *allocate(size_t bytes) noexcept override
+    {
+        auto buffer = heap_.allocate(bytes);
+        if (buffer)
+            held += bytes;
+        return buffer;
+    }
+
+    void free(gsl::byte *buffer, size_t bytes) noexcept override
+    {
+        held -= bytes;
+        heap_.free(buffer, bytes);
+    }
+
+    size_t held = 0;
+
+private:
+    heap_host_allocator heap_;
+};
+
+const int32_t counts[] = { 256, 4096, 1024 };
+
+runtime_tensor filled(int32_t count, float value)
+{
+    auto tensor = hrt::create(dt_float32, { (size_t)count }).unwrap_or_throw();
+    auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+    auto p = reinterpret_cast<float *>(map.buffer().data());
+    for (int32_t i = 0; i < count; i++)
+        p[i] = value + (float)i;
+    return tensor;
+}
+
+std::vector<float> values(runtime_tensor &tensor)
+{
+    auto map = std::move(hrt::map(tensor, hrt::map_read).unwrap_or_throw());
+    auto p = reinterpret_cast<const float *>(map.buffer().data());
+    return { p, p + map.buffer().size() / sizeof(float) };
+}
+
+struct run_result
+{
+    std::vector<std::vector<float>> outputs;
+    size_t held;
+};
+
+// Loads one interpreter per model, then runs them one after another twice
+run_result run_models(const std::vector<std::vector<uint8_t>> &models, counting_allocator &allocator, scratch_arena *arena)
+{
+    std::vector<std::unique_ptr<interpreter>> interps;
+    for (auto &model : models)
+    {
+        auto &interp = *interps.emplace_back(std::make_unique<interpreter>());
+        interp.allocator(allocator);
+        if (arena)
+            interp.scratch(*arena);
+        interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+    }
+
+    run_result run;
+    for (float round : { 0.f, 100000.f })
+    {
+        run.outputs.clear();
+        for (size_t i = 0; i < interps.size(); i++)
+        {
+            auto count = counts[i];
+            auto output = filled(count, -1.f);
+            interps[i]->input_tensor(0, filled(count, round + (float)i * 10000.f)).unwrap_or_throw();
+            interps[i]->output_tensor(0, output).unwrap_or_throw();
+            interps[i]->run().unwrap_or_throw();
+            run.outputs.emplace_back(values(output));
+        }
+    }
+
+    run.held = allocator.held;
+    return run;
+}
+}
+
+TEST(ScratchArenaTest, interpreters_share_data_pool)
+{
+    std::vector<std::vector<uint8_t>> models;
+    for (auto count : counts)
+        models.emplace_back(identity_model(count));
+
+    counting_allocator own_allocator, shared_allocator;
+    auto own = run_models(models, own_allocator, nullptr);
+    scratch_arena arena(shared_allocator);
+    auto shared = run_models(models, shared_allocator, &arena);
+
+    ASSERT_EQ(own.outputs.size(), shared.outputs.size());
+    for (size_t i = 0; i < own.outputs.size(); i++)
+    {
+        EXPECT_EQ(own.outputs[i], shared.outputs[i]) << "model " << i;
+        EXPECT_EQ(100000.f + (float)i * 10000.f + counts[i] - 1, shared.outputs[i].back()) << "model " << i;
+    }
+
+    // each interpreter holds its own data pool, the arena only the largest one
+    auto data_size = [](int32_t count) { return (size_t)count * sizeof(float); };
+    size_t sum = 0, largest = 0;
+    for (auto count : counts)
+    {
+        sum += data_size(count);
+        largest = std::max(largest, data_size(count));
+    }
+
+    EXPECT_EQ(largest, arena.capacity());
+    EXPECT_LT(shared.held, own.held);
+    EXPECT_EQ(sum - largest, own.held - shared.held);
+
+    // trimming frees the buffer until the next run
+    auto held = shared_allocator.held;
+    arena.trim();
+    EXPECT_EQ(held - largest, shared_allocator.held);
+    EXPECT_EQ(largest, arena.capacity());
+    auto buffer = arena.acquire().unwrap_or_throw();
+    EXPECT_EQ(held, shared_allocator.held);
+}
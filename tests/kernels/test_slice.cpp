@@ -88,6 +88,28 @@ public:
     runtime_axis_t strides;
 };
 
+INSTANTIATE_TEST_SUITE_P(
+    SliceTestDims5,
+    SliceTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 3, 5, 4, 8, 6 }), // input shape
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0, 0 }, // input strides offset
+            runtime_shape_t { 0, 3, 0, 0, 0 }),
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0, 0 }, // begin
+            runtime_shape_t { 1, 2, 1, 1, 1 }),
+        testing::Values(
+            runtime_axis_t { 3, 5, 4, 8, 6 }, // end
+            runtime_axis_t { 2, 4, 3, 8, 6 }),
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0, 0 }, // output strides offset
+            runtime_shape_t { 3, 3, 3, 3, 3 }),
+        testing::Values(
+            runtime_axis_t { 1, 1, 1, 1, 1 }, // strides
+            runtime_axis_t { 1, 2, 1, 1, 3 })));
+
 INSTANTIATE_TEST_SUITE_P(
     SliceTestDims4,
     SliceTest,
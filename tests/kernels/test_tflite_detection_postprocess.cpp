@@ -0,0 +1,93 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+class DetectionPostprocessTest : public ::testing::TestWithParam<std::tuple<size_t, bool, int32_t, float>>
+{
+public:
+    void SetUp() override
+    {
+        std::tie(num_boxes, regular_nms, max_classes_per_detection, iou_threshold) = GetParam();
+        boxes_shape = { 1, num_boxes, 4 };
+        scores_shape = { 1, num_boxes, (size_t)num_classes + 1 };
+        anchors_shape = { num_boxes, 4 };
+
+        // anchors on a coarse grid so neighbours overlap, scores rounded so they tie
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> box_dis(-1.f, 1.f), score_dis(0.f, 1.f);
+        boxes.resize(compute_size(boxes_shape));
+        for (auto &v : boxes)
+            v = box_dis(gen);
+        anchors.resize(compute_size(anchors_shape));
+        for (size_t i = 0; i < num_boxes; i++)
+        {
+            anchors[i * 4 + 0] = (float)(i % 16) / 16;
+            anchors[i * 4 + 1] = (float)(i / 16 % 16) / 16;
+            anchors[i * 4 + 2] = 0.1f + (float)(i % 3) / 10;
+            anchors[i * 4 + 3] = 0.1f + (float)(i % 5) / 10;
+        }
+        scores.resize(compute_size(scores_shape));
+        for (auto &v : scores)
+            v = std::round(score_dis(gen) * 64) / 64;
+    }
+
+    struct outputs
+    {
+        std::vector<float> locations, classes, scores, num_detections;
+
+        bool operator==(const outputs &other) const
+        {
+            auto same = [](const std::vector<float> &a, const std::vector<float> &b) {
+                return a.size() == b.size() && !std::memcmp(a.data(), b.data(), a.size() * sizeof(float));
+            };
+            return same(locations, other.locations) && same(classes, other.classes) && same(scores, other.scores) && same(num_detections, other.num_detections);
+        }
+    };
+
+    template <class Kernel>
+    outputs run(Kernel &&kernel)
+    {
+        outputs out { std::vector<float>(max_detections * max_classes_per_detection * 4), std::vector<float>(max_detections * max_classes_per_detection),
+            std::vector<float>(max_detections * max_classes_per_detection), std::vector<float>(1) };
+        kernel(boxes.data(), scores.data(), anchors.data(), out.locations.data(), out.classes.data(), out.scores.data(), out.num_detections.data(),
+            boxes_shape, scores_shape, anchors_shape, max_detections, max_classes_per_detection, 100, regular_nms, 0.25f, iou_threshold,
+            num_classes, 10.f, 10.f, 5.f, 5.f)
+            .unwrap_or_throw();
+        return out;
+    }
+
+    size_t num_boxes;
+    bool regular_nms;
+    int32_t max_classes_per_detection;
+    float iou_threshold;
+    const int32_t num_classes = 12, max_detections = 50;
+    runtime_shape_t boxes_shape, scores_shape, anchors_shape;
+    std::vector<float> boxes, scores, anchors;
+};
+
+INSTANTIATE_TEST_SUITE_P(DetectionPostprocess, DetectionPostprocessTest,
+    testing::Combine(testing::Values(5, 1917, 12276), testing::Bool(), testing::Values(1, 3), testing::Values(0.f, 0.5f)));
+
+TEST_P(DetectionPostprocessTest, same_as_reference)
+{
+    auto expected = run([](auto &&...args) { return cpu::reference::tflite_detection_postprocess(args...); });
+    auto actual = run([](auto &&...args) { return kernels::tflite_detection_postprocess(args...); });
+    EXPECT_GT(expected.num_detections[0], 0);
+    EXPECT_TRUE(expected == actual);
+}
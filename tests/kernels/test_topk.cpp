@@ -0,0 +1,70 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+class TopKTest : public ::testing::TestWithParam<std::tuple<runtime_shape_t, int32_t, int64_t>>
+{
+public:
+    void SetUp() override
+    {
+        std::tie(in_shape, axis, k) = GetParam();
+        out_shape = in_shape;
+        out_shape[axis] = (size_t)k;
+
+        // few distinct values, so rows are full of ties, and a NaN now and then
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int32_t> dis(-8, 8);
+        input.resize(compute_size(in_shape));
+        for (auto &v : input)
+            v = (float)dis(gen) / 4;
+        for (size_t i = 7; i < input.size(); i += 97)
+            input[i] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    runtime_shape_t in_shape, out_shape;
+    int32_t axis;
+    int64_t k;
+    std::vector<float> input;
+};
+
+INSTANTIATE_TEST_SUITE_P(TopK, TopKTest,
+    testing::Values(std::tuple { runtime_shape_t { 64, 1000 }, 1, int64_t(5) },
+        std::tuple { runtime_shape_t { 64, 1000 }, 1, int64_t(100) },
+        std::tuple { runtime_shape_t { 2, 300, 7 }, 1, int64_t(20) },
+        std::tuple { runtime_shape_t { 40, 3, 5 }, 0, int64_t(40) },
+        std::tuple { runtime_shape_t { 1, 17 }, 1, int64_t(1) }));
+
+TEST_P(TopKTest, same_as_reference)
+{
+    const auto in_strides = get_default_strides(in_shape), out_strides = get_default_strides(out_shape);
+    for (auto [largest, sorted] : { std::pair { true, true }, std::pair { false, true }, std::pair { true, false }, std::pair { false, false } })
+    {
+        std::vector<float> expected(compute_size(out_shape)), actual(expected.size());
+        std::vector<int64_t> expected_indices(expected.size()), actual_indices(expected.size());
+        cpu::reference::topk(input.data(), expected.data(), expected_indices.data(), in_shape, in_strides, out_shape, out_strides, out_shape,
+            out_strides, k, axis, largest, sorted)
+            .unwrap_or_throw();
+        kernels::topk(input.data(), actual.data(), actual_indices.data(), in_shape, in_strides, out_shape, out_strides, out_shape,
+            out_strides, k, axis, largest, sorted)
+            .unwrap_or_throw();
+
+        EXPECT_EQ(expected_indices, actual_indices) << "largest " << largest << " sorted " << sorted;
+        EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float))) << "largest " << largest << " sorted " << sorted;
+    }
+}
@@ -0,0 +1,79 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import time
+import numpy as np
+from onnx import helper, numpy_helper, TensorProto
+import pytest
+import nncase
+
+
+def _pointwise_model():
+    # 1x1 convs over a symbolic sequence axis, every position is computed on its own
+    channels = 64
+    nodes, weights = [], []
+    x = 'x'
+    for i in range(8):
+        w = np.random.rand(channels, channels, 1, 1).astype(np.float32) * 0.05
+        weights.append(numpy_helper.from_array(w, f'w{i}'))
+        nodes.append(helper.make_node('Conv', [x, f'w{i}'], [f'conv{i}']))
+        x = f'conv{i}'
+    nodes.append(helper.make_node('Relu', [x], ['y']))
+
+    shape = [1, channels, 'seq', 16]
+    graph = helper.make_graph(nodes, 'pointwise',
+                              [helper.make_tensor_value_info('x', TensorProto.FLOAT, shape)],
+                              [helper.make_tensor_value_info('y', TensorProto.FLOAT, shape)],
+                              initializer=weights)
+    return helper.make_model(graph, producer_name='nncase')
+
+
+def _run(sim, data, runs=5):
+    sim.reshape_inputs([list(data.shape)])
+    sim.set_input_tensor(0, nncase.RuntimeTensor.from_numpy(data))
+    best = float('inf')
+    for _ in range(runs):
+        start = time.perf_counter()
+        sim.run()
+        best = min(best, time.perf_counter() - start)
+    return sim.get_output_tensor(0).to_numpy().copy(), best
+
+
+def test_dim_values(request):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compile_options.dim_values = {'seq': [256, 32]}
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(_pointwise_model().SerializeToString(), nncase.ImportOptions())
+    compiler.compile()
+    kmodel = compiler.gencode_tobytes()
+
+    sim = nncase.Simulator()
+    sim.load_model(kmodel)
+    long_input = np.random.rand(1, 64, 256, 16).astype(np.float32)
+    long_output, long_time = _run(sim, long_input)
+    short_output, short_time = _run(sim, long_input[:, :, :32].copy())
+    assert short_output.shape == (1, 64, 32, 16)
+    assert np.allclose(short_output, long_output[:, :, :32], atol=1e-5)
+
+    # the short variant does an eighth of the work instead of padding to the longest
+    assert short_time < long_time * 0.5
+
+    with pytest.raises(RuntimeError):
+        sim.reshape_inputs([[1, 64, 100, 16]])
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_dim_values.py'])
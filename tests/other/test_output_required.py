@@ -0,0 +1,89 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import time
+import numpy as np
+from onnx import helper, numpy_helper, TensorProto
+import pytest
+import nncase
+
+
+def _two_heads_model():
+    # a deep conv head and a cheap relu head on the same input
+    channels = 32
+    nodes, weights = [], []
+    x = 'x'
+    for i in range(8):
+        w = np.random.rand(channels, channels, 3, 3).astype(np.float32) * 0.05
+        weights.append(numpy_helper.from_array(w, f'w{i}'))
+        nodes.append(helper.make_node('Conv', [x, f'w{i}'], [f'conv{i}'], pads=[1, 1, 1, 1]))
+        x = f'conv{i}'
+    nodes.append(helper.make_node('Identity', [x], ['heavy']))
+    nodes.append(helper.make_node('Relu', ['x'], ['light']))
+
+    shape = [1, channels, 64, 64]
+    graph = helper.make_graph(nodes, 'two_heads',
+                              [helper.make_tensor_value_info('x', TensorProto.FLOAT, shape)],
+                              [helper.make_tensor_value_info('heavy', TensorProto.FLOAT, shape),
+                               helper.make_tensor_value_info('light', TensorProto.FLOAT, shape)],
+                              initializer=weights)
+    return helper.make_model(graph, producer_name='nncase')
+
+
+def _best_of(sim, runs=5):
+    best = float('inf')
+    for _ in range(runs):
+        start = time.perf_counter()
+        sim.run()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def test_output_required(request):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(_two_heads_model().SerializeToString(), nncase.ImportOptions())
+    compiler.compile()
+    kmodel = compiler.gencode_tobytes()
+
+    sim = nncase.Simulator()
+    sim.load_model(kmodel)
+    data = np.random.rand(1, 32, 64, 64).astype(np.float32) - 0.5
+    sim.set_input_tensor(0, nncase.RuntimeTensor.from_numpy(data))
+    sim.run()
+    outputs = [sim.get_output_tensor(i).to_numpy().copy() for i in range(sim.outputs_size)]
+    light = 0 if np.allclose(outputs[0], np.maximum(data, 0)) else 1
+    heavy = 1 - light
+    all_heads = _best_of(sim)
+
+    # the skipped head is left as it was, the other is computed as before
+    sim.set_output_required(heavy, False)
+    assert not sim.get_output_required(heavy)
+    sim.set_output_tensor(heavy, nncase.RuntimeTensor.from_numpy(np.zeros_like(outputs[heavy])))
+    light_only = _best_of(sim)
+    assert np.array_equal(sim.get_output_tensor(light).to_numpy(), outputs[light])
+    assert not sim.get_output_tensor(heavy).to_numpy().any()
+
+    # skipped heads cost no time, the light head alone is a small fraction of the whole model
+    assert light_only < all_heads * 0.25
+
+    sim.set_output_required(heavy, True)
+    sim.run()
+    assert np.array_equal(sim.get_output_tensor(heavy).to_numpy(), outputs[heavy])
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_output_required.py'])
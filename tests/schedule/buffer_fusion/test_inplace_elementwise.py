@@ -0,0 +1,73 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import glob
+import os
+import re
+import pytest
+import tensorflow as tf
+import numpy as np
+import nncase
+from tflite_test_runner import TfliteTestRunner
+
+
+def _make_module():
+    class Module(tf.Module):
+        def __init__(self):
+            super(Module).__init__()
+
+        @tf.function(input_signature=[tf.TensorSpec([1, 8, 8, 3], tf.float32)])
+        def __call__(self, x):
+            a = tf.math.sin(x)
+            b = tf.math.exp(a * 0.5)
+            # a is still alive here, so b must not overwrite it
+            c = tf.math.cos(b) + a
+            return tf.math.sigmoid(c) * 3.0
+    return Module()
+
+
+def _inplace_ops(model_file, dump_dir):
+    # ops of the .sched dumps that write their output over one of their inputs, `%n = op(%n, ...)`
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compile_options.dump_ir = True
+    compile_options.dump_dir = dump_dir
+    compiler = nncase.Compiler(compile_options)
+    with open(model_file, 'rb') as f:
+        compiler.import_tflite(f.read(), nncase.ImportOptions())
+    compiler.compile()
+    compiler.gencode_tobytes()
+
+    ops = []
+    for sched in glob.glob(os.path.join(dump_dir, 'codegen', '*.sched')):
+        with open(sched) as f:
+            for line in f:
+                m = re.match(r'\s*(%\d+) = (\w+)\(([^)]*)\)', line)
+                if m and m.group(1) in re.findall(r'%\d+', m.group(3)):
+                    ops.append(m.group(2))
+    return ops
+
+
+def test_inplace_elementwise(request, tmp_path):
+    module = _make_module()
+
+    runner = TfliteTestRunner(request.node.name)
+    model_file = runner.from_tensorflow(module)
+    assert _inplace_ops(model_file, str(tmp_path)), 'no elementwise op runs in place'
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_inplace_elementwise.py'])
@@ -693,6 +693,7 @@ class TestRunner(metaclass=ABCMeta):
         compile_options.is_fpga = cfg.compile_opt.is_fpga
         compile_options.use_mse_quant_w = cfg.compile_opt.use_mse_quant_w
         compile_options.split_w_to_act = cfg.compile_opt.split_w_to_act
+        compile_options.w_storage_type = cfg.compile_opt.w_storage_type
         compile_options.input_type = preprocess['input_type']
         compile_options.output_type = cfg.compile_opt.output_type
         compile_options.output_range = cfg.compile_opt.output_range
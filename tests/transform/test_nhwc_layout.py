@@ -0,0 +1,77 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import tensorflow as tf
+import numpy as np
+from tflite_test_runner import TfliteTestRunner
+
+
+def _make_module(in_shape, out_channel, pool, resize):
+    class Module(tf.Module):
+        def __init__(self):
+            super(Module).__init__()
+
+        @tf.function(input_signature=[tf.TensorSpec(in_shape, tf.float32)])
+        def __call__(self, x):
+            dw = tf.constant(np.random.rand(3, 3, in_shape[3], 1).astype(np.float32) - 0.5)
+            pw = tf.constant(np.random.rand(1, 1, in_shape[3], out_channel).astype(np.float32) - 0.5)
+            conv = tf.constant(np.random.rand(3, 3, out_channel, out_channel).astype(np.float32) - 0.5)
+            y = tf.nn.relu6(tf.nn.depthwise_conv2d(x, dw, strides=[1, 1, 1, 1], padding='SAME'))
+            y = tf.nn.conv2d(y, pw, strides=[1, 1, 1, 1], padding='VALID')
+            if pool:
+                y = tf.nn.max_pool2d(y, 2, 2, padding='VALID')
+            y = tf.pad(y, [[0, 0], [1, 1], [1, 1], [0, 0]])
+            y = y + tf.nn.conv2d(y, conv, strides=[1, 1, 1, 1], padding='SAME')
+            if resize:
+                y = tf.image.resize(y, [y.shape[1] * 2, y.shape[2] * 2], method='bilinear')
+            return tf.math.sigmoid(y)
+    return Module()
+
+
+in_shapes = [
+    [1, 16, 16, 8],
+    [1, 15, 17, 3]
+]
+
+out_channels = [
+    4
+]
+
+pools = [
+    True,
+    False
+]
+
+resizes = [
+    True,
+    False
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('out_channel', out_channels)
+@pytest.mark.parametrize('pool', pools)
+@pytest.mark.parametrize('resize', resizes)
+def test_nhwc_layout(in_shape, out_channel, pool, resize, request):
+    module = _make_module(in_shape, out_channel, pool, resize)
+
+    runner = TfliteTestRunner(request.node.name)
+    model_file = runner.from_tensorflow(module)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_nhwc_layout.py'])
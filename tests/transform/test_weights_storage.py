@@ -0,0 +1,68 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import torch
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_channel, out_channel, out_features):
+    class Module(torch.nn.Module):
+        def __init__(self):
+            super(Module, self).__init__()
+            self.conv2d = torch.nn.Conv2d(in_channel, out_channel, 3, padding=1)
+            self.dw = torch.nn.Conv2d(out_channel, out_channel, 3, padding=1, groups=out_channel)
+            self.fc = torch.nn.Linear(out_channel, out_features)
+
+        def forward(self, x):
+            x = torch.relu(self.conv2d(x))
+            x = self.dw(x)
+            x = torch.mean(x, dim=[2, 3])
+            return self.fc(x)
+
+    return Module()
+
+
+in_shapes = [
+    [1, 8, 16, 16]
+]
+
+# The runner compares the kmodel outputs against the float32 model
+overwrite_cfgs = [
+    """
+case:
+    compile_opt:
+        w_storage_type: 'float16'
+    """,
+    """
+case:
+    compile_opt:
+        w_storage_type: 'bfloat16'
+    """
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('overwrite_cfg', overwrite_cfgs, ids=["float16", "bfloat16"])
+def test_weights_storage(in_shape, overwrite_cfg, request):
+    module = _make_module(in_shape[1], 16, 32)
+
+    runner = OnnxTestRunner(request.node.name, overwrite_configs=overwrite_cfg)
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_weights_storage.py'])
@@ -6,6 +6,8 @@ if (${CMAKE_HOST_SYSTEM_NAME} MATCHES "Windows")
 elseif (${CMAKE_HOST_SYSTEM_NAME} MATCHES "Linux")
     add_definitions(-DX86_64_SIMD_ON)
     add_compile_options( -mfma -msse -msse2 -msse3 -mssse3 -msse4 -msse4a -msse4.1 -msse4.2 -mavx -mavx2)
+    # Only for the sources that check the CPU supports F16C before they use it
+    set(X86_64_F16C_FLAGS -mf16c)
 else()
     message("current platform: other ... ")
 endif()
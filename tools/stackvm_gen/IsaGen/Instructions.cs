@@ -138,6 +138,7 @@ namespace IsaGen
 		BREAK,
 
 		TENSOR,
+		BR_UNUSED,
 	}
 
 	[BitLength(16)]
@@ -187,7 +188,10 @@ namespace IsaGen
 		TFLITE_DETECTION_POSTPROCESS,
 		LAYER_NORMALIZATION,
 		COMPRESS,
-		GATHER_ELEMENTS
+		GATHER_ELEMENTS,
+		LSTM,
+		CONV2D_CHAIN,
+		FUSED_ELEMENTWISE
 	}
 
 	[BitLength(8)]
@@ -1087,6 +1091,22 @@ namespace IsaGen
 		public override OpCode OpCode => OpCode.BREAK;
 	}
 
+	[DisplayName("BR_UNUSED")]
+	[Category("Control and Status Instructions")]
+	[Description("Transfers control to a target instruction if none of the function outputs in the masks popped from the stack is required")]
+	public class BrUnusedInstruction : Instruction
+	{
+		public override OpCode OpCode => OpCode.BR_UNUSED;
+
+		[DisplayName("masks")]
+		[Description("Count of 32 bit output masks, the first one covers outputs 0 to 31 and is pushed first")]
+		public byte Masks { get; set; }
+
+		[DisplayName("target")]
+		[Description("Branches to a target instruction at the specified offset")]
+		public int Target { get; set; }
+	}
+
 	public static class TensorCalls
 	{
 		public abstract class TensorInstruction : Instruction
@@ -1280,6 +1300,74 @@ namespace IsaGen
 			[Description("Datatype")]
 			public DataType DataType { get; set; }
 
+			[DisplayName("w_datatype")]
+			[Description("Weights datatype")]
+			public DataType WDataType { get; set; }
+
+			[DisplayName("rshape_src")]
+			[Description("Source shape register")]
+			public byte RshapeSrc { get; set; }
+
+			[DisplayName("rstride_src")]
+			[Description("Source stride register")]
+			public byte RstrideSrc { get; set; }
+
+			[DisplayName("rshape_kernel")]
+			[Description("Kernel shape register")]
+			public byte RshapeKernel { get; set; }
+
+			[DisplayName("rstride_kernel")]
+			[Description("Kernel stride register")]
+			public byte RstrideKernel { get; set; }
+
+			[DisplayName("rstride_bias")]
+			[Description("Bias stride register")]
+			public byte RstrideBias { get; set; }
+
+			[DisplayName("rstride_dest")]
+			[Description("Dest stride register")]
+			public byte RstrideDest { get; set; }
+
+			[DisplayName("groups")]
+			[Description("Groups")]
+			public ushort Groups { get; set; }
+
+			[DisplayName("stride_h")]
+			[Description("StrideH")]
+			public ushort StrideH { get; set; }
+
+			[DisplayName("stride_w")]
+			[Description("StrideW")]
+			public ushort StrideW { get; set; }
+
+			[DisplayName("dilation_h")]
+			[Description("DilationH")]
+			public ushort DilationH { get; set; }
+
+			[DisplayName("dilation_w")]
+			[Description("DilationW")]
+			public ushort DilationW { get; set; }
+
+			[DisplayName("fused_clamp_low")]
+			[Description("FusedClampLow")]
+			public float FusedClampLow { get; set; }
+
+			[DisplayName("fused_clamp_high")]
+			[Description("FusedClampHigh")]
+			public float FusedClampHigh { get; set; }
+		}
+
+		[DisplayName("TENSOR.CONV2D_TRANSPOSE")]
+		[Category("Tensor Instructions")]
+		[Description("Conv2DTranspose")]
+		public class Conv2DTransposeInstruction : TensorInstruction
+		{
+			public override TensorFunction Function => TensorFunction.CONV2D_TRANSPOSE;
+
+			[DisplayName("datatype")]
+			[Description("Datatype")]
+			public DataType DataType { get; set; }
+
 			[DisplayName("rshape_src")]
 			[Description("Source shape register")]
 			public byte RshapeSrc { get; set; }
@@ -1300,6 +1388,10 @@ namespace IsaGen
 			[Description("Bias stride register")]
 			public byte RstrideBias { get; set; }
 
+			[DisplayName("rshape_dest")]
+			[Description("Dest shape register")]
+			public byte RshapeDest { get; set; }
+
 			[DisplayName("rstride_dest")]
 			[Description("Dest stride register")]
 			public byte RstrideDest { get; set; }
@@ -1572,6 +1664,10 @@ namespace IsaGen
 		{
 			public override TensorFunction Function => TensorFunction.MATMUL;
 
+			[DisplayName("w_datatype")]
+			[Description("Source2 datatype")]
+			public DataType WDataType { get; set; }
+
 			[DisplayName("rshape_src1")]
 			[Description("Source1 shape register")]
 			public byte RshapeSrc1 { get; set; }
@@ -2438,5 +2534,113 @@ namespace IsaGen
             [Description("Axis")]
             public int Axis { get; set; }
         }
+
+		[DisplayName("TENSOR.LSTM")]
+		[Category("Tensor Instructions")]
+		[Description("Lstm")]
+		public class LstmInstruction : TensorInstruction
+		{
+			public override TensorFunction Function => TensorFunction.LSTM;
+
+			[DisplayName("input_shape_src")]
+			[Description("Input shape register")]
+			public byte RshapeSrc1 { get; set; }
+
+			[DisplayName("initial_h_shape_src")]
+			[Description("Initial_h shape register")]
+			public byte RshapeSrc2 { get; set; }
+
+			[DisplayName("w_shape_src")]
+			[Description("W shape register")]
+			public byte RshapeSrc3 { get; set; }
+
+			[DisplayName("b_shape_src")]
+			[Description("B shape register")]
+			public byte RshapeSrc4 { get; set; }
+
+			[DisplayName("sequence_lens_src")]
+			[Description("Sequence lens register")]
+			public byte RshapeSrc5 { get; set; }
+
+			[DisplayName("direction")]
+			[Description("Direction")]
+			public byte Direction { get; set; }
+
+			[DisplayName("framework")]
+			[Description("Framework")]
+			public byte Framework { get; set; }
+		}
+
+		[DisplayName("TENSOR.CONV2D_CHAIN")]
+		[Category("Tensor Instructions")]
+		[Description("Conv2D chain, executed band by band")]
+		public class Conv2DChainInstruction : TensorInstruction
+		{
+			public override TensorFunction Function => TensorFunction.CONV2D_CHAIN;
+
+			[DisplayName("datatype")]
+			[Description("Datatype")]
+			public DataType DataType { get; set; }
+
+			[DisplayName("rshape_src")]
+			[Description("Source shape register")]
+			public byte RshapeSrc { get; set; }
+
+			[DisplayName("rstride_src")]
+			[Description("Source stride register")]
+			public byte RstrideSrc { get; set; }
+
+			[DisplayName("rstride_dest")]
+			[Description("Dest stride register")]
+			public byte RstrideDest { get; set; }
+
+			[DisplayName("rstage_src")]
+			[Description("First stage shape register, two per stage")]
+			public byte RstageSrc { get; set; }
+
+			[DisplayName("rpad_src")]
+			[Description("First stage paddings register, one per stage")]
+			public byte RpadSrc { get; set; }
+
+			[DisplayName("stages")]
+			[Description("Stages")]
+			public byte Stages { get; set; }
+
+			[DisplayName("tile_h")]
+			[Description("Output rows per band")]
+			public ushort TileH { get; set; }
+		}
+
+		[DisplayName("TENSOR.FUSED_ELEMENTWISE")]
+		[Category("Tensor Instructions")]
+		[Description("Fused elementwise, evaluates an nnil body per output element")]
+		public class FusedElementwiseInstruction : TensorInstruction
+		{
+			public override TensorFunction Function => TensorFunction.FUSED_ELEMENTWISE;
+
+			[DisplayName("datatype")]
+			[Description("Datatype")]
+			public DataType DataType { get; set; }
+
+			[DisplayName("rshape_dest")]
+			[Description("Dest shape register")]
+			public byte RshapeDest { get; set; }
+
+			[DisplayName("rstride_dest")]
+			[Description("Dest stride register")]
+			public byte RstrideDest { get; set; }
+
+			[DisplayName("rshape_src")]
+			[Description("First source shape register, shape and strides per input")]
+			public byte RshapeSrc { get; set; }
+
+			[DisplayName("inputs")]
+			[Description("Inputs")]
+			public byte Inputs { get; set; }
+
+			[DisplayName("body_size")]
+			[Description("Size of the nnil body that follows the instruction")]
+			public ushort BodySize { get; set; }
+		}
 	}
 }